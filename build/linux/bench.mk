@@ -0,0 +1,101 @@
+.PHONY: bench
+bench:
+
+
+BENCH_LIB:=$(LIB) bin/mcpp.so
+
+
+#	COMPRESSION
+
+
+bench: bin/bench_compression.exe
+
+
+bin/bench_compression.exe: \
+$(OBJ) \
+obj/bench/compression.o | \
+$(BENCH_LIB) \
+bin/data_provider.so \
+bin/mods/mcpp_world.so
+	$(GPP) -o $@ $^ $(BENCH_LIB) bin/data_provider.so bin/mods/mcpp_world.so -lzstd -Wl,-rpath,'$$ORIGIN/mods' $(call LINK)
+
+
+#	JSON
+
+
+bench: bin/bench_json.exe
+
+
+bin/bench_json.exe: \
+$(OBJ) \
+obj/bench/json.o | \
+$(BENCH_LIB)
+	$(GPP) -o $@ $^ $(BENCH_LIB) $(call LINK)
+
+
+#	RANDOM
+
+
+bench: bin/bench_random.exe
+
+
+bin/bench_random.exe: \
+$(OBJ) \
+obj/bench/random.o | \
+$(BENCH_LIB)
+	$(GPP) -o $@ $^ $(BENCH_LIB) $(call LINK)
+
+
+#	HTTP
+
+
+bench: bin/bench_http.exe
+
+
+bin/bench_http.exe: \
+$(OBJ) \
+obj/bench/http.o | \
+$(BENCH_LIB)
+	$(GPP) -o $@ $^ $(BENCH_LIB) $(call LINK)
+
+
+#	AES
+
+
+bench: bin/bench_aes.exe
+
+
+bin/bench_aes.exe: \
+$(OBJ) \
+obj/bench/aes.o | \
+$(BENCH_LIB)
+	$(GPP) -o $@ $^ $(BENCH_LIB) -lcrypto $(call LINK)
+
+
+#	NOTIFIER
+
+
+bench: bin/bench_notifier.exe
+
+
+bin/bench_notifier.exe: \
+$(OBJ) \
+obj/bench/notifier.o \
+obj/bench/syscalls.o \
+obj/load_test/histogram.o | \
+$(BENCH_LIB)
+	$(GPP) -o $@ $^ $(BENCH_LIB) -ldl $(call LINK)
+
+
+#	OWNERSHIP
+
+
+bench: bin/bench_ownership.exe
+
+
+bin/bench_ownership.exe: \
+$(OBJ) \
+obj/bench/ownership.o | \
+$(BENCH_LIB) \
+bin/mods/mcpp_world.so
+	$(GPP) -o $@ $^ $(BENCH_LIB) bin/mods/mcpp_world.so -Wl,-rpath,'$$ORIGIN/mods' $(call LINK)
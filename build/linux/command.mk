@@ -3,6 +3,7 @@ bin/mods/mcpp_command.so \
 bin/mods/mcpp_command_chat_log.so \
 bin/mods/mcpp_command_kick.so \
 bin/mods/mcpp_command_op.so \
+bin/mods/mcpp_command_profile.so \
 bin/mods/mcpp_command_time.so \
 bin/mods/mcpp_command_whisper.so \
 
@@ -55,6 +56,16 @@ bin/mods/mcpp_op.so
 	$(GPP) -shared -o $@ $^ $(COMMAND_LIB) bin/mods/mcpp_op.so $(call LINK,$@)
 	
 	
+#	PROFILE
+
+
+bin/mods/mcpp_command_profile.so: \
+$(MOD_OBJ) \
+obj/profile/command.o | \
+$(COMMAND_LIB)
+	$(GPP) -shared -o $@ $^ $(COMMAND_LIB) $(call LINK,$@)
+	
+	
 #	DISPLAY TIME
 
 
@@ -1,12 +1,16 @@
 mods: \
 bin/mods/mcpp_info.so \
+bin/mods/mcpp_info_auth.so \
 bin/mods/mcpp_info_ban.so \
 bin/mods/mcpp_info_client.so \
 bin/mods/mcpp_info_data_provider.so \
+bin/mods/mcpp_info_dns.so \
 bin/mods/mcpp_info_mcpp.so \
 bin/mods/mcpp_info_op.so \
 bin/mods/mcpp_info_os.so \
 bin/mods/mcpp_info_pool.so \
+bin/mods/mcpp_info_pregen.so \
+bin/mods/mcpp_info_profile.so \
 bin/mods/mcpp_info_world.so
 
 
@@ -26,6 +30,17 @@ bin/mods/mcpp_op.so
 INFO_LIB:=$(MOD_LIB) bin/mods/mcpp_info.so bin/mods/mcpp_chat.so
 
 
+#	AUTHENTICATION
+
+
+bin/mods/mcpp_info_auth.so: \
+$(MOD_OBJ) \
+obj/auth/info.o | \
+$(INFO_LIB) \
+bin/mods/mcpp_auth.so
+	$(GPP) -shared -o $@ $^ $(INFO_LIB) bin/mods/mcpp_auth.so $(call LINK,$@)
+	
+	
 #	BANS
 
 
@@ -57,6 +72,16 @@ $(INFO_LIB)
 	$(GPP) -shared -o $@ $^ $(INFO_LIB) $(call LINK,$@)
 	
 	
+#	DNS
+
+
+bin/mods/mcpp_info_dns.so: \
+$(MOD_OBJ) \
+obj/info/dns.o | \
+$(INFO_LIB)
+	$(GPP) -shared -o $@ $^ $(INFO_LIB) $(call LINK,$@)
+	
+	
 #	MCPP
 
 
@@ -98,6 +123,27 @@ $(INFO_LIB)
 	$(GPP) -shared -o $@ $^ $(INFO_LIB) $(call LINK,$@)
 	
 	
+#	WORLD PRE-GENERATION
+
+
+bin/mods/mcpp_info_pregen.so: \
+$(MOD_OBJ) \
+obj/pregen/info.o | \
+$(INFO_LIB) \
+bin/mods/mcpp_pregen.so
+	$(GPP) -shared -o $@ $^ $(INFO_LIB) bin/mods/mcpp_pregen.so $(call LINK,$@)
+	
+	
+#	PROFILER
+
+
+bin/mods/mcpp_info_profile.so: \
+$(MOD_OBJ) \
+obj/profile/info.o | \
+$(INFO_LIB)
+	$(GPP) -shared -o $@ $^ $(INFO_LIB) $(call LINK,$@)
+	
+	
 #	WORLD
 
 
@@ -0,0 +1,16 @@
+all: load_test
+
+
+.PHONY: load_test
+load_test: bin/load_test.exe
+
+
+bin/load_test.exe: \
+$(OBJ) \
+obj/load_test/client.o \
+obj/load_test/generator.o \
+obj/load_test/histogram.o \
+obj/load_test/main.o | \
+$(LIB) \
+bin/mcpp.so
+	$(GPP) -o $@ $^ $(LIB) bin/mcpp.so $(call LINK)
\ No newline at end of file
@@ -7,11 +7,13 @@ mcpp: bin/mcpp.so
 
 bin/mcpp.so: \
 $(OBJ) \
+obj/accept_limiter.o \
 obj/aes_128_cfb_8.o \
 obj/base_64.o \
 obj/client.o \
 obj/client_list.o \
 obj/client_list_iterator.o \
+obj/codec.o \
 obj/compression.o \
 obj/concurrency_manager.o \
 obj/dns_handler.o \
@@ -20,11 +22,13 @@ obj/hardware_concurrency.o \
 obj/http_handler.o \
 obj/ip_address_range.o \
 obj/json.o \
+obj/log_queue.o \
 obj/mod.o \
 obj/mod_loader.o \
 obj/multi_scope_guard.o \
 obj/nbt.o \
 obj/network/connection.o \
+obj/network/send_handle.o \
 obj/network/linux/notification.o \
 obj/network/linux/notifier.o \
 obj/network/posix/channel_base.o \
@@ -42,6 +46,7 @@ obj/network/posix/worker.o \
 obj/noise.o \
 obj/packet.o \
 obj/packet_router.o \
+obj/profiler.o \
 obj/recursive_mutex.o \
 obj/rsa_key.o \
 obj/serializer.o \
@@ -54,4 +59,14 @@ obj/thread_pool.o \
 obj/yggdrasil.o | \
 bin \
 bin/data_provider.so
-	$(GPP) -shared -o $@ $^ $(LIB) bin/data_provider.so -lz -lcrypto -lcurl -lcares -lpthread $(call LINK,$@)
\ No newline at end of file
+	$(GPP) -shared -o $@ $^ $(LIB) bin/data_provider.so -lz -lzstd -lcrypto -lcurl -lcares -lpthread $(call LINK,$@)
+
+
+#	The AES-NI kernel is only built by GCC 4.8 if the
+#	whole file targets AES-NI, and is slower than
+#	OpenSSL unless it is optimized, so this file is
+#	optimized even in debug builds.  The CPU is still
+#	checked before the kernel is used
+ifneq ($(filter x86_64 i386 i486 i586 i686,$(shell uname -m)),)
+obj/aes_128_cfb_8.o: GPP:=$(GPP) -maes -O3
+endif
\ No newline at end of file
@@ -25,6 +25,7 @@ bin/mods/mcpp_keep_alive.so \
 bin/mods/mcpp_op.so \
 bin/mods/mcpp_ping.so \
 bin/mods/mcpp_player_list.so \
+bin/mods/mcpp_pregen.so \
 bin/mods/mcpp_time.so
 
 
@@ -108,6 +109,18 @@ $(MOD_LIB)
 	$(GPP) -shared -o $@ $^ $(MOD_LIB) $(call LINK,$@)
 	
 	
+#	WORLD PRE-GENERATION
+
+
+bin/mods/mcpp_pregen.so: \
+$(MOD_OBJ) \
+obj/pregen/main.o | \
+$(MOD_LIB) \
+bin/mods/mcpp_time.so \
+bin/mods/mcpp_world.so
+	$(GPP) -shared -o $@ $^ $(MOD_LIB) bin/mods/mcpp_time.so bin/mods/mcpp_world.so $(call LINK,$@)
+	
+	
 #	TIME
 
 
@@ -8,6 +8,7 @@ src/player/get_player.cpp \
 src/player/player.cpp \
 src/player/players.cpp \
 src/player/player_position.cpp \
+src/player/prefetch.cpp \
 src/player/set_spawn.cpp \
 src/player/update_position.cpp | \
 $(MOD_LIB) \
@@ -0,0 +1,88 @@
+.PHONY: bench
+bench:
+
+
+BENCH_LIB:=$(LIB) bin/mcpp.dll
+
+
+#	COMPRESSION
+
+
+bench: bin/mcpp_bench_compression.exe
+
+
+bin/mcpp_bench_compression.exe: \
+$(OBJ) \
+obj/bench/compression.o | \
+$(BENCH_LIB) \
+bin/data_provider.dll \
+bin/libzstd.dll \
+bin/mods/mcpp_world.dll
+	$(GPP) -o $@ $^ $(BENCH_LIB) bin/data_provider.dll bin/libzstd.dll bin/mods/mcpp_world.dll
+
+
+#	JSON
+
+
+bench: bin/mcpp_bench_json.exe
+
+
+bin/mcpp_bench_json.exe: \
+$(OBJ) \
+obj/bench/json.o | \
+$(BENCH_LIB)
+	$(GPP) -o $@ $^ $(BENCH_LIB)
+
+
+#	RANDOM
+
+
+bench: bin/mcpp_bench_random.exe
+
+
+bin/mcpp_bench_random.exe: \
+$(OBJ) \
+obj/bench/random.o | \
+$(BENCH_LIB)
+	$(GPP) -o $@ $^ $(BENCH_LIB)
+
+
+#	HTTP
+
+
+bench: bin/mcpp_bench_http.exe
+
+
+bin/mcpp_bench_http.exe: \
+$(OBJ) \
+obj/bench/http.o | \
+$(BENCH_LIB)
+	$(GPP) -o $@ $^ $(BENCH_LIB)
+
+
+#	AES
+
+
+bench: bin/mcpp_bench_aes.exe
+
+
+bin/mcpp_bench_aes.exe: \
+$(OBJ) \
+obj/bench/aes.o | \
+$(BENCH_LIB) \
+bin/libeay32.dll
+	$(GPP) -o $@ $^ $(BENCH_LIB) bin/libeay32.dll
+
+
+#	OWNERSHIP
+
+
+bench: bin/mcpp_bench_ownership.exe
+
+
+bin/mcpp_bench_ownership.exe: \
+$(OBJ) \
+obj/bench/ownership.o | \
+$(BENCH_LIB) \
+bin/mods/mcpp_world.dll
+	$(GPP) -o $@ $^ $(BENCH_LIB) bin/mods/mcpp_world.dll
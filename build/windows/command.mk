@@ -7,6 +7,8 @@ bin/mods/mcpp_command.dll \
 bin/mods/mcpp_command_blacklist.dll \
 bin/mods/mcpp_command_kick.dll \
 bin/mods/mcpp_command_permissions.dll \
+bin/mods/mcpp_command_pregen.dll \
+bin/mods/mcpp_command_profile.dll \
 bin/mods/mcpp_command_save.dll \
 bin/mods/mcpp_command_settings.dll \
 bin/mods/mcpp_command_shutdown.dll \
@@ -76,6 +78,28 @@ bin/mods/mcpp_permissions.dll
 	$(GPP) -shared -o $@ $^ $(COMMAND_LIB) bin/mods/mcpp_permissions.dll
 	
 	
+#	WORLD PRE-GENERATION
+
+
+bin/mods/mcpp_command_pregen.dll: \
+$(MOD_OBJ) \
+obj/pregen/command.o | \
+$(COMMAND_LIB) \
+bin/mods/mcpp_permissions.dll \
+bin/mods/mcpp_pregen.dll
+	$(GPP) -shared -o $@ $^ $(COMMAND_LIB) bin/mods/mcpp_permissions.dll bin/mods/mcpp_pregen.dll
+	
+	
+#	PROFILE
+
+
+bin/mods/mcpp_command_profile.dll: \
+$(MOD_OBJ) \
+obj/profile/command.o | \
+$(COMMAND_LIB)
+	$(GPP) -shared -o $@ $^ $(COMMAND_LIB)
+	
+	
 #	SAVE
 
 
@@ -4,17 +4,21 @@ mods: info
 .PHONY: info
 info: \
 bin/mods/mcpp_info.dll \
+bin/mods/mcpp_info_auth.dll \
 bin/mods/mcpp_info_ban.dll \
 bin/mods/mcpp_info_blacklist.dll \
 bin/mods/mcpp_info_brand.dll \
 bin/mods/mcpp_info_client.dll \
 bin/mods/mcpp_info_data_provider.dll \
+bin/mods/mcpp_info_dns.dll \
 bin/mods/mcpp_info_handler.dll \
 bin/mods/mcpp_info_mcpp.dll \
 bin/mods/mcpp_info_mods.dll \
 bin/mods/mcpp_info_os.dll \
 bin/mods/mcpp_info_permissions.dll \
 bin/mods/mcpp_info_pool.dll \
+bin/mods/mcpp_info_pregen.dll \
+bin/mods/mcpp_info_profile.dll \
 bin/mods/mcpp_info_save.dll \
 bin/mods/mcpp_info_time.dll \
 bin/mods/mcpp_info_whitelist.dll \
@@ -37,6 +41,17 @@ bin/mods/mcpp_permissions.dll
 INFO_LIB:=$(MOD_LIB) bin/mods/mcpp_info.dll bin/mods/mcpp_chat.dll
 
 
+#	AUTHENTICATION
+
+
+bin/mods/mcpp_info_auth.dll: \
+$(MOD_OBJ) \
+obj/auth/info.o | \
+$(INFO_LIB) \
+bin/mods/mcpp_auth.dll
+	$(GPP) -shared -o $@ $^ $(INFO_LIB) bin/mods/mcpp_auth.dll
+	
+	
 #	BANS
 
 
@@ -90,6 +105,16 @@ $(INFO_LIB)
 	$(GPP) -shared -o $@ $^ $(INFO_LIB)
 	
 	
+#	DNS
+
+
+bin/mods/mcpp_info_dns.dll: \
+$(MOD_OBJ) \
+obj/info/dns.o | \
+$(INFO_LIB)
+	$(GPP) -shared -o $@ $^ $(INFO_LIB)
+	
+	
 #	HANDLER
 
 
@@ -151,6 +176,27 @@ $(INFO_LIB)
 	$(GPP) -shared -o $@ $^ $(INFO_LIB)
 	
 	
+#	PROFILER
+
+
+bin/mods/mcpp_info_profile.dll: \
+$(MOD_OBJ) \
+obj/profile/info.o | \
+$(INFO_LIB)
+	$(GPP) -shared -o $@ $^ $(INFO_LIB)
+	
+	
+#	WORLD PRE-GENERATION
+
+
+bin/mods/mcpp_info_pregen.dll: \
+$(MOD_OBJ) \
+obj/pregen/info.o | \
+$(INFO_LIB) \
+bin/mods/mcpp_pregen.dll
+	$(GPP) -shared -o $@ $^ $(INFO_LIB) bin/mods/mcpp_pregen.dll
+	
+	
 #	SAVE SYSTEM
 
 
@@ -0,0 +1,16 @@
+all: load_test
+
+
+.PHONY: load_test
+load_test: bin/mcpp_load_test.exe
+
+
+bin/mcpp_load_test.exe: \
+$(OBJ) \
+obj/load_test/client.o \
+obj/load_test/generator.o \
+obj/load_test/histogram.o \
+obj/load_test/main.o | \
+$(LIB) \
+bin/mcpp.dll
+	$(GPP) -o $@ $^ $(LIB) bin/mcpp.dll
\ No newline at end of file
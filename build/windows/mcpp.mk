@@ -7,7 +7,8 @@ bin/libcares-2.dll \
 bin/libcurl.dll \
 bin/libeay32.dll \
 bin/ssleay32.dll \
-bin/zlib1.dll
+bin/zlib1.dll \
+bin/libzstd.dll
 
 
 .PHONY: mcpp
@@ -16,11 +17,13 @@ mcpp: bin/mcpp.dll
 
 bin/mcpp.dll: \
 $(OBJ) \
+obj/accept_limiter.o \
 obj/aes_128_cfb_8.o \
 obj/base_64.o \
 obj/client.o \
 obj/client_list.o \
 obj/client_list_iterator.o \
+obj/codec.o \
 obj/compression.o \
 obj/concurrency_manager.o \
 obj/dns_handler.o \
@@ -29,11 +32,13 @@ obj/hardware_concurrency.o \
 obj/http_handler.o \
 obj/ip_address_range.o \
 obj/json.o \
+obj/log_queue.o \
 obj/mod.o \
 obj/mod_loader.o \
 obj/multi_scope_guard.o \
 obj/nbt.o \
 obj/network/connection.o \
+obj/network/send_handle.o \
 obj/network/windows/accept_command.o \
 obj/network/windows/accept_data.o \
 obj/network/windows/completion_command.o \
@@ -51,6 +56,7 @@ obj/network/windows/send_command.o \
 obj/noise.o \
 obj/packet.o \
 obj/packet_router.o \
+obj/profiler.o \
 obj/recursive_mutex.o \
 obj/rsa_key.o \
 obj/serializer.o \
@@ -62,4 +68,10 @@ obj/url.o \
 obj/yggdrasil.o | \
 $(MCPP_LIB) \
 bin
-	$(GPP) -shared -o $@ $^ $(MCPP_LIB) -lws2_32
\ No newline at end of file
+	$(GPP) -shared -o $@ $^ $(MCPP_LIB) -lws2_32
+
+#	The AES-NI kernel is slower than OpenSSL unless
+#	it is optimized, so this file is optimized even
+#	in debug builds.  The CPU is still checked before
+#	the kernel is used
+obj/aes_128_cfb_8.o: GPP:=$(GPP) -maes -O3
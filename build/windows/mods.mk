@@ -31,6 +31,7 @@ bin/mods/mcpp_permissions.dll \
 bin/mods/mcpp_ping.dll \
 bin/mods/mcpp_player_list.dll \
 bin/mods/mcpp_plugin_message.dll \
+bin/mods/mcpp_pregen.dll \
 bin/mods/mcpp_time.dll \
 bin/mods/mcpp_whitelist.dll
 
@@ -179,6 +180,18 @@ $(MOD_LIB)
 	$(GPP) -shared -o $@ $^ $(MOD_LIB)
 	
 	
+#	WORLD PRE-GENERATION
+
+
+bin/mods/mcpp_pregen.dll: \
+$(MOD_OBJ) \
+obj/pregen/main.o | \
+$(MOD_LIB) \
+bin/mods/mcpp_time.dll \
+bin/mods/mcpp_world.dll
+	$(GPP) -shared -o $@ $^ $(MOD_LIB) bin/mods/mcpp_time.dll bin/mods/mcpp_world.dll
+	
+	
 #	TIME
 
 
@@ -8,6 +8,7 @@ obj/player/get_player.o \
 obj/player/player.o \
 obj/player/players.o \
 obj/player/player_position.o \
+obj/player/prefetch.o \
 obj/player/set_spawn.o \
 obj/player/update_position.o | \
 $(MOD_LIB) \
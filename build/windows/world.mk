@@ -12,6 +12,8 @@ $(MOD_OBJ) \
 obj/world/add_client.o \
 obj/world/begin.o \
 obj/world/block_id.o \
+obj/world/cache.o \
+obj/world/column_allocator.o \
 obj/world/column_container.o \
 obj/world/column_id.o \
 obj/world/events.o \
@@ -22,6 +24,7 @@ obj/world/get_info.o \
 obj/world/has_skylight.o \
 obj/world/interest.o \
 obj/world/key.o \
+obj/world/light.o \
 obj/world/load.o \
 obj/world/maintenance.o \
 obj/world/save.o \
@@ -0,0 +1,8 @@
+@echo off
+
+robocopy ./deps/zstd150/dll ./bin libzstd.dll /E /XD *
+
+IF ERRORLEVEL 0 exit /B 0
+IF ERRORLEVEL 1 exit /B 0
+
+exit /B 1
\ No newline at end of file
@@ -0,0 +1,205 @@
+/**
+ *	\file
+ */
+
+
+#pragma once
+
+
+#include <rleahylib/rleahylib.hpp>
+#include <ip_address_range.hpp>
+#include <atomic>
+
+
+namespace MCPP {
+
+
+	/**
+	 *	Contains information about an AcceptLimiter.
+	 */
+	class AcceptLimiterInfo {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The number of milliseconds over which
+			 *	connections are counted.
+			 */
+			Word Window;
+			/**
+			 *	The greatest number of connections a single
+			 *	IP address may make within the window, or
+			 *	zero if unlimited.
+			 */
+			Word HostLimit;
+			/**
+			 *	The greatest number of connections a single
+			 *	range of IP addresses (a /24 for IPv4, a /64
+			 *	for IPv6) may make within the window, or zero
+			 *	if unlimited.
+			 */
+			Word RangeLimit;
+			/**
+			 *	The number of connections which have been
+			 *	checked.
+			 */
+			UInt64 Checked;
+			/**
+			 *	The number of connections which were refused
+			 *	because their IP address exceeded its limit.
+			 */
+			UInt64 HostRefused;
+			/**
+			 *	The number of connections which were refused
+			 *	because their range of IP addresses exceeded
+			 *	its limit.
+			 */
+			UInt64 RangeRefused;
+			/**
+			 *	The number of times an IP address or range
+			 *	of IP addresses was escalated.
+			 */
+			UInt64 Escalated;
+	
+	
+	};
+	
+	
+	/**
+	 *	The result of checking a connection against
+	 *	an AcceptLimiter.
+	 */
+	class AcceptLimit {
+	
+	
+		public:
+		
+		
+			/**
+			 *	\em true if the connection should be
+			 *	accepted, \em false otherwise.
+			 */
+			bool Allow;
+			/**
+			 *	If the IP address or range of IP addresses
+			 *	which made the connection has exceeded its
+			 *	limit so greatly that it should be refused
+			 *	outright for a time, that IP address or
+			 *	range.
+			 */
+			Nullable<IPAddressRange> Escalate;
+			/**
+			 *	If \em Escalate is not null, the number of
+			 *	milliseconds for which that range should be
+			 *	refused.
+			 */
+			Word Milliseconds;
+	
+	
+	};
+	
+	
+	/**
+	 *	Limits the rate at which each IP address,
+	 *	and each range of IP addresses, may form
+	 *	connections.
+	 *
+	 *	Connections are counted over a sliding window
+	 *	in a sketch of fixed size, so the memory used
+	 *	does not depend on the number of hosts which
+	 *	connect.  The sketch may overestimate, but
+	 *	never underestimates, the number of connections
+	 *	a host has made.
+	 */
+	class AcceptLimiter {
+	
+	
+		private:
+		
+		
+			Word window;
+			Word host_limit;
+			Word range_limit;
+			Word escalate;
+			Word escalate_time;
+			
+			//	Counters for the current and previous
+			//	windows, for hosts and ranges
+			Vector<UInt16> counts;
+			Word current;
+			UInt64 started;
+			UInt64 seed;
+			Timer clock;
+			Mutex lock;
+			
+			std::atomic<UInt64> checked;
+			std::atomic<UInt64> host_refused;
+			std::atomic<UInt64> range_refused;
+			std::atomic<UInt64> escalated;
+			
+			
+			UInt16 * table (Word, bool) noexcept;
+			void roll (UInt64) noexcept;
+			UInt64 key (IPAddress, bool) const noexcept;
+			Word count (UInt64, bool, UInt64, Word &) noexcept;
+		
+		
+		public:
+		
+		
+			/**
+			 *	Creates a new AcceptLimiter.
+			 *
+			 *	\param [in] window
+			 *		The number of milliseconds over which
+			 *		connections are counted.
+			 *	\param [in] host_limit
+			 *		The greatest number of connections a
+			 *		single IP address may make within
+			 *		\em window.  Zero for unlimited.
+			 *	\param [in] range_limit
+			 *		The greatest number of connections a
+			 *		single /24 (IPv4) or /64 (IPv6) may make
+			 *		within \em window.  Zero for unlimited.
+			 *	\param [in] escalate
+			 *		When an IP address or range makes this
+			 *		many times its limit of connections
+			 *		within \em window, it is escalated.  Zero
+			 *		to never escalate.
+			 *	\param [in] escalate_time
+			 *		The number of milliseconds for which an
+			 *		escalated IP address or range should be
+			 *		refused.
+			 */
+			AcceptLimiter (Word window, Word host_limit, Word range_limit, Word escalate, Word escalate_time);
+			
+			
+			/**
+			 *	Counts a connection from a certain IP address
+			 *	and determines whether it should be accepted.
+			 *
+			 *	\param [in] ip
+			 *		The IP address from which the connection
+			 *		was made.
+			 *
+			 *	\return
+			 *		The result of the check.
+			 */
+			AcceptLimit Check (IPAddress ip);
+			
+			
+			/**
+			 *	Retrieves information about this limiter.
+			 *
+			 *	\return
+			 *		An AcceptLimiterInfo structure.
+			 */
+			AcceptLimiterInfo GetInfo () const noexcept;
+	
+	
+	};
+
+
+}
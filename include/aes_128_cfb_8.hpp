@@ -29,6 +29,16 @@ namespace MCPP {
 			EVP_CIPHER_CTX decrypt;
 			Vector<Byte> key;
 			Vector<Byte> iv;
+			//	When the CPU supports AES-NI decryption
+			//	does not go through OpenSSL, and uses
+			//	the key schedule and shift register
+			//	below instead of the decrypt context
+			bool accelerated;
+			Byte round_keys [11*16];
+			Byte shift [16];
+			
+			
+			void decrypt_bytes (const Byte *, const Byte *, Byte *);
 			
 			
 		public:
@@ -67,6 +77,18 @@ namespace MCPP {
 			~AES128CFB8 () noexcept;
 			
 			
+			/**
+			 *	Determines whether decryption uses the
+			 *	CPU's AES instructions (AES-NI) rather
+			 *	than OpenSSL.
+			 *
+			 *	\return
+			 *		\em true if decryption is accelerated,
+			 *		\em false otherwise.
+			 */
+			bool Accelerated () const noexcept;
+			
+			
 			/**
 			 *	Acquires the necessary lock to encrypt
 			 *	in a threadsafe manner.
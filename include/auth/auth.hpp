@@ -7,17 +7,76 @@
 
 
 #include <rleahylib/rleahylib.hpp>
+#include <client.hpp>
 #include <mod.hpp>
 #include <synchronized_random.hpp>
 #include <rsa_key.hpp>
+#include <thread_pool.hpp>
 #include <uniform_int_distribution.hpp>
 #include <yggdrasil.hpp>
+#include <atomic>
+#include <functional>
 #include <random>
+#include <unordered_map>
 
 
 namespace MCPP {
 
 
+	/**
+	 *	Contains information about logins and
+	 *	the authenticator's cryptography workers.
+	 */
+	class AuthenticationInfo {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The number of logins which are in
+			 *	progress.
+			 */
+			Word Active;
+			/**
+			 *	The maximum number of logins which may be
+			 *	in progress at once, or zero if there is
+			 *	no maximum.
+			 */
+			Word Maximum;
+			/**
+			 *	The number of logins which are waiting
+			 *	to begin.
+			 */
+			Word Queued;
+			/**
+			 *	The number of logins which have completed
+			 *	successfully since the server was started.
+			 */
+			Word Completed;
+			/**
+			 *	The number of nanoseconds which the logins
+			 *	which have completed successfully took in
+			 *	total, including time spent waiting to
+			 *	begin.
+			 */
+			UInt64 Elapsed;
+			/**
+			 *	The number of clients which have been
+			 *	disconnected because they waited too long
+			 *	for their login to begin.
+			 */
+			Word TimedOut;
+			/**
+			 *	The number of threads which perform
+			 *	cryptography for logins.
+			 */
+			Word Workers;
+	
+	
+	};
+
+
 	/**
 	 *	
 	 */
@@ -41,6 +100,54 @@ namespace MCPP {
 			//	ASCII characters for the server ID
 			//	string
 			SynchronizedRandom<UniformIntDistribution<Byte>> id_dist;
+			
+			
+			//	Performs expensive cryptography so
+			//	that it doesn't hold up the server's
+			//	thread pool
+			Nullable<ThreadPool> crypto;
+			
+			
+			//	A login which is waiting to begin
+			class QueuedLogin {
+			
+			
+				public:
+				
+				
+					SmartPointer<Client> Target;
+					Timer Elapsed;
+					std::function<void ()> Callback;
+			
+			
+			};
+			
+			
+			//	SETTINGS
+			
+			Word max_logins;
+			Word queue_timeout;
+			
+			
+			//	STATE
+			
+			//	Logins in progress, and how long
+			//	they've been in progress
+			std::unordered_map<const Client *,Timer> logins;
+			//	Logins waiting to begin, in the
+			//	order they arrived
+			Vector<QueuedLogin> queue;
+			mutable Mutex logins_lock;
+			
+			
+			//	STATISTICS
+			
+			std::atomic<Word> completed;
+			std::atomic<UInt64> elapsed;
+			std::atomic<Word> timed_out;
+			
+			
+			void expire (const Client *);
 		
 		
 		public:
@@ -124,6 +231,65 @@ namespace MCPP {
 			String GetServerID ();
 	
 	
+			/**
+			 *	Runs a task on the threads reserved for
+			 *	login cryptography, so that many logins
+			 *	at once cannot starve the server's thread
+			 *	pool.
+			 *
+			 *	\param [in] callback
+			 *		The task to run.
+			 */
+			void Offload (std::function<void ()> callback);
+			
+			
+			/**
+			 *	Begins a client's login once fewer than
+			 *	the maximum number of logins are in
+			 *	progress.
+			 *
+			 *	Logins begin in the order they are
+			 *	admitted.  A client whose login waits
+			 *	too long to begin is disconnected.
+			 *
+			 *	Every admitted client must eventually
+			 *	be passed to Finish.
+			 *
+			 *	\param [in] client
+			 *		The client which is logging in.
+			 *	\param [in] callback
+			 *		Invoked to begin the login, possibly
+			 *		in another thread.
+			 */
+			void Admit (SmartPointer<Client> client, std::function<void ()> callback);
+			/**
+			 *	Ends a client's login, allowing the next
+			 *	waiting login to begin.
+			 *
+			 *	Does nothing if the client was not
+			 *	admitted, or has already been passed to
+			 *	this function.
+			 *
+			 *	\param [in] client
+			 *		The client whose login has ended.
+			 *	\param [in] success
+			 *		\em true if the client logged in,
+			 *		\em false if the login failed or
+			 *		was abandoned.
+			 */
+			void Finish (const Client & client, bool success);
+			
+			
+			/**
+			 *	Retrieves information about logins.
+			 *
+			 *	\return
+			 *		A structure containing information
+			 *		about logins.
+			 */
+			AuthenticationInfo GetInfo () const;
+	
+	
 	};
 
 
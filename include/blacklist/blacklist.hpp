@@ -9,6 +9,7 @@
 #include <rleahylib/rleahylib.hpp>
 #include <ip_address_range.hpp>
 #include <mod.hpp>
+#include <unordered_map>
 #include <unordered_set>
 
 
@@ -29,6 +30,10 @@ namespace MCPP {
 			 *	IP ranges that are blacklisted.
 			 */
 			Vector<IPAddressRange> Ranges;
+			/**
+			 *	IP ranges that are temporarily blacklisted.
+			 */
+			Vector<IPAddressRange> Temporary;
 	
 	
 	};
@@ -45,6 +50,11 @@ namespace MCPP {
 		
 		
 			std::unordered_set<IPAddressRange> ranges;
+			//	Ranges which are blacklisted only until
+			//	the time they're mapped to, these are
+			//	not saved
+			std::unordered_map<IPAddressRange,UInt64> temporary;
+			mutable Timer clock;
 			mutable RWLock lock;
 			
 			
@@ -59,6 +69,9 @@ namespace MCPP {
 			static Blacklist & Get () noexcept;
 			
 			
+			Blacklist ();
+			
+			
 			/**
 			 *	\cond
 			 */
@@ -93,6 +106,20 @@ namespace MCPP {
 			 *	disconnected.
 			 */
 			void Add (IPAddressRange range);
+			/**
+			 *	Blacklists the given range of IPs for a certain
+			 *	period of time.  If any clients in the given
+			 *	range are connected, they will be disconnected.
+			 *
+			 *	Ranges blacklisted in this way are not saved.
+			 *
+			 *	\param [in] range
+			 *		The IP range to blacklist.
+			 *	\param [in] milliseconds
+			 *		The number of milliseconds for which
+			 *		\em range shall be blacklisted.
+			 */
+			void Add (IPAddressRange range, Word milliseconds);
 			
 			
 			/**
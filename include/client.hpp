@@ -48,7 +48,7 @@ namespace MCPP {
 		public:
 		
 		
-			typedef Vector<Promise<bool>> AtomicType;
+			typedef Vector<SendHandle> AtomicType;
 	
 	
 		private:
@@ -66,6 +66,12 @@ namespace MCPP {
 			//	Encryption worker
 			Nullable<AES128CFB8> encryptor;
 			
+			//	Send buffer
+			
+			//	Cleartext of sends which are held
+			//	until they're flushed
+			Vector<Byte> staged;
+			
 			//	Receive buffer
 			
 			//	Packet currently being built
@@ -92,16 +98,29 @@ namespace MCPP {
 			
 			void enable_encryption (const Vector<Byte> &, const Vector<Byte> &);
 			void log (const Packet &, ProtocolState, ProtocolDirection, const Vector<Byte> &, const Vector<Byte> &) const;
+			//	Sends a buffer on the connection,
+			//	tracking the send only if asked
+			SendHandle dispatch (Vector<Byte>, bool);
+			Vector<Byte> encrypt (Vector<Byte>);
+			//	Whether sends are being staged
+			bool staging () const noexcept;
+			//	Sends the staged sends in one buffer
+			SendHandle flush (bool);
+			//	Sends cleartext, staging it if
+			//	appropriate
+			SendHandle transmit (Vector<Byte>, bool, bool);
+			SendHandle send (Vector<Byte>, bool);
 			
 			
 			template <typename T>
-			Promise<bool> send (const T & packet) {
+			SendHandle send (const T & packet, bool track, bool urgent) {
 			
 				auto buffer=Serialize(packet);
-				Vector<Byte> ciphertext;
 				
-				if (encryptor.IsNull()) {
+				if (!(encryptor.IsNull() || staging())) {
 				
+					auto ciphertext=encryptor->Encrypt(buffer);
+					
 					log(
 						packet,
 						T::State,
@@ -110,21 +129,22 @@ namespace MCPP {
 						ciphertext
 					);
 					
-					return conn->Send(std::move(buffer));
+					return dispatch(std::move(ciphertext),track);
 				
 				}
 				
-				ciphertext=encryptor->Encrypt(buffer);
-				
+				//	Staged sends are encrypted together
+				//	when they're flushed, so there's
+				//	no ciphertext to log
 				log(
 					packet,
 					T::State,
 					T::Direction,
 					buffer,
-					ciphertext
+					Vector<Byte>{}
 				);
 				
-				return conn->Send(std::move(ciphertext));
+				return transmit(std::move(buffer),track,urgent);
 			
 			}
 			
@@ -134,7 +154,7 @@ namespace MCPP {
 				std::is_base_of<Packet,typename std::decay<T>::type>::value
 			>::type atomic_perform (AtomicType & sends, T && packet) {
 			
-				sends.Add(send(std::forward<T>(packet)));
+				sends.Add(send(std::forward<T>(packet),true,false));
 			
 			}
 			
@@ -272,7 +292,7 @@ namespace MCPP {
 			 *		monitor the progress of the asynchronous
 			 *		send operation.
 			 */
-			Promise<bool> Send (Vector<Byte> buffer);
+			SendHandle Send (Vector<Byte> buffer);
 			/**
 			 *	Sends data to the client.
 			 *
@@ -289,11 +309,61 @@ namespace MCPP {
 			 *		send operation.
 			 */
 			template <typename T>
-			Promise<bool> Send (const T & packet) {
+			SendHandle Send (const T & packet) {
 			
-				return lock.Execute([&] () {	return send(packet);	});
+				return lock.Execute([&] () {	return send(packet,true,false);	});
 			
 			}
+			/**
+			 *	Sends data to the client without
+			 *	tracking the send.
+			 *
+			 *	Should be preferred to Send whenever
+			 *	the result of the send is of no
+			 *	interest.
+			 *
+			 *	\param [in] buffer
+			 *		A buffer of bytes to send to the
+			 *		client.
+			 */
+			void Post (Vector<Byte> buffer);
+			/**
+			 *	Sends data to the client without
+			 *	tracking the send.
+			 *
+			 *	Should be preferred to Send whenever
+			 *	the result of the send is of no
+			 *	interest.
+			 *
+			 *	If the server batches sends, the packet
+			 *	may be held until the end of the tick,
+			 *	unless it is urgent.
+			 *
+			 *	\tparam T
+			 *		The type of packet which shall be
+			 *		sent.
+			 *
+			 *	\param [in] packet
+			 *		The packet to send to the client.
+			 *	\param [in] urgent
+			 *		If \em true the packet, and any
+			 *		packets held before it, are sent
+			 *		at once.  Defaults to \em false.
+			 */
+			template <typename T>
+			void Post (const T & packet, bool urgent=false) {
+			
+				lock.Execute([&] () {	send(packet,false,urgent);	});
+			
+			}
+			/**
+			 *	Sends all packets which are being held
+			 *	because the server batches sends.
+			 *
+			 *	Called by the server at the end of
+			 *	each tick.
+			 */
+			void Flush ();
 			
 			
 			/**
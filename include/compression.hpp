@@ -7,11 +7,352 @@
 
 
 #include <rleahylib/rleahylib.hpp>
+#include <stdexcept>
+
+
+/**
+ *	\cond
+ */
+
+
+struct z_stream_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+
+/**
+ *	\endcond
+ */
 
 
 namespace MCPP {
 
 
+	/**
+	 *	A reusable ZLib deflate() stream.
+	 *
+	 *	Creating a ZLib stream allocates and
+	 *	initializes a large amount of state,
+	 *	resetting one does not, so compressing
+	 *	through a long-lived Deflater is much
+	 *	cheaper than creating a stream each
+	 *	time.
+	 *
+	 *	Not thread safe.
+	 */
+	class Deflater {
+	
+	
+		private:
+		
+		
+			z_stream_s * stream;
+			bool gzip;
+			Int32 level;
+		
+		
+		public:
+		
+		
+			/**
+			 *	ZLib's default compression level.
+			 */
+			static constexpr Int32 DefaultLevel=-1;
+			/**
+			 *	The compression level which trades
+			 *	the most size for speed, suitable for
+			 *	data sent over the network.
+			 */
+			static constexpr Int32 FastestLevel=1;
+			/**
+			 *	The compression level which trades
+			 *	the most speed for size, suitable for
+			 *	data which is stored.
+			 */
+			static constexpr Int32 BestLevel=9;
+			
+			
+			/**
+			 *	Retrieves a Deflater which belongs to
+			 *	the calling thread.
+			 *
+			 *	The Deflaters this function returns are
+			 *	shared by everything on the calling thread
+			 *	which compresses, and therefore should
+			 *	only be used to compress a whole buffer at
+			 *	once.  Streams which are compressed piece
+			 *	by piece should use their own Deflater.
+			 *
+			 *	\param [in] gzip
+			 *		\em true if GZip should be used,
+			 *		\em false for ZLib.  Defaults to
+			 *		\em false.
+			 *	\param [in] level
+			 *		The compression level the Deflater
+			 *		uses.  Each level has its own Deflater,
+			 *		so that callers which use different
+			 *		levels do not start each other's streams
+			 *		over.  Defaults to DefaultLevel.
+			 *
+			 *	\return
+			 *		A reference to a Deflater.
+			 */
+			static Deflater & Get (bool gzip=false, Int32 level=DefaultLevel);
+			
+			
+			/**
+			 *	Creates a new Deflater.
+			 *
+			 *	\param [in] gzip
+			 *		\em true if GZip should be used,
+			 *		\em false for ZLib.  Defaults to
+			 *		\em false.
+			 *	\param [in] level
+			 *		The compression level to use until
+			 *		the Deflater is reset.  Defaults to
+			 *		DefaultLevel.
+			 */
+			Deflater (bool gzip=false, Int32 level=DefaultLevel);
+			
+			
+			/**
+			 *	\cond
+			 */
+			
+			
+			Deflater (const Deflater &) = delete;
+			Deflater (Deflater &&) = delete;
+			Deflater & operator = (const Deflater &) = delete;
+			Deflater & operator = (Deflater &&) = delete;
+			
+			
+			~Deflater () noexcept;
+			
+			
+			/**
+			 *	\endcond
+			 */
+			
+			
+			/**
+			 *	Discards the stream currently being
+			 *	compressed, readying the Deflater to
+			 *	compress a new stream.
+			 *
+			 *	\param [in] level
+			 *		The compression level to use for the
+			 *		new stream.  Defaults to DefaultLevel.
+			 */
+			void Reset (Int32 level=DefaultLevel);
+			
+			
+			/**
+			 *	Gets the upper bound on the size of
+			 *	deflating \em num bytes with this
+			 *	Deflater.
+			 *
+			 *	\param [in] num
+			 *		A number of bytes.
+			 *
+			 *	\return
+			 *		The maximum number of bytes
+			 *		\em num bytes will deflate to.
+			 */
+			Word Bound (Word num) const;
+			
+			
+			/**
+			 *	Compresses part of a stream.
+			 *
+			 *	\param [in,out] begin
+			 *		An iterator which points to the first
+			 *		byte in the source buffer.  Advanced
+			 *		past all bytes which were consumed.
+			 *	\param [in] end
+			 *		An iterator which points to one past
+			 *		the last byte in the source buffer.
+			 *	\param [in,out] out
+			 *		An iterator which points to the first
+			 *		byte in the destination buffer.
+			 *		Advanced past all bytes which were
+			 *		produced.
+			 *	\param [in] out_end
+			 *		An iterator which points to one past
+			 *		the last byte in the destination
+			 *		buffer.
+			 *	\param [in] finish
+			 *		\em true if the source buffer contains
+			 *		the end of the stream, \em false
+			 *		otherwise.
+			 *
+			 *	\return
+			 *		\em true if the end of the stream was
+			 *		written to the destination buffer,
+			 *		\em false if more input or output
+			 *		space is required.
+			 */
+			bool Write (const Byte * & begin, const Byte * end, Byte * & out, Byte * out_end, bool finish);
+			/**
+			 *	Resets this Deflater and compresses a whole
+			 *	buffer of bytes into a fixed-size region of
+			 *	memory.
+			 *
+			 *	\param [in] begin
+			 *		An iterator which points to the first
+			 *		byte in the source buffer.
+			 *	\param [in] end
+			 *		An iterator which points to one past
+			 *		the last byte in the source buffer.
+			 *	\param [in] out
+			 *		A pointer to the region of memory into
+			 *		which to compress.
+			 *	\param [in] max
+			 *		The size of the region of memory pointed
+			 *		to by \em out.  If this is at least
+			 *		Bound(end-begin) the compressed data
+			 *		always fits.
+			 *	\param [in] level
+			 *		The compression level to use.  Defaults
+			 *		to DefaultLevel.
+			 *
+			 *	\return
+			 *		The number of bytes written, or zero if
+			 *		the compressed data would not fit within
+			 *		\em max bytes.
+			 */
+			Word Deflate (const Byte * begin, const Byte * end, void * out, Word max, Int32 level=DefaultLevel);
+	
+	
+	};
+	
+	
+	/**
+	 *	A reusable ZLib inflate() stream.
+	 *
+	 *	Whether ZLib or GZip was used to deflate
+	 *	a stream is irrelevant, the compression
+	 *	will be automatically detected.
+	 *
+	 *	Not thread safe.
+	 */
+	class Inflater {
+	
+	
+		private:
+		
+		
+			z_stream_s * stream;
+		
+		
+		public:
+		
+		
+			/**
+			 *	Retrieves an Inflater which belongs to
+			 *	the calling thread.
+			 *
+			 *	The Inflater this function returns is
+			 *	shared by everything on the calling thread
+			 *	which decompresses, and therefore should
+			 *	only be used to decompress a whole buffer
+			 *	at once.  Streams which are decompressed
+			 *	piece by piece should use their own
+			 *	Inflater.
+			 *
+			 *	\return
+			 *		A reference to an Inflater.
+			 */
+			static Inflater & Get ();
+			
+			
+			/**
+			 *	Creates a new Inflater.
+			 */
+			Inflater ();
+			
+			
+			/**
+			 *	\cond
+			 */
+			
+			
+			Inflater (const Inflater &) = delete;
+			Inflater (Inflater &&) = delete;
+			Inflater & operator = (const Inflater &) = delete;
+			Inflater & operator = (Inflater &&) = delete;
+			
+			
+			~Inflater () noexcept;
+			
+			
+			/**
+			 *	\endcond
+			 */
+			
+			
+			/**
+			 *	Discards the stream currently being
+			 *	decompressed, readying the Inflater to
+			 *	decompress a new stream.
+			 */
+			void Reset ();
+			
+			
+			/**
+			 *	Decompresses part of a stream.
+			 *
+			 *	\param [in,out] begin
+			 *		An iterator which points to the first
+			 *		byte in the source buffer.  Advanced
+			 *		past all bytes which were consumed.
+			 *	\param [in] end
+			 *		An iterator which points to one past
+			 *		the last byte in the source buffer.
+			 *	\param [in,out] out
+			 *		An iterator which points to the first
+			 *		byte in the destination buffer.
+			 *		Advanced past all bytes which were
+			 *		produced.
+			 *	\param [in] out_end
+			 *		An iterator which points to one past
+			 *		the last byte in the destination
+			 *		buffer.
+			 *
+			 *	\return
+			 *		\em true if the end of the stream was
+			 *		reached, \em false if more input or
+			 *		output space is required.
+			 */
+			bool Write (const Byte * & begin, const Byte * end, Byte * & out, Byte * out_end);
+			/**
+			 *	Resets this Inflater and decompresses a
+			 *	whole buffer of bytes into a fixed-size
+			 *	region of memory.
+			 *
+			 *	\param [in] begin
+			 *		An iterator which points to the first
+			 *		byte in the source buffer.
+			 *	\param [in] end
+			 *		An iterator which points to one past
+			 *		the last byte in the source buffer.
+			 *	\param [in] out
+			 *		A pointer to the region of memory into
+			 *		which to decompress.
+			 *	\param [in] max
+			 *		The size of the region of memory pointed
+			 *		to by \em out.
+			 *
+			 *	\return
+			 *		The number of bytes decompressed, or zero
+			 *		if the decompressed data would not fit
+			 *		within \em max bytes.
+			 */
+			Word Inflate (const Byte * begin, const Byte * end, void * out, Word max);
+	
+	
+	};
+	
+	
 	/**
 	 *	Uses ZLib deflate() to compress
 	 *	a buffer of bytes.
@@ -26,13 +367,16 @@ namespace MCPP {
 	 *		\em true if GZip should be used,
 	 *		\em false for ZLib.  Defaults to
 	 *		\em false.
+	 *	\param [in] level
+	 *		The compression level to use.  Defaults
+	 *		to Deflater::DefaultLevel.
 	 *
 	 *	\return
 	 *		A buffer of bytes which contain
 	 *		the compressed representation of
 	 *		\em buffer.
 	 */
-	Vector<Byte> Deflate (const Byte * begin, const Byte * end, bool gzip=false);
+	Vector<Byte> Deflate (const Byte * begin, const Byte * end, bool gzip=false, Int32 level=Deflater::DefaultLevel);
 	/**
 	 *	Uses ZLib deflate() to compress a buffer
 	 *	of bytes and places the result thereof
@@ -58,8 +402,11 @@ namespace MCPP {
 	 *		\em true if GZip should be used,
 	 *		\em false for ZLib.  Defaults to
 	 *		\em false.
+	 *	\param [in] level
+	 *		The compression level to use.  Defaults
+	 *		to Deflater::DefaultLevel.
 	 */
-	void Deflate (const Byte * begin, const Byte * end, Vector<Byte> * buffer, bool gzip=false);
+	void Deflate (const Byte * begin, const Byte * end, Vector<Byte> * buffer, bool gzip=false, Int32 level=Deflater::DefaultLevel);
 	/**
 	 *	Gets the upper bound on the size of
 	 *	deflating \em num bytes.
@@ -126,6 +473,396 @@ namespace MCPP {
 	 *		decompress.
 	 */
 	void Inflate (const Byte * begin, const Byte * end, Vector<Byte> * buffer);
+	/**
+	 *	Uses ZLib inflate() to decompress a buffer
+	 *	of bytes directly into a fixed-size region
+	 *	of memory.
+	 *
+	 *	Whether ZLib or GZip was used to deflate
+	 *	the buffer is irrelevant, the compression
+	 *	will be automatically detected.
+	 *
+	 *	\param [in] begin
+	 *		An iterator which points to the first
+	 *		byte in the source buffer.
+	 *	\param [in] end
+	 *		An iterator which points to one past
+	 *		the last byte in the source buffer.
+	 *	\param [in] out
+	 *		A pointer to the region of memory into
+	 *		which to decompress.
+	 *	\param [in] max
+	 *		The size of the region of memory pointed
+	 *		to by \em out.
+	 *
+	 *	\return
+	 *		The number of bytes decompressed, or zero
+	 *		if the decompressed data would not fit
+	 *		within \em max bytes.
+	 */
+	Word Inflate (const Byte * begin, const Byte * end, void * out, Word max);
+	
+	
+	/**
+	 *	Thrown when data cannot be decoded because
+	 *	it was compressed with a dictionary other
+	 *	than the one the codec has.
+	 */
+	class CodecError : public std::runtime_error {
+	
+	
+		private:
+		
+		
+			UInt32 saved;
+			UInt32 current;
+		
+		
+		public:
+		
+		
+			/**
+			 *	\cond
+			 */
+			
+			
+			CodecError (const char * what, UInt32 saved, UInt32 current);
+			
+			
+			/**
+			 *	\endcond
+			 */
+			
+			
+			/**
+			 *	The ID of the dictionary the data was
+			 *	compressed with.
+			 *
+			 *	\return
+			 *		A dictionary ID.
+			 */
+			UInt32 Saved () const noexcept;
+			/**
+			 *	The ID of the codec's dictionary, or
+			 *	zero if it has none.
+			 *
+			 *	\return
+			 *		A dictionary ID.
+			 */
+			UInt32 Current () const noexcept;
+	
+	
+	};
+	
+	
+	/**
+	 *	A format in which data may be compressed
+	 *	for storage.
+	 *
+	 *	Data encoded by a codec begins with a short
+	 *	header which records which codec produced
+	 *	it, so that the data may be decoded even
+	 *	after the codec used for storage has been
+	 *	changed.  Data without such a header is
+	 *	treated as plain ZLib or GZip.
+	 *
+	 *	Codecs are thread safe.
+	 */
+	class Codec {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The ID of the ZLib codec.
+			 */
+			static constexpr Byte Zlib=0;
+			/**
+			 *	The ID of the Zstandard codec.
+			 */
+			static constexpr Byte Zstd=1;
+			
+			
+			/**
+			 *	Determines which codec encoded a buffer
+			 *	of bytes.
+			 *
+			 *	\param [in,out] begin
+			 *		An iterator which points to the first
+			 *		byte in the buffer.  Advanced past the
+			 *		header, if there is one.
+			 *	\param [in] end
+			 *		An iterator which points to one past
+			 *		the last byte in the buffer.
+			 *
+			 *	\return
+			 *		The ID of the codec which encoded the
+			 *		buffer.
+			 */
+			static Byte Identify (const Byte * & begin, const Byte * end) noexcept;
+			
+			
+			/**
+			 *	\cond
+			 */
+			
+			
+			virtual ~Codec () noexcept;
+			
+			
+			/**
+			 *	\endcond
+			 */
+			
+			
+			/**
+			 *	Retrieves the ID which identifies data
+			 *	encoded by this codec.
+			 *
+			 *	\return
+			 *		The ID of this codec.
+			 */
+			virtual Byte ID () const noexcept = 0;
+			/**
+			 *	Retrieves the name of this codec.
+			 *
+			 *	\return
+			 *		The name of this codec.
+			 */
+			virtual const String & Name () const noexcept = 0;
+			/**
+			 *	Gets the upper bound on the size of
+			 *	compressing \em num bytes with this
+			 *	codec, not including the header.
+			 *
+			 *	\param [in] num
+			 *		A number of bytes.
+			 *
+			 *	\return
+			 *		The maximum number of bytes
+			 *		\em num bytes will compress to.
+			 */
+			virtual Word Bound (Word num) const = 0;
+			/**
+			 *	Compresses a buffer of bytes into a
+			 *	fixed-size region of memory, without a
+			 *	header.
+			 *
+			 *	\param [in] begin
+			 *		An iterator which points to the first
+			 *		byte in the source buffer.
+			 *	\param [in] end
+			 *		An iterator which points to one past
+			 *		the last byte in the source buffer.
+			 *	\param [in] out
+			 *		A pointer to the region of memory into
+			 *		which to compress.
+			 *	\param [in] max
+			 *		The size of the region of memory pointed
+			 *		to by \em out.
+			 *
+			 *	\return
+			 *		The number of bytes written, or zero if
+			 *		the compressed data would not fit within
+			 *		\em max bytes.
+			 */
+			virtual Word Compress (const Byte * begin, const Byte * end, void * out, Word max) const = 0;
+			/**
+			 *	Decompresses a buffer of bytes, without a
+			 *	header, into a fixed-size region of memory.
+			 *
+			 *	\param [in] begin
+			 *		An iterator which points to the first
+			 *		byte in the source buffer.
+			 *	\param [in] end
+			 *		An iterator which points to one past
+			 *		the last byte in the source buffer.
+			 *	\param [in] out
+			 *		A pointer to the region of memory into
+			 *		which to decompress.
+			 *	\param [in] max
+			 *		The size of the region of memory pointed
+			 *		to by \em out.
+			 *
+			 *	\return
+			 *		The number of bytes decompressed, or zero
+			 *		if the decompressed data would not fit
+			 *		within \em max bytes.
+			 */
+			virtual Word Decompress (const Byte * begin, const Byte * end, void * out, Word max) const = 0;
+			
+			
+			/**
+			 *	Compresses a buffer of bytes, and places
+			 *	a header identifying this codec before
+			 *	the compressed data.
+			 *
+			 *	\param [in] begin
+			 *		An iterator which points to the first
+			 *		byte in the source buffer.
+			 *	\param [in] end
+			 *		An iterator which points to one past
+			 *		the last byte in the source buffer.
+			 *
+			 *	\return
+			 *		A buffer of bytes which contains the
+			 *		header and compressed data.
+			 */
+			Vector<Byte> Encode (const Byte * begin, const Byte * end) const;
+	
+	
+	};
+	
+	
+	/**
+	 *	Compresses data with ZLib.
+	 */
+	class ZlibCodec : public Codec {
+	
+	
+		private:
+		
+		
+			Int32 level;
+		
+		
+		public:
+		
+		
+			/**
+			 *	Creates a new ZLib codec.
+			 *
+			 *	\param [in] level
+			 *		The compression level to use.
+			 *		Defaults to Deflater::BestLevel.
+			 */
+			ZlibCodec (Int32 level=Deflater::BestLevel) noexcept;
+			
+			
+			/**
+			 *	\cond
+			 */
+			
+			
+			virtual Byte ID () const noexcept override;
+			virtual const String & Name () const noexcept override;
+			virtual Word Bound (Word num) const override;
+			virtual Word Compress (const Byte * begin, const Byte * end, void * out, Word max) const override;
+			virtual Word Decompress (const Byte * begin, const Byte * end, void * out, Word max) const override;
+			
+			
+			/**
+			 *	\endcond
+			 */
+	
+	
+	};
+	
+	
+	/**
+	 *	Compresses data with Zstandard, optionally
+	 *	with a dictionary.
+	 *
+	 *	Zstandard compresses and decompresses much
+	 *	faster than ZLib, and a dictionary trained
+	 *	on typical data (for example with
+	 *	<tt>zstd --train</tt>) improves its ratio on
+	 *	small, repetitive buffers further still.
+	 */
+	class ZstdCodec : public Codec {
+	
+	
+		private:
+		
+		
+			Int32 level;
+			UInt32 dictionary;
+			ZSTD_CDict_s * cdict;
+			ZSTD_DDict_s * ddict;
+		
+		
+		public:
+		
+		
+			/**
+			 *	Zstandard's default compression level.
+			 */
+			static constexpr Int32 DefaultLevel=3;
+			
+			
+			/**
+			 *	Creates a new Zstandard codec.
+			 *
+			 *	\param [in] level
+			 *		The compression level to use.
+			 *		Defaults to DefaultLevel.
+			 */
+			ZstdCodec (Int32 level=DefaultLevel) noexcept;
+			/**
+			 *	Creates a new Zstandard codec which
+			 *	uses a dictionary.
+			 *
+			 *	Data compressed with a dictionary can
+			 *	only be decompressed with that same
+			 *	dictionary.  The dictionary's ID is
+			 *	stored with the data, and attempting
+			 *	to decompress it with any other
+			 *	dictionary throws CodecError.
+			 *
+			 *	\param [in] level
+			 *		The compression level to use.
+			 *	\param [in] begin
+			 *		An iterator which points to the first
+			 *		byte of the dictionary.
+			 *	\param [in] end
+			 *		An iterator which points to one past
+			 *		the last byte of the dictionary.
+			 */
+			ZstdCodec (Int32 level, const Byte * begin, const Byte * end);
+			
+			
+			/**
+			 *	Retrieves the ID of this codec's dictionary.
+			 *
+			 *	This is the ID Zstandard assigned a trained
+			 *	dictionary, or a hash of the dictionary's
+			 *	content otherwise.
+			 *
+			 *	\return
+			 *		The ID of the dictionary, or zero if this
+			 *		codec does not use one.
+			 */
+			UInt32 Dictionary () const noexcept;
+			
+			
+			/**
+			 *	\cond
+			 */
+			
+			
+			ZstdCodec (const ZstdCodec &) = delete;
+			ZstdCodec (ZstdCodec &&) = delete;
+			ZstdCodec & operator = (const ZstdCodec &) = delete;
+			ZstdCodec & operator = (ZstdCodec &&) = delete;
+			
+			
+			virtual ~ZstdCodec () noexcept;
+			
+			
+			virtual Byte ID () const noexcept override;
+			virtual const String & Name () const noexcept override;
+			virtual Word Bound (Word num) const override;
+			virtual Word Compress (const Byte * begin, const Byte * end, void * out, Word max) const override;
+			virtual Word Decompress (const Byte * begin, const Byte * end, void * out, Word max) const override;
+			
+			
+			/**
+			 *	\endcond
+			 */
+	
+	
+	};
 
 
 }
@@ -0,0 +1,263 @@
+/**
+ *	\file
+ */
+
+
+#pragma once
+
+
+#include <rleahylib/rleahylib.hpp>
+#include <limits>
+#include <type_traits>
+
+
+namespace MCPP {
+
+
+	/**
+	 *	A counter-based pseudo-random number
+	 *	generator.
+	 *
+	 *	Each number is produced by mixing a key with
+	 *	a counter (as in SplitMix64), so the entire
+	 *	state is two 64-bit integers.  This makes the
+	 *	generator cheap to create, which makes it
+	 *	suitable for deriving a fresh, deterministic
+	 *	stream for each column, or each feature within
+	 *	a column, rather than seeding a generator with
+	 *	a large internal state each time.
+	 *
+	 *	Satisfies the requirements of a uniform
+	 *	random bit generator.
+	 */
+	class CounterRandom {
+	
+	
+		private:
+		
+		
+			//	The golden ratio, used to space
+			//	successive counter values
+			static constexpr UInt64 gamma=0x9E3779B97F4A7C15ULL;
+			
+			
+			UInt64 key;
+			UInt64 counter;
+		
+		
+		public:
+		
+		
+			typedef UInt64 result_type;
+			
+			
+			/**
+			 *	Scrambles a 64-bit integer such that
+			 *	each bit of the input affects each bit
+			 *	of the output.
+			 *
+			 *	\param [in] z
+			 *		The integer to scramble.
+			 *
+			 *	\return
+			 *		The scrambled integer.
+			 */
+			static UInt64 Mix (UInt64 z) noexcept {
+			
+				z=(z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+				z=(z^(z>>27))*0x94D049BB133111EBULL;
+				
+				return z^(z>>31);
+			
+			}
+			
+			
+			/**
+			 *	Creates a new generator.
+			 *
+			 *	\param [in] key
+			 *		The key which determines the
+			 *		sequence of numbers the generator
+			 *		will produce.  Defaults to zero.
+			 */
+			explicit CounterRandom (UInt64 key=0) noexcept : key(key), counter(0) {	}
+			/**
+			 *	Creates a new generator, keyed from
+			 *	a seed sequence.
+			 *
+			 *	\tparam Sseq
+			 *		The type of seed sequence.
+			 *
+			 *	\param [in] seq
+			 *		The seed sequence from which to
+			 *		derive the key.
+			 */
+			template <
+				typename Sseq,
+				typename=typename std::enable_if<
+					!std::is_same<Sseq,CounterRandom>::value
+				>::type
+			>
+			explicit CounterRandom (Sseq & seq) : counter(0) {
+			
+				seed(seq);
+			
+			}
+			
+			
+			/**
+			 *	Re-keys this generator and resets its
+			 *	counter.
+			 *
+			 *	\param [in] key
+			 *		The new key.  Defaults to zero.
+			 */
+			void seed (UInt64 key=0) noexcept {
+			
+				this->key=key;
+				counter=0;
+			
+			}
+			/**
+			 *	Re-keys this generator from a seed sequence
+			 *	and resets its counter.
+			 *
+			 *	\tparam Sseq
+			 *		The type of seed sequence.
+			 *
+			 *	\param [in] seq
+			 *		The seed sequence from which to
+			 *		derive the key.
+			 */
+			template <typename Sseq>
+			void seed (Sseq & seq) {
+			
+				UInt32 words [2];
+				seq.generate(words,words+2);
+				
+				seed((static_cast<UInt64>(words[1])<<32)|words[0]);
+			
+			}
+			
+			
+			/**
+			 *	Derives an independent generator from
+			 *	this generator's key.
+			 *
+			 *	The derived generator depends only on
+			 *	this generator's key and \em stream, and
+			 *	not on how many numbers this generator
+			 *	has produced.
+			 *
+			 *	\param [in] stream
+			 *		A value which identifies the derived
+			 *		generator, for example a feature of
+			 *		a column.
+			 *
+			 *	\return
+			 *		A new generator.
+			 */
+			CounterRandom Branch (UInt64 stream) const noexcept {
+			
+				return CounterRandom(Mix(key^Mix(stream+gamma)));
+			
+			}
+			
+			
+			/**
+			 *	Produces a random number.
+			 *
+			 *	\return
+			 *		A random number.
+			 */
+			result_type operator () () noexcept {
+			
+				return Mix(key+((++counter)*gamma));
+			
+			}
+			
+			
+			/**
+			 *	Advances the generator as if a certain
+			 *	number of random numbers had been produced.
+			 *
+			 *	\param [in] n
+			 *		The number of random numbers to skip.
+			 */
+			void discard (UInt64 n) noexcept {
+			
+				counter+=n;
+			
+			}
+			
+			
+			/**
+			 *	Returns the minimum value that will be
+			 *	generated.
+			 *
+			 *	\return
+			 *		The lowest value this generator will
+			 *		produce.
+			 */
+			static constexpr result_type min () noexcept {
+			
+				return std::numeric_limits<result_type>::min();
+			
+			}
+			
+			
+			/**
+			 *	Returns the maximum value that will be
+			 *	generated.
+			 *
+			 *	\return
+			 *		The highest value this generator will
+			 *		produce.
+			 */
+			static constexpr result_type max () noexcept {
+			
+				return std::numeric_limits<result_type>::max();
+			
+			}
+			
+			
+			/**
+			 *	Determines whether two generators will
+			 *	produce the same sequence of numbers.
+			 *
+			 *	\param [in] other
+			 *		The generator to compare to.
+			 *
+			 *	\return
+			 *		\em true if this generator and
+			 *		\em other will produce the same
+			 *		sequence, \em false otherwise.
+			 */
+			bool operator == (const CounterRandom & other) const noexcept {
+			
+				return (key==other.key) && (counter==other.counter);
+			
+			}
+			/**
+			 *	Determines whether two generators will
+			 *	produce different sequences of numbers.
+			 *
+			 *	\param [in] other
+			 *		The generator to compare to.
+			 *
+			 *	\return
+			 *		\em true if this generator and
+			 *		\em other will produce different
+			 *		sequences, \em false otherwise.
+			 */
+			bool operator != (const CounterRandom & other) const noexcept {
+			
+				return !(*this==other);
+			
+			}
+	
+	
+	};
+
+
+}
@@ -7,6 +7,7 @@
 
 
 #include <rleahylib/rleahylib.hpp>
+#include <hash.hpp>
 #include <socketpair.hpp>
 #include <promise.hpp>
 #include <ares.h>
@@ -212,8 +213,53 @@ namespace MCPP {
 	};
 
 
+	/**
+	 *	Contains information about the DNS lookups
+	 *	made by all DNSHandlers.
+	 */
+	class DNSInfo {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The number of lookups which were answered
+			 *	from a cache.
+			 */
+			UInt64 Hits;
+			/**
+			 *	The number of lookups which were sent to
+			 *	a name server.
+			 */
+			UInt64 Misses;
+			/**
+			 *	The number of lookups which were answered
+			 *	by an identical lookup already in progress.
+			 */
+			UInt64 Coalesced;
+			/**
+			 *	The number of lookups sent to a name server
+			 *	which have completed.
+			 */
+			UInt64 Resolved;
+			/**
+			 *	The total number of nanoseconds spent waiting
+			 *	on lookups sent to a name server.
+			 */
+			UInt64 Elapsed;
+	
+	
+	};
+
+
 	/**
 	 *	Allows asynchronous DNS queries to be made.
+	 *
+	 *	Responses are cached for as long as their
+	 *	records' time to live, and responses indicating
+	 *	a name or record does not exist are cached as
+	 *	long as the zone's SOA record allows.
 	 */
 	class DNSHandler {
 	
@@ -264,7 +310,8 @@ namespace MCPP {
 				
 					virtual ~Query () noexcept;
 					virtual void Complete (int status, Word timeouts, unsigned char * abuf, int alen) noexcept = 0;
-					void Begin (ares_channel, const String &, DoneType);
+					int Type () const noexcept;
+					void Begin (DoneType);
 					void Done (bool) noexcept;
 			
 			
@@ -421,10 +468,54 @@ namespace MCPP {
 			};
 			
 			
+			//	Queries with the same name and type
+			//	share a single lookup
+			typedef Tuple<String,int> KeyType;
+			
+			
+			class Lookup {
+			
+			
+				public:
+				
+				
+					DNSHandler * Handler;
+					KeyType Key;
+					Timer Elapsed;
+					Vector<Query *> Waiting;
+			
+			
+			};
+			
+			
+			class CacheEntry {
+			
+			
+				public:
+				
+				
+					int Status;
+					Vector<Byte> Response;
+					UInt64 Stored;
+					UInt64 Expires;
+			
+			
+			};
+			
+			
 			//	Handle to libcares
 			ares_channel channel;
 			
 			
+			//	Sockets libcares is waiting on, only
+			//	accessed while holding the lock
+			#ifdef ENVIRONMENT_WINDOWS
+			std::unordered_map<ares_socket_t,short> sockets;
+			#else
+			int poller;
+			#endif
+			
+			
 			//	Worker
 			Thread thread;
 			//	Control socket allows worker to be
@@ -442,6 +533,20 @@ namespace MCPP {
 				Query *,
 				std::unique_ptr<Query>
 			> queries;
+			//	Lookups in progress
+			std::unordered_map<
+				KeyType,
+				std::unique_ptr<Lookup>
+			> lookups;
+			
+			
+			//	Responses which have been received,
+			//	times are in milliseconds since clock
+			//	started
+			mutable Mutex cache_lock;
+			std::unordered_map<KeyType,CacheEntry> cache;
+			Word max_cache;
+			Timer clock;
 			
 			
 			//	Panic callback
@@ -452,6 +557,14 @@ namespace MCPP {
 			DoneType complete;
 			
 			
+			static void socket_callback (void *, ares_socket_t, int, int) noexcept;
+			static void lookup_callback (void *, int, int, unsigned char *, int) noexcept;
+			
+			
+			void watch (ares_socket_t, bool, bool);
+			bool cached (const KeyType &, Query &);
+			void store (const KeyType &, int, const unsigned char *, int);
+			void cleanup () noexcept;
 			void worker_func () noexcept;
 			bool should_stop ();
 			void worker ();
@@ -472,8 +585,13 @@ namespace MCPP {
 			 *		be invoked when and if something goes
 			 *		wrong in the DNS handler's worker
 			 *		thread.
+			 *	\param [in] max_cache
+			 *		Optional.  The greatest number of
+			 *		responses which will be cached.  If
+			 *		not provided 1024 responses will be
+			 *		cached.  Zero disables the cache.
 			 */
-			DNSHandler (PanicType panic=PanicType());
+			DNSHandler (PanicType panic=PanicType(), Word max_cache=1024);
 			/**
 			 *	Stops and cleans up a DNSHandler.
 			 *
@@ -483,6 +601,17 @@ namespace MCPP {
 			~DNSHandler () noexcept;
 			
 			
+			/**
+			 *	Retrieves information about the lookups
+			 *	made by all DNSHandlers.
+			 *
+			 *	\return
+			 *		A structure containing information
+			 *		about DNS lookups.
+			 */
+			static DNSInfo GetInfo () noexcept;
+			
+			
 			/**
 			 *	Resolves a host name to A records.
 			 *
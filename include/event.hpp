@@ -7,6 +7,7 @@
 
 
 #include <rleahylib/rleahylib.hpp>
+#include <profiler.hpp>
 #include <functional>
 #include <type_traits>
  
@@ -49,6 +50,8 @@ namespace MCPP {
 		
 		
 			Vector<std::function<T (Args...)>> callbacks;
+			//	The module which added each callback
+			Vector<Word> owners;
 			bool does_throw;
 			
 			
@@ -179,13 +182,25 @@ namespace MCPP {
 	
 	
 	template <typename T, typename... Args>
-	Event<T (Args...)>::Event (bool does_throw) noexcept : callbacks(0), does_throw(does_throw) {	}
+	Event<T (Args...)>::Event (bool does_throw) noexcept : callbacks(0), owners(0), does_throw(does_throw) {	}
 	
 	
 	template <typename T, typename... Args>
 	void Event<T (Args...)>::Add (const std::function<T (Args...)> & func) {
 	
-		callbacks.Add(func);
+		owners.Add(Profiler::GetOwner());
+		
+		try {
+		
+			callbacks.Add(func);
+		
+		} catch (...) {
+		
+			owners.Delete(owners.Count()-1);
+			
+			throw;
+		
+		}
 	
 	}
 	
@@ -193,7 +208,19 @@ namespace MCPP {
 	template <typename T, typename... Args>
 	void Event<T (Args...)>::Add (std::function<T (Args...)> && func) {
 	
-		callbacks.Add(std::move(func));
+		owners.Add(Profiler::GetOwner());
+		
+		try {
+		
+			callbacks.Add(std::move(func));
+		
+		} catch (...) {
+		
+			owners.Delete(owners.Count()-1);
+			
+			throw;
+		
+		}
 	
 	}
 	
@@ -204,11 +231,13 @@ namespace MCPP {
 		std::is_same<T1,T>::value && std::is_same<T,void>::value
 	>::type Event<T (Args...)>::operator () (Args... args) {
 	
-		for (std::function<T (Args...)> & func : callbacks) {
+		for (Word i=0;i<callbacks.Count();++i) {
 		
 			try {
 			
-				func(args...);
+				ProfileScope scope(Profiler::Subscriber,owners[i]);
+				
+				callbacks[i](args...);
 			
 			} catch (...) {
 			
@@ -230,9 +259,11 @@ namespace MCPP {
 	
 		try {
 	
-			for (std::function<T (Args...)> & func : callbacks) {
+			for (Word i=0;i<callbacks.Count();++i) {
 			
-				if (!func(args...)) return false;
+				ProfileScope scope(Profiler::Subscriber,owners[i]);
+				
+				if (!callbacks[i](args...)) return false;
 			
 			}
 			
@@ -258,11 +289,13 @@ namespace MCPP {
 	
 		Vector<Nullable<T>> returnthis(callbacks.Count());
 		
-		for (std::function<T (Args...)> & func : callbacks) {
+		for (Word i=0;i<callbacks.Count();++i) {
 		
 			try {
 			
-				returnthis.Add(func(args...));
+				ProfileScope scope(Profiler::Subscriber,owners[i]);
+				
+				returnthis.Add(callbacks[i](args...));
 			
 			} catch (...) {
 			
@@ -283,6 +316,7 @@ namespace MCPP {
 	void Event<T (Args...)>::Clear () noexcept {
 	
 		callbacks.Clear();
+		owners.Clear();
 	
 	}
 	
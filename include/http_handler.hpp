@@ -302,7 +302,7 @@ namespace MCPP {
 				public:
 				
 				
-					Request (HTTPRequest);
+					Request (HTTPRequest, CURLSH *);
 					~Request () noexcept;
 				
 				
@@ -325,6 +325,28 @@ namespace MCPP {
 			
 			//	Multi handle
 			CURLM * handle;
+			//	Share handle, lets requests to the
+			//	same host reuse connections, TLS
+			//	sessions, and DNS lookups
+			CURLSH * share;
+			Mutex share_locks [CURL_LOCK_DATA_LAST];
+			
+			
+			//	Sockets cURL is waiting on, only
+			//	accessed while holding the lock
+			#ifdef ENVIRONMENT_WINDOWS
+			std::unordered_map<curl_socket_t,short> sockets;
+			#else
+			int poller;
+			#endif
+			//	cURL's timer, -1 if it's not
+			//	set
+			long timeout;
+			Timer timer;
+			//	Exceptions thrown in callbacks
+			//	cannot pass through cURL, they're
+			//	held here
+			std::exception_ptr ex;
 		
 		
 			//	Worker thread
@@ -356,6 +378,20 @@ namespace MCPP {
 			bool should_stop ();
 			
 			
+			//	Callbacks from cURL
+			static int socket_callback (CURL *, curl_socket_t, int, void *, void *) noexcept;
+			static int timer_callback (CURLM *, long, void *) noexcept;
+			static void lock_callback (CURL *, curl_lock_data, curl_lock_access, void *) noexcept;
+			static void unlock_callback (CURL *, curl_lock_data, void *) noexcept;
+			
+			
+			void watch (curl_socket_t, int);
+			long remaining ();
+			void action (curl_socket_t, int);
+			void complete ();
+			void cleanup () noexcept;
+			
+			
 			//	Worker functions
 			void worker_func () noexcept;
 			void worker ();
@@ -390,6 +426,22 @@ namespace MCPP {
 			 *		A promise of a future HTTP response.
 			 */
 			Promise<HTTPResponse> Execute (HTTPRequest request);
+			
+			
+			/**
+			 *	Limits the number of connections which
+			 *	will be open to any one host at once.
+			 *
+			 *	Requests to a host which is at the limit
+			 *	wait for one of its connections to become
+			 *	free.
+			 *
+			 *	\param [in] max
+			 *		The greatest number of connections to
+			 *		open to any one host.  Zero means there
+			 *		is no limit, which is the default.
+			 */
+			void SetMaxHostConnections (Word max);
 	
 	
 	};
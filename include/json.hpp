@@ -244,6 +244,18 @@ namespace JSON {
 	 *		\em value.
 	 */
 	String Serialize (const Value & value);
+	/**
+	 *	Serializes a JSON value to UTF-8 encoded
+	 *	JSON, appending it to a buffer.
+	 *
+	 *	\param [in,out] buffer
+	 *		The buffer to which the UTF-8 encoded
+	 *		JSON representation of \em value shall
+	 *		be appended.
+	 *	\param [in] value
+	 *		The value to serialize.
+	 */
+	void Serialize (Vector<Byte> & buffer, const Value & value);
 	
 	
 	/**
@@ -262,6 +274,28 @@ namespace JSON {
 	 *		A single JSON value.
 	 */
 	Value Parse (const String & json, Word max_depth=0);
+	/**
+	 *	Parses UTF-8 encoded JSON into a JSON
+	 *	value.
+	 *
+	 *	\param [in] begin
+	 *		A pointer to the beginning of the
+	 *		buffer containing UTF-8 encoded
+	 *		JSON.
+	 *	\param [in] end
+	 *		A pointer to the end of the buffer
+	 *		containing UTF-8 encoded JSON.
+	 *	\param [in] max_depth
+	 *		The maximum recursive depth
+	 *		to which the parser will follow
+	 *		the JSON structure before throwing
+	 *		an exception.  Defaults to zero,
+	 *		or unlimited depth.
+	 *
+	 *	\return
+	 *		A single JSON value.
+	 */
+	Value Parse (const Byte * begin, const Byte * end, Word max_depth=0);
 	
 	
 	/**
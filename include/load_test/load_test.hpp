@@ -0,0 +1,403 @@
+/**
+ *	\file
+ */
+
+
+#pragma once
+
+
+#include <rleahylib/rleahylib.hpp>
+#include <aes_128_cfb_8.hpp>
+#include <network.hpp>
+#include <packet.hpp>
+#include <thread_pool.hpp>
+#include <atomic>
+#include <memory>
+
+
+namespace MCPP {
+
+
+	namespace LoadTest {
+	
+	
+		/**
+		 *	Records a distribution of latencies.
+		 *
+		 *	Values are placed into buckets whose
+		 *	width grows with their magnitude such
+		 *	that each bucket is accurate to within
+		 *	12.5%.
+		 */
+		class Histogram {
+		
+		
+			private:
+			
+			
+				static const Word sub_buckets=8;
+				static const Word num_buckets=sub_buckets*62;
+				
+				
+				mutable Mutex lock;
+				UInt64 buckets [num_buckets];
+				UInt64 count;
+				UInt64 total;
+				UInt64 min;
+				UInt64 max;
+				
+				
+				static Word get_bucket (UInt64) noexcept;
+				static UInt64 get_upper (Word) noexcept;
+			
+			
+			public:
+			
+			
+				Histogram () noexcept;
+				
+				
+				/**
+				 *	Records a value.
+				 *
+				 *	\param [in] ns
+				 *		The latency in nanoseconds.
+				 */
+				void Add (UInt64 ns) noexcept;
+				
+				
+				/**
+				 *	Retrieves the number of values which
+				 *	have been recorded.
+				 *
+				 *	\return
+				 *		The number of values recorded.
+				 */
+				UInt64 Count () const noexcept;
+				/**
+				 *	Estimates a certain percentile.
+				 *
+				 *	\param [in] p
+				 *		The percentile, between 0 and
+				 *		100 inclusive.
+				 *
+				 *	\return
+				 *		The estimated value in nanoseconds.
+				 */
+				UInt64 Percentile (Double p) const noexcept;
+				
+				
+				/**
+				 *	Summarizes this histogram in a form
+				 *	suitable for display.
+				 *
+				 *	\param [in] name
+				 *		The name of the phase this histogram
+				 *		measures.
+				 *
+				 *	\return
+				 *		A string.
+				 */
+				String ToString (const String & name) const;
+		
+		
+		};
+		
+		
+		/**
+		 *	The paths which simulated clients may
+		 *	follow once they've spawned.
+		 */
+		enum class PathType {
+		
+			Circle,	/**<	Walk in a circle around the spawn point.	*/
+			Line,	/**<	Walk in a straight line away from the spawn point.	*/
+			Fly		/**<	Fly in a straight line above the spawn point.	*/
+		
+		};
+		
+		
+		/**
+		 *	Configures a load test.
+		 */
+		class Options {
+		
+		
+			public:
+			
+			
+				/**
+				 *	The host name which shall be sent in
+				 *	the handshake.
+				 */
+				String Host;
+				/**
+				 *	The IP address of the server.
+				 */
+				IPAddress IP;
+				/**
+				 *	The port of the server.
+				 */
+				UInt16 Port;
+				/**
+				 *	The number of simulated clients.
+				 */
+				Word Clients;
+				/**
+				 *	The number of clients which shall be
+				 *	connected per second.
+				 */
+				Word ConnectRate;
+				/**
+				 *	How long the test shall run for, in
+				 *	seconds.
+				 */
+				Word Duration;
+				/**
+				 *	The number of threads which shall
+				 *	service connections.
+				 */
+				Word Threads;
+				/**
+				 *	The path clients shall follow.
+				 */
+				PathType Path;
+				/**
+				 *	How fast clients shall move, in blocks
+				 *	per second.
+				 */
+				Word Speed;
+				/**
+				 *	The radius of circular paths, in blocks.
+				 */
+				Word Radius;
+				/**
+				 *	How often each client shall chat, in
+				 *	milliseconds, or zero to never chat.
+				 */
+				Word ChatInterval;
+				/**
+				 *	How often each client shall measure
+				 *	latency by sending a keep alive, in
+				 *	milliseconds, or zero to never do so.
+				 */
+				Word KeepAliveInterval;
+				/**
+				 *	The process ID of the server, if its
+				 *	CPU use shall be reported.
+				 */
+				Nullable<UInt64> PID;
+				
+				
+				Options ();
+		
+		
+		};
+		
+		
+		/**
+		 *	The measurements taken during a load
+		 *	test.
+		 */
+		class Results {
+		
+		
+			public:
+			
+			
+				/**
+				 *	Time from requesting a connection to it
+				 *	being established.
+				 */
+				Histogram Connect;
+				/**
+				 *	Time from the connection being established
+				 *	to the server confirming the login.
+				 */
+				Histogram Login;
+				/**
+				 *	Time from the server confirming the login
+				 *	to the first column being received.
+				 */
+				Histogram FirstChunk;
+				/**
+				 *	Round trip time of client-initiated keep
+				 *	alives.
+				 */
+				Histogram KeepAlive;
+				/**
+				 *	Time from sending a chat message to
+				 *	receiving it back from the server.
+				 */
+				Histogram Chat;
+				
+				
+				std::atomic<UInt64> Connected;
+				std::atomic<UInt64> LoggedIn;
+				std::atomic<UInt64> Failed;
+				std::atomic<UInt64> Disconnected;
+				std::atomic<UInt64> Chunks;
+				std::atomic<UInt64> ChunkBytes;
+				std::atomic<UInt64> Sent;
+				std::atomic<UInt64> Received;
+				
+				
+				Results () noexcept;
+		
+		
+		};
+		
+		
+		/**
+		 *	A single simulated client.
+		 */
+		class SimulatedClient {
+		
+		
+			private:
+			
+			
+				const Options & options;
+				Results & results;
+				Word index;
+				String name;
+				
+				
+				mutable Mutex lock;
+				SmartPointer<Connection> conn;
+				bool done;
+				//	Bytes left in the network layer's
+				//	buffer after the last receive
+				Word leftover;
+				ProtocolState state;
+				Nullable<AES128CFB8> aes;
+				//	Plaintext, once encryption is enabled
+				Vector<Byte> buffer;
+				//	A single packet, for the parser
+				Vector<Byte> frame;
+				PacketParser parser;
+				
+				
+				//	Times the current phase
+				Timer timer;
+				bool first_chunk;
+				
+				
+				//	Movement
+				bool spawned;
+				Double x;
+				Double y;
+				Double z;
+				Double origin_x;
+				Double origin_y;
+				Double origin_z;
+				Double heading;
+				Double distance;
+				
+				
+				//	Latency measurements
+				bool ka_waiting;
+				Timer ka_timer;
+				Vector<Byte> chat_token;
+				Timer chat_timer;
+				Word chat_seq;
+				
+				
+				template <typename T>
+				void send (const T & packet);
+				void process (Vector<Byte> &);
+				bool is_parsed (UInt32) const noexcept;
+				void handle (Packet &);
+				void move ();
+				void chat ();
+				void keep_alive ();
+			
+			
+			public:
+			
+			
+				SimulatedClient (Word index, const Options & options, Results & results);
+				
+				
+				/**
+				 *	Retrieves an endpoint which may be
+				 *	used to connect this client to the
+				 *	server.
+				 *
+				 *	\return
+				 *		An endpoint.
+				 */
+				RemoteEndpoint GetEndpoint ();
+				
+				
+				/**
+				 *	Performs one tick of scripted activity.
+				 *
+				 *	\param [in] tick
+				 *		The number of ticks which have
+				 *		elapsed since the test began.
+				 */
+				void Tick (Word tick);
+				
+				
+				/**
+				 *	Disconnects this client.
+				 */
+				void Disconnect ();
+		
+		
+		};
+		
+		
+		/**
+		 *	Drives a number of simulated clients
+		 *	against a server.
+		 */
+		class Generator {
+		
+		
+			private:
+			
+			
+				Options options;
+				Results results;
+				Vector<std::unique_ptr<SimulatedClient>> clients;
+				
+				
+				ThreadPool pool;
+				ConnectionHandler handler;
+				
+				
+				Mutex lock;
+				CondVar wait;
+				
+				
+				void report (UInt64 elapsed, Nullable<UInt64> cpu);
+			
+			
+			public:
+			
+			
+				/**
+				 *	The length of a tick, in milliseconds.
+				 */
+				static const Word TickLength=50;
+				
+				
+				Generator (Options options);
+				
+				
+				/**
+				 *	Runs the load test and writes the results
+				 *	to standard output.
+				 */
+				void Run ();
+		
+		
+		};
+	
+	
+	}
+
+
+}
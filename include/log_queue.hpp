@@ -0,0 +1,487 @@
+/**
+ *	\file
+ */
+
+
+#pragma once
+
+
+#include <rleahylib/rleahylib.hpp>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+namespace MCPP {
+
+
+	/**
+	 *	\cond
+	 */
+	
+	
+	class LogRecord {
+	
+	
+		public:
+		
+		
+			static constexpr Word MaxArguments=8;
+			//	Slots keep the memory text arguments
+			//	were copied into for the next record,
+			//	unless it grew beyond this many code
+			//	points
+			static constexpr Word MaxRetained=256;
+			
+			
+			enum class ArgumentType : Byte {
+			
+				Signed,
+				Unsigned,
+				Floating,
+				Text
+			
+			};
+			
+			
+			//	Where a text argument's code points
+			//	are in the record's text
+			class TextRange {
+			
+			
+				public:
+				
+				
+					UInt32 Offset;
+					UInt32 Length;
+			
+			
+			};
+			
+			
+			union Argument {
+			
+				Int64 Signed;
+				UInt64 Unsigned;
+				Double Floating;
+				TextRange Text;
+			
+			};
+			
+			
+			//	The template, which must outlive the
+			//	record, or null if the message is
+			//	preformatted and stored as the
+			//	first argument
+			const String * Template;
+			Service::LogType Type;
+			Byte Count;
+			ArgumentType Types [MaxArguments];
+			Argument Arguments [MaxArguments];
+			//	The code points of every text argument
+			//	one after the other, so that a record
+			//	holds one allocation rather than one
+			//	per argument, and reuses it
+			Vector<CodePoint> Text;
+			
+			
+			//	Copies a string into the record's text
+			//	as the argument at a given index
+			void SetText (Word i, const String & str);
+			
+			
+			template <typename T>
+			typename std::enable_if<
+				std::is_integral<typename std::decay<T>::type>::value &&
+				std::is_signed<typename std::decay<T>::type>::value &&
+				!std::is_same<typename std::decay<T>::type,bool>::value
+			>::type Set (Word i, T && arg) noexcept {
+			
+				Types[i]=ArgumentType::Signed;
+				Arguments[i].Signed=static_cast<Int64>(arg);
+			
+			}
+			
+			
+			template <typename T>
+			typename std::enable_if<
+				std::is_integral<typename std::decay<T>::type>::value &&
+				std::is_unsigned<typename std::decay<T>::type>::value &&
+				!std::is_same<typename std::decay<T>::type,bool>::value
+			>::type Set (Word i, T && arg) noexcept {
+			
+				Types[i]=ArgumentType::Unsigned;
+				Arguments[i].Unsigned=static_cast<UInt64>(arg);
+			
+			}
+			
+			
+			template <typename T>
+			typename std::enable_if<
+				std::is_floating_point<typename std::decay<T>::type>::value
+			>::type Set (Word i, T && arg) noexcept {
+			
+				Types[i]=ArgumentType::Floating;
+				Arguments[i].Floating=static_cast<Double>(arg);
+			
+			}
+			
+			
+			template <typename T>
+			typename std::enable_if<
+				std::is_same<typename std::decay<T>::type,String>::value
+			>::type Set (Word i, T && arg) {
+			
+				SetText(i,arg);
+			
+			}
+			
+			
+			template <typename T>
+			typename std::enable_if<
+				std::is_same<typename std::decay<T>::type,const char *>::value
+			>::type Set (Word i, T && arg) {
+			
+				SetText(i,String(arg));
+			
+			}
+			
+			
+			//	Anything else is formatted eagerly
+			//	so that the record does not hold
+			//	references to the caller's objects
+			template <typename T>
+			typename std::enable_if<
+				!(
+					std::is_arithmetic<typename std::decay<T>::type>::value ||
+					std::is_same<typename std::decay<T>::type,String>::value ||
+					std::is_same<typename std::decay<T>::type,const char *>::value
+				) ||
+				std::is_same<typename std::decay<T>::type,bool>::value
+			>::type Set (Word i, T && arg) {
+			
+				SetText(
+					i,
+					String::Format(
+						String("{0}"),
+						std::forward<T>(arg)
+					)
+				);
+			
+			}
+			
+			
+			String ToString () const;
+			//	Called once the record has been written,
+			//	releases the record's text if it grew
+			//	too large to be worth keeping
+			void Clear () noexcept;
+	
+	
+	};
+	
+	
+	class LogRing {
+	
+	
+		public:
+		
+		
+			LogRing (Word capacity);
+			
+			
+			std::unique_ptr<LogRecord []> Records;
+			Word Capacity;
+			//	Next slot to be written, only
+			//	advanced by the owning thread
+			std::atomic<Word> Head;
+			//	Next slot to be read, only advanced
+			//	by the logging thread
+			std::atomic<Word> Tail;
+			//	Set when the owning thread exits,
+			//	once drained the ring is discarded
+			std::atomic<bool> Abandoned;
+	
+	
+	};
+	
+	
+	/**
+	 *	\endcond
+	 */
+	
+	
+	/**
+	 *	Contains information about a log queue
+	 *	at a particular moment in time.
+	 */
+	class LogQueueInfo {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The number of records which have been
+			 *	written out by the logging thread.
+			 */
+			UInt64 Written;
+			/**
+			 *	The number of records which were discarded
+			 *	because the ring buffer of the thread which
+			 *	generated them was full.
+			 */
+			UInt64 Dropped;
+			/**
+			 *	The number of per thread ring buffers.
+			 */
+			Word Rings;
+			/**
+			 *	The number of records each newly-created
+			 *	ring buffer holds.
+			 */
+			Word Capacity;
+	
+	
+	};
+	
+	
+	/**
+	 *	Defers the formatting and writing of log
+	 *	records to a dedicated thread.
+	 *
+	 *	Each thread which logs is given its own
+	 *	bounded ring buffer, which it writes to
+	 *	without taking any locks.  When a ring
+	 *	buffer is full, records are dropped and
+	 *	counted rather than blocking the caller.
+	 */
+	class LogQueue {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The type of callback invoked on the
+			 *	logging thread for each record.
+			 */
+			typedef std::function<void (const String &, Service::LogType)> CallbackType;
+		
+		
+		private:
+		
+		
+			//	Distinguishes this queue from any other
+			//	queue which has existed in this process,
+			//	so threads can tell whether their ring
+			//	belongs to this queue
+			UInt64 id;
+			
+			
+			CallbackType callback;
+			
+			
+			std::atomic<Word> capacity;
+			std::atomic<UInt64> written;
+			std::atomic<UInt64> dropped;
+			
+			
+			//	True while the logging thread is (or
+			//	is about to be) asleep, producers only
+			//	take the lock to wake it if this is set
+			std::atomic<bool> sleeping;
+			
+			
+			mutable Mutex lock;
+			mutable CondVar wait;
+			Vector<std::shared_ptr<LogRing>> rings;
+			bool stop;
+			//	Flush requests, and the last request
+			//	the logging thread has satisfied
+			UInt64 requested;
+			UInt64 completed;
+			
+			
+			Thread thread;
+			
+			
+			LogRing * get_ring ();
+			void notify () noexcept;
+			void worker_func () noexcept;
+			bool drain ();
+		
+		
+		public:
+		
+		
+			LogQueue () = delete;
+			LogQueue (const LogQueue &) = delete;
+			LogQueue (LogQueue &&) = delete;
+			LogQueue & operator = (const LogQueue &) = delete;
+			LogQueue & operator = (LogQueue &&) = delete;
+			
+			
+			/**
+			 *	Creates and starts a new log queue.
+			 *
+			 *	\param [in] callback
+			 *		The callback which shall be invoked
+			 *		on the logging thread for each
+			 *		formatted record.
+			 *	\param [in] capacity
+			 *		The number of records each per thread
+			 *		ring buffer shall hold.
+			 */
+			LogQueue (CallbackType callback, Word capacity);
+			/**
+			 *	Writes all outstanding records and stops
+			 *	the logging thread.
+			 */
+			~LogQueue () noexcept;
+			
+			
+			/**
+			 *	Enqueues a record which shall be formatted
+			 *	and written on the logging thread.
+			 *
+			 *	Arithmetic arguments and strings are
+			 *	captured by value and formatted on the
+			 *	logging thread, all other arguments are
+			 *	formatted at once.
+			 *
+			 *	\tparam Args
+			 *		The types of the arguments.
+			 *
+			 *	\param [in] format
+			 *		The template which shall be passed to
+			 *		String::Format.  This reference must
+			 *		remain valid until the record is written,
+			 *		so it should refer to an object with static
+			 *		storage duration.
+			 *	\param [in] type
+			 *		The type of the log record.
+			 *	\param [in] args
+			 *		Up to eight arguments to format into
+			 *		\em format.
+			 */
+			template <typename... Args>
+			void Enqueue (const String & format, Service::LogType type, Args &&... args) noexcept;
+			/**
+			 *	Enqueues a preformatted record which shall
+			 *	be written on the logging thread.
+			 *
+			 *	\param [in] message
+			 *		The message.
+			 *	\param [in] type
+			 *		The type of the log record.
+			 */
+			void Enqueue (const String & message, Service::LogType type) noexcept;
+			
+			
+			/**
+			 *	Blocks until every record enqueued by any
+			 *	thread before this call has been written.
+			 *
+			 *	Must not be called from the logging thread.
+			 */
+			void Flush () noexcept;
+			
+			
+			/**
+			 *	Changes the capacity of ring buffers created
+			 *	after this call.
+			 *
+			 *	\param [in] capacity
+			 *		The number of records each new ring buffer
+			 *		shall hold.
+			 */
+			void SetCapacity (Word capacity) noexcept;
+			
+			
+			/**
+			 *	Retrieves information about this queue.
+			 *
+			 *	\return
+			 *		A structure populated with information
+			 *		about this queue.
+			 */
+			LogQueueInfo GetInfo () const noexcept;
+	
+	
+	};
+	
+	
+	/**
+	 *	\cond
+	 */
+	
+	
+	inline void set_log_arguments (LogRecord &, Word) noexcept {	}
+	
+	
+	template <typename T, typename... Args>
+	void set_log_arguments (LogRecord & record, Word i, T && arg, Args &&... args) {
+	
+		record.Set(i,std::forward<T>(arg));
+		
+		set_log_arguments(record,i+1,std::forward<Args>(args)...);
+	
+	}
+	
+	
+	template <typename... Args>
+	void LogQueue::Enqueue (const String & format, Service::LogType type, Args &&... args) noexcept {
+	
+		static_assert(
+			sizeof...(Args)<=LogRecord::MaxArguments,
+			"Too many arguments to log record"
+		);
+		
+		try {
+		
+			auto ring=get_ring();
+			
+			//	Only this thread ever advances
+			//	the head
+			Word head=ring->Head.load(std::memory_order_relaxed);
+			
+			if ((head-ring->Tail.load(std::memory_order_acquire))==ring->Capacity) {
+			
+				++dropped;
+				
+				return;
+			
+			}
+			
+			auto & record=ring->Records[head%ring->Capacity];
+			record.Template=&format;
+			record.Type=type;
+			record.Count=sizeof...(Args);
+			record.Text.SetCount(0);
+			set_log_arguments(record,0,std::forward<Args>(args)...);
+			
+			//	Publish
+			ring->Head.store(head+1);
+		
+		} catch (...) {
+		
+			++dropped;
+			
+			return;
+		
+		}
+		
+		notify();
+	
+	}
+	
+	
+	/**
+	 *	\endcond
+	 */
+
+
+}
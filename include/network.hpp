@@ -7,6 +7,7 @@
 
 
 #include <rleahylib/rleahylib.hpp>
+#include <atomic>
 #include <exception>
 #include <functional>
 
@@ -20,7 +21,6 @@ namespace MCPP {
 	 
 	 
 	class ListeningSocket;
-	class SendHandle;
 	class Connection;
 	class ConnectionHandler;
 	
@@ -356,6 +356,148 @@ namespace MCPP {
 		Failed		/**<	The send failed.	*/
 	
 	};
+	
+	
+	/**
+	 *	\cond
+	 */
+	
+	
+	namespace NetworkImpl {
+	
+	
+		//	The shared state of a send handle,
+		//	which is recycled rather than freed
+		//	so that tracking a send does not
+		//	allocate
+		class SendHandleState {
+		
+		
+			public:
+			
+			
+				std::atomic<Word> References;
+				std::atomic<SendState> State;
+				Mutex Lock;
+				CondVar Wait;
+				//	The next state in the pool
+				SendHandleState * Next;
+		
+		
+		};
+	
+	
+	}
+	
+	
+	/**
+	 *	\endcond
+	 */
+	
+	
+	/**
+	 *	Tracks the progress of an asynchronous
+	 *	send.
+	 *
+	 *	Unlike a promise, a send handle does not
+	 *	allocate once the server has reached a
+	 *	steady state, its state is taken from, and
+	 *	returned to, a pool.  Sends whose results
+	 *	are of no interest should not be tracked
+	 *	at all.
+	 *
+	 *	A default constructed handle tracks nothing,
+	 *	completing it does nothing, and waiting on it
+	 *	throws.
+	 */
+	class SendHandle {
+	
+	
+		private:
+		
+		
+			NetworkImpl::SendHandleState * state;
+			
+			
+			void release () noexcept;
+			
+			
+		public:
+		
+		
+			/**
+			 *	Creates a handle which tracks nothing.
+			 */
+			SendHandle () noexcept;
+			/**
+			 *	Creates a handle which tracks a send
+			 *	which has not yet completed.
+			 *
+			 *	\return
+			 *		A new send handle.
+			 */
+			static SendHandle Make ();
+			
+			
+			/**
+			 *	\cond
+			 */
+			
+			
+			SendHandle (const SendHandle &) noexcept;
+			SendHandle (SendHandle &&) noexcept;
+			SendHandle & operator = (const SendHandle &) noexcept;
+			SendHandle & operator = (SendHandle &&) noexcept;
+			~SendHandle () noexcept;
+			
+			
+			/**
+			 *	\endcond
+			 */
+			
+			
+			/**
+			 *	Determines whether this handle tracks
+			 *	a send.
+			 *
+			 *	\return
+			 *		\em true if this handle tracks a send,
+			 *		\em false otherwise.
+			 */
+			explicit operator bool () const noexcept;
+			
+			
+			/**
+			 *	Retrieves the state of the send.
+			 *
+			 *	\return
+			 *		The state of the send.
+			 */
+			SendState State () const;
+			/**
+			 *	Waits for the send to complete.
+			 *
+			 *	\return
+			 *		\em true if the send succeeded,
+			 *		\em false otherwise.
+			 */
+			bool Wait () const;
+			
+			
+			/**
+			 *	Completes the send, waking all threads
+			 *	waiting on it.
+			 *
+			 *	Has no effect if this handle tracks
+			 *	nothing.
+			 *
+			 *	\param [in] success
+			 *		Whether the send succeeded.
+			 */
+			void Complete (bool success) noexcept;
+	
+	
+	};
 
 
 }
@@ -333,13 +333,13 @@ namespace MCPP {
 					//	How many bytes have been
 					//	sent
 					Word Sent;
-					//	The promise that will be
-					//	fulfilled when this completes
-					Promise<bool> Completion;
+					//	Completed when this completes,
+					//	may track nothing
+					SendHandle Completion;
 					
 					
 					SendBuffer () = delete;
-					SendBuffer (Vector<Byte>) noexcept;
+					SendBuffer (Vector<Byte>, SendHandle) noexcept;
 			
 			
 			};
@@ -381,6 +381,12 @@ namespace MCPP {
 			std::atomic<Word> received;
 			
 			
+			//	Opaque data belonging to the
+			//	owner of this connection
+			std::shared_ptr<void> data;
+			mutable Mutex data_lock;
+			
+			
 			//	Endpoints
 			IPAddress local_ip;
 			UInt16 local_port;
@@ -394,6 +400,7 @@ namespace MCPP {
 			void write (NetworkImpl::FollowUp &);
 			bool get_local_endpoint () noexcept;
 			void get_connect (NetworkImpl::FollowUp &);
+			void enqueue (Vector<Byte>, SendHandle);
 			
 			
 			//	Interface implementation
@@ -423,13 +430,19 @@ namespace MCPP {
 			void Disconnect (String reason);
 			
 			
-			Promise<bool> Send (Vector<Byte> buffer);
+			SendHandle Send (Vector<Byte> buffer);
+			void Post (Vector<Byte> buffer);
 			
 			
 			IPAddress IP () const noexcept;
 			UInt16 Port () const noexcept;
 			Word Sent () const noexcept;
 			Word Received () const noexcept;
+			
+			
+			void SetData (std::shared_ptr<void> data);
+			std::shared_ptr<void> GetData () const;
+			std::shared_ptr<void> TakeData ();
 	
 	
 	};
@@ -303,11 +303,12 @@ namespace MCPP {
 			public:
 			
 			
-				SendCommand (Vector<Byte>) noexcept;
+				SendCommand (Vector<Byte>, SendHandle) noexcept;
 			
 			
 				Vector<Byte> Buffer;
-				Promise<bool> Completion;
+				//	May track nothing
+				SendHandle Completion;
 				
 				
 				//	Makes a WSASend request, queuing
@@ -605,6 +606,12 @@ namespace MCPP {
 			Mutex reason_lock;
 			
 			
+			//	Opaque data belonging to the
+			//	owner of this connection
+			std::shared_ptr<void> data;
+			mutable Mutex data_lock;
+			
+			
 			//	Shuts the socket down
 			void Shutdown () noexcept;
 			
@@ -640,6 +647,11 @@ namespace MCPP {
 			void Begin ();
 			
 			
+			//	Queues up a send, completing the
+			//	handle when it completes
+			void enqueue (Vector<Byte>, SendHandle);
+			
+			
 		public:
 		
 		
@@ -671,13 +683,23 @@ namespace MCPP {
 			 *		The data to sent.
 			 *
 			 *	\return
-			 *		A promise for a boolean.  The value
-			 *		will be set when the asynchronous
-			 *		send operation completes.  It will be
-			 *		set to \em true if the send succeeds,
-			 *		\em false otherwise.
+			 *		A handle which will be completed when
+			 *		the asynchronous send operation
+			 *		completes.
+			 */
+			SendHandle Send (Vector<Byte> buffer);
+			/**
+			 *	Sends data across a connected connection
+			 *	without tracking the send.
+			 *
+			 *	Cheaper than Send, this should be preferred
+			 *	whenever the result of a send is of no
+			 *	interest.
+			 *
+			 *	\param [in] buffer
+			 *		The data to send.
 			 */
-			Promise<bool> Send (Vector<Byte> buffer);
+			void Post (Vector<Byte> buffer);
 			
 			
 			/**
@@ -743,6 +765,48 @@ namespace MCPP {
 			 *		silently ignored.
 			 */
 			void Disconnect (String reason) noexcept;
+			
+			
+			/**
+			 *	Associates data with this connection.
+			 *
+			 *	The connection handler never inspects
+			 *	this data, it exists so that the owner
+			 *	of a connection may find its own state
+			 *	from the connection passed to a callback
+			 *	without searching for it.
+			 *
+			 *	The data is held until it is replaced,
+			 *	taken, or this connection is destroyed.
+			 *	Data which refers back to this connection
+			 *	should therefore be taken when it
+			 *	disconnects.
+			 *
+			 *	\param [in] data
+			 *		The data to associate with this
+			 *		connection, replacing any data
+			 *		previously associated with it.
+			 */
+			void SetData (std::shared_ptr<void> data);
+			/**
+			 *	Retrieves the data associated with this
+			 *	connection.
+			 *
+			 *	\return
+			 *		The data associated with this connection,
+			 *		which is null if there is none.
+			 */
+			std::shared_ptr<void> GetData () const;
+			/**
+			 *	Retrieves the data associated with this
+			 *	connection and dissociates it.
+			 *
+			 *	\return
+			 *		The data which was associated with this
+			 *		connection, which is null if there was
+			 *		none.
+			 */
+			std::shared_ptr<void> TakeData ();
 	
 	
 	};
@@ -177,6 +177,70 @@ namespace MCPP {
 	typedef Variant<Int32,Tuple<Int32,Int16,Int16,Int16>> ObjectData;
 	
 	
+	/**
+	 *	Describes one of the columns sent in
+	 *	a ColumnBulk.
+	 */
+	class ColumnMetadata {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The X co-ordinate of the column.
+			 */
+			Int32 X;
+			/**
+			 *	The Z co-ordinate of the column.
+			 */
+			Int32 Z;
+			/**
+			 *	A bitmask of the sections sent, from
+			 *	bottom to top.
+			 */
+			UInt16 Primary;
+			/**
+			 *	A bitmask of the sections for which
+			 *	the "add" array is sent, from bottom
+			 *	to top.
+			 */
+			UInt16 Add;
+	
+	
+	};
+	
+	
+	/**
+	 *	Several columns sent together and
+	 *	compressed as one.
+	 */
+	class ColumnBulk {
+	
+	
+		public:
+		
+		
+			/**
+			 *	Whether skylight is sent for each
+			 *	column.
+			 */
+			bool Skylight;
+			/**
+			 *	The compressed data of each column,
+			 *	one after another.
+			 */
+			Vector<Byte> Data;
+			/**
+			 *	Describes each column in Data, in
+			 *	order.
+			 */
+			Vector<ColumnMetadata> Columns;
+	
+	
+	};
+	
+	
 	/**
 	 *	The base class from which all packets
 	 *	are derived.
@@ -516,7 +580,7 @@ namespace MCPP {
 		template <> class PacketMap<PL,CB,0x23> : public PacketType<Int32,Byte,UInt32,VarInt<UInt32>,Byte> {	};
 		template <> class PacketMap<PL,CB,0x24> : public PacketType<Int32,Int16,Int32,Byte,Byte,VarInt<UInt32>> {	};
 		template <> class PacketMap<PL,CB,0x25> : public PacketType<VarInt<UInt32>,Int32,Int32,Int32,Byte> {	};
-		//	0x26
+		template <> class PacketMap<PL,CB,0x26> : public PacketType<ColumnBulk> {	};
 		template <> class PacketMap<PL,CB,0x27> : public PacketType<Single,Single,Single,Single,Array<Int32,Tuple<SByte,SByte,SByte>>,Single,Single,Single> {	};
 		template <> class PacketMap<PL,CB,0x28> : public PacketType<Int32,Int32,Byte,Int32,Int32,bool> {	};
 		template <> class PacketMap<PL,CB,0x29> : public PacketType<String,Int32,Int32,Int32,Single,Byte,Byte> {	};
@@ -1074,6 +1138,10 @@ namespace MCPP {
 			private:
 			
 			
+				typedef UInt32 size_type;
+				typedef VarInt<size_type> var_int_type;
+			
+			
 				//	Maximum recursion the JSON parser
 				//	will be willing to go through before
 				//	bailing out and throwing when parsing
@@ -1095,22 +1163,56 @@ namespace MCPP {
 				
 				static void FromBytes (const Byte * & begin, const Byte * end, void * ptr) {
 				
-					//	Get the string from which we'll
-					//	extract JSON
-					auto str=Deserialize<String>(begin,end);
+					//	Get length of the JSON string
+					//	in bytes
+					var_int_type len=Deserialize<decltype(len)>(begin,end);
+					
+					if ((end-begin)<size_type(len)) InsufficientBytes::Raise();
+					
+					auto start=begin;
+					begin+=size_type(len);
 					
-					//	Parse JSON
-					new (ptr) JSON::Value (JSON::Parse(str,max_recursion));
+					//	Parse JSON directly from the
+					//	UTF-8 encoded bytes
+					new (ptr) JSON::Value (JSON::Parse(start,begin,max_recursion));
 				
 				}
 				
 				
 				static void ToBytes (Vector<Byte> & buffer, const JSON::Value & obj) {
 				
-					Serializer<String>::ToBytes(
+					//	The length precedes the JSON, but
+					//	is not known until the JSON has
+					//	been serialized, so the JSON is
+					//	serialized straight into the buffer
+					//	after room for a one byte length,
+					//	and moved along if the length needs
+					//	more than that
+					Word start=buffer.Count();
+					buffer.Add(0);
+					JSON::Serialize(buffer,obj);
+					Word json=buffer.Count();
+					Word len=json-start-1;
+					
+					//	Encode the length at the end of the
+					//	buffer, which also makes room for
+					//	the move
+					Serializer<var_int_type>::ToBytes(
 						buffer,
-						JSON::Serialize(obj)
+						size_type(SafeWord(len))
+					);
+					Word prefix_len=buffer.Count()-json;
+					Byte prefix [(sizeof(size_type)*BitsPerByte()+6)/7];
+					std::memcpy(prefix,buffer.begin()+json,prefix_len);
+					
+					std::memmove(
+						buffer.begin()+start+prefix_len,
+						buffer.begin()+start+1,
+						len
 					);
+					std::memcpy(buffer.begin()+start,prefix,prefix_len);
+					
+					buffer.SetCount(start+prefix_len+len);
 				
 				}
 		
@@ -1482,6 +1584,89 @@ namespace MCPP {
 		};
 		
 		
+		template <>
+		class Serializer<ColumnBulk> {
+		
+		
+			public:
+			
+			
+				static Word Size (const ColumnBulk & obj) {
+				
+					SafeWord size(Serializer<Int16>::Size(0));
+					size+=SafeWord(Serializer<Int32>::Size(0));
+					size+=SafeWord(Serializer<bool>::Size(obj.Skylight));
+					size+=SafeWord(obj.Data.Count());
+					size+=SafeWord(obj.Columns.Count())*SafeWord(
+						(Serializer<Int32>::Size(0)*2)+
+						(Serializer<UInt16>::Size(0)*2)
+					);
+					
+					return Word(size);
+				
+				}
+				
+				
+				static void FromBytes (const Byte * & begin, const Byte * end, void * ptr) {
+				
+					//	The count of columns precedes the
+					//	data, the metadata of each column
+					//	follows it
+					auto count=Deserialize<Int16>(begin,end);
+					auto len=Deserialize<Int32>(begin,end);
+					if ((count<0) || (len<0)) BadFormat::Raise();
+					
+					ColumnBulk obj;
+					obj.Skylight=Deserialize<bool>(begin,end);
+					
+					if ((end-begin)<len) InsufficientBytes::Raise();
+					obj.Data=Vector<Byte>(Word(len));
+					std::memcpy(obj.Data.begin(),begin,Word(len));
+					obj.Data.SetCount(Word(len));
+					begin+=len;
+					
+					for (Int16 i=0;i<count;++i) {
+					
+						ColumnMetadata metadata;
+						metadata.X=Deserialize<Int32>(begin,end);
+						metadata.Z=Deserialize<Int32>(begin,end);
+						metadata.Primary=Deserialize<UInt16>(begin,end);
+						metadata.Add=Deserialize<UInt16>(begin,end);
+						
+						obj.Columns.Add(metadata);
+					
+					}
+					
+					new (ptr) ColumnBulk (std::move(obj));
+				
+				}
+				
+				
+				static void ToBytes (Vector<Byte> & buffer, const ColumnBulk & obj) {
+				
+					Serializer<Int16>::ToBytes(buffer,Int16(SafeWord(obj.Columns.Count())));
+					Serializer<Int32>::ToBytes(buffer,Int32(SafeWord(obj.Data.Count())));
+					Serializer<bool>::ToBytes(buffer,obj.Skylight);
+					
+					while ((buffer.Capacity()-buffer.Count())<obj.Data.Count()) buffer.SetCapacity();
+					std::memcpy(buffer.end(),obj.Data.begin(),obj.Data.Count());
+					buffer.SetCount(buffer.Count()+obj.Data.Count());
+					
+					for (const auto & metadata : obj.Columns) {
+					
+						Serializer<Int32>::ToBytes(buffer,metadata.X);
+						Serializer<Int32>::ToBytes(buffer,metadata.Z);
+						Serializer<UInt16>::ToBytes(buffer,metadata.Primary);
+						Serializer<UInt16>::ToBytes(buffer,metadata.Add);
+					
+					}
+				
+				}
+		
+		
+		};
+		
+		
 		template <>
 		class Serializer<NBT::NamedTag> {
 		
@@ -2373,6 +2558,18 @@ namespace MCPP {
 				};
 				
 				
+				class MapChunkBulk : public Base, public IDPacket<0x26> {
+				
+				
+					public:
+					
+					
+						ColumnBulk Bulk;
+				
+				
+				};
+				
+				
 				class PlayerListItem : public Base, public IDPacket<0x38> {
 				
 				
@@ -2528,6 +2725,41 @@ namespace MCPP {
 				};
 				
 				
+				class PlayerDigging : public Base, public IDPacket<0x07> {
+				
+				
+					public:
+					
+					
+						Byte Status;
+						Int32 X;
+						Byte Y;
+						Int32 Z;
+						Byte Face;
+				
+				
+				};
+				
+				
+				class PlayerBlockPlacement : public Base, public IDPacket<0x08> {
+				
+				
+					public:
+					
+					
+						Int32 X;
+						Byte Y;
+						Int32 Z;
+						SByte Direction;
+						Nullable<Slot> HeldItem;
+						SByte CursorX;
+						SByte CursorY;
+						SByte CursorZ;
+				
+				
+				};
+				
+				
 				class TabComplete : public Base, public IDPacket<0x14> {
 				
 				
@@ -2711,7 +2943,7 @@ namespace MCPP {
 				 */
 				 
 				 
-				class Base : public LIPacket, public CBPacket {	};
+				class Base : public LIPacket, public SBPacket {	};
 				
 				
 				/**
@@ -64,6 +64,9 @@ namespace MCPP {
 			Type status_routes [PacketImpl::LargestID+1];
 			Type login_routes [PacketImpl::LargestID+1];
 			Type handshake_routes [PacketImpl::LargestID+1];
+			//	The module which installed each route,
+			//	indexed by state and then by ID
+			Word owners [4][PacketImpl::LargestID+1];
 			
 			
 			inline void destroy () noexcept;
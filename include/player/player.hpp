@@ -12,6 +12,7 @@
 #include <concurrency_manager.hpp>
 #include <packet.hpp>
 #include <packet_router.hpp>
+#include <atomic>
 #include <functional>
 #include <unordered_set>
 #include <unordered_map>
@@ -162,6 +163,22 @@ namespace MCPP {
 			PlayerPosition Position;
 			SByte Dimension;
 			std::unordered_set<ColumnID> Columns;
+			/**
+			 *	The player's recent velocity along the
+			 *	X axis, in blocks per second.
+			 */
+			Double VelocityX;
+			/**
+			 *	The player's recent velocity along the
+			 *	Z axis, in blocks per second.
+			 */
+			Double VelocityZ;
+			/**
+			 *	Columns ahead of the player which are
+			 *	being prefetched, mapped to whether
+			 *	interest in them is held.
+			 */
+			std::unordered_map<ColumnID,bool> Prefetched;
 	
 	
 	};
@@ -188,6 +205,15 @@ namespace MCPP {
 			//	columns which shall be allowed to
 			//	remain on the client
 			Word cache_distance;
+			//	Specifies how many columns past the
+			//	edge of the view distance columns
+			//	are prefetched in the direction in
+			//	which a player is moving
+			Word prefetch_distance;
+			//	Specifies how many columns may be
+			//	waiting to be prefetched across all
+			//	players
+			Word prefetch_budget;
 			
 			
 			//	Determines the spawn location
@@ -210,6 +236,13 @@ namespace MCPP {
 			//	tasks, insuring that they don't
 			//	swamp the server's thread pool
 			Nullable<ConcurrencyManager> cm;
+			//	Prefetches are dispatched separately,
+			//	one at a time, so that they never hold
+			//	up columns players can already see
+			Nullable<ConcurrencyManager> prefetch_cm;
+			//	The number of columns waiting to be
+			//	prefetched
+			std::atomic<Word> prefetching;
 			
 			
 			//	Contains the columns around the
@@ -233,6 +266,18 @@ namespace MCPP {
 			//	necessary after a player's position
 			//	has changed
 			void update_position (SmartPointer<Player> &, std::function<void ()> then=std::function<void ()>());
+			//	Determines which columns should be
+			//	prefetched for a player given the
+			//	column they are in, retrieving the
+			//	columns which should begin being
+			//	prefetched, and the columns in which
+			//	interest should be ended.
+			//
+			//	The player's lock must be held.
+			void prefetch (Player &, ColumnID, Vector<ColumnID> &, Vector<ColumnID> &);
+			//	Dispatches prefetches of columns for
+			//	a player
+			void begin_prefetch (const SmartPointer<Player> &, const Vector<ColumnID> &);
 			
 			
 			//	EVENT HANDLERS
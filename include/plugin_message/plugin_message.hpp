@@ -144,11 +144,11 @@ namespace MCPP {
 			 *		The message to send.
 			 *
 			 *	\return
-			 *		A promise for the results of the
+			 *		A handle for the results of the
 			 *		send if a send was performed, null
 			 *		otherwise.
 			 */
-			Nullable<Promise<bool>> Send (PluginMessage message);
+			Nullable<SendHandle> Send (PluginMessage message);
 	
 	
 	};
@@ -0,0 +1,205 @@
+/**
+ *	\file
+ */
+
+
+#pragma once
+
+
+#include <rleahylib/rleahylib.hpp>
+#include <world/world.hpp>
+#include <mod.hpp>
+#include <atomic>
+
+
+namespace MCPP {
+
+
+	/**
+	 *	Encapsulates statistics and information
+	 *	about the world pre-generator.
+	 */
+	class PregenInfo {
+	
+	
+		public:
+		
+		
+			/**
+			 *	Whether a region is being
+			 *	pre-generated.
+			 */
+			bool Running;
+			/**
+			 *	Whether pre-generation is waiting for
+			 *	ticks to once again complete on time.
+			 */
+			bool Paused;
+			/**
+			 *	The dimension being pre-generated.
+			 */
+			SByte Dimension;
+			/**
+			 *	The radius, in columns, of the region
+			 *	being pre-generated.
+			 */
+			Word Radius;
+			/**
+			 *	The number of columns in the region
+			 *	which have been pre-generated.
+			 */
+			Word Completed;
+			/**
+			 *	The number of columns in the region.
+			 */
+			Word Total;
+			/**
+			 *	The number of columns which have been
+			 *	pre-generated since the server was last
+			 *	restarted.
+			 */
+			Word Generated;
+			/**
+			 *	The number of nanoseconds which have been
+			 *	spent pre-generating columns since the
+			 *	server was last restarted.
+			 */
+			UInt64 Elapsed;
+			/**
+			 *	The number of times pre-generation has
+			 *	paused because a tick took too long.
+			 */
+			Word Pauses;
+	
+	
+	};
+	
+	
+	/**
+	 *	Generates and populates a square region of
+	 *	the world ahead of time, so that players who
+	 *	explore it do not wait for columns to be
+	 *	generated.
+	 *
+	 *	Columns are generated one at a time, in a
+	 *	spiral outward from the origin, and generation
+	 *	pauses whenever the server's ticks take too
+	 *	long.  Progress is saved to the backing store,
+	 *	and pre-generation resumes when the server is
+	 *	restarted.
+	 */
+	class Pregenerator : public Module {
+	
+	
+		private:
+		
+		
+			//	SETTINGS
+			
+			//	How many columns are generated before
+			//	they are saved
+			Word batch_size;
+			
+			
+			//	STATE
+			
+			bool running;
+			bool paused;
+			SByte dimension;
+			Word radius;
+			//	The index in the spiral of the next
+			//	column to generate
+			Word next;
+			//	Columns which have been generated but
+			//	not saved
+			Vector<ColumnID> batch;
+			//	Incremented each time pre-generation
+			//	is started or stopped so that work
+			//	from an earlier run can recognize
+			//	that it is stale
+			Word run;
+			mutable Mutex lock;
+			
+			
+			//	STATISTICS
+			
+			std::atomic<Word> generated;
+			std::atomic<UInt64> elapsed;
+			std::atomic<Word> pauses;
+			
+			
+			static ColumnID get_column (Word, SByte) noexcept;
+			void save_progress ();
+			void save_batch (Vector<ColumnID>);
+			void step (Word);
+			void schedule (Word, Word);
+		
+		
+		public:
+		
+		
+			/**
+			 *	Retrieves a reference to a valid instance
+			 *	of this class.
+			 *
+			 *	\return
+			 *		A reference to an instance of this class.
+			 */
+			static Pregenerator & Get () noexcept;
+			
+			
+			/**
+			 *	\cond
+			 */
+			
+			
+			Pregenerator () noexcept;
+			
+			
+			virtual Word Priority () const noexcept override;
+			virtual const String & Name () const noexcept override;
+			virtual void Install () override;
+			
+			
+			/**
+			 *	\endcond
+			 */
+			
+			
+			/**
+			 *	Begins pre-generating a region, replacing
+			 *	any region currently being pre-generated.
+			 *
+			 *	\param [in] dimension
+			 *		The dimension to pre-generate.
+			 *	\param [in] radius
+			 *		The number of columns between the
+			 *		origin and each edge of the region
+			 *		to pre-generate.
+			 */
+			void Start (SByte dimension, Word radius);
+			/**
+			 *	Stops pre-generating, discarding progress.
+			 *
+			 *	\return
+			 *		\em true if a region was being
+			 *		pre-generated, \em false otherwise.
+			 */
+			bool Stop ();
+			
+			
+			/**
+			 *	Retrieves information and statistics about
+			 *	the pre-generator.
+			 *
+			 *	\return
+			 *		A structure which contains information and
+			 *		statistics about the pre-generator.
+			 */
+			PregenInfo GetInfo () const noexcept;
+	
+	
+	};
+
+
+}
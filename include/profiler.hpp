@@ -0,0 +1,400 @@
+/**
+ *	\file
+ */
+
+
+#pragma once
+
+
+#include <rleahylib/rleahylib.hpp>
+#include <atomic>
+
+
+namespace MCPP {
+
+
+	/**
+	 *	A summary of the time spent executing
+	 *	a certain handler on behalf of a certain
+	 *	module.
+	 */
+	class ProfileEntry {
+	
+	
+		public:
+		
+		
+			/**
+			 *	What was executed.
+			 */
+			String Name;
+			/**
+			 *	The module which registered the
+			 *	handler, or the empty string if
+			 *	it's not known.
+			 */
+			String Owner;
+			/**
+			 *	The number of times the handler was
+			 *	executed.
+			 */
+			UInt64 Count;
+			/**
+			 *	The total number of nanoseconds spent
+			 *	executing the handler.
+			 */
+			UInt64 Total;
+			/**
+			 *	The largest number of nanoseconds a
+			 *	single execution of the handler took.
+			 */
+			UInt64 Max;
+	
+	
+	};
+	
+	
+	/**
+	 *	Information about a capture which has
+	 *	completed.
+	 */
+	class ProfileCaptureInfo {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The number of spans which were written.
+			 */
+			UInt64 Spans;
+			/**
+			 *	The number of spans which were discarded
+			 *	because a thread's buffer was full.
+			 */
+			UInt64 Dropped;
+	
+	
+	};
+	
+	
+	/**
+	 *	Records how long handlers take to execute,
+	 *	and which module registered them.
+	 *
+	 *	Labels name what's being executed, and are
+	 *	interned so that recording a span does not
+	 *	copy strings.  The label of the module on
+	 *	whose behalf a thread is executing is tracked
+	 *	per thread and captured by handlers as
+	 *	they're registered so that time may be
+	 *	attributed to modules.
+	 *
+	 *	When the profiler is not active recording
+	 *	a span costs a single relaxed atomic load.
+	 */
+	class Profiler {
+	
+	
+		private:
+		
+		
+			static std::atomic<bool> active;
+			static std::atomic<bool> enabled;
+			static std::atomic<bool> capturing;
+			
+			
+			static void update () noexcept;
+		
+		
+		public:
+		
+		
+			/**
+			 *	The label used when no label is
+			 *	known.
+			 */
+			static const Word None=0;
+			/**
+			 *	The label of thread pool tasks.
+			 */
+			static const Word Task=1;
+			/**
+			 *	The label of event subscribers.
+			 */
+			static const Word Subscriber=2;
+			/**
+			 *	The label of ticks.
+			 */
+			static const Word Tick=3;
+			/**
+			 *	The label of callbacks invoked each
+			 *	tick, or after a certain number of
+			 *	ticks.
+			 */
+			static const Word TickCallback=4;
+			
+			
+			/**
+			 *	Determines whether spans are currently
+			 *	being recorded.
+			 *
+			 *	\return
+			 *		\em true if spans are being recorded,
+			 *		\em false otherwise.
+			 */
+			static bool Active () noexcept {
+			
+				return active.load(std::memory_order_relaxed);
+			
+			}
+			
+			
+			/**
+			 *	Retrieves the label associated with a
+			 *	certain name, creating it if necessary.
+			 *
+			 *	Labels are never released, they should
+			 *	be created for names which are drawn from
+			 *	a small set.
+			 *
+			 *	\param [in] name
+			 *		The name.
+			 *
+			 *	\return
+			 *		The label.
+			 */
+			static Word GetLabel (const String & name);
+			/**
+			 *	Retrieves the name associated with a
+			 *	certain label.
+			 *
+			 *	\param [in] label
+			 *		The label.
+			 *
+			 *	\return
+			 *		The name.
+			 */
+			static String GetName (Word label);
+			
+			
+			/**
+			 *	Retrieves the label of the module on
+			 *	whose behalf the calling thread is
+			 *	executing.
+			 *
+			 *	\return
+			 *		A label, or Profiler::None if
+			 *		it's not known.
+			 */
+			static Word GetOwner () noexcept;
+			/**
+			 *	Sets the label of the module on whose
+			 *	behalf the calling thread is executing.
+			 *
+			 *	\param [in] owner
+			 *		A label.
+			 *
+			 *	\return
+			 *		The label which was previously set.
+			 */
+			static Word SetOwner (Word owner) noexcept;
+			
+			
+			/**
+			 *	Retrieves a timestamp suitable for
+			 *	passing to Record.
+			 *
+			 *	\return
+			 *		A number of nanoseconds.
+			 */
+			static UInt64 Now () noexcept;
+			/**
+			 *	Records a span in the calling thread's
+			 *	buffer.
+			 *
+			 *	\param [in] label
+			 *		What was executed.
+			 *	\param [in] owner
+			 *		The module on whose behalf it was
+			 *		executed.
+			 *	\param [in] begin
+			 *		When execution began, as returned by
+			 *		Now.
+			 *	\param [in] end
+			 *		When execution ended, as returned by
+			 *		Now.
+			 */
+			static void Record (Word label, Word owner, UInt64 begin, UInt64 end) noexcept;
+			
+			
+			/**
+			 *	Enables or disables the rolling summary
+			 *	of the slowest handlers.
+			 *
+			 *	\param [in] enable
+			 *		\em true to enable, \em false to
+			 *		disable.
+			 */
+			static void Enable (bool enable) noexcept;
+			/**
+			 *	Determines whether the rolling summary
+			 *	of the slowest handlers is enabled.
+			 *
+			 *	\return
+			 *		\em true if it is enabled, \em false
+			 *		otherwise.
+			 */
+			static bool IsEnabled () noexcept;
+			/**
+			 *	Retrieves the slowest handlers over the
+			 *	last several seconds.
+			 *
+			 *	\param [in] count
+			 *		The maximum number of handlers to
+			 *		retrieve.
+			 *
+			 *	\return
+			 *		Summaries of the slowest handlers,
+			 *		slowest first.
+			 */
+			static Vector<ProfileEntry> GetSlowest (Word count);
+			
+			
+			/**
+			 *	Begins capturing spans.
+			 *
+			 *	\return
+			 *		\em true if capturing began, \em false
+			 *		if a capture is already in progress.
+			 */
+			static bool BeginCapture ();
+			/**
+			 *	Stops capturing spans and writes those
+			 *	captured to a file in the Chrome trace
+			 *	event format.
+			 *
+			 *	\param [in] filename
+			 *		The file to which the trace shall be
+			 *		written.
+			 *
+			 *	\return
+			 *		Information about the capture.
+			 */
+			static ProfileCaptureInfo EndCapture (const String & filename);
+	
+	
+	};
+	
+	
+	/**
+	 *	Records a span from its construction to
+	 *	its destruction, and sets the calling
+	 *	thread's owner for its lifetime.
+	 */
+	class ProfileScope {
+	
+	
+		private:
+		
+		
+			Word label;
+			Word owner;
+			Word previous;
+			UInt64 begin;
+			bool active;
+		
+		
+		public:
+		
+		
+			/**
+			 *	Begins a span.
+			 *
+			 *	\param [in] label
+			 *		What's being executed.
+			 *	\param [in] owner
+			 *		The module on whose behalf it's
+			 *		being executed.
+			 */
+			ProfileScope (Word label, Word owner) noexcept
+				:	label(label),
+					owner(owner),
+					previous(Profiler::SetOwner(owner)),
+					begin(0),
+					active(Profiler::Active())
+			{
+			
+				if (active) begin=Profiler::Now();
+			
+			}
+			
+			
+			/**
+			 *	Ends the span.
+			 */
+			~ProfileScope () noexcept {
+			
+				if (active) Profiler::Record(label,owner,begin,Profiler::Now());
+				
+				Profiler::SetOwner(previous);
+			
+			}
+			
+			
+			ProfileScope (const ProfileScope &) = delete;
+			ProfileScope (ProfileScope &&) = delete;
+			ProfileScope & operator = (const ProfileScope &) = delete;
+			ProfileScope & operator = (ProfileScope &&) = delete;
+	
+	
+	};
+	
+	
+	/**
+	 *	Sets the calling thread's owner for its
+	 *	lifetime, without recording a span.
+	 */
+	class ProfileOwner {
+	
+	
+		private:
+		
+		
+			Word previous;
+		
+		
+		public:
+		
+		
+			/**
+			 *	Sets the calling thread's owner.
+			 *
+			 *	\param [in] owner
+			 *		The module on whose behalf the
+			 *		calling thread is executing.
+			 */
+			ProfileOwner (Word owner) noexcept : previous(Profiler::SetOwner(owner)) {	}
+			
+			
+			/**
+			 *	Restores the calling thread's previous
+			 *	owner.
+			 */
+			~ProfileOwner () noexcept {
+			
+				Profiler::SetOwner(previous);
+			
+			}
+			
+			
+			ProfileOwner (const ProfileOwner &) = delete;
+			ProfileOwner (ProfileOwner &&) = delete;
+			ProfileOwner & operator = (const ProfileOwner &) = delete;
+			ProfileOwner & operator = (ProfileOwner &&) = delete;
+	
+	
+	};
+
+
+}
@@ -7,10 +7,12 @@
 
 
 #include <rleahylib/rleahylib.hpp>
+#include <accept_limiter.hpp>
 #include <chat_provider.hpp>
 #include <command_interpreter.hpp>
 #include <data_provider.hpp>
 #include <event.hpp>
+#include <log_queue.hpp>
 #include <mod_loader.hpp>
 #include <network.hpp>
 #include <packet_router.hpp>
@@ -117,6 +119,7 @@ namespace MCPP {
 		
 			//	Components
 			Nullable<ConnectionHandler> connections;
+			Nullable<AcceptLimiter> limiter;
 			Nullable<ThreadPool> pool;
 			Nullable<ModuleLoader> mods;
 			
@@ -144,6 +147,9 @@ namespace MCPP {
 			std::atomic<bool> verbose_all;
 			mutable RWLock verbose_lock;
 			std::unordered_set<String> verbose;
+			//	Whether log records shall be handed
+			//	off to the logging thread
+			std::atomic<bool> async_log;
 			
 			//	Shutdown synchronization
 			bool is_shutting_down;
@@ -151,6 +157,10 @@ namespace MCPP {
 			CondVar shutdown_wait;
 			
 			
+			//	Asynchronous logging
+			LogQueue logger;
+			
+			
 			//					//
 			//	PRIVATE METHODS	//
 			//					//
@@ -162,6 +172,7 @@ namespace MCPP {
 			void get_binds ();
 			inline void load_mods ();
 			inline void cleanup_events () noexcept;
+			void write_log (const String &, Service::LogType) noexcept;
 			inline void stop_impl ();
 			[[noreturn]]
 			inline void panic_impl (std::exception_ptr except=std::exception_ptr()) noexcept;
@@ -319,6 +330,14 @@ namespace MCPP {
 			 *	disconnecting them.
 			 */
 			Word MaximumBytes;
+			/**
+			 *	When non-zero, packets sent to playing
+			 *	clients whose sends are not tracked are
+			 *	held, and encrypted and sent together
+			 *	at the end of each tick, or once this
+			 *	many bytes are being held for a client.
+			 */
+			Word BatchBytes;
 			/**
 			 *	The maximum number of players which may
 			 *	simultaneously be connected to this
@@ -365,6 +384,14 @@ namespace MCPP {
 			 *		handler.
 			 */
 			ConnectionHandler & Handler ();
+			/**
+			 *	Gets the server's accept limiter.
+			 *
+			 *	\return
+			 *		A reference to the server's accept
+			 *		limiter.
+			 */
+			AcceptLimiter & Limiter ();
 			/**
 			 *	A list of clients connected to the
 			 *	server.
@@ -427,6 +454,69 @@ namespace MCPP {
 			 *		The type of message to log.
 			 */
 			void WriteLog (const String & message, Service::LogType type) noexcept;
+			/**
+			 *	Writes to the log specific to this
+			 *	instance, deferring formatting to
+			 *	the logging thread where possible.
+			 *
+			 *	Prefer this to WriteLog on hot paths,
+			 *	formatting a message is considerably
+			 *	more expensive than capturing its
+			 *	arguments.
+			 *
+			 *	\tparam Args
+			 *		The types of the arguments.
+			 *
+			 *	\param [in] type
+			 *		The type of message to log.
+			 *	\param [in] format
+			 *		The template which shall be passed
+			 *		to String::Format.  Must remain valid
+			 *		until the message has been written,
+			 *		and therefore should have static
+			 *		storage duration.
+			 *	\param [in] args
+			 *		The arguments to format into
+			 *		\em format.
+			 */
+			template <typename... Args>
+			void Log (Service::LogType type, const String & format, Args &&... args) noexcept {
+			
+				if (async_log && (type!=Service::LogType::Critical)) {
+				
+					logger.Enqueue(format,type,std::forward<Args>(args)...);
+					
+					return;
+				
+				}
+				
+				try {
+				
+					write_log(
+						String::Format(
+							format,
+							std::forward<Args>(args)...
+						),
+						type
+					);
+				
+				} catch (...) {	}
+			
+			}
+			/**
+			 *	Blocks until all log messages written
+			 *	before this call have been written out.
+			 */
+			void FlushLog () noexcept;
+			/**
+			 *	Retrieves information about the server's
+			 *	asynchronous logging.
+			 *
+			 *	\return
+			 *		A structure containing information
+			 *		about the log queue.
+			 */
+			LogQueueInfo GetLogInfo () const noexcept;
 			/**
 			 *	Writes to the server's chat log.
 			 *
@@ -642,6 +732,14 @@ namespace MCPP {
 			 *	the connection.
 			 */
 			Event<bool (IPAddress, UInt16, IPAddress, UInt16)> OnAccept;
+			/**
+			 *	Invoked whenever an IP address or range of
+			 *	IP addresses forms connections so quickly
+			 *	that it should be refused outright for a
+			 *	time, passed that range and the number of
+			 *	milliseconds for which it should be refused.
+			 */
+			Event<void (IPAddressRange, Word)> OnAcceptLimit;
 			/**
 			 *	Invoked whenever a connection is accepted
 			 *	into the server, passed the Connection
@@ -170,6 +170,17 @@ namespace MCPP {
 			void Clear (fd_set & set) const noexcept;
 			
 			
+			/**
+			 *	Retrieves the slave end of the control
+			 *	socket, so that it may be waited on by
+			 *	means other than select.
+			 *
+			 *	\return
+			 *		The slave end of the control socket.
+			 */
+			Type Get () const noexcept;
+			
+			
 			/**
 			 *	Sends a message across the control socket.
 			 *
@@ -153,6 +153,12 @@ namespace MCPP {
 				public:
 				
 				
+					//	The module on whose behalf this
+					//	task was enqueued
+					Word Owner;
+					
+					
+					Task () noexcept;
 					virtual ~Task () noexcept;
 					virtual bool operator () () noexcept = 0;
 			
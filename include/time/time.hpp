@@ -106,6 +106,17 @@ namespace MCPP {
 			 *	The current tick length in milliseconds.
 			 */
 			Word Length;
+			/**
+			 *	The length of the most recent tick in
+			 *	milliseconds.
+			 */
+			Word Last;
+			/**
+			 *	The length in milliseconds above which
+			 *	a tick is considered to have taken too
+			 *	long.
+			 */
+			Word Threshold;
 	
 	
 	};
@@ -128,6 +139,12 @@ namespace MCPP {
 				
 					std::function<void (MultiScopeGuard)> callback;
 					bool wait;
+					//	The module which enqueued this
+					//	callback
+					Word owner;
+					
+					
+					static void invoke (const std::function<void (MultiScopeGuard)> &, Word, MultiScopeGuard);
 			
 				
 				public:
@@ -160,6 +177,11 @@ namespace MCPP {
 			std::atomic<UInt64> tick_time;
 			//	Time spent executing ticks
 			std::atomic<UInt64> executing;
+			//	Length of the most recent tick
+			std::atomic<Word> last;
+			//	The label under which ticks are
+			//	profiled
+			Word owner;
 			
 			
 			//	Age of the world
@@ -8,6 +8,7 @@
 
 #include <rleahylib/rleahylib.hpp>
 #include <client.hpp>
+#include <counter_random.hpp>
 #include <event.hpp>
 #include <hash.hpp>
 #include <mod.hpp>
@@ -16,6 +17,8 @@
 #include <cstddef>
 #include <functional>
 #include <initializer_list>
+#include <list>
+#include <map>
 #include <memory>
 #include <new>
 #include <random>
@@ -325,6 +328,22 @@ namespace MCPP {
 			
 			bool operator == (const ColumnID & other) const noexcept;
 			bool operator != (const ColumnID & other) const noexcept;
+			/**
+			 *	Imposes a strict total ordering on
+			 *	column IDs.
+			 *
+			 *	Columns are ordered first by dimension,
+			 *	then by x-coordinate, and finally by
+			 *	z-coordinate.
+			 *
+			 *	\param [in] other
+			 *		The column ID to compare against.
+			 *
+			 *	\return
+			 *		\em true if this column ID orders
+			 *		before \em other, \em false otherwise.
+			 */
+			bool operator < (const ColumnID & other) const noexcept;
 			
 			
 			/**
@@ -700,6 +719,140 @@ namespace MCPP {
 	};
 	
 	
+	//	How the memory columns are stored in
+	//	is backed by huge pages
+	enum class HugePages {
+	
+		//	Ordinary pages only
+		None,
+		//	The operating system is advised to
+		//	back column storage with huge pages
+		//	when it can
+		Transparent,
+		//	Column storage is allocated from
+		//	reserved huge pages, falling back to
+		//	ordinary pages if none are available
+		Explicit
+	
+	};
+	
+	
+	//	Allocates memory for columns.
+	//
+	//	Memory is obtained from the operating
+	//	system in slabs of several columns, and
+	//	memory freed by unloaded columns is kept
+	//	and reused rather than being returned.
+	class ColumnAllocator {
+	
+	
+		private:
+		
+		
+			//	A slot which is not in use holds
+			//	a pointer to the next such slot
+			class FreeSlot {
+			
+			
+				public:
+				
+				
+					FreeSlot * Next;
+			
+			
+			};
+			
+			
+			//	Holds a thread's scratch slot, and
+			//	returns it when the thread exits
+			class ScratchSlot;
+			
+			
+			HugePages huge;
+			FreeSlot * free;
+			Word free_count;
+			Word in_use;
+			//	Slabs are never returned to the
+			//	operating system
+			Word slabs;
+			Word bytes;
+			mutable Mutex lock;
+			
+			
+			void grow ();
+			//	Take a slot from and return a slot
+			//	to the free list, the lock must be
+			//	held
+			void * take ();
+			void give (void *) noexcept;
+		
+		
+		public:
+		
+		
+			//	The number of bytes in each slot
+			static const Word SlotSize;
+			//	The least number of slots in each slab,
+			//	slabs hold as many more as fit in the
+			//	pages they are rounded up to
+			static const Word SlabSlots;
+		
+		
+			//	Retrieves the allocator from which
+			//	all columns are allocated.
+			//
+			//	It is never destroyed, so that columns
+			//	may safely be freed at any point during
+			//	shutdown.
+			static ColumnAllocator & Get ();
+			
+			
+			ColumnAllocator () noexcept;
+			
+			
+			ColumnAllocator (const ColumnAllocator &) = delete;
+			ColumnAllocator (ColumnAllocator &&) = delete;
+			ColumnAllocator & operator = (const ColumnAllocator &) = delete;
+			ColumnAllocator & operator = (ColumnAllocator &&) = delete;
+			
+			
+			//	Sets how slabs obtained from this point
+			//	forward are backed by huge pages, and
+			//	ensures there are at least a certain
+			//	number of free slots
+			void Configure (HugePages, Word);
+			//	Retrieves a slot large enough to hold
+			//	a ColumnContainer, throws std::bad_alloc
+			//	if one could not be obtained
+			void * Allocate ();
+			//	Returns a slot to the allocator
+			void Free (void *) noexcept;
+			//	Retrieves a slot which belongs to the
+			//	calling thread, for columns to be copied
+			//	into when they are saved and loaded.
+			//
+			//	The same slot is returned each time it is
+			//	called on a given thread, and it is not
+			//	counted as in use.  It is returned to the
+			//	allocator when the thread exits.
+			void * Scratch ();
+			
+			
+			//	The number of slots in use
+			Word InUse () const noexcept;
+			//	The number of slots not in use
+			Word Available () const noexcept;
+			//	The number of slabs obtained from the
+			//	operating system
+			Word Slabs () const noexcept;
+			//	The number of bytes obtained from the
+			//	operating system
+			Word Bytes () const noexcept;
+	
+	
+	};
+	
+	
 	class ColumnContainer {
 	
 		
@@ -713,16 +866,34 @@ namespace MCPP {
 			//	Creates a ColumnContainer with a given id
 			//	and in the loading state
 			ColumnContainer (ColumnID) noexcept;
+			
+			
+			//	Columns are allocated from the
+			//	ColumnAllocator
+			static void * operator new (std::size_t);
+			static void operator delete (void *) noexcept;
 		
 		
 			//	The layout of the proceeding
-			//	three fields is identical to
+			//	six fields is identical to
 			//	the layout in which they will
 			//	be saved to the backing store,
 			//	this removes the need for any
 			//	sort of copying
 			Block Blocks [16*16*16*16];
 			Biome Biomes [16*16];
+			//	The number of non-air blocks in
+			//	each section, from bottom to top
+			UInt16 Occupancy [16];
+			//	The number of blocks in each section
+			//	whose type does not fit in a single
+			//	byte, from bottom to top
+			UInt16 Extended [16];
+			//	The Y co-ordinate of the highest
+			//	non-air block in each vertical
+			//	shaft of blocks, or zero if there
+			//	are none, indexed by X+(Z*16)
+			Byte Heightmap [16*16];
 			bool Populated;
 			
 			
@@ -730,7 +901,14 @@ namespace MCPP {
 			//	within each column container
 			//	which should be saved and
 			//	loaded
-			static constexpr Word Size=sizeof(Populated)+sizeof(Blocks)+sizeof(Biomes);
+			static constexpr Word Size=sizeof(Blocks)+sizeof(Biomes)+sizeof(Occupancy)+sizeof(Extended)+sizeof(Heightmap)+sizeof(Populated);
+			//	The size of columns saved before
+			//	occupancy and heights were saved
+			//	alongside blocks
+			static constexpr Word LegacySize=sizeof(Blocks)+sizeof(Biomes)+sizeof(Populated);
+			//	The largest number of bytes ToRaw
+			//	may write
+			static constexpr Word MaxRawSize=(16*16*16*16*3)+(16*16);
 			
 			
 			//	Retrieves the ID of this column
@@ -741,6 +919,21 @@ namespace MCPP {
 			//	Retrieves a 0x33 packet which unloads
 			//	the contained column from a client
 			PacketType GetUnload () const;
+			//	Writes the contained column in the
+			//	format in which it's sent to clients,
+			//	without compressing it, and retrieves
+			//	the masks of the sections written.
+			//
+			//	Returns the number of bytes written,
+			//	which is at most MaxRawSize.
+			//
+			//	Not thread safe.
+			Word ToRaw (Byte *, UInt16 &, UInt16 &) const noexcept;
+			//	Determines how many bytes ToRaw
+			//	would write.
+			//
+			//	Not thread safe.
+			Word RawSize () const noexcept;
 			//	Checks the column's state.
 			//
 			//	If the column is in the required state, or
@@ -796,6 +989,14 @@ namespace MCPP {
 			bool Check (ColumnState) noexcept;
 			//	Retrieves the column's current state
 			ColumnState GetState () const noexcept;
+			//	Determines whether the column's light
+			//	has been calculated, and therefore
+			//	whether light may be propagated into
+			//	and out of it
+			bool Lit () const noexcept;
+			//	Marks the column's light as having
+			//	been calculated
+			void SetLit () noexcept;
 			//	Sends the column to all currently
 			//	added clients
 			//
@@ -804,6 +1005,27 @@ namespace MCPP {
 			void Send ();
 			//	Adds a player to this column.
 			void AddPlayer (SmartPointer<Client>);
+			//	Adds a player to this column without
+			//	sending the column to them, the caller
+			//	is responsible for sending it, and then
+			//	calling Sent.  Until then block changes
+			//	and removals are held back, so that they
+			//	do not reach the player before the column.
+			//
+			//	Returns false if the player had already
+			//	been added.
+			//
+			//	Not thread safe.
+			bool Attach (SmartPointer<Client>);
+			//	Called once the column has been sent to
+			//	a player it was attached to, sends them
+			//	whatever was held back in the meantime
+			void Sent (SmartPointer<Client>);
+			//	Sends the column again to every player
+			//	it has been sent to, after something
+			//	clients do not calculate themselves,
+			//	such as light, has changed
+			void Resend ();
 			//	Removes a player from this column.
 			//
 			//	Boolean indicates whether or not
@@ -826,10 +1048,59 @@ namespace MCPP {
 			//	Not thread safe.
 			bool CanUnload () const noexcept;
 			//	Sets a block within this column, sending
-			//	the appropriate packet
-			void SetBlock (BlockID, Block);
+			//	the appropriate packet.
+			//
+			//	Unless the boolean is true, which means
+			//	that the caller owns the column, waits
+			//	until no other thread owns the column.
+			void SetBlock (BlockID, Block, bool);
 			//	Gets a block within this column
 			Block GetBlock (BlockID) const noexcept;
+			//	Gets the Y co-ordinate of the highest
+			//	non-air block within this column
+			//	at the given X and Z co-ordinates
+			Byte GetHeight (Int32, Int32) const noexcept;
+			//	Recalculates occupancy, extended counts,
+			//	and heights from the column's blocks.
+			//
+			//	Should be invoked after blocks have been
+			//	written without SetBlock.
+			//
+			//	Not thread safe.
+			void Recalculate () noexcept;
+			//	Loads a column saved before occupancy
+			//	and heights were saved alongside blocks.
+			//
+			//	Not thread safe.
+			void LoadLegacy (const void *) noexcept;
+			//	Attempts to acquire write ownership
+			//	of the column on behalf of a transaction.
+			//
+			//	If the column is already owned and the
+			//	boolean is true, blocks until ownership
+			//	is relinquished, otherwise returns false
+			//	at once.
+			//
+			//	Throws std::logic_error if the column is
+			//	owned by the calling thread, since waiting
+			//	would never end.
+			//
+			//	Returns true if ownership was acquired.
+			bool AcquireWrite (bool);
+			//	Relinquishes write ownership of the
+			//	column, waking any threads waiting
+			//	for it
+			void ReleaseWrite () noexcept;
+			//	Acquires the right to propagate light
+			//	into and out of the column.  If the
+			//	argument is true blocks until no one
+			//	else is, otherwise fails at once.
+			//
+			//	Returns true if the right was acquired.
+			bool AcquireLight (bool) noexcept;
+			//	Relinquishes the right to propagate
+			//	light into and out of the column
+			void ReleaseLight () noexcept;
 			//	Acquires the column's internal lock
 			void Acquire () const noexcept;
 			//	Release the column's internal lock
@@ -876,9 +1147,39 @@ namespace MCPP {
 			//	Asynchronous callbacks waiting on a
 			//	change of state
 			Vector<Tuple<ColumnState,std::function<void ()>>> pending;
+			//	What is held back from a client to
+			//	which the column has been attached,
+			//	but not yet sent
+			class Unsent {
+			
+			
+				public:
+				
+				
+					Vector<Packets::Play::Clientbound::BlockChange> Changes;
+					//	The client was removed, and, if
+					//	Unload is set, must be sent an
+					//	unload once the column is sent
+					bool Removed;
+					bool Unload;
+					//	The client was removed and added
+					//	again, it must be sent the column
+					//	as it is now
+					bool Resend;
+					
+					
+					Unsent () noexcept;
+			
+			
+			};
+			
+			
 			//	All clients who have or want this
 			//	column
 			std::unordered_set<SmartPointer<Client>> clients;
+			//	Clients to which the column has been
+			//	attached but not yet sent
+			std::unordered_map<SmartPointer<Client>,Unsent> unsent;
 			//	The "interest" count.
 			//
 			//	So long as there is "interest" in
@@ -890,6 +1191,26 @@ namespace MCPP {
 			//	Whether this column has been modified
 			//	since it was last saved
 			bool dirty;
+			//	The thread whose handle currently
+			//	owns this column for writing, if
+			//	any
+			Nullable<decltype(Thread::ID())> owner;
+			//	The number of threads waiting for
+			//	ownership, or the right to propagate
+			//	light, to be relinquished
+			Word waiting;
+			//	Whether light is being propagated
+			//	into and out of this column
+			bool lighting;
+			//	Whether the column's light has been
+			//	calculated
+			std::atomic<bool> lit;
+			
+			
+			//	Finds the highest non-air block in
+			//	a shaft, beginning from a certain
+			//	height
+			Byte get_height (Word, Byte) const noexcept;
 		
 	
 	};
@@ -913,11 +1234,19 @@ namespace MCPP {
 		(
 			offsetof(
 				ColumnContainer,
-				Populated
+				Occupancy
 			)==(
 				(16*16*16*16*sizeof(Block))+(16*16*sizeof(Byte))
 			)
 		) &&
+		(
+			offsetof(
+				ColumnContainer,
+				Populated
+			)==(
+				(16*16*16*16*sizeof(Block))+(16*16*sizeof(Byte))+(16*2*sizeof(UInt16))+(16*16*sizeof(Byte))
+			)
+		) &&
 		(sizeof(bool)==sizeof(Byte)),
 		"ColumnContainer layout incorrect"
 	);
@@ -936,6 +1265,37 @@ namespace MCPP {
 	 */
 	enum class BlockWriteStrategy {
 
+		/**
+		 *	The state of each column the handle
+		 *	reads from or writes to is guaranteed
+		 *	not to change after the handle first
+		 *	accesses it.  Other threads may read
+		 *	from those columns, but may not write
+		 *	to them.  Columns the handle has not
+		 *	accessed may be freely written by other
+		 *	threads.
+		 *
+		 *	To avoid deadlock, a handle only waits
+		 *	for a column held by another handle if
+		 *	that column orders after every column
+		 *	the handle already holds.  Otherwise the
+		 *	handle relinquishes every column it holds,
+		 *	and waits for them all, and the column it
+		 *	touched, in order, before the read or write
+		 *	proceeds.  Columns the handle relinquished
+		 *	may have been written in the meantime,
+		 *	which WorldHandle::Reacquired reveals.
+		 *	Handles which must touch several columns
+		 *	should acquire them up front with
+		 *	WorldHandle::Acquire, which never
+		 *	relinquishes them.
+		 *
+		 *	Touching a column which another handle
+		 *	on the same thread owns throws
+		 *	std::logic_error, since waiting for it
+		 *	would never end.
+		 */
+		Transactional,
 		/**
 		 *	The world's state is guaranteed
 		 *	not to change after the handle
@@ -943,7 +1303,7 @@ namespace MCPP {
 		 *	read from the world, but may not
 		 *	write to it.
 		 */
-		Transactional,
+		Exclusive,
 		/**
 		 *	Other threads may write to and
 		 *	read from the world at any time,
@@ -951,6 +1311,10 @@ namespace MCPP {
 		 *	to be thread safe, however no
 		 *	operations are guaranteed to be
 		 *	atomic.
+		 *
+		 *	Writes wait for transactional handles
+		 *	on other threads which own the column
+		 *	being written to.
 		 */
 		Dirty
 
@@ -1060,9 +1424,18 @@ namespace MCPP {
 			//	moved
 			mutable World * world;
 			//	True if this handle holds the
-			//	world lock, and write operations
-			//	may proceed seamlessly
+			//	world lock exclusively, and write
+			//	operations may proceed seamlessly
 			mutable bool locked;
+			//	True if this handle holds the
+			//	world lock shared, and write
+			//	operations must acquire ownership
+			//	of the columns they touch
+			mutable bool shared;
+			//	Columns this handle currently owns
+			//	for writing, ordered so that the last
+			//	is the greatest
+			mutable std::map<ColumnID,ColumnContainer *> held;
 			//	A pointer to the last column
 			//	that this handle accessed, for
 			//	caching reasons
@@ -1071,6 +1444,10 @@ namespace MCPP {
 			//	handle is being used for
 			//	population.
 			mutable Word populate;
+			//	The number of times this handle
+			//	relinquished and reacquired the
+			//	columns it owns
+			mutable Word reacquired;
 			
 			
 			WorldHandle (World *, BlockWriteStrategy, BlockAccessStrategy);
@@ -1082,6 +1459,9 @@ namespace MCPP {
 			inline ColumnContainer * get_column_impl (ColumnID) const;
 			inline ColumnContainer * get_column (ColumnID, bool) const;
 			inline bool set_impl (ColumnContainer *, BlockID, Block, bool) const;
+			inline bool own (ColumnContainer *, bool) const;
+			inline void acquire (ColumnContainer *) const;
+			inline void release () const noexcept;
 			
 			
 		public:
@@ -1152,16 +1532,47 @@ namespace MCPP {
 			Nullable<Block> Get (BlockID id, std::nothrow_t no_throw) const;
 			
 			
+			/**
+			 *	Acquires ownership of a rectangular
+			 *	region of columns.
+			 *
+			 *	Columns are acquired in order, which
+			 *	means that a transactional handle which
+			 *	acquires every column it will touch
+			 *	through a single call to this function
+			 *	before touching any other column is
+			 *	guaranteed never to relinquish a column
+			 *	it owns.
+			 *
+			 *	Has no effect on handles which do not
+			 *	use BlockWriteStrategy::Transactional.
+			 *
+			 *	\exception std::invalid_argument
+			 *		Thrown if \em a and \em b are not
+			 *		in the same dimension.
+			 *
+			 *	\param [in] a
+			 *		One corner of the region.
+			 *	\param [in] b
+			 *		The opposite corner of the region.
+			 *		Must be in the same dimension as
+			 *		\em a.
+			 *
+			 *	\return
+			 *		\em true if all columns in the region
+			 *		were acquired, \em false if a column
+			 *		could not be retrieved.
+			 */
+			bool Acquire (ColumnID a, ColumnID b) const;
+			
+			
 			/**
 			 *	Determines whether this handle currently
 			 *	has exclusive access to the world.
 			 *
-			 *	If the return value of this function is
-			 *	\em false, and no other handles are held
-			 *	by the current thread, attempting to
-			 *	acquire a transactional handle, or attempting
-			 *	to write through a different handle is
-			 *	guaranteed not to deadlock.
+			 *	Only handles which use
+			 *	BlockWriteStrategy::Exclusive have
+			 *	exclusive access to the world.
 			 *
 			 *	\return
 			 *		\em true if this world handle currently
@@ -1169,6 +1580,45 @@ namespace MCPP {
 			 *		\em false otherwise.
 			 */
 			bool Exclusive () const noexcept;
+			/**
+			 *	Determines whether this handle currently
+			 *	holds a lock on the world, or owns any
+			 *	columns.
+			 *
+			 *	If the return value of this function is
+			 *	\em false, and no other handles are held
+			 *	by the current thread, attempting to
+			 *	acquire a transactional or exclusive handle,
+			 *	or attempting to write through a different
+			 *	handle is guaranteed not to deadlock.
+			 *
+			 *	\return
+			 *		\em true if this world handle currently
+			 *		holds a lock on the world or owns
+			 *		columns, \em false otherwise.
+			 */
+			bool Locked () const noexcept;
+			/**
+			 *	Determines how many times this handle
+			 *	has relinquished the columns it owns to
+			 *	avoid deadlock.
+			 *
+			 *	A transactional handle which touches a
+			 *	column owned by another handle, which
+			 *	orders before a column it already owns,
+			 *	relinquishes and reacquires every column
+			 *	it owns.  Those columns may have been
+			 *	written in between.  A transaction which
+			 *	depends on blocks it read earlier may
+			 *	compare this value before and after
+			 *	touching a column, and start over if
+			 *	it changed.
+			 *
+			 *	\return
+			 *		The number of times this handle
+			 *		relinquished the columns it owns.
+			 */
+			Word Reacquired () const noexcept;
 	
 	
 	};
@@ -1324,6 +1774,66 @@ namespace MCPP {
 			UInt64 Populating;
 			
 			
+			/**
+			 *	The number of times a column has been
+			 *	lit.
+			 */
+			Word Lit;
+			/**
+			 *	The number of times a section has been
+			 *	relit after blocks within it changed.
+			 */
+			Word Relit;
+			/**
+			 *	The amount of time spent lighting
+			 *	columns and relighting sections.
+			 */
+			UInt64 Lighting;
+			/**
+			 *	The number of block changes waiting
+			 *	to be relit.
+			 */
+			Word LightQueue;
+			
+			
+			/**
+			 *	The number of times a column being
+			 *	loaded was found in the cache of
+			 *	recently unloaded columns.
+			 */
+			Word CacheHits;
+			/**
+			 *	The number of times a column being
+			 *	loaded was not found in the cache of
+			 *	recently unloaded columns.
+			 */
+			Word CacheMisses;
+			/**
+			 *	The number of columns which have been
+			 *	evicted from the cache of recently
+			 *	unloaded columns to keep it within
+			 *	its budget.
+			 */
+			Word CacheEvictions;
+			/**
+			 *	The number of columns in the cache of
+			 *	recently unloaded columns.
+			 */
+			Word CacheCount;
+			/**
+			 *	The number of bytes of compressed column
+			 *	data in the cache of recently unloaded
+			 *	columns.
+			 */
+			Word CacheSize;
+			/**
+			 *	The most bytes of compressed column data
+			 *	the cache of recently unloaded columns
+			 *	may hold.
+			 */
+			Word CacheMax;
+			
+			
 			/**
 			 *	The number of currently loaded
 			 *	columns.
@@ -1334,6 +1844,23 @@ namespace MCPP {
 			 *	used to hold raw column data.
 			 */
 			Word Size;
+			/**
+			 *	The number of column-sized slots of
+			 *	memory which are not in use.
+			 */
+			Word Free;
+			/**
+			 *	The number of slabs of memory which
+			 *	have been obtained from the operating
+			 *	system to store columns.
+			 */
+			Word Slabs;
+			/**
+			 *	The number of bytes of memory which
+			 *	have been obtained from the operating
+			 *	system to store columns.
+			 */
+			Word Storage;
 	
 	
 	};
@@ -1406,6 +1933,29 @@ namespace MCPP {
 			//	How often (in milliseconds)
 			//	maintenance should be performed
 			Word maintenance_interval;
+			//	How long (in milliseconds) block
+			//	changes are batched before being
+			//	relit
+			Word light_delay;
+			//	The most uncompressed bytes of column
+			//	data which are sent to a client in a
+			//	single packet
+			Word bulk_max;
+			//	How long (in milliseconds) columns
+			//	which become ready are batched before
+			//	being sent, while more columns are
+			//	being made ready for the same client
+			Word bulk_delay;
+			//	The most bytes of compressed column
+			//	data which are kept for recently
+			//	unloaded columns
+			Word cache_max;
+			//	The codec columns are saved with
+			const Codec * codec;
+			//	Codecs columns may have been saved
+			//	with
+			std::unique_ptr<ZlibCodec> zlib_codec;
+			std::unique_ptr<ZstdCodec> zstd_codec;
 			
 			
 			//	STATISTICS
@@ -1443,6 +1993,24 @@ namespace MCPP {
 			//	Number of nanoseconds spent populating
 			//	columns
 			std::atomic<UInt64> populate_time;
+			//	Number of times a column has been
+			//	lit
+			std::atomic<Word> lit;
+			//	Number of times a section has been
+			//	relit
+			std::atomic<Word> relit;
+			//	Number of nanoseconds spent lighting
+			//	and relighting
+			std::atomic<UInt64> light_time;
+			//	Number of times a column was loaded
+			//	from the cache
+			std::atomic<Word> cache_hits;
+			//	Number of times a column was not
+			//	in the cache when loaded
+			std::atomic<Word> cache_misses;
+			//	Number of columns evicted from the
+			//	cache
+			std::atomic<Word> cache_evictions;
 		
 		
 			//	Contains loaded world generators
@@ -1475,7 +2043,13 @@ namespace MCPP {
 			
 			
 			//	World lock
-			Mutex wlock;
+			//
+			//	Exclusive handles hold this
+			//	for writing, all other writers
+			//	hold it for reading and then
+			//	take ownership of individual
+			//	columns
+			RWLock wlock;
 			
 			
 			//	Only one thread is allowed to
@@ -1492,6 +2066,73 @@ namespace MCPP {
 				std::unordered_set<ColumnID>
 			> clients;
 			Mutex clients_lock;
+			
+			
+			//	Block changes which have not yet
+			//	been relit, grouped by column
+			std::unordered_map<
+				ColumnID,
+				Vector<Word>
+			> light_pending;
+			//	The number of block changes which
+			//	have not yet been relit
+			Word light_count;
+			//	Whether a relight has been scheduled
+			bool light_scheduled;
+			mutable Mutex light_lock;
+			
+			
+			//	The columns which are ready to be
+			//	sent to a client, each holds interest
+			//	in its column
+			class BulkPending {
+			
+			
+				public:
+				
+				
+					Vector<ColumnContainer *> Columns;
+					//	The uncompressed size of the
+					//	columns
+					Word Bytes;
+					//	The number of columns which have
+					//	been added to the client but are
+					//	not yet ready
+					Word Outstanding;
+					
+					
+					BulkPending () noexcept;
+			
+			
+			};
+			
+			
+			std::unordered_map<
+				SmartPointer<Client>,
+				BulkPending
+			> bulk_pending;
+			//	Whether a delayed send, and whether
+			//	an immediate send, have been scheduled
+			bool bulk_scheduled;
+			bool bulk_immediate;
+			Mutex bulk_lock;
+			
+			
+			//	Compressed copies of recently unloaded
+			//	columns, and the order in which they
+			//	were used, most recent first
+			std::unordered_map<
+				ColumnID,
+				Tuple<
+					Vector<Byte>,
+					std::list<ColumnID>::iterator
+				>
+			> cache;
+			std::list<ColumnID> cache_order;
+			//	The number of bytes of compressed
+			//	data in the cache
+			Word cache_size;
+			mutable Mutex cache_lock;
 		
 		
 			//	PRIVATE METHODS
@@ -1509,8 +2150,51 @@ namespace MCPP {
 			//	Returns the state the column is
 			//	in after being loaded.
 			ColumnState load (ColumnContainer &);
+			//	Retrieves the codec with a certain
+			//	ID, throwing if there is no such
+			//	codec
+			const Codec & get_codec (Byte) const;
 			//	Populates a column
 			void populate (ColumnContainer &, const WorldHandle *);
+			//	Keeps a compressed copy of a column
+			//	which has been unloaded, evicting the
+			//	least recently used copies as necessary
+			void cache (ColumnContainer &);
+			//	Attempts to load a column from the
+			//	cache, removing it from the cache.
+			//
+			//	Returns true if the column was loaded.
+			bool uncache (ColumnContainer &);
+			//	Calculates a column's light, and
+			//	exchanges light with its lit neighbours,
+			//	resending those whose light changed
+			void light (ColumnContainer &);
+			//	Queues a block change within a column
+			//	to be relit, if the blocks before and
+			//	after the change affect light differently
+			void enqueue_light (ColumnContainer &, BlockID, Block, Block);
+			//	Relights all queued block changes,
+			//	one pass per affected section
+			void relight ();
+			//	Queues a column, in which the caller has
+			//	expressed interest, to be sent to a
+			//	client.  The interest is ended once the
+			//	column is sent.
+			void enqueue_bulk (SmartPointer<Client>, ColumnContainer *);
+			//	Sends queued columns, as few packets
+			//	per client as possible.
+			//
+			//	If the boolean is false only the columns
+			//	of clients for which no more columns are
+			//	being made ready, or which have a full
+			//	packet's worth, are sent.
+			void flush_bulk (bool);
+			//	Retrieves a column and the eight columns
+			//	surrounding it, expressing interest in
+			//	each of the latter.  Surrounding columns
+			//	which are not loaded or have not been lit
+			//	are null.
+			void get_neighbours (ColumnContainer &, ColumnContainer ** columns);
 			//	Does maintenance work -- scans and
 			//	saves all columns, unloads columns
 			//	that are inactive.
@@ -1680,7 +2364,10 @@ namespace MCPP {
 			 *
 			 *	The column will be loaded, populated, and/or
 			 *	generated as necessary, after which the
-			 *	column will be sent to the client-in-question.
+			 *	column will be sent to the client-in-question
+			 *	together with any other columns which become
+			 *	ready to be sent to that client shortly
+			 *	thereafter.
 			 *
 			 *	The column will not be unloaded until this
 			 *	client is removed from it.
@@ -1697,7 +2384,7 @@ namespace MCPP {
 			 *		indeterminate point in the future.  If \em false
 			 *		the method will block in the aforementioned situation
 			 *		until the column has been prepared by the
-			 *		other thread and sent.  Defaults to \em false.
+			 *		other thread.  Defaults to \em false.
 			 */
 			void Add (SmartPointer<Client> client, ColumnID id, bool async=false);
 			/**
@@ -1741,20 +2428,93 @@ namespace MCPP {
 			 *		The world's seed.
 			 */
 			UInt64 Seed () const noexcept;
+			/**
+			 *	Retrieves a random number generator
+			 *	keyed by the world's seed.
+			 *
+			 *	\return
+			 *		A random number generator.
+			 */
+			CounterRandom GetRandom () const noexcept {
+			
+				return CounterRandom(seed);
+			
+			}
+			/**
+			 *	Retrieves a random number generator
+			 *	keyed by the world's seed and a column
+			 *	ID.
+			 *
+			 *	The generator is cheap to create, and
+			 *	may be retrieved each time it is needed.
+			 *
+			 *	\param [in] id
+			 *		A column ID to use to key the random
+			 *		number generator.
+			 *
+			 *	\return
+			 *		A random number generator.
+			 */
+			CounterRandom GetRandom (ColumnID id) const noexcept {
+			
+				union {
+					UInt32 out;
+					Int32 in;
+				};
+				
+				in=id.X;
+				UInt64 coords=out;
+				in=id.Z;
+				coords|=static_cast<UInt64>(out)<<32;
+				
+				union {
+					Byte out_b;
+					SByte in_b;
+				};
+				
+				in_b=id.Dimension;
+				
+				return GetRandom().Branch(coords).Branch(out_b);
+			
+			}
+			/**
+			 *	Retrieves a random number generator
+			 *	keyed by the world's seed, a column ID,
+			 *	and a feature within that column.
+			 *
+			 *	Each feature receives a stream of random
+			 *	numbers which is independent of the
+			 *	streams of other features, so that
+			 *	adding, removing, or reordering features
+			 *	does not change the others.
+			 *
+			 *	\param [in] id
+			 *		A column ID to use to key the random
+			 *		number generator.
+			 *	\param [in] feature
+			 *		A value which identifies the feature.
+			 *
+			 *	\return
+			 *		A random number generator.
+			 */
+			CounterRandom GetRandom (ColumnID id, UInt64 feature) const noexcept {
+			
+				return GetRandom(id).Branch(feature);
+			
+			}
 			/**
 			 *	Retrieves a random number generator
 			 *	seeded by the world's seed.
 			 *
 			 *	\tparam T
 			 *		The type of random number generator
-			 *		to create and seed.  Defaults to
-			 *		std::mt19937.
+			 *		to create and seed.
 			 *
 			 *	\return
 			 *		A seeded random number generator of
 			 *		type \em T.
 			 */
-			template <typename T=std::mt19937>
+			template <typename T>
 			T GetRandom () const noexcept(
 				std::is_nothrow_constructible<
 					std::seed_seq,
@@ -1776,10 +2536,15 @@ namespace MCPP {
 			 *	seeded by the world's seed and a
 			 *	column ID.
 			 *
+			 *	Generators with a large internal state
+			 *	(such as std::mt19937) are expensive to
+			 *	seed.  Prefer the overloads which return
+			 *	a CounterRandom when a generator is
+			 *	needed for each column.
+			 *
 			 *	\tparam T
 			 *		The type of random number generator
-			 *		to create and seed.  Defaults to
-			 *		std::mt19937.
+			 *		to create and seed.
 			 *
 			 *	\param [in] id
 			 *		A column ID to use to seed the random
@@ -1789,7 +2554,7 @@ namespace MCPP {
 			 *		A seeded random number generator of
 			 *		type \em T.
 			 */
-			template <typename T=std::mt19937>
+			template <typename T>
 			T GetRandom (ColumnID id) const noexcept(
 				std::is_nothrow_constructible<
 					std::seed_seq,
@@ -1801,33 +2566,12 @@ namespace MCPP {
 				>::value
 			) {
 			
-				Word seed=23;
-				seed*=31;
-				seed+=this->seed;
+				UInt64 key=GetRandom(id)();
 				
-				union {
-					UInt32 out;
-					Int32 in;
-				};
-				
-				in=id.X;
-				seed*=31;
-				seed+=out;
-				
-				in=id.Z;
-				seed*=31;
-				seed+=out;
-				
-				union {
-					Byte out_b;
-					SByte in_b;
-				};
-				
-				in_b=id.Dimension;
-				seed*=31;
-				seed+=out_b;
-				
-				std::seed_seq seq({seed});
+				std::seed_seq seq({
+					static_cast<Word>(key),
+					static_cast<Word>(key>>32)
+				});
 				
 				return T(seq);
 			
@@ -1874,6 +2618,46 @@ namespace MCPP {
 			 *		The column in which to end interest.
 			 */
 			void EndInterest (ColumnID id) noexcept;
+			/**
+			 *	Saves certain columns to the backing store
+			 *	at once, rather than waiting for them to be
+			 *	saved during maintenance.
+			 *
+			 *	Columns which are not loaded, or which have
+			 *	not changed since they were last saved, are
+			 *	not saved.
+			 *
+			 *	\param [in] ids
+			 *		The columns to save.
+			 *
+			 *	\return
+			 *		The number of columns which were saved.
+			 */
+			Word Save (const Vector<ColumnID> & ids);
+			
+			
+			/**
+			 *	Retrieves the Y co-ordinate of the highest
+			 *	non-air block at certain co-ordinates.
+			 *
+			 *	The column containing the co-ordinates is
+			 *	not loaded or generated, callers which need
+			 *	it to be should express interest in it first.
+			 *
+			 *	\param [in] x
+			 *		The X co-ordinate.
+			 *	\param [in] z
+			 *		The Z co-ordinate.
+			 *	\param [in] dimension
+			 *		The dimension.
+			 *
+			 *	\return
+			 *		The Y co-ordinate of the highest non-air
+			 *		block, or null if the column containing
+			 *		\em x and \em z has not been loaded and
+			 *		populated.
+			 */
+			Nullable<Byte> GetHeight (Int32 x, Int32 z, SByte dimension);
 			
 			
 			/**
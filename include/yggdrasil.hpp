@@ -7,11 +7,14 @@
 
 
 #include <rleahylib/rleahylib.hpp>
+#include <hash.hpp>
 #include <http_handler.hpp>
 #include <json.hpp>
 #include <promise.hpp>
+#include <atomic>
 #include <exception>
 #include <type_traits>
+#include <unordered_map>
 
 
 namespace Yggdrasil {
@@ -234,6 +237,66 @@ namespace Yggdrasil {
 	};
 
 
+	/**
+	 *	A range of latencies.
+	 */
+	class LatencyBucket {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The greatest latency, in milliseconds,
+			 *	which falls within this range.
+			 */
+			Word Maximum;
+			/**
+			 *	The number of requests whose latency
+			 *	fell within this range.
+			 */
+			UInt64 Count;
+	
+	
+	};
+	
+	
+	/**
+	 *	Contains information about the session
+	 *	verifications a client has performed.
+	 */
+	class SessionInfo {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The number of verifications which were
+			 *	sent to the session server.
+			 */
+			UInt64 Requests;
+			/**
+			 *	The number of verifications which were
+			 *	answered by an identical verification
+			 *	already in progress.
+			 */
+			UInt64 Coalesced;
+			/**
+			 *	The number of verifications which were
+			 *	answered from recently verified sessions.
+			 */
+			UInt64 Cached;
+			/**
+			 *	The latency of requests to the session
+			 *	server, in ascending order of latency.
+			 */
+			Vector<LatencyBucket> Latency;
+	
+	
+	};
+	
+	
 	/**
 	 *	Processes asynchronous requests to the Yggdrasil
 	 *	HTTP API.
@@ -244,9 +307,60 @@ namespace Yggdrasil {
 		private:
 		
 		
+			typedef Tuple<String,String> SessionKey;
+			typedef Tuple<String,IPAddress> VerifiedKey;
+			
+			
+			class VerifiedSession {
+			
+			
+				public:
+				
+				
+					String UUID;
+					UInt64 Expires;
+			
+			
+			};
+			
+			
+			//	Session verifications in progress
+			//	keyed on username and server hash,
+			//	with the promises waiting on each
+			//
+			//	This and everything else below must
+			//	outlive the HTTP handler, which
+			//	completes requests in progress as it
+			//	shuts down
+			mutable Mutex sessions_lock;
+			std::unordered_map<
+				SessionKey,
+				Vector<Promise<String>>
+			> sessions;
+			//	Sessions which were verified recently
+			//	keyed on username and IP address, times
+			//	are in milliseconds since clock started
+			mutable Mutex verified_lock;
+			std::unordered_map<VerifiedKey,VerifiedSession> verified;
+			Word verified_max;
+			Word verified_time;
+			Timer clock;
+			//	Statistics
+			std::atomic<UInt64> requests;
+			std::atomic<UInt64> coalesced;
+			std::atomic<UInt64> cached;
+			std::atomic<UInt64> latency [8];
+			
+			
 			MCPP::HTTPHandler http;
 			
 			
+			Nullable<String> recall (const VerifiedKey &);
+			void remember (VerifiedKey, String);
+			Vector<Promise<String>> take (const SessionKey &);
+			void record (UInt64) noexcept;
+			
+			
 			template <typename T, typename Callback, typename... Args>
 			typename std::enable_if<
 				!std::is_same<
@@ -262,6 +376,12 @@ namespace Yggdrasil {
 			
 			
 		public:
+		
+		
+			/**
+			 *	Creates a new client.
+			 */
+			Client ();
 			
 			
 			/**
@@ -400,6 +520,12 @@ namespace Yggdrasil {
 			 *	\param [in] pulic_key
 			 *		The PublicKeyInfo used to complete the
 			 *		encryption handshake with the client.
+			 *	\param [in] ip
+			 *		The IP address the client connected
+			 *		from.  Optional.  If provided, and the
+			 *		same username was verified from this
+			 *		address recently, the session server is
+			 *		not asked again.  See SetSessionCache.
 			 *
 			 *	\return
 			 *		A promise of the client's UUID from
@@ -409,8 +535,49 @@ namespace Yggdrasil {
 				const String & username,
 				const String & server_id,
 				const Vector<Byte> & secret,
-				const Vector<Byte> & public_key
+				const Vector<Byte> & public_key,
+				Nullable<IPAddress> ip=Nullable<IPAddress>{}
 			);
+			
+			
+			/**
+			 *	Sets how many, and for how long, verified
+			 *	sessions are remembered.
+			 *
+			 *	Sessions are not remembered by default.
+			 *
+			 *	\param [in] max
+			 *		The greatest number of sessions to
+			 *		remember.
+			 *	\param [in] milliseconds
+			 *		How long each session is remembered
+			 *		after it's verified.  Zero means
+			 *		sessions are not remembered.
+			 */
+			void SetSessionCache (Word max, Word milliseconds);
+			
+			
+			/**
+			 *	Retrieves information about the session
+			 *	verifications this client has performed.
+			 *
+			 *	\return
+			 *		A structure containing information
+			 *		about session verifications.
+			 */
+			SessionInfo GetInfo () const;
+			
+			
+			/**
+			 *	Limits the number of requests which will
+			 *	be made to each Yggdrasil host at once.
+			 *
+			 *	\param [in] max
+			 *		The greatest number of requests to make
+			 *		to any one host at once.  Zero means there
+			 *		is no limit, which is the default.
+			 */
+			void SetMaxConnections (Word max);
 	
 	
 	};
@@ -0,0 +1,253 @@
+#include <accept_limiter.hpp>
+#include <random_device.hpp>
+#include <algorithm>
+#include <limits>
+
+
+namespace MCPP {
+
+
+	//	Each counter is found by this many
+	//	hashes, the estimate is the smallest
+	//	of the counters found
+	static const Word depth=4;
+	//	The number of counters each hash
+	//	chooses between
+	static const Word width=8192;
+	static const Word table_size=depth*width;
+	static const UInt16 saturated=std::numeric_limits<UInt16>::max();
+	//	Ranges are /24s for IPv4, and /64s for
+	//	IPv6
+	static const Word v4_range_bits=24;
+	static const Word v6_range_bits=64;
+	
+	
+	static UInt64 mix (UInt64 x) noexcept {
+	
+		x^=x>>30;
+		x*=0xBF58476D1CE4E5B9ULL;
+		x^=x>>27;
+		x*=0x94D049BB133111EBULL;
+		x^=x>>31;
+		
+		return x;
+	
+	}
+	
+	
+	AcceptLimiter::AcceptLimiter (Word window, Word host_limit, Word range_limit, Word escalate, Word escalate_time)
+		:	window((window==0) ? 1 : window),
+			host_limit(host_limit),
+			range_limit(range_limit),
+			escalate(escalate),
+			escalate_time(escalate_time),
+			counts(table_size*4),
+			current(0),
+			started(0),
+			seed(RandomDevice<UInt64>{}()),
+			clock(Timer::CreateAndStart()),
+			checked(0),
+			host_refused(0),
+			range_refused(0),
+			escalated(0)
+	{
+	
+		counts.SetCount(table_size*4);
+		std::fill(counts.begin(),counts.end(),0);
+	
+	}
+	
+	
+	UInt16 * AcceptLimiter::table (Word which, bool range) noexcept {
+	
+		return counts.begin()+(((which*2)+(range ? 1 : 0))*table_size);
+	
+	}
+	
+	
+	void AcceptLimiter::roll (UInt64 now) noexcept {
+	
+		auto elapsed=now-started;
+		if (elapsed<window) return;
+		
+		auto previous=current^1;
+		
+		//	If exactly one window has ended, it
+		//	becomes the previous window, otherwise
+		//	nothing counted is still of interest
+		if (elapsed<(window*2)) {
+		
+			started+=window;
+		
+		} else {
+		
+			std::fill(table(current,false),table(current,false)+table_size,0);
+			std::fill(table(current,true),table(current,true)+table_size,0);
+			
+			started=now-(elapsed%window);
+		
+		}
+		
+		std::fill(table(previous,false),table(previous,false)+table_size,0);
+		std::fill(table(previous,true),table(previous,true)+table_size,0);
+		
+		current=previous;
+	
+	}
+	
+	
+	UInt64 AcceptLimiter::key (IPAddress ip, bool range) const noexcept {
+	
+		//	The hashes are seeded so that addresses
+		//	which collide cannot be chosen ahead of
+		//	time
+		if (ip.IsV6()) {
+		
+			auto i=static_cast<UInt128>(ip);
+			if (range) i>>=(sizeof(UInt128)*BitsPerByte())-v6_range_bits;
+			
+			return mix(static_cast<UInt64>(i)^mix(static_cast<UInt64>(i>>64)^seed));
+		
+		}
+		
+		auto i=static_cast<UInt32>(ip);
+		if (range) i>>=(sizeof(UInt32)*BitsPerByte())-v4_range_bits;
+		
+		return mix(i^mix(seed+1));
+	
+	}
+	
+	
+	Word AcceptLimiter::count (UInt64 key, bool range, UInt64 now, Word & before) noexcept {
+	
+		auto curr=table(current,range);
+		auto prev=table(current^1,range);
+		
+		//	Each row's counter is chosen by combining
+		//	two hashes
+		Word indices [depth];
+		UInt64 step=mix(key)|1;
+		for (Word i=0;i<depth;++i) indices[i]=(i*width)+static_cast<Word>((key+(i*step))%width);
+		
+		UInt16 low=saturated;
+		UInt16 prev_low=saturated;
+		for (auto i : indices) {
+		
+			low=std::min(low,curr[i]);
+			prev_low=std::min(prev_low,prev[i]);
+		
+		}
+		
+		//	The previous window's count is weighted
+		//	by how much of it still lies within the
+		//	sliding window
+		Word weighted=static_cast<Word>((UInt64(prev_low)*(window-(now-started)))/window);
+		before=low+weighted;
+		
+		//	Only the counters which are the smallest
+		//	are raised, so that counters shared with
+		//	other hosts are not raised needlessly
+		if (low!=saturated) {
+		
+			++low;
+			for (auto i : indices) if (curr[i]<low) curr[i]=low;
+		
+		}
+		
+		return low+weighted;
+	
+	}
+	
+	
+	AcceptLimit AcceptLimiter::Check (IPAddress ip) {
+	
+		++checked;
+		
+		AcceptLimit retr;
+		retr.Allow=true;
+		retr.Milliseconds=0;
+		
+		if ((host_limit==0) && (range_limit==0)) return retr;
+		
+		Word hosts=0;
+		Word hosts_before=0;
+		Word ranges=0;
+		Word ranges_before=0;
+		lock.Execute([&] () {
+		
+			//	The clock is read while holding the lock
+			//	so that no check sees a time earlier than
+			//	the start of the current window
+			auto now=clock.ElapsedMilliseconds();
+			if (now<started) now=started;
+			
+			roll(now);
+			
+			if (host_limit!=0) hosts=count(key(ip,false),false,now,hosts_before);
+			if (range_limit!=0) ranges=count(key(ip,true),true,now,ranges_before);
+		
+		});
+		
+		if ((host_limit!=0) && (hosts>host_limit)) {
+		
+			retr.Allow=false;
+			++host_refused;
+		
+		} else if ((range_limit!=0) && (ranges>range_limit)) {
+		
+			retr.Allow=false;
+			++range_refused;
+		
+		}
+		
+		if (retr.Allow || (escalate==0)) return retr;
+		
+		//	Escalate the first time the count reaches
+		//	the threshold, rather than on every
+		//	connection beyond it
+		if (range_limit!=0) {
+		
+			Word threshold=range_limit*escalate;
+			if ((ranges>=threshold) && (ranges_before<threshold)) retr.Escalate.Construct(
+				ip,
+				ip.IsV6() ? v6_range_bits : v4_range_bits
+			);
+		
+		}
+		
+		if (retr.Escalate.IsNull() && (host_limit!=0)) {
+		
+			Word threshold=host_limit*escalate;
+			if ((hosts>=threshold) && (hosts_before<threshold)) retr.Escalate.Construct(ip);
+		
+		}
+		
+		if (!retr.Escalate.IsNull()) {
+		
+			retr.Milliseconds=escalate_time;
+			++escalated;
+		
+		}
+		
+		return retr;
+	
+	}
+	
+	
+	AcceptLimiterInfo AcceptLimiter::GetInfo () const noexcept {
+	
+		AcceptLimiterInfo retr;
+		retr.Window=window;
+		retr.HostLimit=host_limit;
+		retr.RangeLimit=range_limit;
+		retr.Checked=checked;
+		retr.HostRefused=host_refused;
+		retr.RangeRefused=range_refused;
+		retr.Escalated=escalated;
+		
+		return retr;
+	
+	}
+
+
+}
@@ -1,7 +1,19 @@
 #include <aes_128_cfb_8.hpp>
+#include <cstring>
 #include <stdexcept>
 #include <openssl/aes.h>
+#include <openssl/crypto.h>
 #include <openssl/err.h>
+//	Compilers before GCC 4.9 can only use AES-NI
+//	intrinsics if the entire translation unit is
+//	compiled for AES-NI, which the makefiles do
+//	(the CPU is still checked before the kernel
+//	is used)
+#if (defined(__i386__) || defined(__x86_64__)) && (defined(__AES__) || (__GNUC__>4) || ((__GNUC__==4) && (__GNUC_MINOR__>=9)))
+#define AES_NI
+#include <cpuid.h>
+#include <wmmintrin.h>
+#endif
 
 
 namespace MCPP {
@@ -9,14 +21,154 @@ namespace MCPP {
 
 	static const char * insufficient_key_size="Encryption key is not long enough";
 	static const char * insufficient_iv_size="Initialization vector is not long enough";
-
-
+	
+	
+	#ifdef AES_NI
+	
+	
+	static bool has_aes_ni () noexcept {
+	
+		unsigned int a;
+		unsigned int b;
+		unsigned int c;
+		unsigned int d;
+		if (__get_cpuid(1,&a,&b,&c,&d)==0) return false;
+		
+		return (c&bit_AES)!=0;
+	
+	}
+	
+	
+	static const bool aes_ni=has_aes_ni();
+	
+	
+	__attribute__((target("aes")))
+	static inline __m128i aes_ni_expand_step (__m128i key, __m128i assist) noexcept {
+	
+		assist=_mm_shuffle_epi32(assist,0xFF);
+		key=_mm_xor_si128(key,_mm_slli_si128(key,4));
+		key=_mm_xor_si128(key,_mm_slli_si128(key,4));
+		key=_mm_xor_si128(key,_mm_slli_si128(key,4));
+		
+		return _mm_xor_si128(key,assist);
+	
+	}
+	
+	
+	__attribute__((target("aes")))
+	static void aes_ni_expand (const Byte * key, Byte * round_keys) noexcept {
+	
+		__m128i rk [11];
+		rk[0]=_mm_loadu_si128(reinterpret_cast<const __m128i *>(key));
+		//	The round constant must be an immediate,
+		//	so this cannot be a loop
+		rk[1]=aes_ni_expand_step(rk[0],_mm_aeskeygenassist_si128(rk[0],0x01));
+		rk[2]=aes_ni_expand_step(rk[1],_mm_aeskeygenassist_si128(rk[1],0x02));
+		rk[3]=aes_ni_expand_step(rk[2],_mm_aeskeygenassist_si128(rk[2],0x04));
+		rk[4]=aes_ni_expand_step(rk[3],_mm_aeskeygenassist_si128(rk[3],0x08));
+		rk[5]=aes_ni_expand_step(rk[4],_mm_aeskeygenassist_si128(rk[4],0x10));
+		rk[6]=aes_ni_expand_step(rk[5],_mm_aeskeygenassist_si128(rk[5],0x20));
+		rk[7]=aes_ni_expand_step(rk[6],_mm_aeskeygenassist_si128(rk[6],0x40));
+		rk[8]=aes_ni_expand_step(rk[7],_mm_aeskeygenassist_si128(rk[7],0x80));
+		rk[9]=aes_ni_expand_step(rk[8],_mm_aeskeygenassist_si128(rk[8],0x1B));
+		rk[10]=aes_ni_expand_step(rk[9],_mm_aeskeygenassist_si128(rk[9],0x36));
+		
+		for (Word i=0;i<11;++i) _mm_storeu_si128(
+			reinterpret_cast<__m128i *>(round_keys+(i*16)),
+			rk[i]
+		);
+	
+	}
+	
+	
+	//	Number of keystream blocks which are
+	//	computed at once
+	static const Word aes_ni_lanes=8;
+	
+	
+	//	Decrypts count bytes from in into out,
+	//	the block preceding the byte at index i
+	//	begins at blocks+i
+	__attribute__((target("aes")))
+	static inline void aes_ni_run (const __m128i * rk, const Byte * blocks, const Byte * in, Byte * out, Word count) noexcept {
+	
+		Word i=0;
+		for (;(i+aes_ni_lanes)<=count;i+=aes_ni_lanes) {
+		
+			__m128i b [aes_ni_lanes];
+			for (Word j=0;j<aes_ni_lanes;++j) b[j]=_mm_xor_si128(
+				_mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks+i+j)),
+				rk[0]
+			);
+			for (Word r=1;r<10;++r) for (Word j=0;j<aes_ni_lanes;++j) b[j]=_mm_aesenc_si128(b[j],rk[r]);
+			for (Word j=0;j<aes_ni_lanes;++j) b[j]=_mm_aesenclast_si128(b[j],rk[10]);
+			
+			//	Only the first byte of each block
+			//	of keystream is used
+			for (Word j=0;j<aes_ni_lanes;++j) out[i+j]=in[i+j]^static_cast<Byte>(_mm_cvtsi128_si32(b[j]));
+		
+		}
+		
+		for (;i<count;++i) {
+		
+			__m128i b=_mm_xor_si128(
+				_mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks+i)),
+				rk[0]
+			);
+			for (Word r=1;r<10;++r) b=_mm_aesenc_si128(b,rk[r]);
+			b=_mm_aesenclast_si128(b,rk[10]);
+			
+			out[i]=in[i]^static_cast<Byte>(_mm_cvtsi128_si32(b));
+		
+		}
+	
+	}
+	
+	
+	//	In CFB8 the block which is encrypted to
+	//	decrypt each byte is the 16 bytes of
+	//	ciphertext (or IV) which precede it.
+	//	All of those are known up front when
+	//	decrypting, so unlike encryption, many
+	//	blocks may be in flight at once
+	__attribute__((target("aes")))
+	static void aes_ni_decrypt (const Byte * round_keys, Byte * shift, const Byte * begin, const Byte * end, Byte * out) noexcept {
+	
+		__m128i rk [11];
+		for (Word i=0;i<11;++i) rk[i]=_mm_loadu_si128(reinterpret_cast<const __m128i *>(round_keys+(i*16)));
+		
+		Word len=Word(end-begin);
+		
+		//	The shift register followed by the
+		//	first bytes of ciphertext, so that the
+		//	blocks which straddle the two are
+		//	contiguous
+		Byte head [32];
+		Word head_len=(len<16) ? len : 16;
+		std::memcpy(head,shift,16);
+		std::memcpy(head+16,begin,head_len);
+		
+		aes_ni_run(rk,head,begin,out,head_len);
+		//	Every block after the first 16 lies
+		//	entirely within the ciphertext
+		if (len>16) aes_ni_run(rk,begin,begin+16,out+16,len-16);
+		
+		//	The shift register is now the last
+		//	16 bytes of IV and ciphertext
+		std::memcpy(shift,(len<16) ? (head+len) : (end-16),16);
+	
+	}
+	
+	
+	#endif
+	
+	
 	AES128CFB8::AES128CFB8 (Vector<Byte> key, Vector<Byte> iv) : key(std::move(key)), iv(std::move(iv)) {
 	
 		//	Insufficient key or IV bytes
 		if (this->key.Count()<16) throw std::invalid_argument(insufficient_key_size);
 		if (this->iv.Count()<16) throw std::invalid_argument(insufficient_iv_size);
-	
+		
 		//	Initialize cipher contexts
 		EVP_CIPHER_CTX_init(&encrypt);
 		EVP_CIPHER_CTX_init(&decrypt);
@@ -71,6 +223,18 @@ namespace MCPP {
 			throw;
 		
 		}
+		
+		#ifdef AES_NI
+		accelerated=aes_ni;
+		if (accelerated) {
+		
+			aes_ni_expand(this->key.begin(),round_keys);
+			std::memcpy(shift,this->iv.begin(),sizeof(shift));
+		
+		}
+		#else
+		accelerated=false;
+		#endif
 	
 	}
 	
@@ -79,6 +243,49 @@ namespace MCPP {
 	
 		EVP_CIPHER_CTX_cleanup(&encrypt);
 		EVP_CIPHER_CTX_cleanup(&decrypt);
+		
+		OPENSSL_cleanse(round_keys,sizeof(round_keys));
+		OPENSSL_cleanse(shift,sizeof(shift));
+	
+	}
+	
+	
+	bool AES128CFB8::Accelerated () const noexcept {
+	
+		return accelerated;
+	
+	}
+	
+	
+	void AES128CFB8::decrypt_bytes (const Byte * begin, const Byte * end, Byte * out) {
+	
+		#ifdef AES_NI
+		if (accelerated) {
+		
+			aes_ni_decrypt(round_keys,shift,begin,end,out);
+			
+			return;
+		
+		}
+		#endif
+		
+		//	Convert the length of the
+		//	ciphertext into an integer
+		//	format acceptable for OpenSSL
+		int len=int(SafeInt<decltype(end-begin)>(end-begin));
+		
+		if (EVP_DecryptUpdate(
+			&decrypt,
+			reinterpret_cast<unsigned char *>(out),
+			&len,
+			reinterpret_cast<const unsigned char *>(begin),
+			len
+		)==0) throw std::runtime_error(
+			ERR_error_string(
+				ERR_get_error(),
+				nullptr
+			)
+		);
 	
 	}
 	
@@ -138,7 +345,7 @@ namespace MCPP {
 				nullptr
 			)
 		);
-
+		
 		//	Update buffer's count
 		buffer.SetCount(cleartext.Count());
 		
@@ -159,34 +366,11 @@ namespace MCPP {
 		//	decrypted
 		if (ciphertext.Count()==0) return buffer;
 		
-		//	Convert the length of
-		//	the ciphertext into an
-		//	integer format acceptable
-		//	for OpenSSL
-		int len=int(SafeWord(ciphertext.Count()));
-		
 		//	Decrypt
-		if (EVP_DecryptUpdate(
-			&decrypt,
-			reinterpret_cast<unsigned char *>(
-				static_cast<Byte *>(
-					buffer
-				)
-			),
-			&len,
-			reinterpret_cast<unsigned char *>(
-				static_cast<Byte *>(
-					const_cast<Vector<Byte> &>(
-						ciphertext
-					)
-				)
-			),
-			len
-		)==0) throw std::runtime_error(
-			ERR_error_string(
-				ERR_get_error(),
-				nullptr
-			)
+		decrypt_bytes(
+			ciphertext.begin(),
+			ciphertext.end(),
+			buffer.begin()
 		);
 		
 		//	Update buffer's count
@@ -208,7 +392,7 @@ namespace MCPP {
 		//	If there's no ciphertext, short-circuit
 		//	out
 		if (ciphertext->Count()==0) return;
-	
+		
 		//	Pre-allocate enough space in
 		//	plaintext
 		Word plaintext_capacity=Word(
@@ -217,31 +401,11 @@ namespace MCPP {
 		);
 		plaintext->SetCapacity(plaintext_capacity);
 		
-		//	Convert the length of the ciphertext
-		//	into an integer format acceptable
-		//	for OpenSSL
-		int len=int(SafeWord(ciphertext->Count()));
-		
 		//	Decrypt
-		if (EVP_DecryptUpdate(
-			&decrypt,
-			reinterpret_cast<unsigned char *>(
-				static_cast<Byte *>(
-					*plaintext
-				)+plaintext->Count()
-			),
-			&len,
-			reinterpret_cast<unsigned char *>(
-				static_cast<Byte *>(
-					*ciphertext
-				)
-			),
-			len
-		)==0) throw std::runtime_error(
-			ERR_error_string(
-				ERR_get_error(),
-				nullptr
-			)
+		decrypt_bytes(
+			ciphertext->begin(),
+			ciphertext->end(),
+			plaintext->end()
 		);
 		
 		//	Update buffer's count
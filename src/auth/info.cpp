@@ -0,0 +1,174 @@
+#include <auth/auth.hpp>
+#include <info/info.hpp>
+#include <mod.hpp>
+
+
+using namespace MCPP;
+
+
+static const String name("Authentication Information");
+static const Word priority=1;
+static const String identifier("auth");
+static const String help("Displays information about logins.");
+static const String auth_banner("LOGINS:");
+static const String active("In Progress: {0}");
+static const String maximum("Maximum In Progress: {0}");
+static const String unlimited("Maximum In Progress: Unlimited");
+static const String queued("Waiting: {0}");
+static const String completed("Completed: {0}");
+static const String latency("Average Latency: {0}ms");
+static const String timed_out("Timed Out Waiting: {0}");
+static const String workers("Cryptography Threads: {0}");
+static const String session_banner("SESSION VERIFICATION:");
+static const String requests("Requests: {0}");
+static const String coalesced("Coalesced: {0}");
+static const String cached("Cached: {0}");
+static const String bucket("Up To {0}ms: {1}");
+static const String last_bucket("Over {0}ms: {1}");
+
+
+static Double average_milliseconds (UInt64 ns, Word count) noexcept {
+
+	return (count==0) ? 0 : ((static_cast<Double>(ns)/1000000)/static_cast<Double>(count));
+
+}
+
+
+class AuthenticationInfoProvider : public Module, public InformationProvider {
+
+
+	public:
+	
+	
+		virtual const String & Name () const noexcept override {
+		
+			return name;
+		
+		}
+		
+		
+		virtual Word Priority () const noexcept override {
+		
+			return priority;
+		
+		}
+		
+		
+		virtual void Install () override {
+		
+			Information::Get().Add(this);
+		
+		}
+		
+		
+		virtual const String & Identifier () const noexcept override {
+		
+			return identifier;
+		
+		}
+		
+		
+		virtual const String & Help () const noexcept override {
+		
+			return help;
+		
+		}
+		
+		
+		virtual void Execute (ChatMessage & message) const override {
+		
+			auto info=Authentication::Get().GetInfo();
+			
+			message	<<	ChatStyle::Bold
+					<<	auth_banner
+					<<	ChatFormat::Pop
+					<<	Newline
+					<<	String::Format(
+							active,
+							info.Active
+						)
+					<<	Newline
+					<<	(
+							(info.Maximum==0)
+								?	unlimited
+								:	String::Format(
+										maximum,
+										info.Maximum
+									)
+						)
+					<<	Newline
+					<<	String::Format(
+							queued,
+							info.Queued
+						)
+					<<	Newline
+					<<	String::Format(
+							completed,
+							info.Completed
+						)
+					<<	Newline
+					<<	String::Format(
+							latency,
+							average_milliseconds(
+								info.Elapsed,
+								info.Completed
+							)
+						)
+					<<	Newline
+					<<	String::Format(
+							timed_out,
+							info.TimedOut
+						)
+					<<	Newline
+					<<	String::Format(
+							workers,
+							info.Workers
+						);
+		
+			auto session=Authentication::Get().GetClient().GetInfo();
+			
+			message	<<	Newline
+					<<	ChatStyle::Bold
+					<<	session_banner
+					<<	ChatFormat::Pop
+					<<	Newline
+					<<	String::Format(
+							requests,
+							session.Requests
+						)
+					<<	Newline
+					<<	String::Format(
+							coalesced,
+							session.Coalesced
+						)
+					<<	Newline
+					<<	String::Format(
+							cached,
+							session.Cached
+						);
+			
+			//	Each bucket holds requests which took
+			//	longer than the bucket before it, the
+			//	last bucket is unbounded
+			for (Word i=0;i<session.Latency.Count();++i) message	<<	Newline
+																	<<	(
+																			((i+1)==session.Latency.Count())
+																				?	String::Format(
+																						last_bucket,
+																						(i==0) ? 0 : session.Latency[i-1].Maximum,
+																						session.Latency[i].Count
+																					)
+																				:	String::Format(
+																						bucket,
+																						session.Latency[i].Maximum,
+																						session.Latency[i].Count
+																					)
+																		);
+		
+		}
+
+
+};
+
+
+INSTALL_MODULE(AuthenticationInfoProvider)
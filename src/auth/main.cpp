@@ -23,6 +23,23 @@ namespace MCPP {
 	//	Module information
 	static const Word priority=1;
 	static const String name("Authentication API");
+	//	Settings
+	static const String threads_setting("auth_threads");
+	static const Word default_threads=2;
+	static const String max_logins_setting("max_logins");
+	static const Word default_max_logins=0;	//	Unlimited
+	static const String queue_timeout_setting("login_queue_timeout");
+	static const Word default_queue_timeout=30000;
+	static const String max_connections_setting("auth_max_connections");
+	static const Word default_max_connections=0;	//	Unlimited
+	static const String session_cache_size_setting("session_cache_size");
+	static const Word default_session_cache_size=1024;
+	static const String session_cache_time_setting("session_cache_time");
+	static const Word default_session_cache_time=0;	//	Disabled
+	//	Clients which wait too long to
+	//	log in are disconnected with this
+	//	reason
+	static const String queue_timed_out("Timed out waiting to log in");
 	
 	
 	/*static bool debug () {
@@ -43,9 +60,15 @@ namespace MCPP {
 	Authentication::Authentication ()
 		:	gen(get_mt19937()),
 			id_len(UniformIntDistribution<Word>(15,20)),
-			id_dist(UniformIntDistribution<Byte>('!','~'))
+			id_dist(UniformIntDistribution<Byte>('!','~')),
+			max_logins(default_max_logins),
+			queue_timeout(default_queue_timeout)
 	{
 	
+		completed=0;
+		elapsed=0;
+		timed_out=0;
+	
 		/*ygg.SetDebug(
 			[this] (Yggdrasil::Request request) mutable {
 			
@@ -175,8 +198,179 @@ namespace MCPP {
 	}
 	
 	
-	//	Does nothing
-	void Authentication::Install () {	}
+	void Authentication::Install () {
+	
+		auto & server=Server::Get();
+		
+		max_logins=server.Data().GetSetting(max_logins_setting,default_max_logins);
+		queue_timeout=server.Data().GetSetting(queue_timeout_setting,default_queue_timeout);
+		
+		//	Session server requests beyond this
+		//	wait for a connection to free up
+		ygg.SetMaxConnections(server.Data().GetSetting(max_connections_setting,default_max_connections));
+		ygg.SetSessionCache(
+			server.Data().GetSetting(session_cache_size_setting,default_session_cache_size),
+			server.Data().GetSetting(session_cache_time_setting,default_session_cache_time)
+		);
+		
+		Word threads=server.Data().GetSetting(threads_setting,default_threads);
+		if (threads==0) threads=1;
+		crypto.Construct(
+			threads,
+			[] (std::exception_ptr ex) {	Server::Get().Panic(std::move(ex));	}
+		);
+		
+		//	Clients which disconnect part way
+		//	through logging in, or while waiting
+		//	to log in, make room for others
+		server.OnDisconnect.Add([this] (SmartPointer<Client> client, const String &) mutable {	Finish(*client,false);	});
+	
+	}
+	
+	
+	void Authentication::Offload (std::function<void ()> callback) {
+	
+		if (crypto.IsNull()) callback();
+		else crypto->Enqueue(std::move(callback));
+	
+	}
+	
+	
+	void Authentication::Admit (SmartPointer<Client> client, std::function<void ()> callback) {
+	
+		const Client * ptr=static_cast<Client *>(client);
+		
+		if (logins_lock.Execute([&] () mutable {
+		
+			if ((max_logins==0) || (logins.size()<max_logins)) {
+			
+				logins.emplace(ptr,Timer::CreateAndStart());
+				
+				return true;
+			
+			}
+			
+			queue.Add(
+				QueuedLogin{
+					client,
+					Timer::CreateAndStart(),
+					std::move(callback)
+				}
+			);
+			
+			return false;
+		
+		})) {
+		
+			callback();
+			
+			return;
+		
+		}
+		
+		//	The client is held until the timeout
+		//	expires so that another client cannot
+		//	take its address in the meantime
+		Server::Get().Pool().Enqueue(
+			queue_timeout,
+			[this,client] () mutable {	expire(static_cast<Client *>(client));	}
+		);
+	
+	}
+	
+	
+	void Authentication::expire (const Client * client) {
+	
+		Nullable<QueuedLogin> login;
+		logins_lock.Execute([&] () mutable {
+		
+			for (Word i=0;i<queue.Count();++i) if (static_cast<Client *>(queue[i].Target)==client) {
+			
+				login.Construct(std::move(queue[i]));
+				queue.Delete(i);
+				
+				++timed_out;
+				
+				break;
+			
+			}
+		
+		});
+		
+		//	No work has been done on behalf of
+		//	the client, so it's simply dropped
+		if (!login.IsNull()) login->Target->Disconnect(queue_timed_out);
+	
+	}
+	
+	
+	void Authentication::Finish (const Client & client, bool success) {
+	
+		Nullable<QueuedLogin> next;
+		logins_lock.Execute([&] () mutable {
+		
+			auto iter=logins.find(&client);
+			if (iter==logins.end()) {
+			
+				//	The client may still be waiting
+				for (Word i=0;i<queue.Count();++i) if (static_cast<Client *>(queue[i].Target)==&client) {
+				
+					queue.Delete(i);
+					
+					break;
+				
+				}
+				
+				return;
+			
+			}
+			
+			if (success) {
+			
+				++completed;
+				elapsed+=iter->second.ElapsedNanoseconds();
+			
+			}
+			
+			logins.erase(iter);
+			
+			if (queue.Count()==0) return;
+			
+			//	Begin the login which has waited
+			//	longest, the time it spent waiting
+			//	counts toward its latency
+			next.Construct(std::move(queue[0]));
+			queue.Delete(0);
+			logins.emplace(
+				static_cast<Client *>(next->Target),
+				next->Elapsed
+			);
+		
+		});
+		
+		if (!next.IsNull()) Server::Get().Pool().Enqueue(std::move(next->Callback));
+	
+	}
+	
+	
+	AuthenticationInfo Authentication::GetInfo () const {
+	
+		AuthenticationInfo retr;
+		logins_lock.Execute([&] () {
+		
+			retr.Active=logins.size();
+			retr.Queued=queue.Count();
+		
+		});
+		retr.Maximum=max_logins;
+		retr.Completed=completed;
+		retr.Elapsed=elapsed;
+		retr.TimedOut=timed_out;
+		retr.Workers=crypto.IsNull() ? 0 : crypto->Count();
+		
+		return retr;
+	
+	}
 	
 	
 	static Singleton<Authentication> singleton;
@@ -21,12 +21,20 @@ static const String authentication_failed("Authentication failed");
 //	bytes is 3
 static const Word priority=1;
 static const String name("Minecraft.net Authentication Support");
+static const String online_mode_setting("online_mode");
+static const bool online_mode_default=true;
 
 
 enum class AuthenticationState {
 
 	Waiting,
+	//	Waiting for the login to be
+	//	admitted
+	Admitting,
 	ResponseSent,
+	//	Waiting for the shared secret
+	//	and verify token to be decrypted
+	Decrypting,
 	Authenticate
 
 };
@@ -102,6 +110,11 @@ class VanillaAuth : public Module {
 		RWLock map_lock;
 		
 		
+		//	Whether clients' sessions shall be
+		//	verified against minecraft.net
+		bool online;
+		
+		
 		SmartPointer<ClientData> get (const SmartPointer<Client> client) {
 		
 			return map_lock.Read([&] () mutable {
@@ -144,7 +157,7 @@ class VanillaAuth : public Module {
 			//	not do any further processing
 			if (data.IsNull()) return Status::Gone;
 			
-			return data->Lock.Execute([&] () mutable {
+			auto status=data->Lock.Execute([&] () mutable {
 			
 				//	Verify client's authentication
 				//	state
@@ -157,6 +170,55 @@ class VanillaAuth : public Module {
 					)
 				);
 				
+				data->State=AuthenticationState::Admitting;
+				
+				return Status::Success;
+			
+			});
+			
+			if (status!=Status::Success) return status;
+			
+			//	The key exchange is deferred until
+			//	there's room for another login, since
+			//	it's what leads to the expensive
+			//	cryptography
+			#pragma GCC diagnostic push
+			#pragma GCC diagnostic ignored "-Wpedantic"
+			Authentication::Get().Admit(
+				event.From,
+				[this,client=event.From] () mutable {
+				
+					try {
+					
+						handle(request_key(client),client);
+					
+					} catch (...) {
+					
+						client->Disconnect(auth_callback_error);
+						
+						throw;
+					
+					}
+				
+				}
+			);
+			#pragma GCC diagnostic pop
+			
+			return Status::Success;
+		
+		}
+		
+		
+		Status request_key (SmartPointer<Client> & client) {
+		
+			auto data=get(client);
+			
+			if (data.IsNull()) return Status::Gone;
+			
+			return data->Lock.Execute([&] () mutable {
+			
+				if (data->State!=AuthenticationState::Admitting) return Status::ProtocolError;
+				
 				//	We respond with EncryptionResponse
 				key_request reply;
 				
@@ -174,7 +236,7 @@ class VanillaAuth : public Module {
 				data->VerifyToken=reply.VerifyToken;
 				
 				//	Send our reply
-				event.From->Send(reply);
+				client->Post(reply);
 				
 				//	Advance client's authentication
 				//	state
@@ -212,15 +274,16 @@ class VanillaAuth : public Module {
 			
 			});
 			
+			//	Make room for another login
+			Authentication::Get().Finish(*client,true);
+			
 			//	Client is authenticated, log
-			server.WriteLog(
-				String::Format(
-					logged_in,
-					client->IP(),
-					client->Port(),
-					client->GetUsername()
-				),
-				Service::LogType::Information
+			server.Log(
+				Service::LogType::Information,
+				logged_in,
+				client->IP(),
+				client->Port(),
+				client->GetUsername()
 			);
 		
 		}
@@ -234,26 +297,81 @@ class VanillaAuth : public Module {
 			//	away
 			if (data.IsNull()) return Status::Gone;
 			
-			return data->Lock.Execute([&] () mutable {
+			auto & packet=event.Data.Get<key_response>();
+			
+			auto status=data->Lock.Execute([&] () mutable {
 			
 				//	Verify client's authentication
 				//	state
 				if (data->State!=AuthenticationState::ResponseSent) return Status::ProtocolError;
 				
-				auto & packet=event.Data.Get<key_response>();
+				data->State=AuthenticationState::Decrypting;
 				
-				auto & auth=Authentication::Get();
-				auto & key=auth.GetKey();
+				return Status::Success;
+			
+			});
+			
+			if (status!=Status::Success) return status;
+			
+			//	RSA decryption is expensive, it's
+			//	done on threads set aside for it so
+			//	a flood of logins cannot starve the
+			//	rest of the server
+			#pragma GCC diagnostic push
+			#pragma GCC diagnostic ignored "-Wpedantic"
+			Authentication::Get().Offload([
+				this,
+				client=event.From,
+				data=std::move(data),
+				verify_token=std::move(packet.VerifyToken),
+				secret=std::move(packet.Secret)
+			] () mutable {
+			
+				try {
+				
+					handle(
+						decrypt(client,data,verify_token,secret),
+						client
+					);
+				
+				} catch (...) {
+				
+					client->Disconnect(auth_callback_error);
+					
+					throw;
+				
+				}
+			
+			});
+			#pragma GCC diagnostic pop
+			
+			return Status::Success;
+		
+		}
+		
+		
+		Status decrypt (SmartPointer<Client> & client, SmartPointer<ClientData> & data, const Vector<Byte> & encrypted_verify_token, const Vector<Byte> & encrypted_secret) {
+		
+			auto & auth=Authentication::Get();
+			auto & key=auth.GetKey();
+			
+			//	Decrypt outside the lock, only this
+			//	task touches the client's data while
+			//	it's decrypting
+			auto verify_token=key.PrivateDecrypt(encrypted_verify_token);
+			auto secret=key.PrivateDecrypt(encrypted_secret);
+			
+			auto status=data->Lock.Execute([&] () mutable {
+			
+				if (data->State!=AuthenticationState::Decrypting) return Status::ProtocolError;
 				
 				//	Match up verify token
-				auto verify_token=key.PrivateDecrypt(packet.VerifyToken);
 				if (!Authentication::VerifyTokens(
 					verify_token,
 					data->VerifyToken
 				)) return Status::EncryptionError;
 				
-				//	Decrypt the shared secret
-				data->Secret=key.PrivateDecrypt(packet.Secret);
+				data->Secret=std::move(secret);
 				
 				//	Verify secret length (128 bits)
 				if (data->Secret.Count()!=(128/BitsPerByte())) return Status::ProtocolError;
@@ -261,14 +379,20 @@ class VanillaAuth : public Module {
 				//	Advance client's state
 				data->State=AuthenticationState::Authenticate;
 				
+				//	In offline mode the session is not
+				//	verified, the client is logged in
+				//	once the lock is released
+				if (!online) return Status::Success;
+				
 				#pragma GCC diagnostic push
 				#pragma GCC diagnostic ignored "-Wpedantic"
-				Authentication::Get().GetClient().ServerSession(
-					event.From->GetUsername(),
+				auth.GetClient().ServerSession(
+					client->GetUsername(),
 					data->ServerID,
 					data->Secret,
-					key.PublicKey()
-				).Then([=,client=event.From] (Promise<String> p) mutable {
+					key.PublicKey(),
+					client->IP()
+				).Then([=] (Promise<String> p) mutable {
 				
 					try {
 					
@@ -313,6 +437,10 @@ class VanillaAuth : public Module {
 				return Status::Success;
 			
 			});
+			
+			if (!online && (status==Status::Success)) authenticate(client,data);
+			
+			return status;
 		
 		}
 		
@@ -320,6 +448,9 @@ class VanillaAuth : public Module {
 	public:
 		
 		
+		VanillaAuth () noexcept : online(online_mode_default) {	}
+		
+		
 		virtual Word Priority () const noexcept override {
 		
 			return priority;
@@ -338,6 +469,14 @@ class VanillaAuth : public Module {
 		
 			auto & server=Server::Get();
 			
+			//	Offline mode still performs the
+			//	key exchange and enables encryption,
+			//	it only skips the session server
+			online=server.Data().GetSetting(
+				online_mode_setting,
+				online_mode_default
+			);
+			
 			//	Install connect/disconnect handlers
 			
 			server.OnConnect.Add([this] (SmartPointer<Client> client) mutable {
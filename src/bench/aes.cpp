@@ -0,0 +1,139 @@
+#include <rleahylib/rleahylib.hpp>
+#include <rleahylib/main.hpp>
+#include <aes_128_cfb_8.hpp>
+#include <openssl/evp.h>
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+
+
+using namespace MCPP;
+
+
+static const Word keys=2000;
+static const Word chunks=5;
+static const Word max_chunk=4096;
+static const Word buffer_size=1024*1024;
+static const Word iterations=64;
+static const String check_banner("Decrypting random chunks with {0} random keys and IVs, AES-NI {1}:");
+static const String check_result("{0} of {1} chunks differed from OpenSSL");
+static const String banner("AES/CFB8 decryption ({0} iterations of {1} bytes):");
+static const String result("{0}: {1} MB/s");
+static const String enabled("enabled");
+static const String disabled("disabled");
+
+
+static Vector<Byte> get_random (std::mt19937 & gen, Word count) {
+
+	std::uniform_int_distribution<UInt32> dist(0,255);
+	
+	Vector<Byte> retr(count);
+	for (Word i=0;i<count;++i) retr.Add(Byte(dist(gen)));
+	
+	return retr;
+
+}
+
+
+static void init (EVP_CIPHER_CTX & ctx, const Vector<Byte> & key, const Vector<Byte> & iv) {
+
+	EVP_CIPHER_CTX_init(&ctx);
+	EVP_DecryptInit_ex(&ctx,EVP_aes_128_cfb8(),nullptr,key.begin(),iv.begin());
+
+}
+
+
+static void decrypt (EVP_CIPHER_CTX & ctx, const Vector<Byte> & ciphertext, Vector<Byte> & plaintext) {
+
+	int len=int(SafeWord(ciphertext.Count()));
+	EVP_DecryptUpdate(&ctx,plaintext.begin(),&len,ciphertext.begin(),len);
+	plaintext.SetCount(ciphertext.Count());
+
+}
+
+
+//	Decrypts chunks of random length with
+//	AES128CFB8 and with OpenSSL directly,
+//	and counts the chunks where they differ
+static Word check (bool & accelerated) {
+
+	std::mt19937 gen(0);
+	std::uniform_int_distribution<Word> length(0,max_chunk);
+	
+	Word retr=0;
+	for (Word i=0;i<keys;++i) {
+	
+		auto key=get_random(gen,16);
+		auto iv=get_random(gen,16);
+		
+		AES128CFB8 aes(key,iv);
+		accelerated=aes.Accelerated();
+		EVP_CIPHER_CTX ctx;
+		init(ctx,key,iv);
+		
+		for (Word n=0;n<chunks;++n) {
+		
+			auto ciphertext=get_random(gen,length(gen));
+			Vector<Byte> expected(ciphertext.Count());
+			decrypt(ctx,ciphertext,expected);
+			
+			auto plaintext=aes.Decrypt(ciphertext);
+			
+			if (!std::equal(expected.begin(),expected.end(),plaintext.begin())) ++retr;
+		
+		}
+		
+		EVP_CIPHER_CTX_cleanup(&ctx);
+	
+	}
+	
+	return retr;
+
+}
+
+
+template <typename T>
+static void run (const String & name, T callback) {
+
+	auto timer=Timer::CreateAndStart();
+	for (Word i=0;i<iterations;++i) callback();
+	auto elapsed=timer.ElapsedNanoseconds();
+	
+	Double bytes=Double(buffer_size)*Double(iterations);
+	
+	StdOut << String::Format(
+		result,
+		name,
+		(bytes/(1024*1024))/(Double(elapsed)/1000000000)
+	) << Newline;
+
+}
+
+
+int Main (const Vector<const String> &) {
+
+	bool accelerated=false;
+	auto differed=check(accelerated);
+	
+	StdOut << String::Format(check_banner,keys,accelerated ? enabled : disabled) << Newline
+		<< String::Format(check_result,differed,keys*chunks) << Newline;
+	
+	std::mt19937 gen(1);
+	auto key=get_random(gen,16);
+	auto iv=get_random(gen,16);
+	auto ciphertext=get_random(gen,buffer_size);
+	Vector<Byte> plaintext(buffer_size);
+	
+	StdOut << String::Format(banner,iterations,buffer_size) << Newline;
+	
+	AES128CFB8 aes(key,iv);
+	run("AES128CFB8",[&] () {	aes.Decrypt(ciphertext);	});
+	
+	EVP_CIPHER_CTX ctx;
+	init(ctx,key,iv);
+	run("OpenSSL",[&] () {	decrypt(ctx,ciphertext,plaintext);	});
+	EVP_CIPHER_CTX_cleanup(&ctx);
+	
+	return (differed==0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
@@ -0,0 +1,336 @@
+#include <rleahylib/rleahylib.hpp>
+#include <rleahylib/main.hpp>
+#include <compression.hpp>
+#include <data_provider.hpp>
+#include <world/world.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <zdict.h>
+
+
+using namespace MCPP;
+
+
+static const Word default_radius=16;
+static const SByte default_dimension=0;
+//	Every column is compressed at least once,
+//	and the set is compressed again until at
+//	least this many columns have been
+static const Word min_iterations=200;
+//	The size zstd --train chooses by default
+static const Word dictionary_size=112640;
+//	Saved columns are found under the keys
+//	World::key gives them
+static const String key_template("column_{0}_{1}_{2}");
+static const String dictionary_key("column_dictionary");
+static const String usage("Usage: bench_compression [radius] [dimension]");
+static const String loaded_banner(
+	"Loaded {0} saved columns ({1} zlib, {2} Zstandard, {3} legacy) within {4} columns of the origin in dimension {5}"
+);
+static const String none_found("No saved columns were found, save a world (e.g. with the pregenerator) first");
+static const String banner("Deflate ({0} passes over {1} columns of {2} bytes):");
+static const String result("{0}: {1} MB/s, ratio {2}");
+static const String codec_banner("Codecs ({0} passes over {1} columns of {2} bytes):");
+static const String codec_result("{0}: compress {1} MB/s, decompress {2} MB/s, ratio {3}");
+static const String trained_banner("Dictionary of {0} bytes trained on {1} columns, tested on the other {2}:");
+static const char * invalid_column="Saved column could not be decoded";
+static const char * round_trip_failed="Round trip failed";
+static const char * training_failed="Training a dictionary failed";
+
+
+//	Loads saved columns, decoding each as
+//	World::load would, into the layout columns
+//	are compressed from when they're saved
+class Columns {
+
+
+	public:
+	
+	
+		Vector<Vector<Byte>> Decoded;
+		Word Zlib;
+		Word Zstd;
+		Word Legacy;
+		
+		
+		Columns (DataProvider & data, Word radius, SByte dimension) : Zlib(0), Zstd(0), Legacy(0) {
+		
+			ZlibCodec zlib;
+			auto dictionary=data.GetBinary(dictionary_key);
+			std::unique_ptr<ZstdCodec> zstd(
+				dictionary.IsNull()
+					?	new ZstdCodec()
+					:	new ZstdCodec(ZstdCodec::DefaultLevel,dictionary->begin(),dictionary->end())
+			);
+			
+			//	Columns are decoded in place, as
+			//	World::load decodes them
+			std::unique_ptr<ColumnContainer> column(new ColumnContainer(ColumnID{0,0,dimension}));
+			
+			Int32 r=static_cast<Int32>(radius);
+			for (Int32 x=-r;x<=r;++x) for (Int32 z=-r;z<=r;++z) {
+			
+				ColumnID id{x,z,dimension};
+				auto buffer=data.GetBinary(String::Format(key_template,id.X,id.Z,id.Dimension));
+				if (buffer.IsNull()) continue;
+				
+				const Byte * begin=buffer->begin();
+				auto codec_id=Codec::Identify(begin,buffer->end());
+				const Codec * codec;
+				if (codec_id==Codec::Zlib) {
+				
+					codec=&zlib;
+					++Zlib;
+				
+				} else if (codec_id==Codec::Zstd) {
+				
+					codec=zstd.get();
+					++Zstd;
+				
+				} else {
+				
+					throw std::runtime_error(invalid_column);
+				
+				}
+				
+				auto size=codec->Decompress(begin,buffer->end(),column->Get(),ColumnContainer::Size);
+				
+				//	Legacy columns are saved in the current
+				//	layout once they're loaded
+				if (size==ColumnContainer::LegacySize) {
+				
+					column->LoadLegacy(column->Get());
+					++Legacy;
+				
+				} else if (size!=ColumnContainer::Size) {
+				
+					throw std::runtime_error(invalid_column);
+				
+				}
+				
+				Vector<Byte> decoded(ColumnContainer::Size);
+				std::memcpy(decoded.begin(),column->Get(),ColumnContainer::Size);
+				decoded.SetCount(ColumnContainer::Size);
+				Decoded.Add(std::move(decoded));
+			
+			}
+		
+		}
+
+
+};
+
+
+static Double mbs (Double bytes, UInt64 elapsed) noexcept {
+
+	return (bytes/(1024*1024))/(Double(elapsed)/1000000000);
+
+}
+
+
+static Word get_passes (const Vector<Vector<Byte>> & columns) noexcept {
+
+	return (min_iterations+columns.Count()-1)/columns.Count();
+
+}
+
+
+template <typename T>
+static void run (const String & name, const Vector<Vector<Byte>> & columns, T callback, Word streams=1) {
+
+	Word passes=get_passes(columns);
+	Word compressed=0;
+	auto timer=Timer::CreateAndStart();
+	for (Word i=0;i<passes;++i) for (auto & column : columns) compressed+=callback(column);
+	auto elapsed=timer.ElapsedNanoseconds();
+	
+	Double bytes=Double(ColumnContainer::Size)*Double(columns.Count())*Double(passes)*Double(streams);
+	
+	StdOut << String::Format(
+		result,
+		name,
+		mbs(bytes,elapsed),
+		bytes/Double(compressed)
+	) << Newline;
+
+}
+
+
+static Word fresh (const Vector<Byte> & column, Int32 level) {
+
+	//	A new stream for every buffer, which is
+	//	what compressing cost before streams
+	//	were reused
+	Deflater deflater(false,level);
+	Vector<Byte> buffer(deflater.Bound(column.Count()));
+	
+	return deflater.Deflate(column.begin(),column.end(),buffer.begin(),buffer.Capacity(),level);
+
+}
+
+
+static void run_codec (const String & name, const Vector<Vector<Byte>> & columns, const Codec & codec) {
+
+	Word passes=get_passes(columns);
+	
+	Vector<Vector<Byte>> encoded(columns.Count());
+	for (Word i=0;i<columns.Count();++i) encoded.Add(Vector<Byte>());
+	auto compress_timer=Timer::CreateAndStart();
+	for (Word i=0;i<passes;++i) for (Word j=0;j<columns.Count();++j) {
+	
+		encoded[j]=codec.Encode(columns[j].begin(),columns[j].end());
+	
+	}
+	auto compress=compress_timer.ElapsedNanoseconds();
+	
+	Word compressed=0;
+	for (auto & e : encoded) compressed+=e.Count();
+	
+	Vector<Byte> decoded(ColumnContainer::Size);
+	auto decompress_timer=Timer::CreateAndStart();
+	for (Word i=0;i<passes;++i) for (auto & e : encoded) {
+	
+		const Byte * begin=e.begin();
+		Codec::Identify(begin,e.end());
+		if (codec.Decompress(begin,e.end(),decoded.begin(),decoded.Capacity())!=ColumnContainer::Size) throw std::runtime_error(round_trip_failed);
+	
+	}
+	auto decompress=decompress_timer.ElapsedNanoseconds();
+	
+	Double bytes=Double(ColumnContainer::Size)*Double(columns.Count());
+	
+	StdOut << String::Format(
+		codec_result,
+		name,
+		mbs(bytes*Double(passes),compress),
+		mbs(bytes*Double(passes),decompress),
+		bytes/Double(compressed)
+	) << Newline;
+
+}
+
+
+//	Trains a dictionary the way zstd --train
+//	would from saved columns
+static Vector<Byte> train (const Vector<Vector<Byte>> & columns) {
+
+	Vector<Byte> samples(columns.Count()*ColumnContainer::Size);
+	Vector<size_t> sizes(columns.Count());
+	for (auto & column : columns) {
+	
+		std::memcpy(samples.begin()+samples.Count(),column.begin(),column.Count());
+		samples.SetCount(samples.Count()+column.Count());
+		sizes.Add(column.Count());
+	
+	}
+	
+	Vector<Byte> retr(dictionary_size);
+	auto size=ZDICT_trainFromBuffer(
+		retr.begin(),
+		retr.Capacity(),
+		samples.begin(),
+		sizes.begin(),
+		static_cast<unsigned>(sizes.Count())
+	);
+	if (ZDICT_isError(size)) throw std::runtime_error(training_failed);
+	retr.SetCount(size);
+	
+	return retr;
+
+}
+
+
+int Main (const Vector<const String> & args) {
+
+	Word radius=default_radius;
+	SByte dimension=default_dimension;
+	if (!(
+		(args.Count()<=2) &&
+		((args.Count()<1) || args[0].ToInteger(&radius)) &&
+		((args.Count()<2) || args[1].ToInteger(&dimension))
+	)) {
+	
+		StdOut << usage << Newline;
+		
+		return EXIT_FAILURE;
+	
+	}
+	
+	//	Columns are read from wherever the server
+	//	is configured to save them
+	std::unique_ptr<DataProvider> data(DataProvider::GetDataProvider());
+	Columns loaded(*data,radius,dimension);
+	auto & columns=loaded.Decoded;
+	
+	StdOut << String::Format(
+		loaded_banner,
+		columns.Count(),
+		loaded.Zlib,
+		loaded.Zstd,
+		loaded.Legacy,
+		radius,
+		dimension
+	) << Newline;
+	
+	if (columns.Count()==0) {
+	
+		StdOut << none_found << Newline;
+		
+		return EXIT_FAILURE;
+	
+	}
+	
+	StdOut << String::Format(banner,get_passes(columns),columns.Count(),ColumnContainer::Size) << Newline;
+	
+	run("Fastest, new stream",columns,[] (const Vector<Byte> & column) {	return fresh(column,Deflater::FastestLevel);	});
+	run("Fastest, reused stream",columns,[] (const Vector<Byte> & column) {
+	
+		return Deflate(column.begin(),column.end(),false,Deflater::FastestLevel).Count();
+	
+	});
+	run("Best, new stream",columns,[] (const Vector<Byte> & column) {	return fresh(column,Deflater::BestLevel);	});
+	run("Best, reused stream",columns,[] (const Vector<Byte> & column) {
+	
+		return Deflate(column.begin(),column.end(),false,Deflater::BestLevel).Count();
+	
+	});
+	//	Sending and saving on the same thread
+	//	alternate between levels
+	run("Alternating, reused streams",columns,[] (const Vector<Byte> & column) {
+	
+		return (
+			Deflate(column.begin(),column.end(),false,Deflater::FastestLevel).Count()+
+			Deflate(column.begin(),column.end(),false,Deflater::BestLevel).Count()
+		);
+	
+	},2);
+	
+	StdOut << String::Format(codec_banner,get_passes(columns),columns.Count(),ColumnContainer::Size) << Newline;
+	
+	run_codec("ZLib, fastest",columns,ZlibCodec(Deflater::FastestLevel));
+	run_codec("ZLib, best",columns,ZlibCodec(Deflater::BestLevel));
+	run_codec("Zstandard",columns,ZstdCodec());
+	
+	//	A dictionary is only worth what it does
+	//	for columns it wasn't trained on, so half
+	//	the columns train it, and it and the codecs
+	//	without it are measured on the other half
+	if (columns.Count()<2) return EXIT_SUCCESS;
+	
+	Vector<Vector<Byte>> training;
+	Vector<Vector<Byte>> testing;
+	for (Word i=0;i<columns.Count();++i) (((i%2)==0) ? training : testing).Add(columns[i]);
+	
+	auto dictionary=train(training);
+	
+	StdOut << String::Format(trained_banner,dictionary.Count(),training.Count(),testing.Count()) << Newline;
+	
+	run_codec("ZLib, best",testing,ZlibCodec(Deflater::BestLevel));
+	run_codec("Zstandard",testing,ZstdCodec());
+	run_codec("Zstandard, dictionary",testing,ZstdCodec(ZstdCodec::DefaultLevel,dictionary.begin(),dictionary.end()));
+	
+	return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,135 @@
+#include <rleahylib/rleahylib.hpp>
+#include <rleahylib/main.hpp>
+#include <http_handler.hpp>
+#include <network.hpp>
+#include <thread_pool.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+
+using namespace MCPP;
+
+
+static const Word default_requests=5000;
+static const Word default_max_connections=0;
+static const UInt16 default_port=8099;
+static const Word threads=4;
+static const String usage("Usage: bench_http [requests] [max connections per host] [port]");
+static const String banner("HTTP ({0} concurrent requests to a local stub, at most {1} connections per host):");
+static const String result(
+	"{0} succeeded, {1} failed in {2} ms ({3} requests/s)\n"
+	"The stub accepted {4} connections"
+);
+static const String url("http://127.0.0.1:{0}/");
+static const char response []="HTTP/1.1 200 OK\r\nContent-Length: 2\r\nContent-Type: text/plain\r\n\r\nOK";
+static const char terminator []="\r\n\r\n";
+
+
+//	Answers every request it receives with
+//	the same short response, keeping the
+//	connection alive so that cURL may reuse
+//	it
+static void respond (ReceiveEvent event) {
+
+	auto & buffer=event.Buffer;
+	Word len=sizeof(terminator)-1;
+	Word consumed=0;
+	for (Word i=0;(i+len)<=buffer.Count();++i) {
+	
+		if (std::memcmp(buffer.begin()+i,terminator,len)!=0) continue;
+		
+		Vector<Byte> send(sizeof(response)-1);
+		std::memcpy(send.begin(),response,sizeof(response)-1);
+		send.SetCount(sizeof(response)-1);
+		event.Conn->Send(std::move(send));
+		
+		i+=len-1;
+		consumed=i+1;
+	
+	}
+	
+	//	Keep whatever follows the last complete
+	//	request
+	Word remaining=buffer.Count()-consumed;
+	std::memmove(buffer.begin(),buffer.begin()+consumed,remaining);
+	buffer.SetCount(remaining);
+
+}
+
+
+int Main (const Vector<const String> & args) {
+
+	Word requests=default_requests;
+	Word max_connections=default_max_connections;
+	UInt16 port=default_port;
+	if (!(
+		(args.Count()<=3) &&
+		((args.Count()<1) || args[0].ToInteger(&requests)) &&
+		((args.Count()<2) || args[1].ToInteger(&max_connections)) &&
+		((args.Count()<3) || args[2].ToInteger(&port))
+	)) {
+	
+		StdOut << usage << Newline;
+		
+		return EXIT_FAILURE;
+	
+	}
+	
+	ThreadPool pool(threads);
+	ConnectionHandler handler(pool,threads);
+	
+	std::atomic<Word> accepted(0);
+	LocalEndpoint ep;
+	ep.IP=IPAddress(String("127.0.0.1"));
+	ep.Port=port;
+	ep.Accept=[] (AcceptEvent) {	return true;	};
+	ep.Connect=[&] (ConnectEvent) {	++accepted;	};
+	ep.Disconnect=[] (DisconnectEvent) {	};
+	ep.Receive=respond;
+	handler.Listen(std::move(ep));
+	
+	HTTPHandler http;
+	http.SetMaxHostConnections(max_connections);
+	
+	StdOut << String::Format(banner,requests,max_connections) << Newline;
+	
+	//	Every request is started before any is
+	//	waited on, so that they are all in flight
+	//	at once, well beyond what select could
+	//	wait on
+	auto timer=Timer::CreateAndStart();
+	Vector<Promise<HTTPResponse>> promises(requests);
+	auto address=String::Format(url,port);
+	for (Word i=0;i<requests;++i) promises.Add(http.Execute(HTTPRequest(address)));
+	
+	Word succeeded=0;
+	Word failed=0;
+	for (auto & promise : promises) {
+	
+		try {
+		
+			if (promise.Wait().Status==200) ++succeeded;
+			else ++failed;
+		
+		} catch (...) {
+		
+			++failed;
+		
+		}
+	
+	}
+	auto elapsed=timer.ElapsedMilliseconds();
+	
+	StdOut << String::Format(
+		result,
+		succeeded,
+		failed,
+		elapsed,
+		(elapsed==0) ? Double(requests) : ((Double(requests)*1000)/Double(elapsed)),
+		Word(accepted)
+	) << Newline;
+	
+	return (failed==0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
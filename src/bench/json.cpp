@@ -0,0 +1,90 @@
+#include <rleahylib/rleahylib.hpp>
+#include <rleahylib/main.hpp>
+#include <json.hpp>
+#include <packet.hpp>
+#include <cstdlib>
+
+
+using namespace MCPP;
+
+
+static const Word iterations=20000;
+static const Word players=20;
+static const String banner("JSON ({0} iterations of {1} bytes):");
+static const String result("{0}: {1} MB/s");
+
+
+//	Builds a server list ping response like
+//	the one the ping module sends, with a
+//	description which is mostly ASCII but
+//	has escapes and multi-byte characters
+static String get_json () {
+
+	String retr(
+		"{\"version\":{\"name\":\"1.7.10\",\"protocol\":5},"
+		"\"description\":{\"text\":\"A Minecraft Server \\u00A7a\\u00A7lOnline\\n"
+		"Welcome à tous — 欢迎 \\\"friends\\\"\"},"
+		"\"players\":{\"max\":1000,\"online\":12345.5,\"sample\":["
+	);
+	
+	for (Word i=0;i<players;++i) {
+	
+		if (i!=0) retr << ",";
+		retr << "{\"name\":\"Player_" << String(i) << "\",\"id\":\"4566e69f-c907-48ee-8d71-d7ba5aa00d" << String(i) << "\"}";
+	
+	}
+	
+	retr << "]}}";
+	
+	return retr;
+
+}
+
+
+template <typename T>
+static void run (const String & name, Word bytes, T callback) {
+
+	auto timer=Timer::CreateAndStart();
+	for (Word i=0;i<iterations;++i) callback();
+	auto elapsed=timer.ElapsedNanoseconds();
+	
+	Double total=Double(bytes)*Double(iterations);
+	
+	StdOut << String::Format(
+		result,
+		name,
+		(total/(1024*1024))/(Double(elapsed)/1000000000)
+	) << Newline;
+
+}
+
+
+int Main (const Vector<const String> &) {
+
+	auto json=get_json();
+	auto encoded=UTF8().Encode(json);
+	auto value=JSON::Parse(encoded.begin(),encoded.end());
+	
+	StdOut << String::Format(banner,iterations,encoded.Count()) << Newline;
+	
+	run("Parse, String",encoded.Count(),[&] () {	JSON::Parse(json);	});
+	run("Parse, UTF-8",encoded.Count(),[&] () {	JSON::Parse(encoded.begin(),encoded.end());	});
+	run("Serialize, String",encoded.Count(),[&] () {	JSON::Serialize(value);	});
+	run("Serialize, UTF-8",encoded.Count(),[&] () {
+	
+		Vector<Byte> buffer;
+		JSON::Serialize(buffer,value);
+	
+	});
+	//	What sending a packet with JSON in it
+	//	costs
+	run("Serialize, packet",encoded.Count(),[&] () {
+	
+		Vector<Byte> buffer;
+		Serializer<JSON::Value>::ToBytes(buffer,value);
+	
+	});
+	
+	return EXIT_SUCCESS;
+
+}
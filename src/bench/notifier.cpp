@@ -0,0 +1,253 @@
+#include <rleahylib/rleahylib.hpp>
+#include <rleahylib/main.hpp>
+#include <load_test/load_test.hpp>
+#include <network.hpp>
+#include <thread_pool.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <sys/resource.h>
+#include <sys/time.h>
+
+
+using namespace MCPP;
+using namespace MCPP::LoadTest;
+
+
+namespace MCPP {
+
+
+	namespace Bench {
+	
+	
+		//	The number of system calls made to move
+		//	messages so far, see syscalls.cpp
+		std::size_t Syscalls () noexcept;
+	
+	
+	}
+
+
+}
+
+
+static const Word default_connections=16;
+static const Word default_seconds=5;
+static const UInt16 default_port=8098;
+static const Word threads=4;
+static const Word connect_timeout=5000;
+static const Word warm_up=500;
+static const Word drain=200;
+static const String usage("Usage: bench_notifier [connections] [seconds] [port]");
+static const String banner(
+	"Network ({0} connections over TCP loopback, each echoing one timestamp at a time, for {1} s):"
+);
+static const String connect_failed("Only {0} of {1} connections connected");
+static const String round_trip_name("Round trip");
+static const String result(
+	"{0} round trips/s, {1} messages\n"
+	"{2} send, recv, read, write, epoll_wait and epoll_ctl calls per message\n"
+	"{3} context switches per message"
+);
+
+
+//	Timestamps are measured from here
+static Timer epoch(Timer::CreateAndStart());
+static std::atomic<bool> stop;
+static std::atomic<bool> measuring;
+static std::atomic<Word> connected;
+static std::atomic<Word> round_trips;
+static Histogram latency;
+
+
+static void wait_for (Word milliseconds) {
+
+	Mutex lock;
+	CondVar wait;
+	lock.Execute([&] () mutable {	wait.Sleep(lock,milliseconds);	});
+
+}
+
+
+static void send_time (Connection & conn) {
+
+	UInt64 now=epoch.ElapsedNanoseconds();
+	
+	Vector<Byte> buffer(sizeof(now));
+	std::memcpy(buffer.begin(),&now,sizeof(now));
+	buffer.SetCount(sizeof(now));
+	
+	conn.Post(std::move(buffer));
+
+}
+
+
+//	Invokes a callback for each whole timestamp
+//	in a buffer, keeping whatever follows the last
+template <typename T>
+static void each_time (Vector<Byte> & buffer, T callback) {
+
+	Word consumed=0;
+	for (;(consumed+sizeof(UInt64))<=buffer.Count();consumed+=sizeof(UInt64)) {
+	
+		UInt64 time;
+		std::memcpy(&time,buffer.begin()+consumed,sizeof(time));
+		callback(time);
+	
+	}
+	
+	Word remaining=buffer.Count()-consumed;
+	std::memmove(buffer.begin(),buffer.begin()+consumed,remaining);
+	buffer.SetCount(remaining);
+
+}
+
+
+//	The listening end sends back every
+//	timestamp it receives
+static void echo (ReceiveEvent event) {
+
+	each_time(event.Buffer,[&] (UInt64 time) mutable {
+	
+		Vector<Byte> buffer(sizeof(time));
+		std::memcpy(buffer.begin(),&time,sizeof(time));
+		buffer.SetCount(sizeof(time));
+		
+		event.Conn->Post(std::move(buffer));
+	
+	});
+
+}
+
+
+//	The connecting end times each timestamp's
+//	round trip, and sends the next
+static void bounce (ReceiveEvent event) {
+
+	each_time(event.Buffer,[&] (UInt64 time) mutable {
+	
+		if (measuring) {
+		
+			latency.Add(epoch.ElapsedNanoseconds()-time);
+			++round_trips;
+		
+		}
+		
+		if (!stop) send_time(*event.Conn);
+	
+	});
+
+}
+
+
+static Word get_switches () noexcept {
+
+	struct rusage info;
+	getrusage(RUSAGE_SELF,&info);
+	
+	return static_cast<Word>(info.ru_nvcsw+info.ru_nivcsw);
+
+}
+
+
+int Main (const Vector<const String> & args) {
+
+	Word connections=default_connections;
+	Word seconds=default_seconds;
+	UInt16 port=default_port;
+	if (!(
+		(args.Count()<=3) &&
+		((args.Count()<1) || args[0].ToInteger(&connections)) &&
+		((args.Count()<2) || args[1].ToInteger(&seconds)) &&
+		((args.Count()<3) || args[2].ToInteger(&port))
+	)) {
+	
+		StdOut << usage << Newline;
+		
+		return EXIT_FAILURE;
+	
+	}
+	
+	StdOut << String::Format(banner,connections,seconds) << Newline;
+	
+	stop=false;
+	measuring=false;
+	connected=0;
+	round_trips=0;
+	
+	ThreadPool pool(threads);
+	ConnectionHandler handler(pool,threads);
+	
+	LocalEndpoint local;
+	local.IP=IPAddress(String("127.0.0.1"));
+	local.Port=port;
+	local.Accept=[] (AcceptEvent) {	return true;	};
+	local.Connect=[] (ConnectEvent) {	};
+	local.Disconnect=[] (DisconnectEvent) {	};
+	local.Receive=echo;
+	handler.Listen(std::move(local));
+	
+	for (Word i=0;i<connections;++i) {
+	
+		RemoteEndpoint remote;
+		remote.IP=IPAddress(String("127.0.0.1"));
+		remote.Port=port;
+		remote.Connect=[] (ConnectEvent event) {
+		
+			if (event.Conn.IsNull()) return;
+			
+			++connected;
+			
+			send_time(*event.Conn);
+		
+		};
+		remote.Disconnect=[] (DisconnectEvent) {	};
+		remote.Receive=bounce;
+		handler.Connect(std::move(remote));
+	
+	}
+	
+	for (Word waited=0;(connected!=connections) && (waited<connect_timeout);waited+=warm_up) wait_for(warm_up);
+	if (connected!=connections) {
+	
+		StdOut << String::Format(connect_failed,Word(connected),connections) << Newline;
+		
+		return EXIT_FAILURE;
+	
+	}
+	
+	wait_for(warm_up);
+	
+	//	Only what happens while measuring counts,
+	//	not connecting or warming up
+	auto syscalls=Bench::Syscalls();
+	auto switches=get_switches();
+	auto timer=Timer::CreateAndStart();
+	measuring=true;
+	
+	wait_for(seconds*1000);
+	
+	measuring=false;
+	auto elapsed=timer.ElapsedNanoseconds();
+	syscalls=Bench::Syscalls()-syscalls;
+	switches=get_switches()-switches;
+	
+	stop=true;
+	wait_for(drain);
+	
+	//	Each round trip is a message each way
+	Word messages=Word(round_trips)*2;
+	Double per=(messages==0) ? 0 : (Double(1)/Double(messages));
+	
+	StdOut << String::Format(
+		result,
+		(elapsed==0) ? Double(0) : ((Double(round_trips)*1000000000)/Double(elapsed)),
+		messages,
+		Double(syscalls)*per,
+		Double(switches)*per
+	) << Newline << latency.ToString(round_trip_name) << Newline;
+	
+	return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,461 @@
+#include <rleahylib/rleahylib.hpp>
+#include <rleahylib/main.hpp>
+#include <server.hpp>
+#include <world/world.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+
+using namespace MCPP;
+
+
+//	Columns far from spawn, so that the
+//	columns players see are not touched
+static const Int32 origin=10000;
+//	The width of the square of columns
+//	which transactions contend for
+static const Int32 width=4;
+static const Word ordered_threads=4;
+static const Word unordered_threads=4;
+//	Each of these threads has a square
+//	of columns all to itself
+static const Word disjoint_threads=2;
+static const Int32 disjoint_width=2;
+static const Word dirty_threads=2;
+static const Word default_seconds=10;
+//	How long without any thread making
+//	progress is taken to be a deadlock,
+//	in milliseconds
+static const Word deadlock_timeout=5000;
+static const Word check_interval=100;
+//	Counters are kept in the block type
+//	of the topmost block of each column
+static const Byte counter_y=255;
+static const Byte dirty_y=254;
+static const UInt16 counter_range=256;
+static const String usage("Usage: bench_ownership [seconds]");
+static const String banner(
+	"Column ownership ({0}x{0} shared columns, {1} ordered, {2} unordered, {3} disjoint, and {4} dirty threads for {5} s):"
+);
+static const String misuse_failed("Touching a column owned by another handle on the same thread did not throw");
+static const char * not_retrieved="Column could not be retrieved";
+static const String deadlocked("No thread made progress for {0} ms, deadlocked");
+static const String result(
+	"{0} transactions, {1} reacquired their columns, {2} dirty writes\n"
+	"{3} transactions saw a column they owned change, {4} updates were lost, {5} threads threw"
+);
+
+
+static std::atomic<bool> stop;
+static std::atomic<Word> progress;
+static std::atomic<Word> transactions;
+static std::atomic<Word> reacquisitions;
+static std::atomic<Word> dirty_writes;
+static std::atomic<Word> violations;
+static std::atomic<Word> errors;
+//	The number of times each column's counter
+//	was incremented
+static std::unique_ptr<std::atomic<Word> []> increments;
+static std::unique_ptr<UInt16 []> initial;
+
+
+static const Int32 disjoint_origin=origin+width;
+static const Word total_columns=(width*width)+(disjoint_threads*disjoint_width*disjoint_width);
+
+
+static ColumnID get_column (Int32 x, Int32 z) noexcept {
+
+	return ColumnID{origin+x,origin+z,0};
+
+}
+
+
+//	Thread i of the disjoint threads owns a
+//	square beside the shared square
+static ColumnID get_disjoint (Word thread, Int32 x, Int32 z) noexcept {
+
+	return ColumnID{disjoint_origin+(static_cast<Int32>(thread)*disjoint_width)+x,origin+z,0};
+
+}
+
+
+static Word get_index (ColumnID id) noexcept {
+
+	Int32 x=id.X-origin;
+	Int32 z=id.Z-origin;
+	
+	if (x<width) return static_cast<Word>((x*width)+z);
+	
+	return static_cast<Word>(width*width)+static_cast<Word>(((x-width)*disjoint_width)+z);
+
+}
+
+
+static BlockID get_counter (ColumnID id) noexcept {
+
+	return BlockID{id.X*16,counter_y,id.Z*16,id.Dimension};
+
+}
+
+
+//	Increments the counter of each column, all
+//	of which the handle must already own, and
+//	makes sure no one else changed them while
+//	it did
+static void increment (const WorldHandle & handle, const Vector<ColumnID> & ids) {
+
+	Vector<UInt16> expected(ids.Count());
+	for (auto & id : ids) {
+	
+		auto counter=get_counter(id);
+		UInt16 value=(handle.Get(counter).GetType()+1)%counter_range;
+		handle.Set(counter,Block(value),true);
+		expected.Add(value);
+	
+	}
+	
+	for (Word i=0;i<ids.Count();++i) {
+	
+		if (handle.Get(get_counter(ids[i])).GetType()!=expected[i]) ++violations;
+		
+		++increments[get_index(ids[i])];
+	
+	}
+	
+	++transactions;
+
+}
+
+
+//	Acquires a rectangle of columns up front,
+//	and therefore never relinquishes them
+static void ordered (std::mt19937 & gen, Word) {
+
+	std::uniform_int_distribution<Int32> dist(0,width-1);
+	
+	auto a=get_column(dist(gen),dist(gen));
+	auto b=get_column(dist(gen),dist(gen));
+	
+	auto handle=World::Get().Begin(BlockWriteStrategy::Transactional);
+	if (!handle.Acquire(a,b)) throw std::runtime_error(not_retrieved);
+	
+	Int32 min_x=(a.X<b.X) ? a.X : b.X;
+	Int32 max_x=(a.X<b.X) ? b.X : a.X;
+	Int32 min_z=(a.Z<b.Z) ? a.Z : b.Z;
+	Int32 max_z=(a.Z<b.Z) ? b.Z : a.Z;
+	Vector<ColumnID> ids;
+	for (Int32 x=min_x;x<=max_x;++x) for (Int32 z=min_z;z<=max_z;++z) ids.Add(ColumnID{x,z,0});
+	
+	increment(handle,ids);
+	
+	if (handle.Reacquired()!=0) ++violations;
+
+}
+
+
+//	Touches columns in any order before writing
+//	any.  The counters are only read once every
+//	column is owned, so no update may be lost
+//	even if the handle relinquished its columns
+//	meanwhile
+static void unordered (std::mt19937 & gen, Word) {
+
+	std::uniform_int_distribution<Int32> dist(0,width-1);
+	std::uniform_int_distribution<Word> count(2,4);
+	
+	Vector<ColumnID> ids;
+	for (Word i=count(gen);i>0;--i) {
+	
+		auto id=get_column(dist(gen),dist(gen));
+		
+		bool found=false;
+		for (auto & curr : ids) if (curr==id) found=true;
+		if (!found) ids.Add(id);
+	
+	}
+	
+	auto handle=World::Get().Begin(BlockWriteStrategy::Transactional);
+	for (auto & id : ids) handle.Get(get_counter(id));
+	
+	if (handle.Reacquired()!=0) ++reacquisitions;
+	
+	increment(handle,ids);
+
+}
+
+
+//	Touches only columns no other thread
+//	touches, and therefore never contends
+static void disjoint (std::mt19937 & gen, Word thread) {
+
+	std::uniform_int_distribution<Int32> dist(0,disjoint_width-1);
+	
+	Vector<ColumnID> ids;
+	for (Word i=0;i<2;++i) {
+	
+		auto id=get_disjoint(thread,dist(gen),dist(gen));
+		if ((ids.Count()==0) || !(ids[0]==id)) ids.Add(id);
+	
+	}
+	
+	auto handle=World::Get().Begin(BlockWriteStrategy::Transactional);
+	increment(handle,ids);
+	
+	if (handle.Reacquired()!=0) ++violations;
+
+}
+
+
+//	Writes beside the counters, waiting for
+//	whichever transaction owns the column
+static void dirty (std::mt19937 & gen, Word) {
+
+	std::uniform_int_distribution<Int32> dist(0,width-1);
+	
+	auto id=get_column(dist(gen),dist(gen));
+	
+	World::Get().Begin().Set(
+		BlockID{id.X*16,dirty_y,id.Z*16,id.Dimension},
+		Block(UInt16(gen()%counter_range)),
+		true
+	);
+	
+	++dirty_writes;
+
+}
+
+
+//	A second handle on the thread which owns
+//	a column must not wait for it
+static bool check_misuse () {
+
+	auto & world=World::Get();
+	auto counter=get_counter(get_column(0,0));
+	
+	auto a=world.Begin(BlockWriteStrategy::Transactional);
+	a.Get(counter);
+	
+	try {
+	
+		auto b=world.Begin(BlockWriteStrategy::Transactional);
+		b.Get(counter);
+	
+	} catch (const std::logic_error &) {
+	
+		return true;
+	
+	}
+	
+	return false;
+
+}
+
+
+static void for_each_column (const std::function<void (ColumnID)> & callback) {
+
+	for (Int32 x=0;x<width;++x) for (Int32 z=0;z<width;++z) callback(get_column(x,z));
+	
+	for (Word t=0;t<disjoint_threads;++t) for (Int32 x=0;x<disjoint_width;++x) for (Int32 z=0;z<disjoint_width;++z) {
+	
+		callback(get_disjoint(t,x,z));
+	
+	}
+
+}
+
+
+static int run (Word seconds) {
+
+	auto & world=World::Get();
+	
+	StdOut << String::Format(
+		banner,
+		width,
+		ordered_threads,
+		unordered_threads,
+		disjoint_threads,
+		dirty_threads,
+		seconds
+	) << Newline;
+	
+	if (!check_misuse()) {
+	
+		StdOut << misuse_failed << Newline;
+		
+		return EXIT_FAILURE;
+	
+	}
+	
+	increments=std::unique_ptr<std::atomic<Word> []>(new std::atomic<Word> [total_columns]);
+	initial=std::unique_ptr<UInt16 []>(new UInt16 [total_columns]);
+	{
+	
+		auto handle=world.Begin(BlockWriteStrategy::Exclusive);
+		for_each_column([&] (ColumnID id) mutable {
+		
+			auto i=get_index(id);
+			increments[i]=0;
+			initial[i]=handle.Get(get_counter(id)).GetType();
+		
+		});
+	
+	}
+	
+	stop=false;
+	progress=0;
+	transactions=0;
+	reacquisitions=0;
+	dirty_writes=0;
+	violations=0;
+	errors=0;
+	
+	Vector<Thread> threads;
+	auto start=[&] (Word seed, Word thread, void (* callback) (std::mt19937 &, Word)) {
+	
+		threads.Add(Thread([seed,thread,callback] () mutable {
+		
+			std::mt19937 gen(UInt32(seed));
+			
+			try {
+			
+				while (!stop) {
+				
+					callback(gen,thread);
+					
+					++progress;
+				
+				}
+			
+			} catch (...) {
+			
+				++errors;
+			
+			}
+		
+		}));
+	
+	};
+	Word seed=0;
+	for (Word i=0;i<ordered_threads;++i) start(seed++,i,ordered);
+	for (Word i=0;i<unordered_threads;++i) start(seed++,i,unordered);
+	for (Word i=0;i<disjoint_threads;++i) start(seed++,i,disjoint);
+	for (Word i=0;i<dirty_threads;++i) start(seed++,i,dirty);
+	
+	//	Watch for deadlock until the time
+	//	is up
+	Mutex lock;
+	CondVar wait;
+	auto timer=Timer::CreateAndStart();
+	Word last=0;
+	Word stalled=0;
+	lock.Execute([&] () mutable {
+	
+		while (timer.ElapsedMilliseconds()<(UInt64(seconds)*1000)) {
+		
+			wait.Sleep(lock,check_interval);
+			
+			Word curr=progress;
+			if (curr!=last) {
+			
+				last=curr;
+				stalled=0;
+				
+				continue;
+			
+			}
+			
+			stalled+=check_interval;
+			if (stalled>=deadlock_timeout) {
+			
+				StdOut << String::Format(deadlocked,deadlock_timeout) << Newline;
+				
+				//	The deadlocked threads can
+				//	never be joined
+				std::_Exit(EXIT_FAILURE);
+			
+			}
+		
+		}
+	
+	});
+	
+	stop=true;
+	for (auto & t : threads) t.Join();
+	
+	//	Every increment must be reflected in
+	//	the counters, after which they're put
+	//	back the way they were
+	Word lost=0;
+	{
+	
+		auto handle=world.Begin(BlockWriteStrategy::Exclusive);
+		for_each_column([&] (ColumnID id) mutable {
+		
+			auto i=get_index(id);
+			auto counter=get_counter(id);
+			
+			if (handle.Get(counter).GetType()!=((initial[i]+increments[i])%counter_range)) ++lost;
+			
+			handle.Set(counter,Block(initial[i]),true);
+		
+		});
+	
+	}
+	
+	StdOut << String::Format(
+		result,
+		Word(transactions),
+		Word(reacquisitions),
+		Word(dirty_writes),
+		Word(violations),
+		lost,
+		Word(errors)
+	) << Newline;
+	
+	return ((violations==0) && (lost==0) && (errors==0)) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
+
+
+int Main (const Vector<const String> & args) {
+
+	Word seconds=default_seconds;
+	if (!(
+		(args.Count()<=1) &&
+		((args.Count()<1) || args[0].ToInteger(&seconds))
+	)) {
+	
+		StdOut << usage << Newline;
+		
+		return EXIT_FAILURE;
+	
+	}
+	
+	//	The world, its generators, and the data
+	//	provider columns are loaded from and saved
+	//	to are those the server is configured with
+	auto & server=Server::Get();
+	server.Start();
+	
+	int retr;
+	try {
+	
+		retr=run(seconds);
+	
+	} catch (...) {
+	
+		server.Stop();
+		
+		throw;
+	
+	}
+	
+	server.Stop();
+	
+	return retr;
+
+}
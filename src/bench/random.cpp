@@ -0,0 +1,118 @@
+#include <rleahylib/rleahylib.hpp>
+#include <rleahylib/main.hpp>
+#include <counter_random.hpp>
+#include <cstdlib>
+#include <random>
+
+
+using namespace MCPP;
+
+
+static const Word numbers=100000000;
+static const Word columns=100000;
+static const UInt64 world_seed=0x5DEECE66DULL;
+static const String banner("Random ({0} numbers, {1} columns):");
+static const String throughput_result("{0}: {1} million numbers/s");
+static const String column_result("{0}, {1} numbers per column: {2} ns per column");
+
+
+//	Keeps the compiler from discarding
+//	numbers which are never used
+static volatile UInt64 sink;
+
+
+template <typename T>
+static void throughput (const String & name, T gen) {
+
+	UInt64 sum=0;
+	auto timer=Timer::CreateAndStart();
+	for (Word i=0;i<numbers;++i) sum+=gen();
+	auto elapsed=timer.ElapsedNanoseconds();
+	sink=sum;
+	
+	StdOut << String::Format(
+		throughput_result,
+		name,
+		(Double(numbers)/1000000)/(Double(elapsed)/1000000000)
+	) << Newline;
+
+}
+
+
+template <typename T>
+static void per_column (const String & name, Word count, T get) {
+
+	UInt64 sum=0;
+	auto timer=Timer::CreateAndStart();
+	for (Word i=0;i<columns;++i) {
+	
+		auto gen=get(Int32(i%1024),Int32(i/1024));
+		for (Word n=0;n<count;++n) sum+=gen();
+	
+	}
+	auto elapsed=timer.ElapsedNanoseconds();
+	sink=sum;
+	
+	StdOut << String::Format(
+		column_result,
+		name,
+		count,
+		Double(elapsed)/Double(columns)
+	) << Newline;
+
+}
+
+
+//	How World::GetRandom<std::mt19937> (ColumnID)
+//	seeded a generator for each column before
+//	CounterRandom
+static std::mt19937 get_mt19937 (Int32 x, Int32 z) {
+
+	Word seed=23;
+	seed*=31;
+	seed+=world_seed;
+	seed*=31;
+	seed+=static_cast<UInt32>(x);
+	seed*=31;
+	seed+=static_cast<UInt32>(z);
+	
+	std::seed_seq seq({seed});
+	
+	return std::mt19937(seq);
+
+}
+
+
+//	How World::GetRandom (ColumnID) keys a
+//	generator for each column
+static CounterRandom get_counter (Int32 x, Int32 z) {
+
+	UInt64 coords=static_cast<UInt32>(x);
+	coords|=static_cast<UInt64>(static_cast<UInt32>(z))<<32;
+	
+	return CounterRandom(world_seed).Branch(coords).Branch(0);
+
+}
+
+
+int Main (const Vector<const String> &) {
+
+	StdOut << String::Format(banner,numbers,columns) << Newline;
+	
+	throughput("std::mt19937",std::mt19937(UInt32(world_seed)));
+	throughput("std::mt19937_64",std::mt19937_64(world_seed));
+	throughput("CounterRandom",CounterRandom(world_seed));
+	
+	//	Populators draw few numbers per
+	//	column, so the cost of seeding
+	//	dominates
+	for (Word count : {16,256,4096}) {
+	
+		per_column("std::mt19937",count,get_mt19937);
+		per_column("CounterRandom",count,get_counter);
+	
+	}
+	
+	return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,131 @@
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <dlfcn.h>
+
+
+//	Counts the system calls the connection
+//	handler makes to move messages, by standing
+//	in for the C library's wrappers.  The system
+//	headers which declare them are not included
+//	so that these definitions need not match
+//	their exception specifications
+
+
+static std::atomic<std::size_t> count(0);
+
+
+//	Object pointers may not be cast to function
+//	pointers in ISO C++, so the pointer dlsym
+//	returns is copied instead
+template <typename T>
+static T get_real (const char * name) noexcept {
+
+	void * ptr=dlsym(RTLD_NEXT,name);
+	
+	T retr;
+	std::memcpy(&retr,&ptr,sizeof(retr));
+	
+	return retr;
+
+}
+
+
+namespace MCPP {
+
+
+	namespace Bench {
+	
+	
+		std::size_t Syscalls () noexcept {
+		
+			return count;
+		
+		}
+	
+	
+	}
+
+
+}
+
+
+struct epoll_event;
+
+
+extern "C" {
+
+
+	std::ptrdiff_t send (int fd, const void * buffer, std::size_t len, int flags) {
+	
+		typedef std::ptrdiff_t (* type) (int, const void *, std::size_t, int);
+		static const type real=get_real<type>("send");
+		
+		++count;
+		
+		return real(fd,buffer,len,flags);
+	
+	}
+	
+	
+	std::ptrdiff_t recv (int fd, void * buffer, std::size_t len, int flags) {
+	
+		typedef std::ptrdiff_t (* type) (int, void *, std::size_t, int);
+		static const type real=get_real<type>("recv");
+		
+		++count;
+		
+		return real(fd,buffer,len,flags);
+	
+	}
+	
+	
+	std::ptrdiff_t read (int fd, void * buffer, std::size_t len) {
+	
+		typedef std::ptrdiff_t (* type) (int, void *, std::size_t);
+		static const type real=get_real<type>("read");
+		
+		++count;
+		
+		return real(fd,buffer,len);
+	
+	}
+	
+	
+	std::ptrdiff_t write (int fd, const void * buffer, std::size_t len) {
+	
+		typedef std::ptrdiff_t (* type) (int, const void *, std::size_t);
+		static const type real=get_real<type>("write");
+		
+		++count;
+		
+		return real(fd,buffer,len);
+	
+	}
+	
+	
+	int epoll_wait (int fd, struct epoll_event * events, int max, int timeout) {
+	
+		typedef int (* type) (int, struct epoll_event *, int, int);
+		static const type real=get_real<type>("epoll_wait");
+		
+		++count;
+		
+		return real(fd,events,max,timeout);
+	
+	}
+	
+	
+	int epoll_ctl (int fd, int op, int target, struct epoll_event * event) {
+	
+		typedef int (* type) (int, int, int, struct epoll_event *);
+		static const type real=get_real<type>("epoll_ctl");
+		
+		++count;
+		
+		return real(fd,op,target,event);
+	
+	}
+
+
+}
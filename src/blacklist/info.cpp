@@ -12,6 +12,7 @@ static const String name("Blacklist Information Provider");
 static const String help("Displays the blacklist.");
 static const String identifier("blacklist");
 static const String blacklist_banner("BLACKLIST:");
+static const String temporary_banner("TEMPORARILY BLACKLISTED:");
 
 
 class BlacklistInfoProvider : public Module, public InformationProvider {
@@ -70,6 +71,20 @@ class BlacklistInfoProvider : public Module, public InformationProvider {
 			
 			for (auto & range : info.Ranges) message << Newline << String(range);
 		
+			if (info.Temporary.Count()==0) return;
+			
+			message	<<	Newline
+					<<	ChatStyle::Bold
+					<<	temporary_banner
+					<<	ChatFormat::Pop;
+			
+			std::sort(
+				info.Temporary.begin(),
+				info.Temporary.end()
+			);
+			
+			for (auto & range : info.Temporary) message << Newline << String(range);
+		
 		}
 
 
@@ -3,6 +3,7 @@
 #include <serializer.hpp>
 #include <server.hpp>
 #include <singleton.hpp>
+#include <algorithm>
 #include <utility>
 
 
@@ -18,6 +19,7 @@ namespace MCPP {
 	static const String save_key("blacklist");
 	static const String verbose_key("blacklist");
 	static const String blacklist("Blacklisting {0}");
+	static const String blacklist_temporary("Blacklisting {0} for {1}ms");
 	static const String unblacklist("Removing {0} from the blacklist");
 	static const String error_parsing("Error parsing blacklist: \"{0}\" at byte {1}");
 	
@@ -29,6 +31,17 @@ namespace MCPP {
 	}
 	
 	
+	static void disconnect (const IPAddressRange & range) {
+	
+		for (auto & client : Server::Get().Clients) {
+		
+			if (range.Check(client->IP())) client->Disconnect(blacklisted);
+		
+		}
+	
+	}
+	
+	
 	void Blacklist::save () const {
 	
 		ByteBuffer buffer;
@@ -75,6 +88,9 @@ namespace MCPP {
 	}
 	
 	
+	Blacklist::Blacklist () : clock(Timer::CreateAndStart()) {	}
+	
+	
 	static Singleton<Blacklist> singleton;
 	
 	
@@ -108,6 +124,10 @@ namespace MCPP {
 		//	from blacklisted IPs
 		server.OnAccept.Add([this] (IPAddress ip, UInt16, IPAddress, UInt16) {	return !Check(ip);	});
 		
+		//	Hosts which connect too quickly are
+		//	blacklisted for a time
+		server.OnAcceptLimit.Add([this] (IPAddressRange range, Word milliseconds) {	Add(range,milliseconds);	});
+		
 		//	Load blacklists from backing store
 		load();
 		
@@ -123,6 +143,13 @@ namespace MCPP {
 		
 			for (auto & range : ranges) if (range.Check(ip)) return true;
 			
+			if (temporary.size()!=0) {
+			
+				auto now=clock.ElapsedMilliseconds();
+				for (auto & pair : temporary) if ((now<pair.second) && pair.first.Check(ip)) return true;
+			
+			}
+			
 			return false;
 		
 		});
@@ -136,11 +163,7 @@ namespace MCPP {
 		//	blacklisted IP ranges
 		if (lock.Write([&] () mutable {	return ranges.insert(range).second;	})) {
 		
-			for (auto & client : Server::Get().Clients) {
-			
-				if (range.Check(client->IP())) client->Disconnect(blacklisted);
-			
-			}
+			disconnect(range);
 			
 			if (is_verbose()) Server::Get().WriteLog(
 				String::Format(
@@ -155,6 +178,40 @@ namespace MCPP {
 	}
 	
 	
+	void Blacklist::Add (IPAddressRange range, Word milliseconds) {
+	
+		lock.Write([&] () mutable {
+		
+			auto now=clock.ElapsedMilliseconds();
+			
+			//	Forget ranges which are no longer
+			//	blacklisted
+			for (auto iter=temporary.begin();iter!=temporary.end();) {
+			
+				if (now>=iter->second) iter=temporary.erase(iter);
+				else ++iter;
+			
+			}
+			
+			auto & expires=temporary[range];
+			expires=std::max(expires,now+milliseconds);
+		
+		});
+		
+		disconnect(range);
+		
+		if (is_verbose()) Server::Get().WriteLog(
+			String::Format(
+				blacklist_temporary,
+				range,
+				milliseconds
+			),
+			Service::LogType::Debug
+		);
+	
+	}
+	
+	
 	void Blacklist::Remove (IPAddressRange range) {
 	
 		if (
@@ -179,6 +236,9 @@ namespace MCPP {
 			
 			retr.Ranges=Vector<IPAddressRange>(ranges.size());
 			for (const auto & range : ranges) retr.Ranges.Add(range);
+			
+			auto now=clock.ElapsedMilliseconds();
+			for (const auto & pair : temporary) if (now<pair.second) retr.Temporary.Add(pair.first);
 		
 		});
 		
@@ -1,5 +1,7 @@
 #include <client.hpp>
 #include <server.hpp>
+#include <algorithm>
+#include <cstring>
 
 
 namespace MCPP {
@@ -112,13 +114,130 @@ namespace MCPP {
 		
 		}
 		
+		//	Anything staged was meant to be
+		//	sent in the clear
+		flush(false);
+		
 		//	Enable encryption
 		encryptor.Construct(key,iv);
 	
 	}
 	
 	
-	Promise<bool> Client::Send (Vector<Byte> buffer) {
+	SendHandle Client::dispatch (Vector<Byte> buffer, bool track) {
+	
+		if (track) return conn->Send(std::move(buffer));
+		
+		conn->Post(std::move(buffer));
+		
+		return SendHandle{};
+	
+	}
+	
+	
+	Vector<Byte> Client::encrypt (Vector<Byte> buffer) {
+	
+		if (encryptor.IsNull()) return buffer;
+		
+		encryptor->BeginEncrypt();
+		auto guard=AtExit([&] () {	encryptor->EndEncrypt();	});
+		
+		return encryptor->Encrypt(buffer);
+	
+	}
+	
+	
+	bool Client::staging () const noexcept {
+	
+		//	Only clients which are playing receive
+		//	enough traffic to be worth batching,
+		//	and logging in is sensitive to latency
+		return (Server::Get().BatchBytes!=0) && (state==ProtocolState::Play);
+	
+	}
+	
+	
+	SendHandle Client::flush (bool track) {
+	
+		if (staged.Count()==0) return SendHandle{};
+		
+		//	Everything staged is encrypted in
+		//	one go, and queued as one send
+		//
+		//	The staged buffer is kept for the next
+		//	tick, so its contents are encrypted or
+		//	copied out rather than moved
+		Vector<Byte> buffer;
+		if (encryptor.IsNull()) {
+		
+			buffer=Vector<Byte>(staged.Count());
+			std::memcpy(buffer.begin(),staged.begin(),staged.Count());
+			buffer.SetCount(staged.Count());
+		
+		} else {
+		
+			encryptor->BeginEncrypt();
+			auto guard=AtExit([&] () {	encryptor->EndEncrypt();	});
+			
+			buffer=encryptor->Encrypt(staged);
+		
+		}
+		
+		//	A single very large send shouldn't leave
+		//	its client holding that much memory
+		//	forever
+		if (staged.Capacity()>Word(SafeWord(Server::Get().BatchBytes)*SafeWord(2))) staged=Vector<Byte>();
+		else staged.SetCount(0);
+		
+		return dispatch(std::move(buffer),track);
+	
+	}
+	
+	
+	SendHandle Client::transmit (Vector<Byte> buffer, bool track, bool urgent) {
+	
+		if (!staging()) {
+		
+			//	Anything staged must go out
+			//	first
+			flush(false);
+			
+			return dispatch(encrypt(std::move(buffer)),track);
+		
+		}
+		
+		Word count=staged.Count();
+		Word total=Word(SafeWord(count)+SafeWord(buffer.Count()));
+		if (staged.Capacity()<total) {
+		
+			//	Grow geometrically, starting from the
+			//	size of a batch, so that appending is
+			//	amortized constant time
+			Word capacity=std::max(staged.Capacity(),Server::Get().BatchBytes);
+			while (capacity<total) capacity=Word(SafeWord(capacity)*SafeWord(2));
+			
+			staged.SetCapacity(capacity);
+		
+		}
+		std::memcpy(staged.end(),buffer.begin(),buffer.Count());
+		staged.SetCount(total);
+		
+		//	A tracked send completes when the
+		//	buffer it's a part of is sent, so
+		//	it goes out at once along with
+		//	everything before it
+		if (
+			track ||
+			urgent ||
+			(staged.Count()>=Server::Get().BatchBytes)
+		) return flush(track);
+		
+		return SendHandle{};
+	
+	}
+	
+	
+	SendHandle Client::send (Vector<Byte> buffer, bool track) {
 	
 		auto & server=Server::Get();
 		
@@ -141,20 +260,28 @@ namespace MCPP {
 		
 		}
 	
-		return lock.Execute([&] () {
-			
-			if (encryptor.IsNull()) return conn->Send(std::move(buffer));
-							
-			encryptor->BeginEncrypt();
-			auto guard=AtExit([&] () {	encryptor->EndEncrypt();	});
-			
-			return conn->Send(
-				encryptor->Encrypt(
-					std::move(buffer)
-				)
-			);
-			
-		});
+		return lock.Execute([&] () {	return transmit(std::move(buffer),track,false);	});
+	
+	}
+	
+	
+	SendHandle Client::Send (Vector<Byte> buffer) {
+	
+		return send(std::move(buffer),true);
+	
+	}
+	
+	
+	void Client::Post (Vector<Byte> buffer) {
+	
+		send(std::move(buffer),false);
+	
+	}
+	
+	
+	void Client::Flush () {
+	
+		lock.Execute([&] () {	flush(false);	});
 	
 	}
 	
@@ -232,14 +359,12 @@ namespace MCPP {
 				
 				auto retr=parser.FromBytes(buffer,state,ProtocolDirection::Serverbound);
 				
-				if (debug) server.WriteLog(
-					String::Format(
-						bytes_consumed,
-						IP(),
-						Port(),
-						before-buffer.Count()
-					),
-					Service::LogType::Debug
+				if (debug) server.Log(
+					Service::LogType::Debug,
+					bytes_consumed,
+					IP(),
+					Port(),
+					before-buffer.Count()
 				);
 				
 				return retr;
@@ -282,14 +407,12 @@ namespace MCPP {
 			//	the decryption buffer
 			auto retr=parser.FromBytes(encryption_buffer,state,ProtocolDirection::Serverbound);
 			
-			if (debug) server.WriteLog(
-				String::Format(
-					bytes_consumed,
-					IP(),
-					Port(),
-					before-encryption_buffer.Count()
-				),
-				Service::LogType::Debug
+			if (debug) server.Log(
+				Service::LogType::Debug,
+				bytes_consumed,
+				IP(),
+				Port(),
+				before-encryption_buffer.Count()
 			);
 			
 			return retr;
@@ -307,14 +430,12 @@ namespace MCPP {
 		
 		auto state=GetState();
 		
-		if (server.LogPacket(retr.ID,state,ProtocolDirection::Serverbound)) server.WriteLog(
-			String::Format(
-				packet_recvd,
-				IP(),
-				Port(),
-				ToString(retr,state,ProtocolDirection::Serverbound)
-			),
-			Service::LogType::Debug
+		if (server.LogPacket(retr.ID,state,ProtocolDirection::Serverbound)) server.Log(
+			Service::LogType::Debug,
+			packet_recvd,
+			IP(),
+			Port(),
+			ToString(retr,state,ProtocolDirection::Serverbound)
 		);
 		
 		return retr;
@@ -417,14 +538,12 @@ namespace MCPP {
 	
 		auto & server=Server::Get();
 	
-		if (server.LogPacket(packet.ID,state,direction)) server.WriteLog(
-			String::Format(
-				packet_sent,
-				IP(),
-				Port(),
-				ToString(packet,state,direction)
-			),
-			Service::LogType::Debug
+		if (server.LogPacket(packet.ID,state,direction)) server.Log(
+			Service::LogType::Debug,
+			packet_sent,
+			IP(),
+			Port(),
+			ToString(packet,state,direction)
 		);
 		
 		if (server.IsVerbose(raw_send_key)) {
@@ -469,7 +588,7 @@ namespace MCPP {
 	
 	void Client::atomic_perform (AtomicType & sends, Vector<Byte> buffer) {
 	
-		sends.Add(Send(std::move(buffer)));
+		sends.Add(send(std::move(buffer),true));
 	
 	}
 
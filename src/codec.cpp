@@ -0,0 +1,348 @@
+#include <compression.hpp>
+#include <zstd.h>
+#include <zstd_errors.h>
+#include <new>
+#include <stdexcept>
+
+
+namespace MCPP {
+
+
+	static const char * zstd_error="Zstandard error";
+	static const char * bound_error="Compressed data exceeded bound";
+	static const char * dictionary_error="Data was compressed with a different Zstandard dictionary";
+	static const String zlib_name("ZLib");
+	static const String zstd_name("Zstandard");
+	//	Encoded data begins with this byte
+	//	followed by the codec's ID.
+	//
+	//	The low nibble of the first byte of
+	//	a ZLib stream is always 8, and GZip
+	//	streams begin with 0x1F, so data
+	//	saved before codecs existed is never
+	//	mistaken for having a header
+	static const Byte header_marker=0xCD;
+	static const Word header_size=2;
+	//	Zstandard data begins with the ID of the
+	//	dictionary it was compressed with, or zero
+	//	if it was compressed without one
+	static const Word dictionary_size=sizeof(UInt32);
+	
+	
+	//	Zstandard contexts are expensive to
+	//	create but cheap to reuse, each thread
+	//	keeps its own
+	class ZstdContexts {
+	
+	
+		private:
+		
+		
+			ZSTD_CCtx * cctx;
+			ZSTD_DCtx * dctx;
+		
+		
+		public:
+		
+		
+			ZstdContexts () noexcept : cctx(nullptr), dctx(nullptr) {	}
+			
+			
+			~ZstdContexts () noexcept {
+			
+				ZSTD_freeCCtx(cctx);
+				ZSTD_freeDCtx(dctx);
+			
+			}
+			
+			
+			ZSTD_CCtx * Compression () {
+			
+				if (cctx==nullptr) {
+				
+					cctx=ZSTD_createCCtx();
+					if (cctx==nullptr) throw std::bad_alloc();
+				
+				}
+				
+				return cctx;
+			
+			}
+			
+			
+			ZSTD_DCtx * Decompression () {
+			
+				if (dctx==nullptr) {
+				
+					dctx=ZSTD_createDCtx();
+					if (dctx==nullptr) throw std::bad_alloc();
+				
+				}
+				
+				return dctx;
+			
+			}
+	
+	
+	};
+	
+	
+	static thread_local ZstdContexts contexts;
+	
+	
+	static Word zstd_result (std::size_t result) {
+	
+		if (ZSTD_isError(result)) {
+		
+			//	The output did not fit
+			if (ZSTD_getErrorCode(result)==ZSTD_error_dstSize_tooSmall) return 0;
+			
+			throw std::runtime_error(zstd_error);
+		
+		}
+		
+		return Word(SafeInt<std::size_t>(result));
+	
+	}
+	
+	
+	CodecError::CodecError (const char * what, UInt32 saved, UInt32 current)
+		:	std::runtime_error(what),
+			saved(saved),
+			current(current)
+	{	}
+	
+	
+	UInt32 CodecError::Saved () const noexcept {
+	
+		return saved;
+	
+	}
+	
+	
+	UInt32 CodecError::Current () const noexcept {
+	
+		return current;
+	
+	}
+	
+	
+	Byte Codec::Identify (const Byte * & begin, const Byte * end) noexcept {
+	
+		if (
+			(static_cast<Word>(end-begin)>=header_size) &&
+			(*begin==header_marker)
+		) {
+		
+			Byte id=begin[1];
+			begin+=header_size;
+			
+			return id;
+		
+		}
+		
+		//	Data without a header predates
+		//	codecs, and is always ZLib or
+		//	GZip
+		return Zlib;
+	
+	}
+	
+	
+	Codec::~Codec () noexcept {	}
+	
+	
+	Vector<Byte> Codec::Encode (const Byte * begin, const Byte * end) const {
+	
+		//	Make room for the largest the output
+		//	could possibly be, so that everything
+		//	is compressed in one go
+		Word bound=Bound(Word(SafeInt<decltype(end-begin)>(end-begin)));
+		Vector<Byte> buffer(Word(SafeWord(bound)+SafeWord(header_size)));
+		
+		buffer.Add(header_marker);
+		buffer.Add(ID());
+		
+		auto written=Compress(begin,end,buffer.end(),bound);
+		
+		//	The bound should always suffice
+		if (written==0) throw std::runtime_error(bound_error);
+		
+		buffer.SetCount(header_size+written);
+		
+		return buffer;
+	
+	}
+	
+	
+	ZlibCodec::ZlibCodec (Int32 level) noexcept : level(level) {	}
+	
+	
+	Byte ZlibCodec::ID () const noexcept {
+	
+		return Zlib;
+	
+	}
+	
+	
+	const String & ZlibCodec::Name () const noexcept {
+	
+		return zlib_name;
+	
+	}
+	
+	
+	Word ZlibCodec::Bound (Word num) const {
+	
+		return DeflateBound(num);
+	
+	}
+	
+	
+	Word ZlibCodec::Compress (const Byte * begin, const Byte * end, void * out, Word max) const {
+	
+		return Deflater::Get(false,level).Deflate(begin,end,out,max,level);
+	
+	}
+	
+	
+	Word ZlibCodec::Decompress (const Byte * begin, const Byte * end, void * out, Word max) const {
+	
+		return Inflater::Get().Inflate(begin,end,out,max);
+	
+	}
+	
+	
+	static UInt32 get_dictionary (const Byte * begin, std::size_t size) noexcept {
+	
+		//	Trained dictionaries carry an ID, raw
+		//	content dictionaries are identified by
+		//	a hash (FNV-1a) of their content
+		UInt32 retr=ZSTD_getDictID_fromDict(begin,size);
+		if (retr!=0) return retr;
+		
+		retr=2166136261UL;
+		for (std::size_t i=0;i<size;++i) {
+		
+			retr^=begin[i];
+			retr*=16777619UL;
+		
+		}
+		
+		//	Zero means no dictionary
+		return (retr==0) ? 1 : retr;
+	
+	}
+	
+	
+	ZstdCodec::ZstdCodec (Int32 level) noexcept : level(level), dictionary(0), cdict(nullptr), ddict(nullptr) {	}
+	
+	
+	ZstdCodec::ZstdCodec (Int32 level, const Byte * begin, const Byte * end) : level(level) {
+	
+		std::size_t size=std::size_t(SafeInt<decltype(end-begin)>(end-begin));
+		
+		dictionary=get_dictionary(begin,size);
+		
+		cdict=ZSTD_createCDict(begin,size,level);
+		if (cdict==nullptr) throw std::runtime_error(zstd_error);
+		
+		ddict=ZSTD_createDDict(begin,size);
+		if (ddict==nullptr) {
+		
+			ZSTD_freeCDict(cdict);
+			
+			throw std::runtime_error(zstd_error);
+		
+		}
+	
+	}
+	
+	
+	ZstdCodec::~ZstdCodec () noexcept {
+	
+		ZSTD_freeCDict(cdict);
+		ZSTD_freeDDict(ddict);
+	
+	}
+	
+	
+	Byte ZstdCodec::ID () const noexcept {
+	
+		return Zstd;
+	
+	}
+	
+	
+	const String & ZstdCodec::Name () const noexcept {
+	
+		return zstd_name;
+	
+	}
+	
+	
+	UInt32 ZstdCodec::Dictionary () const noexcept {
+	
+		return dictionary;
+	
+	}
+	
+	
+	Word ZstdCodec::Bound (Word num) const {
+	
+		return Word(
+			SafeWord(Word(SafeInt<std::size_t>(ZSTD_compressBound(std::size_t(SafeWord(num))))))+
+			SafeWord(dictionary_size)
+		);
+	
+	}
+	
+	
+	Word ZstdCodec::Compress (const Byte * begin, const Byte * end, void * out, Word max) const {
+	
+		if (max<dictionary_size) return 0;
+		
+		auto ptr=static_cast<Byte *>(out);
+		for (Word i=0;i<dictionary_size;++i) ptr[i]=static_cast<Byte>(dictionary>>(i*BitsPerByte()));
+		
+		auto ctx=contexts.Compression();
+		std::size_t size=std::size_t(SafeInt<decltype(end-begin)>(end-begin));
+		
+		auto written=zstd_result(
+			(cdict==nullptr)
+				?	ZSTD_compressCCtx(ctx,ptr+dictionary_size,max-dictionary_size,begin,size,level)
+				:	ZSTD_compress_usingCDict(ctx,ptr+dictionary_size,max-dictionary_size,begin,size,cdict)
+		);
+		
+		return (written==0) ? 0 : (written+dictionary_size);
+	
+	}
+	
+	
+	Word ZstdCodec::Decompress (const Byte * begin, const Byte * end, void * out, Word max) const {
+	
+		if (static_cast<Word>(end-begin)<dictionary_size) throw std::runtime_error(zstd_error);
+		
+		UInt32 id=0;
+		for (Word i=0;i<dictionary_size;++i) id|=UInt32(begin[i])<<(i*BitsPerByte());
+		begin+=dictionary_size;
+		
+		//	Data compressed without a dictionary
+		//	decompresses whether or not there is
+		//	one now, data compressed with one
+		//	only decompresses with that same one
+		if ((id!=0) && (id!=dictionary)) throw CodecError(dictionary_error,id,dictionary);
+		
+		auto ctx=contexts.Decompression();
+		std::size_t size=std::size_t(SafeInt<decltype(end-begin)>(end-begin));
+		
+		return zstd_result(
+			(id==0)
+				?	ZSTD_decompressDCtx(ctx,out,max,begin,size)
+				:	ZSTD_decompress_usingDDict(ctx,out,max,begin,size,ddict)
+		);
+	
+	}
+
+
+}
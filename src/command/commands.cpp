@@ -407,7 +407,7 @@ namespace MCPP {
 			reply p;
 			p.Match=auto_complete(event.From,packet.Text);
 			
-			event.From->Send(p);
+			event.From->Post(p);
 		
 		};
 		
@@ -11,115 +11,276 @@ namespace MCPP {
 
 
 	static const char * zlib_error="ZLib error";
+	static const char * invalid_level="Invalid compression level";
 	static const Word inflate_buffer_default=256;
 	
 	
-	void Inflate (const Byte * begin, const Byte * end, Vector<Byte> * buffer) {
+	static z_stream_s * create_stream () {
+	
+		auto stream=new z_stream_s;
+		stream->zalloc=Z_NULL;
+		stream->zfree=Z_NULL;
+		stream->opaque=Z_NULL;
 		
-		//	Null check
-		if (buffer==nullptr) throw std::out_of_range(NullPointerError);
+		return stream;
+	
+	}
+	
+	
+	static void set_input (z_stream_s * stream, const Byte * begin, const Byte * end) {
+	
+		//	Convert the number of bytes to
+		//	process safely to the target
+		//	integer type and store them
+		//	in stream
+		auto avail=end-begin;
+		stream->avail_in=static_cast<decltype(stream->avail_in)>(SafeInt<decltype(avail)>(avail));
+		//	The ZLib compression/decompression
+		//	functions do not modify the in buffer,
+		//	therefore it should technically be
+		//	const, but it's not so we'll do an
+		//	ugly const_cast here...
+		stream->next_in=const_cast<decltype(stream->next_in)>(
+			reinterpret_cast<const std::remove_pointer<decltype(stream->next_in)>::type *>(
+				begin
+			)
+		);
+	
+	}
+	
+	
+	static void set_output (z_stream_s * stream, void * out, Word max) {
+	
+		stream->next_out=reinterpret_cast<decltype(stream->next_out)>(out);
+		stream->avail_out=static_cast<decltype(stream->avail_out)>(SafeWord(max));
+	
+	}
+	
+	
+	static bool init (z_stream_s * stream, bool gzip, Int32 level) noexcept {
+	
+		return deflateInit2(
+			stream,
+			level,
+			Z_DEFLATED,
+			MAX_WBITS+(gzip ? 16 : 0),
+			8,
+			Z_DEFAULT_STRATEGY
+		)==Z_OK;
 		
-		//	Preserve initial count for atomicity
-		Word initial_count=buffer->Count();
+	}
+	
+	
+	Deflater & Deflater::Get (bool gzip, Int32 level) {
+	
+		if ((level<DefaultLevel) || (level>BestLevel)) throw std::invalid_argument(invalid_level);
 		
-		//	In event of error we roll
-		//	buffer back
-		try {
+		//	One for each format and level, since the
+		//	format of a stream cannot be changed by
+		//	resetting it, and changing the level
+		//	means starting the stream over
+		static thread_local Nullable<Deflater> deflaters [2][BestLevel-DefaultLevel+1];
 		
-			//	Create and initialize a stream
-			z_stream stream;
-			stream.zalloc=Z_NULL;
-			stream.zfree=Z_NULL;
-			stream.opaque=Z_NULL;
-			
-			if (inflateInit2(&stream,32+MAX_WBITS)!=Z_OK) throw std::runtime_error(zlib_error);
-			
-			try {
-			
-				//	Wire input buffer into the stream
-				auto avail=end-begin;
-				stream.avail_in=static_cast<decltype(stream.avail_in)>(SafeInt<decltype(avail)>(avail));
-				stream.next_in=const_cast<decltype(stream.next_in)>(
-					reinterpret_cast<const std::remove_pointer<decltype(stream.next_in)>::type *>(
-						begin
-					)
-				);
-				
-				//	Loop and decompress
-				for (;;) {
-				
-					//	Wire output buffer into stream
-					stream.next_out=reinterpret_cast<decltype(stream.next_out)>(buffer->end());
-					stream.avail_out=static_cast<decltype(stream.avail_out)>(
-						SafeWord(
-							buffer->Capacity()-buffer->Count()
-						)
-					);
-					
-					//	Inflate
-					int result=inflate(&stream,Z_FINISH);
-					
-					//	Update buffer count
-					buffer->SetCount(buffer->Capacity()-stream.avail_out);
-					
-					//	Did we decompress everything?
-					//	If so we're done.
-					if (result==Z_STREAM_END) break;
-					
-					//	Was more buffer space required?
-					if ((result==Z_BUF_ERROR) && (stream.avail_out==0)) {
-					
-						buffer->SetCapacity();
-						
-						continue;
-					
-					}
-					
-					//	Something went wrong, throw
-					throw std::runtime_error(zlib_error);
-				
-				}
-				
-			} catch (...) {
-			
-				//	Make sure stream is
-				//	cleaned up
-				inflateEnd(&stream);
-				
-				throw;
+		auto & deflater=deflaters[gzip ? 1 : 0][level-DefaultLevel];
+		if (deflater.IsNull()) deflater.Construct(gzip,level);
+		
+		return *deflater;
+	
+	}
+	
+	
+	Deflater::Deflater (bool gzip, Int32 level) : stream(create_stream()), gzip(gzip), level(level) {
+	
+		if (!init(stream,gzip,level)) {
+		
+			delete stream;
 			
-			}
+			throw std::runtime_error(zlib_error);
+		
+		}
+	
+	}
+	
+	
+	Deflater::~Deflater () noexcept {
+	
+		deflateEnd(stream);
+		
+		delete stream;
+	
+	}
+	
+	
+	void Deflater::Reset (Int32 level) {
+	
+		if (level==this->level) {
+		
+			if (deflateReset(stream)!=Z_OK) throw std::runtime_error(zlib_error);
+		
+			return;
+		
+		}
+		
+		//	Changing the level of a stream may
+		//	compress what it holds into wherever its
+		//	output last pointed, which belonged to a
+		//	previous caller, so the stream is started
+		//	over instead
+		deflateEnd(stream);
+		if (!init(stream,gzip,level)) throw std::runtime_error(zlib_error);
 			
-			inflateEnd(&stream);
+		this->level=level;
+	
+	}
+	
+	
+	Word Deflater::Bound (Word num) const {
+	
+		//	Safely convert the input number to
+		//	the type that deflateBound expects
+		typedef FunctionInformation<decltype(deflateBound)>::ArgumentType<1>::Type LengthType;
 		
-		} catch (...) {
+		LengthType z_num=LengthType(SafeWord(num));
 		
-			//	Roll buffer back
-			buffer->SetCount(initial_count);
+		//	deflateBound only reads the stream's
+		//	parameters
+		auto bound=deflateBound(stream,z_num);
+		
+		return Word(SafeInt<decltype(bound)>(bound));
+	
+	}
+	
+	
+	bool Deflater::Write (const Byte * & begin, const Byte * end, Byte * & out, Byte * out_end, bool finish) {
+	
+		set_input(stream,begin,end);
+		set_output(stream,out,Word(out_end-out));
+		
+		int result=deflate(stream,finish ? Z_FINISH : Z_NO_FLUSH);
+		
+		begin=reinterpret_cast<const Byte *>(stream->next_in);
+		out=reinterpret_cast<Byte *>(stream->next_out);
+		
+		if (result==Z_STREAM_END) return true;
+		
+		//	Z_BUF_ERROR means no progress could
+		//	be made, which is not fatal, the
+		//	caller must supply more input or
+		//	more room for output
+		if ((result==Z_OK) || (result==Z_BUF_ERROR)) return false;
+		
+		throw std::runtime_error(zlib_error);
+	
+	}
+	
+	
+	Word Deflater::Deflate (const Byte * begin, const Byte * end, void * out, Word max, Int32 level) {
+	
+		Reset(level);
+		
+		set_input(stream,begin,end);
+		set_output(stream,out,max);
+		
+		//	Deflate everything at once, there
+		//	is nowhere to put more output
+		int result=deflate(stream,Z_FINISH);
+		
+		if (result==Z_STREAM_END) return max-stream->avail_out;
+		
+		//	The output did not fit
+		if ((result==Z_OK) || (result==Z_BUF_ERROR)) return 0;
+		
+		throw std::runtime_error(zlib_error);
+	
+	}
+	
+	
+	Inflater & Inflater::Get () {
+	
+		static thread_local Nullable<Inflater> inflater;
+		
+		if (inflater.IsNull()) inflater.Construct();
+		
+		return *inflater;
+	
+	}
+	
+	
+	Inflater::Inflater () : stream(create_stream()) {
+	
+		//	Automatically detect ZLib or GZip
+		if (inflateInit2(stream,32+MAX_WBITS)!=Z_OK) {
+		
+			delete stream;
 			
-			//	Propagate
-			throw;
+			throw std::runtime_error(zlib_error);
 		
 		}
 	
 	}
-
-
-	Vector<Byte> Inflate (const Byte * begin, const Byte * end) {
+	
+	
+	Inflater::~Inflater () noexcept {
+	
+		inflateEnd(stream);
 		
-		//	Create buffer
-		Vector<Byte> buffer(inflate_buffer_default);
+		delete stream;
+	
+	}
+	
+	
+	void Inflater::Reset () {
+	
+		if (inflateReset(stream)!=Z_OK) throw std::runtime_error(zlib_error);
+	
+	}
+	
+	
+	bool Inflater::Write (const Byte * & begin, const Byte * end, Byte * & out, Byte * out_end) {
+	
+		set_input(stream,begin,end);
+		set_output(stream,out,Word(out_end-out));
 		
-		//	Inflate
-		Inflate(begin,end,&buffer);
+		int result=inflate(stream,Z_NO_FLUSH);
 		
-		//	Return
-		return buffer;
+		begin=reinterpret_cast<const Byte *>(stream->next_in);
+		out=reinterpret_cast<Byte *>(stream->next_out);
+		
+		if (result==Z_STREAM_END) return true;
+		
+		//	Z_BUF_ERROR means no progress could
+		//	be made, which is not fatal, the
+		//	caller must supply more input or
+		//	more room for output
+		if ((result==Z_OK) || (result==Z_BUF_ERROR)) return false;
+		
+		throw std::runtime_error(zlib_error);
+	
+	}
+	
+	
+	Word Inflater::Inflate (const Byte * begin, const Byte * end, void * out, Word max) {
+	
+		Reset();
+		
+		set_input(stream,begin,end);
+		set_output(stream,out,max);
+		
+		//	Inflate everything at once, there
+		//	is nowhere to put more output
+		int result=inflate(stream,Z_FINISH);
+		
+		if (result==Z_STREAM_END) return max-stream->avail_out;
+		
+		//	The output did not fit
+		if ((result==Z_BUF_ERROR) && (stream->avail_out==0)) return 0;
+		
+		throw std::runtime_error(zlib_error);
 	
 	}
 	
 	
-	void Deflate (const Byte * begin, const Byte * end, Vector<Byte> * buffer, bool gzip) {
+	void Inflate (const Byte * begin, const Byte * end, Vector<Byte> * buffer) {
 	
 		//	Null check
 		if (buffer==nullptr) throw std::out_of_range(NullPointerError);
@@ -131,89 +292,40 @@ namespace MCPP {
 		//	buffer back
 		try {
 		
-			//	Create and initialize a stream
-			z_stream stream;
-			stream.zalloc=Z_NULL;
-			stream.zfree=Z_NULL;
-			stream.opaque=Z_NULL;
+			auto & inflater=Inflater::Get();
+			inflater.Reset();
 			
-			if (deflateInit2(
-				&stream,
-				Z_DEFAULT_COMPRESSION,
-				Z_DEFLATED,
-				MAX_WBITS+(gzip ? 16 : 0),
-				8,
-				Z_DEFAULT_STRATEGY
-			)!=Z_OK) throw std::runtime_error(zlib_error);
+			//	Loop and decompress
+			for (;;) {
 			
-			try {
-			
-				//	Convert the number of bytes to
-				//	compress safely to the target
-				//	integer type and store them
-				//	in stream
-				stream.avail_in=static_cast<decltype(stream.avail_in)>(
-					SafeInt<decltype(end-begin)>(end-begin)
-				);
-				//	The ZLib compression/decompression
-				//	functions do not modify the in buffer,
-				//	therefore it should technically be
-				//	const, but it's not so we'll do an
-				//	ugly const_cast here...
-				stream.next_in=const_cast<decltype(stream.next_in)>(
-					reinterpret_cast<const std::remove_pointer<decltype(stream.next_in)>::type *>(
-						begin
-					)
-				);
+				//	Make sure there's somewhere to
+				//	put output
+				if (buffer->Count()==buffer->Capacity()) buffer->SetCapacity();
 				
-				//	Loop and compress
-				for (;;) {
+				//	Wire output buffer into stream
+				Byte * out=buffer->end();
 				
-					//	Wire output buffer into stream
-					stream.next_out=reinterpret_cast<decltype(stream.next_out)>(buffer->end());
-					stream.avail_out=static_cast<decltype(stream.avail_out)>(SafeWord(buffer->Capacity()-buffer->Count()));
-					
-					//	Deflate
-					int result=deflate(&stream,Z_FINISH);
-					
-					//	Update buffer count
-					buffer->SetCount(buffer->Capacity()-stream.avail_out);
-					
-					//	Did we compress everything?
-					//	If so we're done
-					if (result==Z_STREAM_END) break;
-					
-					//	Does the buffer need to be bigger?
-					if (
-						(result==Z_OK) ||
-						(
-							(result==Z_BUF_ERROR) &&
-							(stream.avail_out==0)
-						)
-					) {
-
-						buffer->SetCapacity();
-						
-						continue;
-						
-					}
-					
-					//	Error
-					throw std::runtime_error(zlib_error);
+				//	Inflate
+				bool done=inflater.Write(
+					begin,
+					end,
+					out,
+					buffer->begin()+buffer->Capacity()
+				);
 				
-				}
+				//	Update buffer count
+				buffer->SetCount(Word(out-buffer->begin()));
 				
-			} catch (...) {
-			
-				//	Make sure the stream is
-				//	cleaned up
-				deflateEnd(&stream);
+				//	Did we decompress everything?
+				//	If so we're done.
+				if (done) break;
 				
-				throw;
+				//	If all the input was consumed and
+				//	there was still room for output, the
+				//	stream is truncated
+				if ((begin==end) && (buffer->Count()!=buffer->Capacity())) throw std::runtime_error(zlib_error);
 			
 			}
-			
-			deflateEnd(&stream);
 		
 		} catch (...) {
 		
@@ -228,17 +340,20 @@ namespace MCPP {
 	}
 	
 	
-	Vector<Byte> Deflate (const Byte * begin, const Byte * end, bool gzip) {
+	Word Inflate (const Byte * begin, const Byte * end, void * out, Word max) {
+	
+		return Inflater::Get().Inflate(begin,end,out,max);
+	
+	}
+	
+	
+	Vector<Byte> Inflate (const Byte * begin, const Byte * end) {
 	
-		//	We want to try and do this in
-		//	one go, so get the bound and
-		//	initialize the output buffer
-		//	to that size
-		Word num=Word(SafeInt<decltype(end-begin)>(end-begin));
-		Vector<Byte> buffer(DeflateBound(num,gzip));
+		//	Create buffer
+		Vector<Byte> buffer(inflate_buffer_default);
 		
-		//	Compress
-		Deflate(begin,end,&buffer,gzip);
+		//	Inflate
+		Inflate(begin,end,&buffer);
 		
 		//	Return
 		return buffer;
@@ -246,52 +361,53 @@ namespace MCPP {
 	}
 	
 	
-	Word DeflateBound (Word num, bool gzip) {
-	
-		//	Safely convert the input number to
-		//	the type that deflateBound expects
-		typedef FunctionInformation<decltype(deflateBound)>::ArgumentType<1>::Type LengthType;
-		
-		LengthType z_num=LengthType(SafeWord(num));
+	void Deflate (const Byte * begin, const Byte * end, Vector<Byte> * buffer, bool gzip, Int32 level) {
 	
-		//	Prepare a dummy stream
-		z_stream stream;
-		stream.zalloc=Z_NULL;
-		stream.zfree=Z_NULL;
-		stream.opaque=Z_NULL;
+		//	Null check
+		if (buffer==nullptr) throw std::out_of_range(NullPointerError);
 		
-		if (deflateInit2(
-			&stream,
-			Z_DEFAULT_COMPRESSION,
-			Z_DEFLATED,
-			MAX_WBITS+(gzip ? 16 : 0),
-			8,
-			Z_DEFAULT_STRATEGY
-		)!=Z_OK) throw std::runtime_error(zlib_error);
+		auto & deflater=Deflater::Get(gzip,level);
 		
-		Word bound;
-		try {
+		//	Make room for the largest the
+		//	output could possibly be, so that
+		//	everything is compressed in one go
+		Word bound=deflater.Bound(Word(SafeInt<decltype(end-begin)>(end-begin)));
+		Word count=buffer->Count();
+		Word capacity=Word(SafeWord(count)+SafeWord(bound));
+		if (buffer->Capacity()<capacity) buffer->SetCapacity(capacity);
 		
-			//	Obtain the bound
-			bound=Word(
-				SafeInt<decltype(deflateBound(&stream,z_num))>(
-					deflateBound(&stream,z_num)
-				)
-			);
-			
-		} catch (...) {
+		//	The buffer's count is only updated
+		//	on success, so its contents are
+		//	not added to in the case of an
+		//	error
+		auto written=deflater.Deflate(begin,end,buffer->end(),bound,level);
 		
-			deflateEnd(&stream);
-			
-			throw;
+		//	The bound should always suffice
+		if (written==0) throw std::runtime_error(zlib_error);
 		
-		}
+		buffer->SetCount(count+written);
+	
+	}
+	
+	
+	Vector<Byte> Deflate (const Byte * begin, const Byte * end, bool gzip, Int32 level) {
+	
+		//	Create buffer, the above will
+		//	size it
+		Vector<Byte> buffer;
 		
-		//	Free the stream
-		deflateEnd(&stream);
+		//	Compress
+		Deflate(begin,end,&buffer,gzip,level);
 		
 		//	Return
-		return bound;
+		return buffer;
+	
+	}
+	
+	
+	Word DeflateBound (Word num, bool gzip) {
+	
+		return Deflater::Get(gzip).Bound(num);
 	
 	}
 
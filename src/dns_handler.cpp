@@ -1,7 +1,9 @@
 #include <dns_handler.hpp>
 #include <safeint.hpp>
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <cstring>
 #include <iterator>
 #include <limits>
 #include <stdexcept>
@@ -9,13 +11,17 @@
 #include <utility>
 #ifdef ENVIRONMENT_WINDOWS
 #include <nameser.h>
+#include <winsock2.h>
 #include <windows.h>
 #else
 #include <arpa/nameser.h>
+#include <sys/epoll.h>
+#include <cerrno>
 #include <fcntl.h>
 #include <netdb.h>
 #include <sys/socket.h>
 #include <sys/time.h>
+#include <unistd.h>
 #endif
 
 
@@ -63,6 +69,153 @@ namespace MCPP {
 	}
 	
 	
+	//	Statistics for all handlers
+	static std::atomic<UInt64> cache_hits(0);
+	static std::atomic<UInt64> cache_misses(0);
+	static std::atomic<UInt64> coalesced(0);
+	static std::atomic<UInt64> lookups_resolved(0);
+	static std::atomic<UInt64> lookup_time(0);
+	
+	
+	//	Responses are never cached for longer
+	//	than this many seconds, and responses
+	//	saying something does not exist for even
+	//	less
+	static const UInt32 max_ttl=86400;
+	static const UInt32 max_negative_ttl=900;
+	//	The size of the header of a DNS message
+	static const Word header_size=12;
+	//	The size of the type, class, time to live,
+	//	and length which follow the name of a
+	//	resource record
+	static const Word record_size=10;
+	//	The data of a SOA record is two names of
+	//	at least one byte each followed by five
+	//	32-bit integers, the last of which is the
+	//	time to live for negative responses
+	static const Word soa_minimum_size=22;
+	
+	
+	static UInt16 get_uint16 (const Byte * ptr) noexcept {
+	
+		return static_cast<UInt16>((static_cast<UInt16>(ptr[0])<<8)|ptr[1]);
+	
+	}
+	
+	
+	static UInt32 get_uint32 (const Byte * ptr) noexcept {
+	
+		return	(static_cast<UInt32>(ptr[0])<<24)|
+				(static_cast<UInt32>(ptr[1])<<16)|
+				(static_cast<UInt32>(ptr[2])<<8)|
+				static_cast<UInt32>(ptr[3]);
+	
+	}
+	
+	
+	static void set_uint32 (Byte * ptr, UInt32 value) noexcept {
+	
+		ptr[0]=static_cast<Byte>(value>>24);
+		ptr[1]=static_cast<Byte>(value>>16);
+		ptr[2]=static_cast<Byte>(value>>8);
+		ptr[3]=static_cast<Byte>(value);
+	
+	}
+	
+	
+	//	Advances past a possibly compressed name
+	//	in a DNS message, returns false if the
+	//	name is malformed
+	static bool skip_name (const Byte * & ptr, const Byte * end) noexcept {
+	
+		while (ptr!=end) {
+		
+			auto len=*ptr;
+			
+			//	A pointer to a name elsewhere in
+			//	the message ends the name
+			if ((len&0xC0)==0xC0) {
+			
+				if ((end-ptr)<2) return false;
+				
+				ptr+=2;
+				
+				return true;
+			
+			}
+			
+			++ptr;
+			
+			//	The root label ends the name
+			if (len==0) return true;
+			
+			if (((len&0xC0)!=0) || (static_cast<Word>(end-ptr)<len)) return false;
+			
+			ptr+=len;
+		
+		}
+		
+		return false;
+	
+	}
+	
+	
+	//	Invokes a callback for each resource record
+	//	in the answer and authority sections of a
+	//	DNS message with whether it's in the answer
+	//	section, its type, a pointer to its time to
+	//	live, and its data
+	//
+	//	Returns false if the message is malformed
+	template <typename T>
+	static bool for_each_record (Byte * begin, Word len, T && callback) noexcept {
+	
+		if (len<header_size) return false;
+		
+		const Byte * end=begin+len;
+		Word questions=get_uint16(begin+4);
+		Word answers=get_uint16(begin+6);
+		Word authorities=get_uint16(begin+8);
+		
+		const Byte * ptr=begin+header_size;
+		for (Word i=0;i<questions;++i) {
+		
+			//	Questions have a type and class
+			//	after their name
+			if (!skip_name(ptr,end) || (static_cast<Word>(end-ptr)<4)) return false;
+			
+			ptr+=4;
+		
+		}
+		
+		for (Word i=0;i<(answers+authorities);++i) {
+		
+			if (!skip_name(ptr,end) || (static_cast<Word>(end-ptr)<record_size)) return false;
+			
+			auto type=get_uint16(ptr);
+			auto ttl=begin+(ptr-begin)+4;
+			Word rdlen=get_uint16(ptr+8);
+			ptr+=record_size;
+			
+			if (static_cast<Word>(end-ptr)<rdlen) return false;
+			
+			callback(i<answers,type,ttl,ptr,rdlen);
+			
+			ptr+=rdlen;
+		
+		}
+		
+		return true;
+	
+	}
+	
+	
+	//	Backslashes in arguments to libcares must
+	//	be backslash-escaped
+	static const Regex escape("\\\\");
+	static const RegexReplacement escape_replacement("\\\\");
+	
+	
 	void DNSHandler::worker_func () noexcept {
 	
 		try {
@@ -97,23 +250,111 @@ namespace MCPP {
 	}
 	
 	
+	//	The most events which will be
+	//	retrieved each time the worker
+	//	wakes up
+	#ifndef ENVIRONMENT_WINDOWS
+	static const int max_events=64;
+	#endif
+	
+	
+	void DNSHandler::socket_callback (void * data, ares_socket_t socket, int readable, int writeable) noexcept {
+	
+		auto & self=*reinterpret_cast<DNSHandler *>(data);
+		
+		try {
+		
+			self.watch(socket,readable!=0,writeable!=0);
+		
+		} catch (...) {
+		
+			try {
+			
+				self.panic(std::current_exception());
+			
+			} catch (...) {	}
+			
+			std::abort();
+		
+		}
+	
+	}
+	
+	
+	void DNSHandler::watch (ares_socket_t socket, bool readable, bool writeable) {
+	
+		#ifdef ENVIRONMENT_WINDOWS
+		
+		//	libcares is done with this socket
+		if (!(readable || writeable)) {
+		
+			sockets.erase(socket);
+			
+			return;
+		
+		}
+		
+		short events=0;
+		if (readable) events|=POLLRDNORM;
+		if (writeable) events|=POLLWRNORM;
+		
+		sockets[socket]=events;
+		
+		#else
+		
+		//	libcares is done with this socket,
+		//	it may already have been closed, which
+		//	removes it from the epoll set
+		if (!(readable || writeable)) {
+		
+			if (
+				(epoll_ctl(poller,EPOLL_CTL_DEL,socket,nullptr)==-1) &&
+				(errno!=EBADF) &&
+				(errno!=ENOENT)
+			) raise_os();
+			
+			return;
+		
+		}
+		
+		struct epoll_event event;
+		std::memset(&event,0,sizeof(event));
+		event.data.fd=socket;
+		if (readable) event.events|=EPOLLIN;
+		if (writeable) event.events|=EPOLLOUT;
+		
+		//	libcares doesn't say whether it's
+		//	already watching a socket, so try
+		//	to modify it first
+		if (epoll_ctl(poller,EPOLL_CTL_MOD,socket,&event)==0) return;
+		if (
+			(errno!=ENOENT) ||
+			(epoll_ctl(poller,EPOLL_CTL_ADD,socket,&event)==-1)
+		) raise_os();
+		
+		#endif
+	
+	}
+	
+	
 	void DNSHandler::worker () {
 	
-		//	FD sets used for selecting
-		fd_set readable;
-		fd_set writeable;
-		//	Maximum file descriptor to pass
-		//	to select
-		int nfds;
-		//	The timeout for select
-		struct timeval tv;
+		#ifdef ENVIRONMENT_WINDOWS
+		Vector<WSAPOLLFD> fds;
+		#else
+		struct epoll_event events [max_events];
+		#endif
+		//	Sockets which became ready, and
+		//	whether they're readable and/or
+		//	writeable
+		Vector<Tuple<ares_socket_t,bool,bool>> ready;
 	
 		//	Loop until shutdown
 		for (;;) {
 		
-			//	Zero FDs
-			FD_ZERO(&readable);
-			FD_ZERO(&writeable);			
+			//	Milliseconds to wait, -1 waits
+			//	forever
+			int timeout=-1;
 			
 			if (lock.Execute([&] () mutable {
 			
@@ -125,70 +366,126 @@ namespace MCPP {
 				//	do that at once
 				if (stop) return true;
 				
-				//	Get the file descriptors from libcares
-				nfds=ares_fds(
-					channel,
-					&readable,
-					&writeable
-				);
-				//	Get the timeout from libcares
-				ares_timeout(
+				//	Get the timeout from libcares, rounding
+				//	up so that the worker doesn't wake up
+				//	just before it
+				struct timeval tv;
+				if (ares_timeout(
 					channel,
 					nullptr,
 					&tv
-				);
+				)!=nullptr) timeout=safe_cast<int>((tv.tv_sec*1000)+((tv.tv_usec+999)/1000));
+				
+				#ifdef ENVIRONMENT_WINDOWS
+				//	The sockets may only be read while
+				//	holding the lock, so take a copy to
+				//	wait on
+				fds.Clear();
+				WSAPOLLFD fd;
+				fd.fd=control.Get();
+				fd.events=POLLRDNORM;
+				fds.Add(fd);
+				for (auto & pair : sockets) {
+				
+					fd.fd=pair.first;
+					fd.events=pair.second;
+					fds.Add(fd);
+				
+				}
+				#endif
 				
 				return false;
 			
 			})) break;
 			
-			//	If there's a message pending on
-			//	the worker end of the socket pair,
-			//	we want to be woken up, so 
-			
-			//	If there's a message pending
-			//	on the worker end of the socket
-			//	pair, we want to be woken up,
-			//	so we're checking for readability
-			nfds=control.Add(readable,nfds);
-			
-			//	Wait for something to happen
-			if (select(
-				nfds,
-				&readable,
-				&writeable,
-				nullptr,
-				&tv
-			)==
+			//	Wait for one of libcares' sockets or
+			//	the control socket to become ready, or
+			//	for libcares' timeout
+			ready.Clear();
+			bool control_ready=false;
+			
 			#ifdef ENVIRONMENT_WINDOWS
-			SOCKET_ERROR
+			
+			if (WSAPoll(
+				fds.begin(),
+				static_cast<ULONG>(fds.Count()),
+				timeout
+			)==SOCKET_ERROR) raise_os();
+			
+			for (auto & fd : fds) {
+			
+				if (fd.revents==0) continue;
+				
+				if (fd.fd==control.Get()) {
+				
+					control_ready=true;
+					
+					continue;
+				
+				}
+				
+				ready.Add(
+					Tuple<ares_socket_t,bool,bool>(
+						fd.fd,
+						(fd.revents&(POLLRDNORM|POLLHUP|POLLERR))!=0,
+						(fd.revents&POLLWRNORM)!=0
+					)
+				);
+			
+			}
+			
 			#else
-			-1
-			#endif
-			) raise_os();
 			
-			//	Did something happen with the
-			//	control socket?
-			if (control.Is(readable)) {
+			int count;
+			while ((count=epoll_wait(
+				poller,
+				events,
+				max_events,
+				timeout
+			))==-1) if (errno!=EINTR) raise_os();
 			
-				//	Check to see if a shutdown command
-				//	is coming through the control socket,
-				//	if so end at once
-				if (should_stop()) break;
+			for (int i=0;i<count;++i) {
 			
-				//	Remove it in case it matters to
-				//	libcares what's in the fd_set
-				control.Clear(readable);
+				auto & event=events[i];
+				
+				if (event.data.fd==control.Get()) {
+				
+					control_ready=true;
+					
+					continue;
+				
+				}
+				
+				ready.Add(
+					Tuple<ares_socket_t,bool,bool>(
+						event.data.fd,
+						(event.events&(EPOLLIN|EPOLLHUP|EPOLLERR))!=0,
+						(event.events&EPOLLOUT)!=0
+					)
+				);
 			
 			}
 			
-			//	Call libcares
+			#endif
+			
+			//	Check to see if a shutdown command
+			//	is coming through the control socket,
+			//	if so end at once
+			if (control_ready && should_stop()) break;
+			
+			//	Call libcares, which also handles
+			//	any queries which have timed out
 			lock.Execute([&] () mutable {
 			
-				ares_process(
+				if (ready.Count()==0) ares_process_fd(
+					channel,
+					ARES_SOCKET_BAD,
+					ARES_SOCKET_BAD
+				);
+				else for (auto & t : ready) ares_process_fd(
 					channel,
-					&readable,
-					&writeable
+					t.Item<1>() ? t.Item<0>() : ARES_SOCKET_BAD,
+					t.Item<2>() ? t.Item<0>() : ARES_SOCKET_BAD
 				);
 			
 			});
@@ -209,10 +506,22 @@ namespace MCPP {
 	decltype(std::declval<T>().Get()) DNSHandler::begin (const String & name, Args &&... args) {
 	
 		auto ptr=std::unique_ptr<Query>(new T(std::forward<Args>(args)...));
+		auto p=ptr.get();
+		auto retr=reinterpret_cast<T *>(p)->Get();
+		
+		//	Names are case insensitive
+		KeyType key(name.ToLower(),p->Type());
+		
+		if (cached(key,*p)) {
 		
-		return lock.Execute([&] () mutable {
+			++cache_hits;
+			
+			return retr;
+		
+		}
+		
+		lock.Execute([&] () mutable {
 		
-			auto p=ptr.get();
 			auto pair=queries.emplace(
 				p,
 				std::move(ptr)
@@ -220,13 +529,65 @@ namespace MCPP {
 			
 			try {
 			
-				issue_command();
+				p->Begin(complete);
 				
-				p->Begin(
-					channel,
-					name,
-					complete
+				//	If there's already a lookup for this
+				//	name and type, wait for its response
+				auto iter=lookups.find(key);
+				if (iter!=lookups.end()) {
+				
+					iter->second->Waiting.Add(p);
+					
+					++coalesced;
+					
+					return;
+				
+				}
+				
+				std::unique_ptr<Lookup> lookup(
+					new Lookup{
+						this,
+						key,
+						Timer::CreateAndStart(),
+						Vector<Query *>()
+					}
 				);
+				lookup->Waiting.Add(p);
+				auto l=lookup.get();
+				auto lookup_pair=lookups.emplace(
+					std::move(key),
+					std::move(lookup)
+				);
+				
+				try {
+				
+					issue_command();
+				
+					//	Escape the string and convert it
+					//	into a C string to be passed to
+					//	libcares
+					auto c_string=escape.Replace(name,escape_replacement).ToCString();
+					
+					++cache_misses;
+					
+					//	libcares may call back before this
+					//	returns
+					ares_query(
+						channel,
+						c_string.begin(),
+						ns_c_in,	//	Internet
+						p->Type(),
+						lookup_callback,
+						l
+					);
+				
+				} catch (...) {
+				
+					lookups.erase(lookup_pair.first);
+					
+					throw;
+				
+				}
 				
 				wait.WakeAll();
 				
@@ -238,14 +599,231 @@ namespace MCPP {
 			
 			}
 			
-			return reinterpret_cast<T *>(p)->Get();
+		});
+		
+		return retr;
+	
+	}
+	
+	
+	void DNSHandler::lookup_callback (void * arg, int status, int timeouts, unsigned char * abuf, int alen) noexcept {
+	
+		auto l=reinterpret_cast<Lookup *>(arg);
+		auto & self=*l->Handler;
+		
+		std::unique_ptr<Lookup> lookup;
+		self.lock.Execute([&] () mutable {
+		
+			auto iter=self.lookups.find(l->Key);
+			lookup=std::move(iter->second);
+			self.lookups.erase(iter);
+		
+		});
+		
+		lookup_time+=lookup->Elapsed.ElapsedNanoseconds();
+		++lookups_resolved;
+		
+		//	Failing to cache a response doesn't
+		//	affect the queries waiting on it
+		try {
+		
+			self.store(lookup->Key,status,abuf,alen);
+		
+		} catch (...) {	}
+		
+		for (auto q : lookup->Waiting) {
+		
+			q->Complete(
+				status,
+				static_cast<Word>(timeouts),
+				abuf,
+				alen
+			);
+			
+			q->Done(status==ARES_SUCCESS);
+		
+		}
+	
+	}
+	
+	
+	bool DNSHandler::cached (const KeyType & key, Query & query) {
+	
+		if (max_cache==0) return false;
+		
+		int status;
+		Vector<Byte> response;
+		UInt64 age;
+		if (!cache_lock.Execute([&] () mutable {
+		
+			auto iter=cache.find(key);
+			if (iter==cache.end()) return false;
+			
+			auto now=clock.ElapsedMilliseconds();
+			if (now>=iter->second.Expires) {
+			
+				cache.erase(iter);
+				
+				return false;
+			
+			}
+			
+			status=iter->second.Status;
+			response=iter->second.Response;
+			age=now-iter->second.Stored;
+			
+			return true;
+		
+		})) return false;
+		
+		//	Records age while they're cached,
+		//	the response is altered so that
+		//	their time to live reflects that
+		UInt32 seconds=static_cast<UInt32>(age/1000);
+		for_each_record(
+			response.begin(),
+			response.Count(),
+			[&] (bool, UInt16, Byte * ttl, const Byte *, Word) noexcept {
+			
+				auto curr=get_uint32(ttl);
+				set_uint32(ttl,(curr>seconds) ? (curr-seconds) : 0);
+			
+			}
+		);
+		
+		query.Complete(
+			status,
+			0,
+			response.begin(),
+			safe_cast<int>(response.Count())
+		);
+		
+		return true;
+	
+	}
+	
+	
+	void DNSHandler::store (const KeyType & key, int status, const unsigned char * abuf, int alen) {
+	
+		if ((max_cache==0) || (abuf==nullptr) || (alen<=0)) return;
+		
+		Vector<Byte> response(static_cast<Word>(alen));
+		std::memcpy(response.begin(),abuf,static_cast<Word>(alen));
+		response.SetCount(static_cast<Word>(alen));
+		
+		//	Determine how long the response may
+		//	be cached
+		Nullable<UInt32> lifetime;
+		auto shorten=[&] (UInt32 value) noexcept {
+		
+			if (lifetime.IsNull() || (value<*lifetime)) lifetime.Construct(value);
+		
+		};
+		if (status==ARES_SUCCESS) {
+		
+			//	As long as the first record in the
+			//	answer to expire
+			if (!for_each_record(
+				response.begin(),
+				response.Count(),
+				[&] (bool answer, UInt16, Byte * ttl, const Byte *, Word) noexcept {
+				
+					if (answer) shorten(get_uint32(ttl));
+				
+				}
+			)) return;
+			
+			if (!lifetime.IsNull() && (*lifetime>max_ttl)) *lifetime=max_ttl;
+		
+		} else if ((status==ARES_ENODATA) || (status==ARES_ENOTFOUND)) {
+		
+			//	As long as the SOA record in the
+			//	authority section allows (RFC 2308)
+			if (!for_each_record(
+				response.begin(),
+				response.Count(),
+				[&] (bool answer, UInt16 type, Byte * ttl, const Byte * rdata, Word rdlen) noexcept {
+				
+					if (answer || (type!=ns_t_soa) || (rdlen<soa_minimum_size)) return;
+					
+					shorten(get_uint32(ttl));
+					shorten(get_uint32(rdata+rdlen-sizeof(UInt32)));
+				
+				}
+			)) return;
+			
+			if (!lifetime.IsNull() && (*lifetime>max_negative_ttl)) *lifetime=max_negative_ttl;
+		
+		}
+		
+		if (lifetime.IsNull() || (*lifetime==0)) return;
+		
+		cache_lock.Execute([&] () mutable {
+		
+			auto now=clock.ElapsedMilliseconds();
+			
+			//	Make room by evicting everything that
+			//	has expired, or if nothing has, the
+			//	entry which would expire first
+			if ((cache.size()>=max_cache) && (cache.find(key)==cache.end())) {
+			
+				auto first=cache.end();
+				for (auto iter=cache.begin();iter!=cache.end();) {
+				
+					if (now>=iter->second.Expires) {
+					
+						iter=cache.erase(iter);
+						
+						continue;
+					
+					}
+					
+					if ((first==cache.end()) || (iter->second.Expires<first->second.Expires)) first=iter;
+					
+					++iter;
+				
+				}
+				
+				if (cache.size()>=max_cache) cache.erase(first);
+			
+			}
+			
+			cache[key]=CacheEntry{
+				status,
+				std::move(response),
+				now,
+				now+(static_cast<UInt64>(*lifetime)*1000)
+			};
 		
 		});
 	
 	}
 
 
-	DNSHandler::DNSHandler (PanicType panic) : stop(false), panic(std::move(panic)) {
+	DNSInfo DNSHandler::GetInfo () noexcept {
+	
+		DNSInfo retr;
+		retr.Hits=cache_hits;
+		retr.Misses=cache_misses;
+		retr.Coalesced=coalesced;
+		retr.Resolved=lookups_resolved;
+		retr.Elapsed=lookup_time;
+		
+		return retr;
+	
+	}
+	
+	
+	DNSHandler::DNSHandler (PanicType panic, Word max_cache)
+		:
+			#ifndef ENVIRONMENT_WINDOWS
+			poller(-1),
+			#endif
+			stop(false),
+			max_cache(max_cache),
+			clock(Timer::CreateAndStart()),
+			panic(std::move(panic))
+	{
 	
 		//	Setup the completion callback
 		complete=[this] (Query * q, bool) mutable noexcept {
@@ -258,15 +836,52 @@ namespace MCPP {
 		//	default it to std::abort
 		if (!panic) panic=[] (std::exception_ptr) {	std::abort();	};
 	
+		#ifndef ENVIRONMENT_WINDOWS
+		//	Wait on the control socket as well
+		//	as libcares' sockets
+		if ((poller=epoll_create1(EPOLL_CLOEXEC))==-1) raise_os();
+		try {
+		
+			struct epoll_event event;
+			std::memset(&event,0,sizeof(event));
+			event.events=EPOLLIN;
+			event.data.fd=control.Get();
+			if (epoll_ctl(poller,EPOLL_CTL_ADD,control.Get(),&event)==-1) raise_os();
+		
+		} catch (...) {
+		
+			close(poller);
+			
+			throw;
+		
+		}
+		#endif
+		
 		//	Initialize libcares
 		auto result=ares_library_init(ARES_LIB_INIT_ALL);
-		if (result!=0) raise(result);
+		if (result!=0) {
+		
+			cleanup();
+			
+			raise(result);
+		
+		}
 		
 		try {
 		
 			//	Prepare an asynchronous resolver
-			//	channel
-			if ((result=ares_init(&channel))!=0) raise(result);
+			//	channel which tells us which sockets
+			//	to wait on, rather than us asking it
+			//	about all of them each time
+			struct ares_options options;
+			std::memset(&options,0,sizeof(options));
+			options.sock_state_cb=socket_callback;
+			options.sock_state_cb_data=this;
+			if ((result=ares_init_options(
+				&channel,
+				&options,
+				ARES_OPT_SOCK_STATE_CB
+			))!=0) raise(result);
 			
 			try {
 			
@@ -284,6 +899,7 @@ namespace MCPP {
 		} catch (...) {
 		
 			ares_library_cleanup();
+			cleanup();
 			
 			throw;
 		
@@ -292,6 +908,15 @@ namespace MCPP {
 	}
 	
 	
+	void DNSHandler::cleanup () noexcept {
+	
+		#ifndef ENVIRONMENT_WINDOWS
+		if (poller!=-1) close(poller);
+		#endif
+	
+	}
+	
+	
 	DNSHandler::~DNSHandler () noexcept {
 	
 		//	Shutdown the worker
@@ -331,6 +956,8 @@ namespace MCPP {
 		
 		//	Cleanup libcares
 		ares_library_cleanup();
+		
+		cleanup();
 	
 	}
 	
@@ -547,42 +1174,16 @@ namespace MCPP {
 	DNSHandler::Query::~Query () noexcept {	}
 	
 	
-	//	Backslashes in arguments to libcares must
-	//	be backslash-escaped
-	static const Regex escape("\\\\");
-	static const RegexReplacement escape_replacement("\\\\");
+	int DNSHandler::Query::Type () const noexcept {
+	
+		return type;
 	
+	}
 	
-	void DNSHandler::Query::Begin (ares_channel channel, const String & name, DoneType callback) {
+	
+	void DNSHandler::Query::Begin (DoneType callback) {
 	
 		this->callback=std::move(callback);
-		
-		//	Escape the string and convert it
-		//	into a C string to be passed to
-		//	libcares
-		auto c_string=escape.Replace(name,escape_replacement).ToCString();
-		
-		ares_query(
-			channel,
-			c_string.begin(),
-			ns_c_in,	//	Internet
-			type,
-			[] (void * arg, int status, int timeouts, unsigned char * abuf, int alen) noexcept {
-			
-				auto ptr=reinterpret_cast<Query *>(arg);
-				
-				ptr->Complete(
-					status,
-					static_cast<Word>(timeouts),
-					abuf,
-					alen
-				);
-				
-				ptr->Done(status==ARES_SUCCESS);
-			
-			},
-			this
-		);
 	
 	}
 	
@@ -1227,9 +1227,6 @@ class DefaultGenerator : public WorldGenerator {
 								)
 					);
 					
-					block.SetSkylight(15);
-					block.SetLight(15);
-					
 					column.Blocks[offset++]=block;
 					
 					//	Set biome if this is the
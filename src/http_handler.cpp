@@ -6,9 +6,12 @@
 #include <stdexcept>
 #include <system_error>
 #ifdef ENVIRONMENT_WINDOWS
+#include <winsock2.h>
 #include <windows.h>
 #else
-#include <sys/time.h>
+#include <sys/epoll.h>
+#include <cerrno>
+#include <unistd.h>
 #endif
 
 
@@ -45,6 +48,17 @@ namespace MCPP {
 	}
 	
 	
+	//	Throws cURL share errors
+	[[noreturn]]
+	static void raise_share (CURLSHcode code) {
+	
+		throw std::runtime_error(
+			curl_share_strerror(code)
+		);
+	
+	}
+	
+	
 	//	Throws OS socket errors
 	[[noreturn]]
 	static void raise_os () {
@@ -277,7 +291,7 @@ namespace MCPP {
 	static const char * curl_easy_init_error="Could not create a cURL easy handle";
 	
 	
-	HTTPHandler::Request::Request (HTTPRequest request_in)
+	HTTPHandler::Request::Request (HTTPRequest request_in, CURLSH * share)
 		:	promise(Promise<HTTPResponse>{}),
 			request(std::move(request_in)),
 			headers_curr(0)
@@ -294,6 +308,15 @@ namespace MCPP {
 			#ifdef LIBCURL_INSECURE
 			set(CURLOPT_SSL_VERIFYPEER,static_cast<long>(0));
 			#endif
+			
+			//
+			//	Connections, TLS sessions, and DNS
+			//
+			set(CURLOPT_SHARE,share);
+			//	Idle connections wait in the pool for
+			//	the next request to the same host, keep
+			//	them from being silently dropped
+			set(CURLOPT_TCP_KEEPALIVE,static_cast<long>(1));
 		
 			//
 			//	URL
@@ -720,25 +743,211 @@ namespace MCPP {
 	//	libcurl documentation says "a few
 	//	seconds"
 	static const long default_timeout=5000;
+	#ifndef ENVIRONMENT_WINDOWS
+	//	The most events which will be
+	//	retrieved each time the worker
+	//	wakes up
+	static const int max_events=64;
+	#endif
 	
 	
-	void HTTPHandler::worker () {
+	int HTTPHandler::socket_callback (CURL *, curl_socket_t socket, int what, void * userp, void *) noexcept {
+	
+		auto & self=*reinterpret_cast<HTTPHandler *>(userp);
 	
-		//	FD sets, nfds, and timeout for select
-		fd_set readable;
-		fd_set writeable;
-		fd_set exceptional;
-		int nfds;
-		long timeout;
+		try {
+		
+			self.watch(socket,what);
+			
+		} catch (...) {
+			
+			self.ex=std::current_exception();
+				
+			return -1;
+			
+		}
+			
+		return 0;
+			
+	}
+			
 	
+	int HTTPHandler::timer_callback (CURLM *, long timeout_ms, void * userp) noexcept {
+	
+		auto & self=*reinterpret_cast<HTTPHandler *>(userp);
+		
+		self.timeout=timeout_ms;
+		self.timer=Timer::CreateAndStart();
+		
+		return 0;
+	
+	}
+	
+	
+	void HTTPHandler::lock_callback (CURL *, curl_lock_data data, curl_lock_access, void * userp) noexcept {
+	
+		reinterpret_cast<HTTPHandler *>(userp)->share_locks[data].Acquire();
+	
+	}
+	
+	
+	void HTTPHandler::unlock_callback (CURL *, curl_lock_data data, void * userp) noexcept {
+	
+		reinterpret_cast<HTTPHandler *>(userp)->share_locks[data].Release();
+	
+	}
+	
+	
+	void HTTPHandler::watch (curl_socket_t socket, int what) {
+	
+		#ifdef ENVIRONMENT_WINDOWS
+		
+		if (what==CURL_POLL_REMOVE) {
+		
+			sockets.erase(socket);
+			
+			return;
+		
+		}
+		
+		short events=0;
+		if ((what&CURL_POLL_IN)!=0) events|=POLLRDNORM;
+		if ((what&CURL_POLL_OUT)!=0) events|=POLLWRNORM;
+		
+		sockets[socket]=events;
+		
+		#else
+		
+		if (what==CURL_POLL_REMOVE) {
+		
+			//	cURL may have already closed the
+			//	socket, which removes it from the
+			//	epoll set
+			if (
+				(epoll_ctl(poller,EPOLL_CTL_DEL,socket,nullptr)==-1) &&
+				(errno!=EBADF) &&
+				(errno!=ENOENT)
+			) raise_os();
+			
+			return;
+		
+		}
+		
+		struct epoll_event event;
+		std::memset(&event,0,sizeof(event));
+		event.data.fd=socket;
+		if ((what&CURL_POLL_IN)!=0) event.events|=EPOLLIN;
+		if ((what&CURL_POLL_OUT)!=0) event.events|=EPOLLOUT;
+		
+		//	cURL doesn't say whether it's already
+		//	watching a socket, so try to modify
+		//	it first
+		if (epoll_ctl(poller,EPOLL_CTL_MOD,socket,&event)==0) return;
+		if (
+			(errno!=ENOENT) ||
+			(epoll_ctl(poller,EPOLL_CTL_ADD,socket,&event)==-1)
+		) raise_os();
+		
+		#endif
+	
+	}
+	
+	
+	long HTTPHandler::remaining () {
+	
+		//	If cURL hasn't set a timer, choose
+		//	some other reasonable timeout
+		if (timeout==-1) return default_timeout;
+		
+		auto elapsed=timer.ElapsedMilliseconds();
+		auto ms=static_cast<decltype(elapsed)>(timeout);
+		
+		return (elapsed>=ms) ? 0 : static_cast<long>(ms-elapsed);
+	
+	}
+	
+	
+	void HTTPHandler::action (curl_socket_t socket, int mask) {
+				
+		int running;	//	Ignored
+		auto result=curl_multi_socket_action(
+			handle,
+			socket,
+			mask,
+			&running
+		);
+		
+		//	If a callback failed, that's the
+		//	actual error
+		if (ex) {
+		
+			auto e=std::move(ex);
+			ex=std::exception_ptr{};
+			
+			std::rethrow_exception(std::move(e));
+				
+		}
+		
+		if (result!=CURLM_OK) raise_multi(result);
+	
+	}
+	
+	
+	void HTTPHandler::complete () {
+				
+		//	Pop all messages off cURL's stack
+		for (;;) {
+				
+			int msgs;	//	Ignored
+			auto msg=curl_multi_info_read(
+				handle,
+				&msgs
+			);
+			//	End when no more messages to read
+			if (msg==nullptr) break;
+			//	CURLMSG_DONE is the only message defined
+			//	as of this writing, but more may be added
+			//	in the future...
+			if (msg->msg!=CURLMSG_DONE) continue;
+					
+			//	Lookup this particular easy handle and
+			//	extract the request
+			auto iter=requests.find(msg->easy_handle);
+			auto request=std::move(iter->second);
+			requests.erase(iter);
+			//	Save the result of the completion
+			auto code=msg->data.result;
+			//	Remove from multi handle
+			auto result=curl_multi_remove_handle(
+				handle,
+				msg->easy_handle
+			);
+			if (result!=CURLM_OK) raise_multi(result);
+					
+			//	Complete request
+			request->Complete(code);
+				
+		}
+			
+	}
+	
+	
+	void HTTPHandler::worker () {
+	
+		#ifdef ENVIRONMENT_WINDOWS
+		Vector<WSAPOLLFD> fds;
+		#else
+		struct epoll_event events [max_events];
+		#endif
+		//	Sockets which became ready, and what
+		//	they became ready for
+		Vector<Tuple<curl_socket_t,int>> ready;
+		
 		//	Loop forever, or until told
 		//	to stop
 		for (;;) {
 		
-			//	Zero FD sets
-			FD_ZERO(&readable);
-			FD_ZERO(&writeable);
-			FD_ZERO(&exceptional);
+			long wait_for=0;
 			
 			//	Lock and check
 			if (lock.Execute([&] () mutable {
@@ -749,118 +958,119 @@ namespace MCPP {
 				//	Were we commanded to stop?
 				if (stop) return true;
 				
-				//	Get FD sets and timeout from libcurl
-				auto result=curl_multi_fdset(
-					handle,
-					&readable,
-					&writeable,
-					&exceptional,
-					&nfds
-				);
-				if (result!=CURLM_OK) raise_multi(result);
-				result=curl_multi_timeout(
-					handle,
-					&timeout
-				);
-				if (result!=CURLM_OK) raise_multi(result);
+				wait_for=remaining();
+				
+				#ifdef ENVIRONMENT_WINDOWS
+				//	The sockets may only be read while
+				//	holding the lock, so take a copy to
+				//	wait on
+				fds.Clear();
+				WSAPOLLFD fd;
+				fd.fd=control.Get();
+				fd.events=POLLRDNORM;
+				fds.Add(fd);
+				for (auto & pair : sockets) {
+				
+					fd.fd=pair.first;
+					fd.events=pair.second;
+					fds.Add(fd);
+				
+				}
+				#endif
 				
 				return false;
 			
 			})) break;
 			
-			//	How we proceed depends on the timeout
-			//	value.  If it's 0 we proceed at once
-			if (timeout!=0) {
-			
-				//	If the timeout is -1, we choose
-				//	some other reasonable timeout
-				if (timeout==-1) timeout=default_timeout;
-				
-				//	Get a struct timeval that
-				//	corresponds to the number of
-				//	milliseconds returned by libcurl
-				struct timeval tv;
-				tv.tv_sec=timeout/1000;
-				tv.tv_usec=(timeout%1000)*1000;
-				
-				//	Wait also on the control socket
-				nfds=control.Add(readable,nfds);
-				
-				//	Select
-				if (select(
-					nfds,
-					&readable,
-					&writeable,
-					&exceptional,
-					&tv
-				)==
-				#ifdef ENVIRONMENT_WINDOWS
-				SOCKET_ERROR
-				#else
-				-1
-				#endif
-				) raise_os();
+			//	Wait on cURL's sockets and the control
+			//	socket until one of them is ready or
+			//	cURL's timer expires
+			ready.Clear();
+			bool control_ready=false;
 			
-			}
+			#ifdef ENVIRONMENT_WINDOWS
 			
-			//	If the control socket became readable,
-			//	and a shutdown command was given, shutdown
-			if (control.Is(readable) && should_stop()) break;
+			if (WSAPoll(
+				fds.begin(),
+				static_cast<ULONG>(fds.Count()),
+				static_cast<INT>(wait_for)
+			)==SOCKET_ERROR) raise_os();
 			
-			//	Invoke libcurl
-			lock.Execute([&] () mutable {
+			for (auto & fd : fds) {
 			
-				//	Loop until cURL no longer wants to be
-				//	called
-				for (;;) {
+				if (fd.revents==0) continue;
 				
-					int running;	//	Ignored
-					auto result=curl_multi_perform(
-						handle,
-						&running
-					);
-					//	If cURL wants to be called again, LOOP
-					if (result==CURLM_CALL_MULTI_PERFORM) continue;
-					//	If all's good, break out of the loop
-					if (result==CURLM_OK) break;
-					//	Otherwise an error occurred, throw
-					raise_multi(result);
+				if (fd.fd==control.Get()) {
+				
+					control_ready=true;
+					
+					continue;
 				
 				}
 				
-				//	Pop all messages off cURL's stack
-				for (;;) {
+				int mask=0;
+				if ((fd.revents&(POLLRDNORM|POLLHUP))!=0) mask|=CURL_CSELECT_IN;
+				if ((fd.revents&POLLWRNORM)!=0) mask|=CURL_CSELECT_OUT;
+				if ((fd.revents&(POLLERR|POLLNVAL))!=0) mask|=CURL_CSELECT_ERR;
 				
-					int msgs;	//	Ignored
-					auto msg=curl_multi_info_read(
-						handle,
-						&msgs
-					);
-					//	End when no more messages to read
-					if (msg==nullptr) break;
-					//	CURLMSG_DONE is the only message defined
-					//	as of this writing, but more may be added
-					//	in the future...
-					if (msg->msg!=CURLMSG_DONE) continue;
+				ready.Add(Tuple<curl_socket_t,int>(fd.fd,mask));
+			
+			}
+			
+			#else
+			
+			int count;
+			while ((count=epoll_wait(
+				poller,
+				events,
+				max_events,
+				static_cast<int>(wait_for)
+			))==-1) if (errno!=EINTR) raise_os();
+			
+			for (int i=0;i<count;++i) {
+			
+				auto & event=events[i];
+				
+				if (event.data.fd==control.Get()) {
+				
+					control_ready=true;
 					
-					//	Lookup this particular easy handle and
-					//	extract the request
-					auto iter=requests.find(msg->easy_handle);
-					auto request=std::move(iter->second);
-					requests.erase(iter);
-					//	Save the result of the completion
-					auto code=msg->data.result;
-					//	Remove from multi handle
-					auto result=curl_multi_remove_handle(
-						handle,
-						msg->easy_handle
-					);
-					if (result!=CURLM_OK) raise_multi(result);
+					continue;
+				
+				}
+				
+				int mask=0;
+				if ((event.events&(EPOLLIN|EPOLLHUP))!=0) mask|=CURL_CSELECT_IN;
+				if ((event.events&EPOLLOUT)!=0) mask|=CURL_CSELECT_OUT;
+				if ((event.events&EPOLLERR)!=0) mask|=CURL_CSELECT_ERR;
+				
+				ready.Add(Tuple<curl_socket_t,int>(event.data.fd,mask));
+			
+			}
+			
+			#endif
+			
+			//	If the control socket became readable,
+			//	and a shutdown command was given, shutdown
+			if (control_ready && should_stop()) break;
+			
+			//	Invoke libcurl, only on the sockets that
+			//	are ready
+			lock.Execute([&] () mutable {
+			
+				for (auto & t : ready) action(t.Item<0>(),t.Item<1>());
+				
+				//	If cURL's timer expired, let it
+				//	know
+				if ((timeout!=-1) && (remaining()==0)) {
+				
+					timeout=-1;
 					
-					//	Complete request
-					request->Complete(code);
+					action(CURL_SOCKET_TIMEOUT,0);
 				
 				}
+				
+				complete();
 			
 			});
 		
@@ -869,32 +1079,96 @@ namespace MCPP {
 	}
 	
 	
+	template <typename T>
+	static void multi_setopt (CURLM * handle, CURLMoption option, T value) {
+	
+		auto result=curl_multi_setopt(handle,option,value);
+		if (result!=CURLM_OK) raise_multi(result);
+	
+	}
+	
+	
+	template <typename T>
+	static void share_setopt (CURLSH * share, CURLSHoption option, T value) {
+	
+		auto result=curl_share_setopt(share,option,value);
+		if (result!=CURLSHE_OK) raise_share(result);
+	
+	}
+	
+	
 	static const char * curl_multi_init_error="Could not create a cURL multi handle";
+	static const char * curl_share_init_error="Could not create a cURL share handle";
 	
 	
-	HTTPHandler::HTTPHandler (PanicType panic) : stop(false), panic(std::move(panic)) {
+	HTTPHandler::HTTPHandler (PanicType panic)
+		:	handle(nullptr),
+			share(nullptr),
+			#ifndef ENVIRONMENT_WINDOWS
+			poller(-1),
+			#endif
+			timeout(-1),
+			timer(Timer::CreateAndStart()),
+			stop(false),
+			panic(std::move(panic))
+	{
 	
 		//	Make sure libcurl was initialized
 		//	properly
 		libcurl.Okay();
-	
-		//	Attempt to create a multi handle
-		if ((handle=curl_multi_init())==nullptr) throw std::runtime_error(
-			curl_multi_init_error
-		);
 		
-		//	We're managing a multi handle now
 		try {
 		
+			//	Attempt to create a share handle,
+			//	requests are added to the multi
+			//	handle from many threads, so access
+			//	to shared data must be synchronized
+			if ((share=curl_share_init())==nullptr) throw std::runtime_error(
+				curl_share_init_error
+			);
+			share_setopt(share,CURLSHOPT_LOCKFUNC,&lock_callback);
+			share_setopt(share,CURLSHOPT_UNLOCKFUNC,&unlock_callback);
+			share_setopt(share,CURLSHOPT_USERDATA,this);
+			share_setopt(share,CURLSHOPT_SHARE,CURL_LOCK_DATA_DNS);
+			share_setopt(share,CURLSHOPT_SHARE,CURL_LOCK_DATA_SSL_SESSION);
+			//	Older versions of cURL cannot share
+			//	connections, but connections are still
+			//	shared by all requests in the multi
+			//	handle
+			#if LIBCURL_VERSION_NUM>=0x073900
+			share_setopt(share,CURLSHOPT_SHARE,CURL_LOCK_DATA_CONNECT);
+			#endif
+			
+			#ifndef ENVIRONMENT_WINDOWS
+			//	Wait on the control socket as well
+			//	as cURL's sockets
+			if ((poller=epoll_create1(EPOLL_CLOEXEC))==-1) raise_os();
+			struct epoll_event event;
+			std::memset(&event,0,sizeof(event));
+			event.events=EPOLLIN;
+			event.data.fd=control.Get();
+			if (epoll_ctl(poller,EPOLL_CTL_ADD,control.Get(),&event)==-1) raise_os();
+			#endif
+	
+			//	Attempt to create a multi handle
+			if ((handle=curl_multi_init())==nullptr) throw std::runtime_error(
+				curl_multi_init_error
+			);
+		
+			//	cURL tells us which sockets to wait
+			//	on and when, rather than us asking
+			//	it about all of them each time
+			multi_setopt(handle,CURLMOPT_SOCKETFUNCTION,&socket_callback);
+			multi_setopt(handle,CURLMOPT_SOCKETDATA,this);
+			multi_setopt(handle,CURLMOPT_TIMERFUNCTION,&timer_callback);
+			multi_setopt(handle,CURLMOPT_TIMERDATA,this);
+		
 			//	Start our worker
 			thread=Thread([this] () mutable {	worker_func();	});
 		
 		} catch (...) {
 		
-			auto result=curl_multi_cleanup(handle);
-			//	Not really much sane we can do about
-			//	this
-			if (result!=CURLM_OK) std::abort();
+			cleanup();
 			
 			throw;
 		
@@ -903,6 +1177,25 @@ namespace MCPP {
 	}
 	
 	
+	void HTTPHandler::cleanup () noexcept {
+	
+		//	Not really much sane we can do about
+		//	failures here
+		
+		if ((handle!=nullptr) && (curl_multi_cleanup(handle)!=CURLM_OK)) std::abort();
+		
+		//	The share handle cannot be destroyed
+		//	while any easy handle is using it
+		requests.clear();
+		if ((share!=nullptr) && (curl_share_cleanup(share)!=CURLSHE_OK)) std::abort();
+		
+		#ifndef ENVIRONMENT_WINDOWS
+		if (poller!=-1) close(poller);
+		#endif
+	
+	}
+	
+	
 	HTTPHandler::~HTTPHandler () noexcept {
 	
 		try {
@@ -930,10 +1223,6 @@ namespace MCPP {
 			
 			}
 			
-			//	Kill the multi handle
-			auto result=curl_multi_cleanup(handle);
-			if (result!=CURLM_OK) raise_multi(result);
-		
 		} catch (...) {
 		
 			//	Nothing we can do to save
@@ -942,13 +1231,17 @@ namespace MCPP {
 		
 		}
 	
+		//	Kill the multi handle, then the
+		//	requests and the share handle
+		cleanup();
+	
 	}
 	
 	
 	Promise<HTTPResponse> HTTPHandler::Execute (HTTPRequest request) {
 	
 		//	Create the request
-		auto ptr=std::unique_ptr<Request>(new Request(std::move(request)));
+		auto ptr=std::unique_ptr<Request>(new Request(std::move(request),share));
 		
 		//	Get the data
 		auto t=ptr->Get();
@@ -994,6 +1287,13 @@ namespace MCPP {
 		return std::move(t.Item<1>());
 	
 	}
+	
+	
+	void HTTPHandler::SetMaxHostConnections (Word max) {
+	
+		lock.Execute([&] () mutable {	multi_setopt(handle,CURLMOPT_MAX_HOST_CONNECTIONS,safe_cast<long>(max));	});
+	
+	}
 
 
 }
@@ -0,0 +1,96 @@
+#include <rleahylib/rleahylib.hpp>
+#include <chat/chat.hpp>
+#include <dns_handler.hpp>
+#include <info/info.hpp>
+#include <mod.hpp>
+
+
+using namespace MCPP;
+
+
+static const String name("DNS Information");
+static const Word priority=1;
+static const String identifier("dns");
+static const String help("Displays information about DNS lookups.");
+static const String dns_banner("DNS LOOKUPS:");
+static const String cache_template("Cache Hits: {0}, Misses: {1}, Coalesced: {2}, Hit Rate: {3}%");
+static const String resolve_template("Resolved: {0}, Average Latency: {1}ms");
+
+
+class DNSInfoProvider : public Module, public InformationProvider {
+
+
+	public:
+	
+	
+		virtual Word Priority () const noexcept override {
+		
+			return priority;
+		
+		}
+		
+		
+		virtual const String & Name () const noexcept override {
+		
+			return name;
+		
+		}
+		
+		
+		virtual void Install () override {
+		
+			Information::Get().Add(this);
+		
+		}
+		
+		
+		virtual const String & Identifier () const noexcept override {
+		
+			return identifier;
+		
+		}
+		
+		
+		virtual const String & Help () const noexcept override {
+		
+			return help;
+		
+		}
+		
+		
+		virtual void Execute (ChatMessage & message) const override {
+		
+			auto info=DNSHandler::GetInfo();
+			
+			//	Lookups which joined one already in
+			//	progress never reached the cache,
+			//	but neither did they reach a name
+			//	server
+			auto total=info.Hits+info.Misses+info.Coalesced;
+			
+			message	<<	ChatStyle::Bold
+					<<	dns_banner
+					<<	ChatFormat::Pop
+					<<	Newline
+					<<	String::Format(
+							cache_template,
+							info.Hits,
+							info.Misses,
+							info.Coalesced,
+							//	Guard against divide by zero
+							(total==0) ? 0 : ((static_cast<Double>(info.Hits)*100)/static_cast<Double>(total))
+						)
+					<<	Newline
+					<<	String::Format(
+							resolve_template,
+							info.Resolved,
+							(info.Resolved==0) ? 0 : ((static_cast<Double>(info.Elapsed)/1000000)/static_cast<Double>(info.Resolved))
+						);
+		
+		}
+
+
+};
+
+
+INSTALL_MODULE(DNSInfoProvider)
@@ -26,6 +26,17 @@ static const String disconnected_label("Connections Terminated");
 static const String listening_label("Listening Sockets");
 static const String connected_label("Connected Sockets");
 static const String workers_label("Number of Worker Threads");
+static const String limiter_banner("ACCEPT RATE LIMITING:");
+static const String window_label("Window");
+static const String window_template("{0}ms");
+static const String host_limit_label("Connections Per Address");
+static const String range_limit_label("Connections Per Range");
+static const String unlimited("Unlimited");
+static const String limit_template("{0}");
+static const String checked_label("Connections Checked");
+static const String host_refused_label("Refused (Address Over Limit)");
+static const String range_refused_label("Refused (Range Over Limit)");
+static const String escalated_label("Escalated to Blacklist");
 
 
 class HandlerInfo : public Module, public InformationProvider {
@@ -34,6 +45,13 @@ class HandlerInfo : public Module, public InformationProvider {
 	private:
 	
 	
+		static String limit (Word limit) {
+		
+			return (limit==0) ? unlimited : String::Format(limit_template,limit);
+		
+		}
+	
+	
 		template <typename T>
 		static void line (ChatMessage & message, const String & label, const T & data) {
 		
@@ -104,6 +122,28 @@ class HandlerInfo : public Module, public InformationProvider {
 			line(message,connected_label,info.Connected);
 			line(message,workers_label,info.Workers);
 		
+			auto limiter=Server::Get().Limiter().GetInfo();
+			
+			message	<<	Newline
+					<<	ChatStyle::Bold
+					<<	limiter_banner
+					<<	ChatFormat::Pop;
+			
+			line(
+				message,
+				window_label,
+				String::Format(
+					window_template,
+					limiter.Window
+				)
+			);
+			line(message,host_limit_label,limit(limiter.HostLimit));
+			line(message,range_limit_label,limit(limiter.RangeLimit));
+			line(message,checked_label,limiter.Checked);
+			line(message,host_refused_label,limiter.HostRefused);
+			line(message,range_refused_label,limiter.RangeRefused);
+			line(message,escalated_label,limiter.Escalated);
+		
 		}
 
 
@@ -14,6 +14,7 @@ static const String help("Display information about mcpp.dll.");
 static const String mcpp_banner("MINECRAFT++:");
 static const String compiled_by_template("Compiled by {0} on {1}");
 static const String minecraft_compat("Compatible with Minecraft {0} (protocol version {1})");
+static const String log_template("Log: {0} written, {1} dropped ({2} buffers of {3} records)");
 
 
 class MCPPInfo : public Module, public InformationProvider {
@@ -78,6 +79,17 @@ class MCPPInfo : public Module, public InformationProvider {
 							),
 							ProtocolVersion
 						);
+			
+			auto log=Server::Get().GetLogInfo();
+			
+			message	<<	Newline
+					<<	String::Format(
+							log_template,
+							log.Written,
+							log.Dropped,
+							log.Rings,
+							log.Capacity
+						);
 		
 		}
 
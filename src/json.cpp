@@ -2,6 +2,7 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <utility>
 
 
@@ -32,64 +33,128 @@ namespace JSON {
 	}
 
 
-	String Serialize (const String & str) {
+	static void put (Vector<Byte> & buffer, const char * str, Word len) {
+	
+		//	Make enough space in the buffer
+		while ((buffer.Capacity()-buffer.Count())<len) buffer.SetCapacity();
+		
+		std::memcpy(
+			buffer.end(),
+			str,
+			len
+		);
+		
+		buffer.SetCount(buffer.Count()+len);
+	
+	}
+	
+	
+	template <Word n>
+	static void put (Vector<Byte> & buffer, const char (& str) [n]) {
+	
+		put(buffer,str,n-1);
+	
+	}
+	
+	
+	static void put_utf8 (Vector<Byte> & buffer, UInt32 cp) {
+	
+		if (cp<0x80) {
+		
+			buffer.Add(static_cast<Byte>(cp));
+			
+			return;
+		
+		}
+		
+		Byte encoded [4];
+		Word len;
+		if (cp<0x800) {
+		
+			encoded[0]=static_cast<Byte>(0xC0|(cp>>6));
+			len=2;
+		
+		} else if (cp<0x10000) {
+		
+			encoded[0]=static_cast<Byte>(0xE0|(cp>>12));
+			len=3;
+		
+		} else {
+		
+			encoded[0]=static_cast<Byte>(0xF0|(cp>>18));
+			len=4;
+		
+		}
+		
+		//	Continuation bytes carry six
+		//	bits each
+		for (Word i=1;i<len;++i) encoded[i]=static_cast<Byte>(0x80|((cp>>(6*(len-i-1)))&0x3F));
+		
+		put(buffer,reinterpret_cast<const char *>(encoded),len);
+	
+	}
+	
 	
-		String retr("\"");
+	static const char * hex_digits="0123456789ABCDEF";
+	
+	
+	static void serialize (Vector<Byte> & buffer, const String & str) {
+	
+		buffer.Add(static_cast<Byte>('"'));
 		
 		for (auto cp : str.CodePoints()) {
 		
 			switch (cp) {
 			
 				case '"':
-					retr << "\\\"";
+					put(buffer,"\\\"");
 					break;
 				case '\\':
-					retr << "\\\\";
+					put(buffer,"\\\\");
 					break;
 				case '/':
-					retr << "\\/";
+					put(buffer,"\\/");
 					break;
 				case '\b':
-					retr << "\\b";
+					put(buffer,"\\b");
 					break;
 				case '\f':
-					retr << "\\f";
+					put(buffer,"\\f");
 					break;
 				case '\n':
-					retr << "\\n";
+					put(buffer,"\\n");
 					break;
 				case '\r':
-					retr << "\\r";
+					put(buffer,"\\r");
 					break;
 				case '\t':
-					retr << "\\t";
+					put(buffer,"\\t");
 					break;
 				default:{
 				
-					auto cpi=CodePointInfo::GetInfo(cp);
-					
+					auto c=static_cast<UInt32>(cp);
+				
+					//	Control characters (general
+					//	category Cc) are escaped
 					if (
-						(cpi!=nullptr) &&
-						(cpi->Category==GeneralCategory::Cc)
+						(c<0x20) ||
+						((c>=0x7F) && (c<=0x9F))
 					) {
 					
-						String hex(cp,16);
-						
-						Word count=hex.Count();
-						if (count<4) {
-						
-							String pad;
-							for (Word i=0;i<(4-count);++i) pad << String("0");
-							
-							hex=pad+hex;
+						char escape []={
+							'\\',
+							'u',
+							'0',
+							'0',
+							hex_digits[(c>>4)&15],
+							hex_digits[c&15]
+						};
 						
-						}
-						
-						retr << "\\u" << hex;
+						put(buffer,escape,sizeof(escape));
 					
 					} else {
 					
-						retr << cp;
+						put_utf8(buffer,c);
 					
 					}
 				
@@ -99,9 +164,7 @@ namespace JSON {
 		
 		}
 		
-		retr << "\"";
-		
-		return retr;
+		buffer.Add(static_cast<Byte>('"'));
 	
 	}
 	
@@ -111,91 +174,147 @@ namespace JSON {
 	static const char * snprintf_error="snprintf returned error";
 	
 	
-	String Serialize (Double dbl) {
+	static void serialize (Vector<Byte> & buffer, Double dbl) {
 	
 		if (std::isnan(dbl)) throw Error(nan);
 		if (!std::isfinite(dbl)) throw Error(inf);
-	
-		const char * format="%g";
-	
-		int size=std::snprintf(nullptr,0,format,dbl);
 		
-		if (size<0) throw Error(snprintf_error);
+		//	%g never produces more than
+		//	a handful of characters for
+		//	a finite double
+		char str [32];
+		int size=std::snprintf(str,sizeof(str),"%g",dbl);
 		
-		SafeInt<int> safe_size(size);
-		++safe_size;
-		Word safe_w_size(safe_size);
+		if ((size<0) || (static_cast<Word>(size)>=sizeof(str))) throw Error(snprintf_error);
 		
-		Vector<Byte> buffer(safe_w_size);
-		
-		if ((size=std::snprintf(
-			reinterpret_cast<char *>(
-				buffer.begin()
-			),
-			int(safe_size),
-			format,
-			dbl
-		))<0) throw Error(snprintf_error);
-		
-		buffer.SetCount(safe_w_size-1);
-		
-		return UTF8().Decode(
-			buffer.begin(),
-			buffer.end()
-		);
+		put(buffer,str,static_cast<Word>(size));
 	
 	}
 	
 	
-	String Serialize (std::nullptr_t) {
+	static void serialize (Vector<Byte> & buffer, std::nullptr_t) {
 	
-		return String("null");
+		put(buffer,"null");
 	
 	}
 	
 	
-	String Serialize (const Object & obj) {
+	static void serialize (Vector<Byte> &, const Value &);
+	
 	
-		if (obj.IsNull()) return Serialize(nullptr);
+	static void serialize (Vector<Byte> & buffer, const Object & obj) {
 	
-		String retr("{");
+		if (obj.IsNull()) {
+		
+			serialize(buffer,nullptr);
+			
+			return;
+		
+		}
+		
+		buffer.Add(static_cast<Byte>('{'));
 		
 		bool first=true;
 		for (const auto & pair : *obj.Pairs) {
 		
 			if (first) first=false;
-			else retr << ",";
-		
-			retr	<<	Serialize(pair.first)
-					<<	":"
-					<<	Serialize(pair.second);
+			else buffer.Add(static_cast<Byte>(','));
+			
+			serialize(buffer,pair.first);
+			buffer.Add(static_cast<Byte>(':'));
+			serialize(buffer,pair.second);
 		
 		}
 		
-		retr << "}";
-		
-		return retr;
+		buffer.Add(static_cast<Byte>('}'));
 	
 	}
 	
 	
-	String Serialize (const Array & arr) {
+	static void serialize (Vector<Byte> & buffer, const Array & arr) {
 	
-		String retr("[");
+		buffer.Add(static_cast<Byte>('['));
 		
 		bool first=true;
 		for (const auto & value : arr.Values) {
 		
 			if (first) first=false;
-			else retr << ",";
+			else buffer.Add(static_cast<Byte>(','));
 			
-			retr << Serialize(value);
+			serialize(buffer,value);
 		
 		}
 		
-		retr << "]";
+		buffer.Add(static_cast<Byte>(']'));
+	
+	}
+	
+	
+	static void serialize (Vector<Byte> & buffer, bool bln) {
+	
+		if (bln) put(buffer,"true");
+		else put(buffer,"false");
+	
+	}
+	
+	
+	static void serialize (Vector<Byte> & buffer, const Value & value) {
+	
+		if (value.IsNull()) serialize(buffer,nullptr);
+		else if (value.Is<String>()) serialize(buffer,value.Get<String>());
+		else if (value.Is<Double>()) serialize(buffer,value.Get<Double>());
+		else if (value.Is<Object>()) serialize(buffer,value.Get<Object>());
+		else if (value.Is<Array>()) serialize(buffer,value.Get<Array>());
+		else serialize(buffer,value.Get<bool>());
+	
+	}
+	
+	
+	template <typename T>
+	static String to_string (const T & value) {
+	
+		Vector<Byte> buffer;
+		serialize(buffer,value);
 		
-		return retr;
+		return UTF8().Decode(
+			buffer.begin(),
+			buffer.end()
+		);
+	
+	}
+	
+	
+	String Serialize (const String & str) {
+	
+		return to_string(str);
+	
+	}
+	
+	
+	String Serialize (Double dbl) {
+	
+		return to_string(dbl);
+	
+	}
+	
+	
+	String Serialize (std::nullptr_t) {
+	
+		return String("null");
+	
+	}
+	
+	
+	String Serialize (const Object & obj) {
+	
+		return to_string(obj);
+	
+	}
+	
+	
+	String Serialize (const Array & arr) {
+	
+		return to_string(arr);
 	
 	}
 	
@@ -209,27 +328,14 @@ namespace JSON {
 	
 	String Serialize (const Value & value) {
 	
-		return (
-			value.IsNull()
-				?	Serialize(nullptr)
-				:	(
-						value.Is<String>()
-							?	Serialize(value.Get<String>())
-							:	(
-									value.Is<Double>()
-										?	Serialize(value.Get<Double>())
-										:	(
-												value.Is<Object>()
-													?	Serialize(value.Get<Object>())
-													:	(
-															value.Is<Array>()
-																?	Serialize(value.Get<Array>())
-																:	Serialize(value.Get<bool>())
-														)
-											)
-								)
-					)
-		);
+		return to_string(value);
+	
+	}
+	
+	
+	void Serialize (Vector<Byte> & buffer, const Value & value) {
+	
+		serialize(buffer,value);
 	
 	}
 	
@@ -263,164 +369,305 @@ namespace JSON {
 	static const char * invalid_hex="Invalid hexadecimal sequence";
 	
 	
-	static UInt16 get_hex (StringGraphemeClusterIterator & iter) {
+	static UInt16 get_hex (const Byte * & begin, const Byte * end) {
+	
+		if ((end-begin)<4) throw Error(invalid_hex);
 	
-		String hex;
+		UInt16 retr=0;
 		for (Word i=0;i<4;++i) {
 		
-			if (iter.IsEnd()) throw Error(invalid_hex);
+			Byte b=*(begin++);
 			
-			hex << *iter;
+			UInt16 nibble;
+			if ((b>='0') && (b<='9')) nibble=b-'0';
+			else if ((b>='a') && (b<='f')) nibble=b-'a'+10;
+			else if ((b>='A') && (b<='F')) nibble=b-'A'+10;
+			else throw Error(invalid_hex);
+			
+			retr=(retr<<4)|nibble;
 		
 		}
 		
-		UInt16 retr;
-		if (!hex.ToInteger(&retr,16)) throw Error(invalid_hex);
-		
 		return retr;
 	
 	}
 	
 	
+	static const char * invalid_utf8="Invalid UTF-8 sequence";
+	
+	
+	static CodePoint get_utf8 (const Byte * & begin, const Byte * end) {
+	
+		Byte lead=*(begin++);
+		
+		if (lead<0x80) return static_cast<CodePoint>(lead);
+		
+		UInt32 cp;
+		Word count;
+		if ((lead&0xE0)==0xC0) {
+		
+			cp=lead&0x1F;
+			count=1;
+		
+		} else if ((lead&0xF0)==0xE0) {
+		
+			cp=lead&0x0F;
+			count=2;
+		
+		} else if ((lead&0xF8)==0xF0) {
+		
+			cp=lead&0x07;
+			count=3;
+		
+		} else {
+		
+			throw Error(invalid_utf8);
+		
+		}
+		
+		if (static_cast<Word>(end-begin)<count) throw Error(invalid_utf8);
+		
+		for (Word i=0;i<count;++i) {
+		
+			Byte b=*(begin++);
+			
+			if ((b&0xC0)!=0x80) throw Error(invalid_utf8);
+			
+			cp=(cp<<6)|(b&0x3F);
+		
+		}
+		
+		//	Reject overlong encodings, surrogates,
+		//	and values beyond the Unicode code
+		//	space
+		static const UInt32 min []={0,0x80,0x800,0x10000};
+		if (
+			(cp<min[count]) ||
+			(cp>0x10FFFF) ||
+			((cp>=0xD800) && (cp<=0xDFFF))
+		) throw Error(invalid_utf8);
+		
+		return static_cast<CodePoint>(cp);
+	
+	}
+	
+	
+	//	Finds the first byte which is a quotation
+	//	mark, a backslash, or not ASCII, examining
+	//	eight bytes at a time
+	static const Byte * scan_string (const Byte * begin, const Byte * end) noexcept {
+	
+		const UInt64 ones=0x0101010101010101ULL;
+		const UInt64 highs=0x8080808080808080ULL;
+		const UInt64 quotes=ones*'"';
+		const UInt64 backslashes=ones*'\\';
+		
+		for (;(end-begin)>=8;begin+=8) {
+		
+			UInt64 word;
+			std::memcpy(&word,begin,sizeof(word));
+			
+			//	A byte of these is zero if and
+			//	only if the corresponding byte
+			//	of the input is a quote or a
+			//	backslash
+			UInt64 q=word^quotes;
+			UInt64 b=word^backslashes;
+			
+			//	The high bit of a byte in this
+			//	is set if the corresponding byte
+			//	might be interesting, the scalar
+			//	loop below makes the exact
+			//	determination
+			if (((((q-ones)&~q)|((b-ones)&~b)|word)&highs)!=0) break;
+		
+		}
+		
+		for (
+			;
+			(begin!=end) &&
+			(*begin!='"') &&
+			(*begin!='\\') &&
+			(*begin<0x80);
+			++begin
+		);
+		
+		return begin;
+	
+	}
+	
+	
 	static const char * unterminated_string="Unterminated string";
 	static const char * unrecognized_escape="Unrecognized escape sequence";
 	static const char * invalid_unicode="Invalid Unicode sequence";
 	
 	
-	static String parse_string (StringGraphemeClusterIterator & iter, ParserState & state) {
+	static String parse_string (const Byte * & begin, const Byte * end, ParserState &) {
 	
-		String retr;
+		Vector<CodePoint> retr;
 		
-		for (++iter;;++iter) {
+		for (++begin;;) {
 		
+			//	Copy runs of ASCII verbatim
+			auto run=scan_string(begin,end);
+			for (;begin!=run;++begin) retr.Add(static_cast<CodePoint>(*begin));
+			
 			//	If we found the end of the
 			//	string without finding a
 			//	closing quote, that's an
 			//	error
-			if (iter.IsEnd()) throw Error(unterminated_string);
-		
+			if (begin==end) throw Error(unterminated_string);
+			
 			//	End on closing quote
-			if (*iter=='"') break;
+			if (*begin=='"') break;
 			
-			//	Backslash escape
-			if (*iter=='\\') {
+			//	Multi-byte UTF-8 sequence
+			if (*begin!='\\') {
 			
-				++iter;
+				retr.Add(get_utf8(begin,end));
 				
-				//	Make sure we haven't reached the end
-				if (iter.IsEnd()) throw Error(unterminated_string);
-				
-				if (*iter=='"') retr << "\"";
-				else if (*iter=='\\') retr << "\\";
-				else if (*iter=='/') retr << "/";
-				else if (*iter=='b') retr << "\b";
-				else if (*iter=='f') retr << "\f";
-				else if (*iter=='n') retr << "\n";
-				else if (*iter=='r') retr << "\r";
-				else if (*iter=='t') retr << "\t";
-				else if (*iter=='u') {
+				continue;
+			
+			}
+			
+			//	Backslash escape
+			
+			++begin;
+			
+			//	Make sure we haven't reached the end
+			if (begin==end) throw Error(unterminated_string);
+			
+			switch (*(begin++)) {
+			
+				case '"':
+					retr.Add(static_cast<CodePoint>('"'));
+					break;
+				case '\\':
+					retr.Add(static_cast<CodePoint>('\\'));
+					break;
+				case '/':
+					retr.Add(static_cast<CodePoint>('/'));
+					break;
+				case 'b':
+					retr.Add(static_cast<CodePoint>('\b'));
+					break;
+				case 'f':
+					retr.Add(static_cast<CodePoint>('\f'));
+					break;
+				case 'n':
+					retr.Add(static_cast<CodePoint>('\n'));
+					break;
+				case 'r':
+					retr.Add(static_cast<CodePoint>('\r'));
+					break;
+				case 't':
+					retr.Add(static_cast<CodePoint>('\t'));
+					break;
+				case 'u':{
 				
 					//	Unicode escape
 					
-					UInt16 decode [2];
-					
-					decode[0]=get_hex(iter);
+					UInt32 cp=get_hex(begin,end);
 					
-					UTF16 decoder(Endianness::IsBigEndian<UInt16>());
+					//	Low surrogates may not
+					//	appear on their own
+					if ((cp>=0xDC00) && (cp<=0xDFFF)) throw Error(invalid_unicode);
 					
-					String decoded=decoder.Decode(
-						reinterpret_cast<const Byte *>(decode),
-						reinterpret_cast<const Byte *>(decode+1)
-					);
-					if (decoded.Count()==0) {
+					//	High surrogates must be
+					//	followed by an escaped low
+					//	surrogate
+					if ((cp>=0xD800) && (cp<=0xDBFF)) {
 					
-						if (iter.IsEnd()) throw Error(unterminated_string);
-						if (*iter!='\\') throw Error(invalid_unicode);
-						++iter;
-						if (*iter!='u') throw Error(invalid_unicode);
-						++iter;
+						if (
+							((end-begin)<2) ||
+							(begin[0]!='\\') ||
+							(begin[1]!='u')
+						) throw Error(invalid_unicode);
 						
-						decode[1]=get_hex(iter);
+						begin+=2;
 						
-						retr << decoder.Decode(
-							reinterpret_cast<const Byte *>(decode),
-							reinterpret_cast<const Byte *>(decode+2)
-						);
-					
-					} else {
-					
-						retr << decoded;
+						UInt32 low=get_hex(begin,end);
+						
+						if (!((low>=0xDC00) && (low<=0xDFFF))) throw Error(invalid_unicode);
+						
+						cp=0x10000+((cp-0xD800)<<10)+(low-0xDC00);
 					
 					}
+					
+					retr.Add(static_cast<CodePoint>(cp));
 				
-				} else throw Error(unrecognized_escape);
-			
-				continue;
+				}break;
+				default:
+					throw Error(unrecognized_escape);
 			
 			}
-			
-			//	Add grapheme verbatim
-			retr << *iter;
 		
 		}
 		
 		//	Get past closing quote
-		++iter;
+		++begin;
 		
-		return retr;
+		return String(std::move(retr));
+	
+	}
+	
+	
+	static bool is_whitespace (Byte b) noexcept {
+	
+		return (b==' ') || (b=='\t') || (b=='\n') || (b=='\r');
 	
 	}
 	
 	
-	static void skip_whitespace (StringGraphemeClusterIterator & iter) {
+	static void skip_whitespace (const Byte * & begin, const Byte * end) noexcept {
 	
-		for (;!iter.IsEnd() && (iter->IsWhitespace() || iter->IsLineBreak());++iter);
+		for (;(begin!=end) && is_whitespace(*begin);++begin);
 	
 	}
 	
 	
-	static Value parse (StringGraphemeClusterIterator &, ParserState &);
+	static Value parse (const Byte * &, const Byte *, ParserState &);
 	
 	
 	static const char * unterminated_array="Unterminated array";
 	static const char * invalid_token_in_array="Invalid token in array";
 	
 	
-	static Array parse_array (StringGraphemeClusterIterator & iter, ParserState & state) {
+	static Array parse_array (const Byte * & begin, const Byte * end, ParserState & state) {
 	
 		Array retr;
 		
-		++iter;
+		++begin;
 		for (bool first=true;;) {
 		
 			//	Whitespace inside arrays is
 			//	legal
-			skip_whitespace(iter);
+			skip_whitespace(begin,end);
 		
-			//	We found the end of the string
+			//	We found the end of the buffer
 			//	without finding a closing square
 			//	bracket, that's an error
-			if (iter.IsEnd()) throw Error(unterminated_array);
+			if (begin==end) throw Error(unterminated_array);
 			
 			//	Is this the end of the array?
-			if (*iter==']') break;
+			if (*begin==']') break;
 			
 			if (first) first=false;
-			else if (*iter==',') {
+			else if (*begin==',') {
 			
-				++iter;
+				++begin;
 				
-				skip_whitespace(iter);
+				skip_whitespace(begin,end);
 				
 			} else throw Error(invalid_token_in_array);
 			
 			//	Get value
-			retr.Values.Add(parse(iter,state));
+			retr.Values.Add(parse(begin,end,state));
 		
 		}
 		
 		//	Skip closing square bracket
-		++iter;
+		++begin;
 		
 		return retr;
 	
@@ -434,58 +681,58 @@ namespace JSON {
 	static const char * invalid_token_in_object="Invalid token in object";
 	
 	
-	static Object parse_object (StringGraphemeClusterIterator & iter, ParserState & state) {
+	static Object parse_object (const Byte * & begin, const Byte * end, ParserState & state) {
 	
 		Object retr;
 		retr.Construct();
 		
-		++iter;
+		++begin;
 		for (bool first=true;;) {
 		
 			//	Whitespace inside objects is
 			//	legal
-			skip_whitespace(iter);
+			skip_whitespace(begin,end);
 			
-			//	String can't end until after
+			//	Buffer can't end until after
 			//	}
-			if (iter.IsEnd()) throw Error(unterminated_object);
+			if (begin==end) throw Error(unterminated_object);
 			
-			if (*iter=='}') break;
+			if (*begin=='}') break;
 			
 			if (first) first=false;
-			else if (*iter==',') {
+			else if (*begin==',') {
 
-				++iter;
+				++begin;
 				
-				skip_whitespace(iter);
+				skip_whitespace(begin,end);
 				
 			} else throw Error(invalid_token_in_object);
 			
 			//	Every item in an object
 			//	is identified by a string
-			if (*iter!='"') throw Error(invalid_key);
+			if ((begin==end) || (*begin!='"')) throw Error(invalid_key);
 			
 			//	Get the key
-			String key(parse_string(iter,state));
+			String key(parse_string(begin,end,state));
 			
 			//	Check for duplicate keys
 			if (retr.Pairs->count(key)!=0) throw Error(duplicate_key);
 			
-			skip_whitespace(iter);
+			skip_whitespace(begin,end);
 			
-			if (iter.IsEnd()) throw Error(unterminated_object);
+			if (begin==end) throw Error(unterminated_object);
 			
 			//	There must be a colon separating
 			//	the key and the value
-			if (*iter!=':') throw Error(no_value_for_key);
+			if (*begin!=':') throw Error(no_value_for_key);
 			
 			//	Skip over colon
-			++iter;
+			++begin;
 			
-			skip_whitespace(iter);
+			skip_whitespace(begin,end);
 			
 			//	Get the value
-			Value value(parse(iter,state));
+			Value value(parse(begin,end,state));
 			
 			//	Insert
 			retr.Pairs->emplace(
@@ -496,7 +743,7 @@ namespace JSON {
 		}
 		
 		//	Skip closing curly brace
-		++iter;
+		++begin;
 		
 		return retr;
 	
@@ -507,65 +754,142 @@ namespace JSON {
 	static const char * invalid_value="Unrecognized value";
 	
 	
-	static Value parse_misc (StringGraphemeClusterIterator & iter, ParserState & state) {
+	static bool matches (const Byte * begin, const Byte * end, const char * str) noexcept {
 	
-		String value;
-		for (;;++iter) {
+		Word len=std::strlen(str);
 		
-			if (
-				iter.IsEnd() ||
-				iter->IsWhitespace() ||
-				iter->IsLineBreak() ||
-				(*iter=='}') ||
-				(*iter==']') ||
-				(*iter==',')
-			) break;
-			
-			value << *iter;
+		return (
+			(static_cast<Word>(end-begin)==len) &&
+			(std::memcmp(begin,str,len)==0)
+		);
+	
+	}
+	
+	
+	static bool is_digit (Byte b) noexcept {
+	
+		return (b>='0') && (b<='9');
+	
+	}
+	
+	
+	static const Byte * skip_digits (const Byte * begin, const Byte * end) noexcept {
+	
+		for (;(begin!=end) && is_digit(*begin);++begin);
 		
-		}
+		return begin;
+	
+	}
+	
+	
+	//	Determines whether a token is a number
+	//	as JSON's grammar defines it, strtod
+	//	accepts many things JSON does not (e.g.
+	//	hexadecimal, infinity, leading zeroes)
+	static bool is_number (const Byte * begin, const Byte * end) noexcept {
+	
+		if ((begin!=end) && (*begin=='-')) ++begin;
 		
-		if (value.Count()==0) throw Error(no_value);
+		//	Integer part
+		if (begin==end) return false;
+		if (*begin=='0') ++begin;
+		else if (is_digit(*begin)) begin=skip_digits(begin,end);
+		else return false;
 		
-		Value retr;
+		//	Fraction
+		if ((begin!=end) && (*begin=='.')) {
 		
-		if (value=="true") retr=true;
-		else if (value=="false") retr=false;
-		else if (value!="null") {
+			auto digits=++begin;
+			begin=skip_digits(begin,end);
+			if (begin==digits) return false;
 		
-			//	See if we have a number
-			
-			auto c_str=value.ToCString();
-			char * end;
-			retr=std::strtod(
-				static_cast<char *>(c_str),
-				&end
-			);
+		}
+		
+		//	Exponent
+		if ((begin!=end) && ((*begin=='e') || (*begin=='E'))) {
+		
+			++begin;
+			if ((begin!=end) && ((*begin=='+') || (*begin=='-'))) ++begin;
 			
-			if (end==static_cast<char *>(c_str)) throw Error(invalid_value);
+			auto digits=begin;
+			begin=skip_digits(begin,end);
+			if (begin==digits) return false;
+		
+		}
+		
+		return begin==end;
+	
+	}
+	
+	
+	static Double parse_number (const Byte * begin, const Byte * end) {
+	
+		if (!is_number(begin,end)) throw Error(invalid_value);
+		
+		//	strtod requires a null terminated
+		//	string, almost every number fits
+		//	on the stack, but JSON places no
+		//	limit on the number of digits
+		char str [64];
+		Vector<char> long_str;
+		char * ptr=str;
+		Word len=static_cast<Word>(end-begin);
+		if (len>=sizeof(str)) {
+		
+			long_str=Vector<char>(Word(SafeWord(len)+SafeWord(1)));
+			ptr=long_str.begin();
 		
 		}
 		
+		std::memcpy(ptr,begin,len);
+		ptr[len]='\0';
+		
+		return std::strtod(ptr,nullptr);
+	
+	}
+	
+	
+	static Value parse_misc (const Byte * & begin, const Byte * end, ParserState &) {
+	
+		auto start=begin;
+		for (
+			;
+			(begin!=end) &&
+			!is_whitespace(*begin) &&
+			(*begin!='}') &&
+			(*begin!=']') &&
+			(*begin!=',');
+			++begin
+		);
+		
+		if (begin==start) throw Error(no_value);
+		
+		Value retr;
+		
+		if (matches(start,begin,"true")) retr=true;
+		else if (matches(start,begin,"false")) retr=false;
+		else if (!matches(start,begin,"null")) retr=parse_number(start,begin);
+		
 		return retr;
 	
 	}
 	
 	
-	static Value parse (StringGraphemeClusterIterator & iter, ParserState & state) {
+	static Value parse (const Byte * & begin, const Byte * end, ParserState & state) {
 	
 		++state.Depth;
 		state.CheckDepth();
 	
-		skip_whitespace(iter);
+		skip_whitespace(begin,end);
 		
 		Value retr;
 		
-		if (iter.IsEnd()) throw Error(no_value);
+		if (begin==end) throw Error(no_value);
 		
-		if (*iter=='"') retr=parse_string(iter,state);
-		else if (*iter=='[') retr=parse_array(iter,state);
-		else if (*iter=='{') retr=parse_object(iter,state);
-		else retr=parse_misc(iter,state);
+		if (*begin=='"') retr=parse_string(begin,end,state);
+		else if (*begin=='[') retr=parse_array(begin,end,state);
+		else if (*begin=='{') retr=parse_object(begin,end,state);
+		else retr=parse_misc(begin,end,state);
 		
 		--state.Depth;
 		
@@ -577,23 +901,34 @@ namespace JSON {
 	static const char * too_many_values="Multiple values at root, JSON consists of only one root value";
 	
 	
-	Value Parse (const String & json, Word max_depth) {
+	Value Parse (const Byte * begin, const Byte * end, Word max_depth) {
 	
-		auto iter=json.begin();
-		
 		ParserState state{0,max_depth};
 		
-		auto retr=parse(iter,state);
+		auto retr=parse(begin,end,state);
 		
-		skip_whitespace(iter);
+		skip_whitespace(begin,end);
 		
-		if (!iter.IsEnd()) throw Error(too_many_values);
+		if (begin!=end) throw Error(too_many_values);
 		
 		return retr;
 	
 	}
 	
 	
+	Value Parse (const String & json, Word max_depth) {
+	
+		auto buffer=UTF8().Encode(json);
+		
+		return Parse(
+			buffer.begin(),
+			buffer.end(),
+			max_depth
+		);
+	
+	}
+	
+	
 	static String print (bool bln) {
 	
 		String retr("Boolean: ");
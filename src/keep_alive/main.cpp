@@ -103,7 +103,7 @@ class KeepAlive : public Module {
 				send reply;
 				reply.KeepAliveID=0;
 				
-				event.From->Send(reply);
+				event.From->Post(reply,true);
 			
 			//	Otherwise we have to check to make
 			//	sure this is the right ID etc.
@@ -153,14 +153,12 @@ class KeepAlive : public Module {
 				
 					//	Log if applicable
 					auto & server=Server::Get();
-					if (server.IsVerbose(debug_key)) server.WriteLog(
-						String::Format(
-							log_ping,
-							event.From->IP(),
-							event.From->Port(),
-							elapsed
-						),
-						Service::LogType::Debug
+					if (server.IsVerbose(debug_key)) server.Log(
+						Service::LogType::Debug,
+						log_ping,
+						event.From->IP(),
+						event.From->Port(),
+						elapsed
 					);
 				
 				}
@@ -199,15 +197,13 @@ class KeepAlive : public Module {
 					bool timed_out=inactive>timeout;
 					
 					//	Debug logging if applicable
-					if (is_verbose) server.WriteLog(
-						String::Format(
-							log_inactive,
-							client->IP(),
-							client->Port(),
-							inactive,
-							timed_out ? log_action_terminate : log_action_keep
-						),
-						Service::LogType::Debug
+					if (is_verbose) server.Log(
+						Service::LogType::Debug,
+						log_inactive,
+						client->IP(),
+						client->Port(),
+						inactive,
+						timed_out ? log_action_terminate : log_action_keep
 					);
 					
 					//	Kill if client has timed out
@@ -262,7 +258,9 @@ class KeepAlive : public Module {
 							send packet;
 							packet.KeepAliveID=id;
 							
-							client->Send(packet);
+							//	Held keep alives would skew the
+							//	measured latency
+							client->Post(packet,true);
 							
 							//	We're now waiting
 							data.Waiting=true;
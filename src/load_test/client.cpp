@@ -0,0 +1,555 @@
+#include <load_test/load_test.hpp>
+#include <json.hpp>
+#include <random_device.hpp>
+#include <rsa_key.hpp>
+#include <scope_guard.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+
+namespace MCPP {
+
+
+	namespace LoadTest {
+	
+	
+		static const String name_template("bot{0}");
+		static const String chat_template("load test {0}:{1}");
+		static const Word secret_length=16;
+		//	Spreads clients' headings evenly
+		//	around the spawn point
+		static const Double golden_angle=2.39996322972865332;
+		static const Double pi=3.14159265358979323846;
+		//	Height of a player's eyes above
+		//	their feet
+		static const Double stance_offset=1.62;
+		//	How high above the spawn point
+		//	flying clients fly
+		static const Double fly_height=32;
+		
+		
+		typedef Packets::Handshaking::Serverbound::Handshake handshake;
+		typedef Packets::Login::Serverbound::LoginStart login_start;
+		typedef Packets::Login::Clientbound::EncryptionResponse key_request;
+		typedef Packets::Login::Serverbound::EncryptionRequest key_response;
+		typedef Packets::Login::Clientbound::LoginSuccess login_success;
+		typedef Packets::Play::Clientbound::KeepAlive keep_alive_in;
+		typedef Packets::Play::Serverbound::KeepAlive keep_alive_out;
+		typedef Packets::Play::Clientbound::ChatMessage chat_in;
+		typedef Packets::Play::Serverbound::ChatMessage chat_out;
+		typedef Packets::Play::Clientbound::PlayerPositionAndLook position_in;
+		typedef Packets::Play::Serverbound::PlayerPositionAndLook position_out;
+		typedef Packets::Play::Clientbound::ChunkData chunk_data;
+		typedef Packets::Play::Clientbound::MapChunkBulk chunk_bulk;
+		
+		
+		SimulatedClient::SimulatedClient (Word index, const Options & options, Results & results)
+			:	options(options),
+				results(results),
+				index(index),
+				name(String::Format(name_template,index)),
+				done(false),
+				leftover(0),
+				state(ProtocolState::Handshaking),
+				first_chunk(false),
+				spawned(false),
+				heading(std::fmod(index*golden_angle,2*pi)),
+				distance(0),
+				ka_waiting(false),
+				chat_seq(0)
+		{	}
+		
+		
+		template <typename T>
+		void SimulatedClient::send (const T & packet) {
+		
+			if (conn.IsNull() || done) return;
+			
+			auto buffer=Serialize(packet);
+			
+			results.Sent+=buffer.Count();
+			
+			if (aes.IsNull()) {
+			
+				conn->Post(std::move(buffer));
+				
+				return;
+			
+			}
+			
+			aes->BeginEncrypt();
+			auto guard=AtExit([&] () {	aes->EndEncrypt();	});
+			
+			conn->Post(aes->Encrypt(buffer));
+		
+		}
+		
+		
+		bool SimulatedClient::is_parsed (UInt32 id) const noexcept {
+		
+			switch (state) {
+			
+				case ProtocolState::Login:
+					return true;
+				case ProtocolState::Play:
+					return (
+						(id==keep_alive_in::PacketID) ||
+						(id==chat_in::PacketID) ||
+						(id==position_in::PacketID)
+					);
+				default:
+					return false;
+			
+			}
+		
+		}
+		
+		
+		void SimulatedClient::process (Vector<Byte> & buffer) {
+		
+			//	Frame packets ourselves, so that packets
+			//	the packet layer doesn't understand, or
+			//	which we don't care about, can be skipped
+			//	without being parsed
+			Word offset=0;
+			for (;;) {
+			
+				const Byte * begin=buffer.begin()+offset;
+				const Byte * end=buffer.end();
+				
+				UInt32 len;
+				try {
+				
+					len=PacketImpl::Deserialize<PacketImpl::VarInt<UInt32>>(begin,end);
+				
+				} catch (const InsufficientBytes &) {
+				
+					break;
+				
+				}
+				
+				if (Word(end-begin)<len) break;
+				
+				const Byte * packet_end=begin+len;
+				UInt32 id=PacketImpl::Deserialize<PacketImpl::VarInt<UInt32>>(begin,packet_end);
+				
+				const Byte * frame_begin=buffer.begin()+offset;
+				Word frame_len=Word(packet_end-frame_begin);
+				offset+=frame_len;
+				
+				if (is_parsed(id)) {
+				
+					frame.SetCount(0);
+					frame.SetCapacity(frame_len);
+					std::memcpy(frame.begin(),frame_begin,frame_len);
+					frame.SetCount(frame_len);
+					
+					if (!parser.FromBytes(frame,state,ProtocolDirection::Clientbound)) BadFormat::Raise();
+					
+					handle(parser.Get());
+					
+					if (done) return;
+				
+				} else if (
+					(state==ProtocolState::Play) &&
+					((id==chunk_data::PacketID) || (id==chunk_bulk::PacketID))
+				) {
+				
+					++results.Chunks;
+					results.ChunkBytes+=frame_len;
+					
+					if (!first_chunk) {
+					
+						first_chunk=true;
+						
+						results.FirstChunk.Add(timer.ElapsedNanoseconds());
+					
+					}
+				
+				}
+			
+			}
+			
+			buffer.Delete(0,offset);
+		
+		}
+		
+		
+		void SimulatedClient::handle (Packet & packet) {
+		
+			switch (state) {
+			
+				case ProtocolState::Login:
+					switch (packet.ID) {
+					
+						case key_request::PacketID:{
+						
+							auto & request=packet.Get<key_request>();
+							
+							Vector<Byte> secret(secret_length);
+							RandomDevice<Byte> device;
+							for (Word i=0;i<secret_length;++i) secret.Add(device());
+							
+							RSAKey key(request.PublicKey);
+							
+							key_response response;
+							response.Secret=key.PublicEncrypt(secret);
+							response.VerifyToken=key.PublicEncrypt(request.VerifyToken);
+							
+							send(response);
+							
+							//	The server encrypts everything it
+							//	sends from here on
+							aes.Construct(secret,secret);
+						
+						}break;
+						
+						case login_success::PacketID:
+							state=ProtocolState::Play;
+							++results.LoggedIn;
+							results.Login.Add(timer.ElapsedNanoseconds());
+							timer=Timer::CreateAndStart();
+							break;
+						
+						//	Disconnect
+						default:
+							++results.Failed;
+							done=true;
+							conn->Disconnect();
+							break;
+					
+					}
+					break;
+				
+				case ProtocolState::Play:
+				default:
+					switch (packet.ID) {
+					
+						case keep_alive_in::PacketID:{
+						
+							auto id=packet.Get<keep_alive_in>().KeepAliveID;
+							
+							//	Reply to our own keep alive
+							if (id==0) {
+							
+								if (ka_waiting) {
+								
+									ka_waiting=false;
+									
+									results.KeepAlive.Add(ka_timer.ElapsedNanoseconds());
+								
+								}
+								
+								break;
+							
+							}
+							
+							keep_alive_out reply;
+							reply.KeepAliveID=id;
+							
+							send(reply);
+						
+						}break;
+						
+						case chat_in::PacketID:{
+						
+							if (chat_token.Count()==0) break;
+							
+							Vector<Byte> json;
+							JSON::Serialize(json,packet.Get<chat_in>().Value);
+							
+							if (std::search(
+								json.begin(),
+								json.end(),
+								chat_token.begin(),
+								chat_token.end()
+							)!=json.end()) {
+							
+								chat_token.SetCount(0);
+								
+								results.Chat.Add(chat_timer.ElapsedNanoseconds());
+							
+							}
+						
+						}break;
+						
+						case position_in::PacketID:{
+						
+							auto & position=packet.Get<position_in>();
+							
+							x=position.X;
+							y=position.Y;
+							z=position.Z;
+							
+							//	The first position the server
+							//	sends is the spawn point, paths
+							//	are relative to it
+							if (!spawned) {
+							
+								spawned=true;
+								
+								origin_x=x;
+								origin_y=y;
+								origin_z=z;
+							
+							}
+							
+							//	Confirm
+							position_out reply;
+							reply.X=x;
+							reply.Y=y;
+							reply.Stance=y+stance_offset;
+							reply.Z=z;
+							reply.Yaw=position.Yaw;
+							reply.Pitch=position.Pitch;
+							reply.OnGround=position.OnGround;
+							
+							send(reply);
+						
+						}break;
+						
+						default:break;
+					
+					}
+					break;
+			
+			}
+		
+		}
+		
+		
+		void SimulatedClient::move () {
+		
+			distance+=(Double(options.Speed)*Generator::TickLength)/1000;
+			
+			switch (options.Path) {
+			
+				case PathType::Circle:{
+				
+					Double radius=(options.Radius==0) ? 1 : Double(options.Radius);
+					Double angle=heading+(distance/radius);
+					
+					x=origin_x+(radius*std::cos(angle));
+					z=origin_z+(radius*std::sin(angle));
+				
+				}break;
+				
+				case PathType::Fly:
+					y=origin_y+fly_height;
+					//	Fall through
+				case PathType::Line:
+				default:
+					x=origin_x+(distance*std::cos(heading));
+					z=origin_z+(distance*std::sin(heading));
+					break;
+			
+			}
+			
+			position_out packet;
+			packet.X=x;
+			packet.Y=y;
+			packet.Stance=y+stance_offset;
+			packet.Z=z;
+			packet.Yaw=Single((heading*180)/pi);
+			packet.Pitch=0;
+			packet.OnGround=options.Path!=PathType::Fly;
+			
+			send(packet);
+		
+		}
+		
+		
+		void SimulatedClient::chat () {
+		
+			auto message=String::Format(chat_template,index,chat_seq++);
+			
+			chat_token=UTF8().Encode(message);
+			chat_timer=Timer::CreateAndStart();
+			
+			chat_out packet;
+			packet.Value=std::move(message);
+			
+			send(packet);
+		
+		}
+		
+		
+		void SimulatedClient::keep_alive () {
+		
+			//	Wait for the last one to come
+			//	back
+			if (ka_waiting) return;
+			
+			ka_waiting=true;
+			ka_timer=Timer::CreateAndStart();
+			
+			//	The server echoes keep alives
+			//	with an ID of zero straight back
+			keep_alive_out packet;
+			packet.KeepAliveID=0;
+			
+			send(packet);
+		
+		}
+		
+		
+		RemoteEndpoint SimulatedClient::GetEndpoint () {
+		
+			RemoteEndpoint ep;
+			ep.IP=options.IP;
+			ep.Port=options.Port;
+			
+			timer=Timer::CreateAndStart();
+			
+			ep.Connect=[this] (ConnectEvent event) mutable {
+			
+				lock.Execute([&] () mutable {
+				
+					if (event.Conn.IsNull()) {
+					
+						++results.Failed;
+						done=true;
+						
+						return;
+					
+					}
+					
+					//	The test ended while we were
+					//	connecting
+					if (done) {
+					
+						event.Conn->Disconnect();
+						
+						return;
+					
+					}
+					
+					conn=std::move(event.Conn);
+					
+					++results.Connected;
+					results.Connect.Add(timer.ElapsedNanoseconds());
+					timer=Timer::CreateAndStart();
+					
+					handshake hs;
+					hs.ProtocolVersion=UInt32(ProtocolVersion);
+					hs.ServerAddress=options.Host;
+					hs.ServerPort=options.Port;
+					hs.CurrentState=ProtocolState::Login;
+					
+					send(hs);
+					
+					state=ProtocolState::Login;
+					
+					login_start start;
+					start.Name=name;
+					
+					send(start);
+				
+				});
+			
+			};
+			
+			ep.Receive=[this] (ReceiveEvent event) mutable {
+			
+				lock.Execute([&] () mutable {
+				
+					//	The network layer appends to the
+					//	buffer, so only what's beyond the
+					//	bytes we left last time is new
+					results.Received+=event.Buffer.Count()-leftover;
+					
+					if (done) {
+					
+						event.Buffer.SetCount(0);
+						leftover=0;
+						
+						return;
+					
+					}
+					
+					//	Before encryption is enabled
+					//	packets are parsed in place
+					if (aes.IsNull()) {
+					
+						process(event.Buffer);
+						leftover=event.Buffer.Count();
+						
+						return;
+					
+					}
+					
+					aes->Decrypt(&event.Buffer,&buffer);
+					leftover=0;
+					
+					process(buffer);
+				
+				});
+			
+			};
+			
+			ep.Disconnect=[this] (DisconnectEvent) mutable {
+			
+				lock.Execute([&] () mutable {
+				
+					if (!done) ++results.Disconnected;
+					
+					done=true;
+				
+				});
+			
+			};
+			
+			return ep;
+		
+		}
+		
+		
+		void SimulatedClient::Tick (Word tick) {
+		
+			lock.Execute([&] () mutable {
+			
+				if (done || !spawned) return;
+				
+				move();
+				
+				//	Offset each client's schedule by its
+				//	index so they don't all act during
+				//	the same tick
+				auto due=[&] (Word interval) {
+				
+					if (interval==0) return false;
+					
+					Word ticks=interval/Generator::TickLength;
+					if (ticks==0) ticks=1;
+					
+					return ((tick+index)%ticks)==0;
+				
+				};
+				
+				if (due(options.KeepAliveInterval)) keep_alive();
+				if (due(options.ChatInterval)) chat();
+			
+			});
+		
+		}
+		
+		
+		void SimulatedClient::Disconnect () {
+		
+			lock.Execute([&] () mutable {
+			
+				done=true;
+				
+				if (!conn.IsNull()) conn->Disconnect();
+			
+			});
+		
+		}
+	
+	
+	}
+
+
+}
@@ -0,0 +1,255 @@
+#include <load_test/load_test.hpp>
+#include <utility>
+#ifndef ENVIRONMENT_WINDOWS
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+#endif
+
+
+namespace MCPP {
+
+
+	namespace LoadTest {
+	
+	
+		static const String default_ip("127.0.0.1");
+		static const UInt16 default_port=25565;
+		static const Word default_clients=100;
+		static const Word default_connect_rate=50;
+		static const Word default_duration=60;
+		static const Word default_threads=4;
+		static const Word default_speed=4;
+		static const Word default_radius=16;
+		static const Word default_chat_interval=10000;
+		static const Word default_keep_alive_interval=1000;
+		//	How often progress is reported,
+		//	in milliseconds
+		static const UInt64 progress_interval=5000;
+		
+		
+		static const String progress_template("{0}s: {1} connected, {2} logged in, {3} failed, {4} disconnected, {5} chunks received");
+		static const String results_banner("RESULTS:");
+		static const String clients_template("Clients: {0} connected, {1} logged in, {2} failed, {3} disconnected by the server");
+		static const String chunks_template("Chunks: {0} ({1}/s, {2} bytes/s)");
+		static const String traffic_template("Traffic: {0} bytes sent, {1} bytes received");
+		static const String cpu_template("Server CPU: {0}% of one core");
+		static const String cpu_unknown("Server CPU: not measured");
+		static const String connect_name("Connect");
+		static const String login_name("Login");
+		static const String first_chunk_name("First Chunk");
+		static const String keep_alive_name("Keep Alive RTT");
+		static const String chat_name("Chat RTT");
+		
+		
+		const Word Generator::TickLength;
+		
+		
+		Options::Options ()
+			:	Host(default_ip),
+				IP(default_ip),
+				Port(default_port),
+				Clients(default_clients),
+				ConnectRate(default_connect_rate),
+				Duration(default_duration),
+				Threads(default_threads),
+				Path(PathType::Circle),
+				Speed(default_speed),
+				Radius(default_radius),
+				ChatInterval(default_chat_interval),
+				KeepAliveInterval(default_keep_alive_interval)
+		{	}
+		
+		
+		Results::Results () noexcept {
+		
+			Connected=0;
+			LoggedIn=0;
+			Failed=0;
+			Disconnected=0;
+			Chunks=0;
+			ChunkBytes=0;
+			Sent=0;
+			Received=0;
+		
+		}
+		
+		
+		//	Retrieves the number of seconds of CPU time
+		//	a process has consumed, if possible
+		static Nullable<Double> get_cpu_time (const Nullable<UInt64> & pid) {
+		
+			Nullable<Double> retr;
+			
+			#ifndef ENVIRONMENT_WINDOWS
+			if (pid.IsNull()) return retr;
+			
+			std::ifstream stream("/proc/"+std::to_string(*pid)+"/stat");
+			if (!stream) return retr;
+			
+			std::string stat(
+				(std::istreambuf_iterator<char>(stream)),
+				std::istreambuf_iterator<char>()
+			);
+			
+			//	The process' name is parenthesized and
+			//	may contain spaces, fields are counted
+			//	from the closing parenthesis
+			auto pos=stat.rfind(')');
+			if (pos==std::string::npos) return retr;
+			
+			//	utime and stime are the 12th and 13th
+			//	fields after the name
+			std::string::size_type begin=pos+1;
+			unsigned long long utime=0;
+			unsigned long long stime=0;
+			for (Word field=0;field<13;++field) {
+			
+				begin=stat.find_first_not_of(' ',begin);
+				if (begin==std::string::npos) return retr;
+				
+				auto end=stat.find(' ',begin);
+				if (end==std::string::npos) end=stat.size();
+				
+				if (field==11) utime=std::stoull(stat.substr(begin,end-begin));
+				else if (field==12) stime=std::stoull(stat.substr(begin,end-begin));
+				
+				begin=end;
+			
+			}
+			
+			retr.Construct(Double(utime+stime)/Double(sysconf(_SC_CLK_TCK)));
+			#else
+			(void)pid;
+			#endif
+			
+			return retr;
+		
+		}
+		
+		
+		Generator::Generator (Options options)
+			:	options(std::move(options)),
+				pool(this->options.Threads),
+				handler(pool,this->options.Threads)
+		{	}
+		
+		
+		void Generator::report (UInt64 elapsed, Nullable<UInt64> cpu) {
+		
+			UInt64 seconds=elapsed/1000;
+			if (seconds==0) seconds=1;
+			
+			StdOut	<< results_banner << Newline
+					<< String::Format(
+						clients_template,
+						UInt64(results.Connected),
+						UInt64(results.LoggedIn),
+						UInt64(results.Failed),
+						UInt64(results.Disconnected)
+					) << Newline
+					<< results.Connect.ToString(connect_name) << Newline
+					<< results.Login.ToString(login_name) << Newline
+					<< results.FirstChunk.ToString(first_chunk_name) << Newline
+					<< results.KeepAlive.ToString(keep_alive_name) << Newline
+					<< results.Chat.ToString(chat_name) << Newline
+					<< String::Format(
+						chunks_template,
+						UInt64(results.Chunks),
+						results.Chunks/seconds,
+						results.ChunkBytes/seconds
+					) << Newline
+					<< String::Format(
+						traffic_template,
+						UInt64(results.Sent),
+						UInt64(results.Received)
+					) << Newline
+					<< (cpu.IsNull() ? cpu_unknown : String::Format(cpu_template,*cpu)) << Newline;
+		
+		}
+		
+		
+		void Generator::Run () {
+		
+			auto cpu_begin=get_cpu_time(options.PID);
+			Timer timer(Timer::CreateAndStart());
+			
+			UInt64 duration=UInt64(options.Duration)*1000;
+			UInt64 last_progress=0;
+			Word started=0;
+			Word tick=0;
+			
+			for (;;) {
+			
+				auto elapsed=timer.ElapsedMilliseconds();
+				if (elapsed>=duration) break;
+				
+				//	Bring new clients online at the
+				//	requested rate
+				Word target=(options.ConnectRate==0)
+					?	options.Clients
+					:	Word(((elapsed*options.ConnectRate)/1000)+1);
+				if (target>options.Clients) target=options.Clients;
+				
+				for (;started<target;++started) {
+				
+					clients.Add(
+						std::unique_ptr<SimulatedClient>(
+							new SimulatedClient(started,options,results)
+						)
+					);
+					
+					handler.Connect(clients[started]->GetEndpoint());
+				
+				}
+				
+				for (auto & client : clients) client->Tick(tick);
+				++tick;
+				
+				if ((elapsed-last_progress)>=progress_interval) {
+				
+					last_progress=elapsed;
+					
+					StdOut << String::Format(
+						progress_template,
+						elapsed/1000,
+						UInt64(results.Connected),
+						UInt64(results.LoggedIn),
+						UInt64(results.Failed),
+						UInt64(results.Disconnected),
+						UInt64(results.Chunks)
+					) << Newline;
+				
+				}
+				
+				//	Sleep until the next tick is due
+				UInt64 next=UInt64(tick)*TickLength;
+				lock.Execute([&] () mutable {
+				
+					UInt64 now;
+					while ((now=timer.ElapsedMilliseconds())<next) wait.Sleep(lock,Word(next-now));
+				
+				});
+			
+			}
+			
+			auto elapsed=timer.ElapsedMilliseconds();
+			auto cpu_end=get_cpu_time(options.PID);
+			
+			for (auto & client : clients) client->Disconnect();
+			
+			Nullable<UInt64> cpu;
+			if (!(cpu_begin.IsNull() || cpu_end.IsNull() || (elapsed==0))) cpu.Construct(
+				UInt64(((*cpu_end-*cpu_begin)*100*1000)/Double(elapsed))
+			);
+			
+			report(elapsed,std::move(cpu));
+		
+		}
+	
+	
+	}
+
+
+}
@@ -0,0 +1,158 @@
+#include <load_test/load_test.hpp>
+#include <limits>
+
+
+namespace MCPP {
+
+
+	namespace LoadTest {
+	
+	
+		static const String summary("{0}: {1} samples, min {2}us, mean {3}us, p50 {4}us, p90 {5}us, p99 {6}us, max {7}us");
+		static const String no_samples("{0}: no samples");
+		
+		
+		const Word Histogram::sub_buckets;
+		const Word Histogram::num_buckets;
+		
+		
+		Word Histogram::get_bucket (UInt64 ns) noexcept {
+		
+			//	Small values are recorded exactly
+			if (ns<sub_buckets) return Word(ns);
+			
+			//	Find the most significant bit
+			Word e=0;
+			for (auto v=ns;v>1;v>>=1) ++e;
+			
+			//	The three bits below the most significant
+			//	bit select the sub-bucket
+			Word sub=Word((ns>>(e-3))&(sub_buckets-1));
+			
+			return sub_buckets+((e-3)*sub_buckets)+sub;
+		
+		}
+		
+		
+		UInt64 Histogram::get_upper (Word bucket) noexcept {
+		
+			if (bucket<sub_buckets) return bucket;
+			
+			Word e=((bucket-sub_buckets)/sub_buckets)+3;
+			UInt64 sub=(bucket-sub_buckets)%sub_buckets;
+			
+			UInt64 lower=(sub_buckets+sub)<<(e-3);
+			
+			return lower+((UInt64(1)<<(e-3))-1);
+		
+		}
+		
+		
+		Histogram::Histogram () noexcept
+			:	count(0),
+				total(0),
+				min(std::numeric_limits<UInt64>::max()),
+				max(0)
+		{
+		
+			for (auto & b : buckets) b=0;
+		
+		}
+		
+		
+		void Histogram::Add (UInt64 ns) noexcept {
+		
+			auto bucket=get_bucket(ns);
+			
+			lock.Execute([&] () mutable {
+			
+				++buckets[bucket];
+				++count;
+				total+=ns;
+				if (ns<min) min=ns;
+				if (ns>max) max=ns;
+			
+			});
+		
+		}
+		
+		
+		UInt64 Histogram::Count () const noexcept {
+		
+			return lock.Execute([&] () {	return count;	});
+		
+		}
+		
+		
+		UInt64 Histogram::Percentile (Double p) const noexcept {
+		
+			return lock.Execute([&] () {
+			
+				if (count==0) return UInt64(0);
+				
+				//	The rank of the sample we're looking
+				//	for
+				UInt64 rank=UInt64((p/100)*count);
+				if (rank==0) rank=1;
+				if (rank>count) rank=count;
+				
+				UInt64 seen=0;
+				for (Word i=0;i<num_buckets;++i) {
+				
+					seen+=buckets[i];
+					
+					if (seen>=rank) {
+					
+						//	Never report a value which
+						//	wasn't observed
+						auto upper=get_upper(i);
+						
+						return (upper>max) ? max : ((upper<min) ? min : upper);
+					
+					}
+				
+				}
+				
+				return max;
+			
+			});
+		
+		}
+		
+		
+		String Histogram::ToString (const String & name) const {
+		
+			UInt64 count;
+			UInt64 total;
+			UInt64 min;
+			UInt64 max;
+			lock.Execute([&] () mutable {
+			
+				count=this->count;
+				total=this->total;
+				min=this->min;
+				max=this->max;
+			
+			});
+			
+			if (count==0) return String::Format(no_samples,name);
+			
+			return String::Format(
+				summary,
+				name,
+				count,
+				min/1000,
+				(total/count)/1000,
+				Percentile(50)/1000,
+				Percentile(90)/1000,
+				Percentile(99)/1000,
+				max/1000
+			);
+		
+		}
+	
+	
+	}
+
+
+}
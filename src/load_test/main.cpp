@@ -0,0 +1,256 @@
+#include <rleahylib/rleahylib.hpp>
+#include <rleahylib/main.hpp>
+#include <load_test/load_test.hpp>
+#include <cstdlib>
+#include <exception>
+#include <utility>
+
+
+using namespace MCPP;
+using namespace MCPP::LoadTest;
+
+
+//	Help message
+static const String help_string(
+	"MCPP Load Generator\n"
+	"\n"
+	"Connects simulated offline-mode clients to a server and reports\n"
+	"latency and throughput.  The server's \"online_mode\" setting must\n"
+	"be false.\n"
+	"\n"
+	"Help:\n"
+	"\n"
+	"/?, -?\n"
+	"\tDisplays this help\n"
+	"-server <IP> [port]\n"
+	"\tThe server to connect to (default 127.0.0.1 25565)\n"
+	"-host <name>\n"
+	"\tThe host name sent in the handshake (default the IP)\n"
+	"-clients <count>\n"
+	"\tThe number of simulated clients (default 100)\n"
+	"-rate <count>\n"
+	"\tThe number of clients connected per second, 0 for all at once (default 50)\n"
+	"-duration <seconds>\n"
+	"\tHow long to run for (default 60)\n"
+	"-threads <count>\n"
+	"\tThe number of network threads (default 4)\n"
+	"-path <circle|line|fly>\n"
+	"\tThe path clients follow once spawned (default circle)\n"
+	"-speed <blocks per second>\n"
+	"\tHow fast clients move (default 4)\n"
+	"-radius <blocks>\n"
+	"\tThe radius of circular paths (default 16)\n"
+	"-chat <milliseconds>\n"
+	"\tHow often each client chats, 0 to never chat (default 10000)\n"
+	"-keepalive <milliseconds>\n"
+	"\tHow often each client measures round trip time, 0 to never (default 1000)\n"
+	"-pid <process ID>\n"
+	"\tThe server's process ID, to report its CPU use"
+);
+//	Arguments which will cause help to be
+//	displayed
+static const String help_args []={
+	"help",
+	"?"
+};
+//	Message displayed when there's a problem
+//	parsing command line arguments
+static const String error_parsing(
+	"Error parsing command line arguments\n"
+	"Try /?"
+);
+
+
+static const Regex flag_regex("^\\s*(?:\\-|\\/)(.*)$");
+
+
+static const Tuple<String,PathType> paths []={
+	{"circle",PathType::Circle},
+	{"line",PathType::Line},
+	{"fly",PathType::Fly}
+};
+
+
+template <typename T>
+static bool get_integer (const Vector<String> & args, T & value) {
+
+	return (args.Count()==1) && args[0].ToInteger(&value);
+
+}
+
+
+static bool set_option (Options & options, String flag, const Vector<String> & args) {
+
+	flag.ToLower();
+	
+	if (flag=="server") {
+	
+		if ((args.Count()==0) || (args.Count()>2)) return false;
+		
+		try {
+		
+			options.IP=IPAddress(args[0]);
+		
+		} catch (...) {
+		
+			return false;
+		
+		}
+		
+		options.Host=args[0];
+		
+		return (args.Count()==1) || args[1].ToInteger(&options.Port);
+	
+	}
+	
+	if (flag=="host") {
+	
+		if (args.Count()!=1) return false;
+		
+		options.Host=args[0];
+		
+		return true;
+	
+	}
+	
+	if (flag=="path") {
+	
+		if (args.Count()!=1) return false;
+		
+		String path(args[0]);
+		path.ToLower();
+		
+		for (auto & t : paths) if (t.Item<0>()==path) {
+		
+			options.Path=t.Item<1>();
+			
+			return true;
+		
+		}
+		
+		return false;
+	
+	}
+	
+	if (flag=="pid") {
+	
+		UInt64 pid;
+		if (!get_integer(args,pid)) return false;
+		
+		options.PID.Construct(pid);
+		
+		return true;
+	
+	}
+	
+	if (flag=="clients") return get_integer(args,options.Clients);
+	if (flag=="rate") return get_integer(args,options.ConnectRate);
+	if (flag=="duration") return get_integer(args,options.Duration);
+	if (flag=="threads") return get_integer(args,options.Threads) && (options.Threads!=0);
+	if (flag=="speed") return get_integer(args,options.Speed);
+	if (flag=="radius") return get_integer(args,options.Radius);
+	if (flag=="chat") return get_integer(args,options.ChatInterval);
+	if (flag=="keepalive") return get_integer(args,options.KeepAliveInterval);
+	
+	return false;
+
+}
+
+
+//	Bootstraps the application
+int Main (const Vector<const String> & args) {
+
+	try {
+	
+		Options options;
+		
+		//	Group each flag with the arguments
+		//	which follow it
+		Nullable<String> flag;
+		Vector<String> flag_args;
+		bool help=false;
+		auto apply=[&] () {
+		
+			if (flag.IsNull()) return flag_args.Count()==0;
+			
+			auto & f=*flag;
+			for (auto & s : help_args) if (f==s) help=true;
+			
+			bool retr=help || set_option(options,std::move(f),flag_args);
+			
+			flag.Destroy();
+			flag_args=Vector<String>();
+			
+			return retr;
+		
+		};
+		
+		for (auto & arg : args) {
+		
+			auto match=flag_regex.Match(arg);
+			
+			if (!match.Success()) {
+			
+				flag_args.Add(arg);
+				
+				continue;
+			
+			}
+			
+			if (!apply()) {
+			
+				StdOut << error_parsing << Newline;
+				
+				return EXIT_FAILURE;
+			
+			}
+			
+			flag.Construct(match[1].Value());
+		
+		}
+		
+		if (!apply()) {
+		
+			StdOut << error_parsing << Newline;
+			
+			return EXIT_FAILURE;
+		
+		}
+		
+		if (help) {
+		
+			StdOut << help_string << Newline;
+			
+			return EXIT_SUCCESS;
+		
+		}
+		
+		Generator generator(std::move(options));
+		
+		generator.Run();
+	
+	} catch (const std::exception & e) {
+	
+		try {
+		
+			StdOut << "ERROR: " << e.what() << Newline;
+		
+		} catch (...) {	}
+		
+		return EXIT_FAILURE;
+	
+	} catch (...) {
+	
+		try {
+		
+			StdOut << "ERROR" << Newline;
+		
+		} catch (...) {	}
+		
+		return EXIT_FAILURE;
+	
+	}
+	
+	return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,399 @@
+#include <log_queue.hpp>
+#include <cstdlib>
+
+
+namespace MCPP {
+
+
+	constexpr Word LogRecord::MaxArguments;
+	constexpr Word LogRecord::MaxRetained;
+	
+	
+	void LogRecord::SetText (Word i, const String & str) {
+	
+		Types[i]=ArgumentType::Text;
+		
+		auto & range=Arguments[i].Text;
+		range.Offset=static_cast<UInt32>(Text.Count());
+		for (auto cp : str.CodePoints()) Text.Add(cp);
+		range.Length=static_cast<UInt32>(Text.Count()-range.Offset);
+	
+	}
+	
+	
+	String LogRecord::ToString () const {
+	
+		//	Each argument is turned back into a
+		//	string to be formatted
+		String a [MaxArguments];
+		for (Word i=0;i<Count;++i) switch (Types[i]) {
+		
+			case ArgumentType::Signed:
+				a[i]=String(Arguments[i].Signed);
+				break;
+			case ArgumentType::Unsigned:
+				a[i]=String(Arguments[i].Unsigned);
+				break;
+			case ArgumentType::Floating:
+				a[i]=String(Arguments[i].Floating);
+				break;
+			case ArgumentType::Text:
+			default:{
+			
+				auto range=Arguments[i].Text;
+				Vector<CodePoint> cps(range.Length);
+				for (Word n=0;n<range.Length;++n) cps.Add(Text[range.Offset+n]);
+				a[i]=String(std::move(cps));
+			
+			}break;
+		
+		}
+		
+		//	Preformatted
+		if (Template==nullptr) return std::move(a[0]);
+		
+		switch (Count) {
+		
+			case 0:
+				return String::Format(*Template);
+			case 1:
+				return String::Format(*Template,a[0]);
+			case 2:
+				return String::Format(*Template,a[0],a[1]);
+			case 3:
+				return String::Format(*Template,a[0],a[1],a[2]);
+			case 4:
+				return String::Format(*Template,a[0],a[1],a[2],a[3]);
+			case 5:
+				return String::Format(*Template,a[0],a[1],a[2],a[3],a[4]);
+			case 6:
+				return String::Format(*Template,a[0],a[1],a[2],a[3],a[4],a[5]);
+			case 7:
+				return String::Format(*Template,a[0],a[1],a[2],a[3],a[4],a[5],a[6]);
+			case 8:
+			default:
+				return String::Format(*Template,a[0],a[1],a[2],a[3],a[4],a[5],a[6],a[7]);
+		
+		}
+	
+	}
+	
+	
+	void LogRecord::Clear () noexcept {
+	
+		if (Text.Capacity()>MaxRetained) Text=Vector<CodePoint>();
+	
+	}
+	
+	
+	LogRing::LogRing (Word capacity) : Records(new LogRecord [capacity]), Capacity(capacity) {
+	
+		Head=0;
+		Tail=0;
+		Abandoned=false;
+	
+	}
+	
+	
+	//	Each thread's handle on its ring
+	//
+	//	When the thread exits the ring is marked
+	//	abandoned so that the logging thread can
+	//	discard it once it's been drained
+	class LocalRing {
+	
+	
+		public:
+		
+		
+			UInt64 Owner;
+			std::shared_ptr<LogRing> Ring;
+			
+			
+			LocalRing () noexcept : Owner(0) {	}
+			
+			
+			~LocalRing () noexcept {
+			
+				if (Ring) Ring->Abandoned=true;
+			
+			}
+	
+	
+	};
+	
+	
+	static thread_local LocalRing local;
+	static std::atomic<UInt64> next_id(1);
+	
+	
+	LogQueue::LogQueue (CallbackType callback, Word capacity)
+		:	id(next_id++),
+			callback(std::move(callback)),
+			stop(false),
+			requested(0),
+			completed(0)
+	{
+	
+		this->capacity=(capacity==0) ? 1 : capacity;
+		written=0;
+		dropped=0;
+		sleeping=false;
+		
+		thread=Thread([this] () mutable {	worker_func();	});
+	
+	}
+	
+	
+	LogQueue::~LogQueue () noexcept {
+	
+		lock.Execute([&] () mutable {
+		
+			stop=true;
+			
+			wait.WakeAll();
+		
+		});
+		
+		thread.Join();
+	
+	}
+	
+	
+	LogRing * LogQueue::get_ring () {
+	
+		//	Fast path: this thread already has
+		//	a ring in this queue
+		if (local.Owner==id) return local.Ring.get();
+		
+		//	Abandon the ring this thread had in
+		//	a previous queue (if any)
+		if (local.Ring) local.Ring->Abandoned=true;
+		local.Ring=std::shared_ptr<LogRing>();
+		local.Owner=0;
+		
+		auto ring=std::make_shared<LogRing>(capacity.load());
+		
+		lock.Execute([&] () mutable {	rings.Add(ring);	});
+		
+		local.Ring=std::move(ring);
+		local.Owner=id;
+		
+		return local.Ring.get();
+	
+	}
+	
+	
+	void LogQueue::notify () noexcept {
+	
+		//	The head was published with a sequentially
+		//	consistent store, and the logging thread sets
+		//	this flag with a sequentially consistent store
+		//	before checking the rings one last time, so
+		//	either it sees our record or we see the flag
+		if (sleeping) lock.Execute([&] () mutable {	wait.WakeAll();	});
+	
+	}
+	
+	
+	bool LogQueue::drain () {
+	
+		bool retr=false;
+		for (Word i=0;;++i) {
+		
+			//	Only this thread removes rings, so
+			//	the ring stays put once the lock is
+			//	released, and producers registering
+			//	new rings aren't held up while we
+			//	write
+			auto ring=lock.Execute([&] () mutable {
+			
+				//	Discard rings whose threads have
+				//	exited, provided they're empty
+				while (
+					(i<rings.Count()) &&
+					rings[i]->Abandoned &&
+					(rings[i]->Head==rings[i]->Tail)
+				) rings.Delete(i);
+				
+				return (i<rings.Count()) ? rings[i].get() : nullptr;
+			
+			});
+			if (ring==nullptr) break;
+		
+			Word tail=ring->Tail.load(std::memory_order_relaxed);
+			
+			for (;tail!=ring->Head;++tail) {
+			
+				auto & record=ring->Records[tail%ring->Capacity];
+				
+				try {
+				
+					callback(record.ToString(),record.Type);
+				
+				} catch (...) {	}
+				
+				record.Clear();
+				
+				//	Hand the slot back to the
+				//	producer
+				ring->Tail.store(tail+1,std::memory_order_release);
+				
+				++written;
+				retr=true;
+			
+			}
+		
+		}
+		
+		return retr;
+	
+	}
+	
+	
+	void LogQueue::worker_func () noexcept {
+	
+		try {
+		
+			for (;;) {
+			
+				UInt64 request=lock.Execute([&] () mutable {	return requested;	});
+				
+				//	Keep going so long as there's
+				//	work to do
+				if (drain()) continue;
+				
+				bool done=lock.Execute([&] () mutable {
+				
+					//	Every record enqueued before the
+					//	flush request we saw has been
+					//	written
+					if (request>completed) {
+					
+						completed=request;
+						
+						wait.WakeAll();
+					
+					}
+					
+					if (stop) return true;
+					
+					//	Announce our intention to sleep,
+					//	then check one last time to make
+					//	sure no records were published
+					//	before producers could see it
+					sleeping=true;
+					
+					bool pending=false;
+					for (auto & ring : rings) if (ring->Head!=ring->Tail) {
+					
+						pending=true;
+						
+						break;
+					
+					}
+					
+					if (!(pending || (requested!=completed))) wait.Sleep(lock);
+					
+					sleeping=false;
+					
+					return false;
+				
+				});
+				
+				if (done) break;
+			
+			}
+			
+			//	Write anything that was enqueued
+			//	while we were shutting down
+			while (drain());
+		
+		} catch (...) {
+		
+			//	Logging is the mechanism through
+			//	which errors are reported, there's
+			//	nothing sane we can do
+			std::abort();
+		
+		}
+	
+	}
+	
+	
+	void LogQueue::Enqueue (const String & message, Service::LogType type) noexcept {
+	
+		try {
+		
+			auto ring=get_ring();
+			
+			Word head=ring->Head.load(std::memory_order_relaxed);
+			
+			if ((head-ring->Tail.load(std::memory_order_acquire))==ring->Capacity) {
+			
+				++dropped;
+				
+				return;
+			
+			}
+			
+			auto & record=ring->Records[head%ring->Capacity];
+			record.Template=nullptr;
+			record.Type=type;
+			record.Count=1;
+			record.Text.SetCount(0);
+			record.SetText(0,message);
+			
+			ring->Head.store(head+1);
+		
+		} catch (...) {
+		
+			++dropped;
+			
+			return;
+		
+		}
+		
+		notify();
+	
+	}
+	
+	
+	void LogQueue::Flush () noexcept {
+	
+		lock.Execute([&] () mutable {
+		
+			UInt64 target=++requested;
+			
+			wait.WakeAll();
+			
+			//	If the logging thread has stopped
+			//	there's nothing to wait for
+			while (!stop && (completed<target)) wait.Sleep(lock);
+		
+		});
+	
+	}
+	
+	
+	void LogQueue::SetCapacity (Word capacity) noexcept {
+	
+		this->capacity=(capacity==0) ? 1 : capacity;
+	
+	}
+	
+	
+	LogQueueInfo LogQueue::GetInfo () const noexcept {
+	
+		LogQueueInfo retr;
+		retr.Written=written;
+		retr.Dropped=dropped;
+		retr.Capacity=capacity;
+		retr.Rings=lock.Execute([&] () {	return rings.Count();	});
+		
+		return retr;
+	
+	}
+
+
+}
@@ -1,4 +1,5 @@
 #include <mod_loader.hpp>
+#include <profiler.hpp>
 #include <system_error>
 #include <type_traits>
 #include <utility>
@@ -622,7 +623,16 @@ namespace MCPP {
 		//	Loop for each loaded module
 		//	as they're already in the
 		//	correct order
-		for (auto & mod : mods) mod.Item<1>()->Install();
+		for (auto & mod : mods) {
+		
+			//	Anything the module registers while
+			//	installing is attributed to it by the
+			//	profiler
+			ProfileOwner owner(Profiler::GetLabel(mod.Item<1>()->Name()));
+			
+			mod.Item<1>()->Install();
+		
+		}
 	
 	}
 	
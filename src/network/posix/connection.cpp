@@ -228,17 +228,11 @@ namespace MCPP {
 				//	Did we send it all?
 				if (s.Sent==s.Buffer.Count()) {
 					
-					//	Complete
-					#pragma GCC diagnostic push
-					#pragma GCC diagnostic ignored "-Wpedantic"
-					f.Action.Add([completion=std::move(s.Completion)] (SmartPointer<ChannelBase>) mutable noexcept {
-						
-						completion.Complete(true);
-						
-						return FollowUp{};
-						
-					});
-					#pragma GCC diagnostic pop
+					//	Completing a handle only wakes
+					//	its waiters, so it's done here
+					//	rather than by dispatching a
+					//	callback
+					s.Completion.Complete(true);
 					
 					sends.Delete(0);
 				
@@ -535,12 +529,12 @@ namespace MCPP {
 	}
 	
 	
-	Promise<bool> Connection::Send (Vector<Byte> buffer) {
+	void Connection::enqueue (Vector<Byte> buffer, SendHandle completion) {
 	
 		//	Create a send buffer
-		SendBuffer send(std::move(buffer));
+		SendBuffer send(std::move(buffer),std::move(completion));
 		
-		return lock.Execute([&] () {
+		lock.Execute([&] () {
 		
 			//	Check to make sure we can send
 			if (is_shutdown) {
@@ -548,10 +542,10 @@ namespace MCPP {
 				//	Socket is shutdown, no more
 				//	sends
 				
-				//	Fail the promise at once
+				//	Fail the send at once
 				send.Completion.Complete(false);
 				
-				return std::move(send.Completion);
+				return;
 			
 			}
 			
@@ -566,14 +560,52 @@ namespace MCPP {
 			) updater->Update(socket);
 			
 			//	Add to send queue
-			auto promise=send.Completion;
 			sends.Add(std::move(send));
-			
-			return promise;
 		
 		});
 	
 	}
+	
+	
+	SendHandle Connection::Send (Vector<Byte> buffer) {
+	
+		auto retr=SendHandle::Make();
+		
+		enqueue(std::move(buffer),retr);
+		
+		return retr;
+	
+	}
+	
+	
+	void Connection::Post (Vector<Byte> buffer) {
+	
+		enqueue(std::move(buffer),SendHandle{});
+	
+	}
+	
+	
+	void Connection::SetData (std::shared_ptr<void> data) {
+	
+		//	The old data is released outside
+		//	the lock
+		data_lock.Execute([&] () mutable {	std::swap(this->data,data);	});
+	
+	}
+	
+	
+	std::shared_ptr<void> Connection::GetData () const {
+	
+		return data_lock.Execute([&] () {	return data;	});
+	
+	}
+	
+	
+	std::shared_ptr<void> Connection::TakeData () {
+	
+		return data_lock.Execute([&] () mutable {	return std::move(data);	});
+	
+	}
 
 
 }
@@ -7,7 +7,11 @@ using namespace MCPP::NetworkImpl;
 namespace MCPP {
 
 
-	Connection::SendBuffer::SendBuffer (Vector<Byte> buffer) noexcept : Buffer(std::move(buffer)), Sent(0) {	}
+	Connection::SendBuffer::SendBuffer (Vector<Byte> buffer, SendHandle completion) noexcept
+		:	Buffer(std::move(buffer)),
+			Sent(0),
+			Completion(std::move(completion))
+	{	}
 
 
 }
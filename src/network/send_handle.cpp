@@ -0,0 +1,198 @@
+#include <network.hpp>
+#include <stdexcept>
+#include <utility>
+
+
+using namespace MCPP::NetworkImpl;
+
+
+namespace MCPP {
+
+
+	//	The most states the pool will hold on
+	//	to, states released beyond this are
+	//	freed
+	static const Word pool_max=4096;
+	
+	
+	//	States which are not in use
+	static Mutex pool_lock;
+	static SendHandleState * pool=nullptr;
+	static Word pool_count=0;
+	
+	
+	static SendHandleState * acquire () {
+	
+		auto retr=pool_lock.Execute([] () {
+		
+			auto retr=pool;
+			if (retr!=nullptr) {
+			
+				pool=retr->Next;
+				--pool_count;
+			
+			}
+			
+			return retr;
+		
+		});
+		
+		if (retr==nullptr) retr=new SendHandleState();
+		
+		retr->References=1;
+		retr->State=SendState::Sending;
+		
+		return retr;
+	
+	}
+	
+	
+	static void recycle (SendHandleState * state) noexcept {
+	
+		if (pool_lock.Execute([&] () {
+		
+			if (pool_count==pool_max) return false;
+			
+			state->Next=pool;
+			pool=state;
+			++pool_count;
+			
+			return true;
+		
+		})) return;
+		
+		delete state;
+	
+	}
+	
+	
+	void SendHandle::release () noexcept {
+	
+		if (
+			(state!=nullptr) &&
+			((--state->References)==0)
+		) recycle(state);
+		
+		state=nullptr;
+	
+	}
+	
+	
+	SendHandle::SendHandle () noexcept : state(nullptr) {	}
+	
+	
+	SendHandle SendHandle::Make () {
+	
+		SendHandle retr;
+		retr.state=acquire();
+		
+		return retr;
+	
+	}
+	
+	
+	SendHandle::SendHandle (const SendHandle & other) noexcept : state(other.state) {
+	
+		if (state!=nullptr) ++state->References;
+	
+	}
+	
+	
+	SendHandle::SendHandle (SendHandle && other) noexcept : state(other.state) {
+	
+		other.state=nullptr;
+	
+	}
+	
+	
+	SendHandle & SendHandle::operator = (const SendHandle & other) noexcept {
+	
+		if (&other!=this) {
+		
+			release();
+			
+			state=other.state;
+			if (state!=nullptr) ++state->References;
+		
+		}
+		
+		return *this;
+	
+	}
+	
+	
+	SendHandle & SendHandle::operator = (SendHandle && other) noexcept {
+	
+		if (&other!=this) {
+		
+			release();
+			
+			std::swap(state,other.state);
+		
+		}
+		
+		return *this;
+	
+	}
+	
+	
+	SendHandle::~SendHandle () noexcept {
+	
+		release();
+	
+	}
+	
+	
+	SendHandle::operator bool () const noexcept {
+	
+		return state!=nullptr;
+	
+	}
+	
+	
+	SendState SendHandle::State () const {
+	
+		if (state==nullptr) throw std::out_of_range(NullPointerError);
+		
+		return state->State;
+	
+	}
+	
+	
+	bool SendHandle::Wait () const {
+	
+		if (state==nullptr) throw std::out_of_range(NullPointerError);
+		
+		//	Avoid the lock if the send has
+		//	already completed
+		if (state->State==SendState::Sending) state->Lock.Execute([&] () {
+		
+			while (state->State==SendState::Sending) state->Wait.Sleep(state->Lock);
+		
+		});
+		
+		return state->State==SendState::Sent;
+	
+	}
+	
+	
+	void SendHandle::Complete (bool success) noexcept {
+	
+		if (state==nullptr) return;
+		
+		//	The state is changed while holding
+		//	the lock so that a waiter cannot see
+		//	the send as pending and then miss
+		//	the wake up
+		state->Lock.Execute([&] () {
+		
+			state->State=success ? SendState::Sent : SendState::Failed;
+			
+			state->Wait.WakeAll();
+		
+		});
+	
+	}
+
+
+}
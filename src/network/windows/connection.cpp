@@ -367,24 +367,22 @@ namespace MCPP {
 	}
 	
 	
-	Promise<bool> Connection::Send (Vector<Byte> buffer) {
+	void Connection::enqueue (Vector<Byte> buffer, SendHandle completion) {
 	
 		//	If attempting to send 0 bytes,
 		//	succeed unconditionally (what does
 		//	it even mean to send 0 bytes?)
 		if (buffer.Count()==0) {
 		
-			Promise<bool> promise;
-			promise.Complete(true);
+			completion.Complete(true);
 			
-			return promise;
+			return;
 		
 		}
 	
 		//	Create a send command for this
 		//	send operation
-		auto command=std::unique_ptr<SendCommand>(new SendCommand(std::move(buffer)));
-		auto promise=command->Completion;
+		auto command=std::unique_ptr<SendCommand>(new SendCommand(std::move(buffer),completion));
 		
 		//	Lock, add, and send
 		if (!sends_lock.Execute([&] () mutable {
@@ -444,9 +442,25 @@ namespace MCPP {
 			
 			return true;
 		
-		})) promise.Complete(false);
+		})) completion.Complete(false);
+	
+	}
+	
+	
+	SendHandle Connection::Send (Vector<Byte> buffer) {
+	
+		auto retr=SendHandle::Make();
+		
+		enqueue(std::move(buffer),retr);
 		
-		return promise;
+		return retr;
+	
+	}
+	
+	
+	void Connection::Post (Vector<Byte> buffer) {
+	
+		enqueue(std::move(buffer),SendHandle{});
 	
 	}
 	
@@ -485,6 +499,29 @@ namespace MCPP {
 		Shutdown();
 	
 	}
+	
+	
+	void Connection::SetData (std::shared_ptr<void> data) {
+	
+		//	The old data is released outside
+		//	the lock
+		data_lock.Execute([&] () mutable {	std::swap(this->data,data);	});
+	
+	}
+	
+	
+	std::shared_ptr<void> Connection::GetData () const {
+	
+		return data_lock.Execute([&] () {	return data;	});
+	
+	}
+	
+	
+	std::shared_ptr<void> Connection::TakeData () {
+	
+		return data_lock.Execute([&] () mutable {	return std::move(data);	});
+	
+	}
 
 
 }
@@ -7,7 +7,11 @@ namespace MCPP {
 	namespace NetworkImpl {
 	
 	
-		SendCommand::SendCommand (Vector<Byte> buffer) noexcept : CompletionCommand(CommandType::Send), Buffer(std::move(buffer)) {	}
+		SendCommand::SendCommand (Vector<Byte> buffer, SendHandle completion) noexcept
+			:	CompletionCommand(CommandType::Send),
+				Buffer(std::move(buffer)),
+				Completion(std::move(completion))
+		{	}
 		
 		
 		DWORD SendCommand::Dispatch (SOCKET socket) noexcept {
@@ -464,6 +464,13 @@ namespace MCPP {
 	}
 	
 	
+	static String print_type (const ColumnBulk &) {
+	
+		return "Column Bulk";
+	
+	}
+	
+	
 	static String print_type (const Metadata &) {
 	
 		return "Entity Metadata";
@@ -512,6 +519,17 @@ namespace MCPP {
 	}
 	
 	
+	static String print_value (const ColumnBulk & bulk) {
+	
+		return String::Format(
+			"{0} columns, {1} bytes",
+			bulk.Columns.Count(),
+			bulk.Data.Count()
+		);
+	
+	}
+	
+	
 	template <typename... Args>
 	static String print_value (const Tuple<Args...> &) {
 	
@@ -1,4 +1,6 @@
 #include <packet_router.hpp>
+#include <profiler.hpp>
+#include <atomic>
 #include <type_traits>
 #include <new>
 #include <utility>
@@ -8,6 +10,44 @@ namespace MCPP {
 
 
 	static const String packet_dne="Packet 0x{0} has no recognized handler";
+	static const String packet_label("Packet 0x{0} ({1})");
+	static const String state_names []={
+		"Handshaking",
+		"Play",
+		"Status",
+		"Login"
+	};
+	
+	
+	static Word get_label (UInt32 id, ProtocolState state) {
+	
+		//	Labels are created the first time each
+		//	packet is profiled.  Threads racing to
+		//	create the same label get the same label
+		//	back, so no lock is required
+		static std::atomic<Word> labels [4][PacketImpl::LargestID+1];
+		
+		auto index=static_cast<Word>(state);
+		auto & label=labels[index][id];
+		
+		Word retr=label;
+		if (retr==Profiler::None) {
+		
+			retr=Profiler::GetLabel(
+				String::Format(
+					packet_label,
+					String(id,16),
+					state_names[index]
+				)
+			);
+			
+			label=retr;
+		
+		}
+		
+		return retr;
+	
+	}
 	
 	
 	template <typename T, Word n>
@@ -42,6 +82,8 @@ namespace MCPP {
 		init_array(status_routes);
 		init_array(login_routes);
 		init_array(handshake_routes);
+		
+		for (auto & arr : owners) for (auto & owner : arr) owner=Profiler::None;
 	
 	}
 
@@ -62,6 +104,11 @@ namespace MCPP {
 	
 	auto PacketRouter::operator () (UInt32 id, ProtocolState state) noexcept -> Type & {
 	
+		//	Routes are installed through this
+		//	overload, so attribute the route to
+		//	whichever module is installing
+		owners[static_cast<Word>(state)][id]=Profiler::GetOwner();
+		
 		switch (state) {
 		
 			case ProtocolState::Handshaking:return handshake_routes[id];
@@ -92,9 +139,17 @@ namespace MCPP {
 	
 	void PacketRouter::operator () (PacketEvent event, ProtocolState state) const {
 	
-		auto & callback=(*this)(event.Data.ID,state);
+		auto id=event.Data.ID;
+		auto & callback=(*this)(id,state);
+		
+		if (!callback) return;
+		
+		ProfileScope scope(
+			Profiler::Active() ? get_label(id,state) : Profiler::None,
+			owners[static_cast<Word>(state)][id]
+		);
 		
-		if (callback) callback(std::move(event));
+		callback(std::move(event));
 	
 	}
 	
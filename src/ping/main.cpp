@@ -153,7 +153,7 @@ class ServerListPing : public Module {
 				response packet;
 				packet.Value=std::move(root);
 				
-				event.From->Send(packet);
+				event.From->Post(packet);
 			
 			};
 			
@@ -170,15 +170,13 @@ class ServerListPing : public Module {
 				ping_sc reply;
 				reply.Time=packet.Time;
 				
-				event.From->Send(reply);
+				event.From->Post(reply);
 				
-				Server::Get().WriteLog(
-					String::Format(
-						ping_template,
-						event.From->IP(),
-						event.From->Port()
-					),
-					Service::LogType::Information
+				Server::Get().Log(
+					Service::LogType::Information,
+					ping_template,
+					event.From->IP(),
+					event.From->Port()
 				);
 			
 			};
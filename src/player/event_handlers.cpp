@@ -8,6 +8,9 @@
 namespace MCPP {
 
 
+	static const Double stance_offset=1.62;
+
+
 	void Players::on_connect (SmartPointer<Client> client) {
 	
 		players_lock.Write([&] () {
@@ -51,9 +54,11 @@ namespace MCPP {
 		//	position/other information
 		//	from backing store
 		
-		//	TODO: Manipulate spawn_y so that
-		//	the player always spawns in air,
-		//	but right above ground
+		//	The player always spawns in air,
+		//	right above the ground, if the spawn
+		//	column is ready
+		auto height=World::Get().GetHeight(spawn_x,spawn_z,dimension);
+		if (!height.IsNull()) spawn_y=static_cast<Int32>(*height)+1;
 		
 		//	Setup this player's object
 		auto player=SmartPointer<Player>::Make();
@@ -64,8 +69,10 @@ namespace MCPP {
 		player->Position.Z=spawn_z;	//	TEMP
 		player->Position.Yaw=0;	//	TEMP
 		player->Position.Pitch=0;	//	TEMP
-		player->Position.Stance=74;	//	TEMP
+		player->Position.Stance=spawn_y+stance_offset;
 		player->Dimension=dimension;
+		player->VelocityX=0;
+		player->VelocityZ=0;
 		
 		//	Add to list of players before
 		//	send
@@ -87,7 +94,7 @@ namespace MCPP {
 		) ? max : static_cast<max_players_t>(max);
 		jg.LevelType=World::Get().Type();
 		
-		client->Send(jg);
+		client->Post(jg);
 		
 		//	Send Spawn Position
 		
@@ -96,10 +103,10 @@ namespace MCPP {
 		sp.Y=spawn_y;
 		sp.Z=spawn_z;
 		
-		client->Send(sp);
+		client->Post(sp);
 		
 		//	Send Player Position and Look
-		client->Send(
+		client->Post(
 			player->Position.ToPacket()
 		);
 		
@@ -119,11 +126,36 @@ namespace MCPP {
 		if (player.IsNull()) return;
 		
 		//	Update player's position
-		auto t=player->Lock.Execute([&] () {	return player->Position.FromPacket(event.Data);	});
+		bool prefetching;
+		auto t=player->Lock.Execute([&] () {
+		
+			Double x=player->Position.X;
+			Double z=player->Position.Z;
+			
+			auto retr=player->Position.FromPacket(event.Data);
+			
+			//	Velocity is smoothed over several
+			//	packets so that a single jittery
+			//	update does not redirect prefetching
+			Double elapsed=Double(retr.Item<1>())/1000000000;
+			if (elapsed!=0) {
+			
+				player->VelocityX=(player->VelocityX+((player->Position.X-x)/elapsed))/2;
+				player->VelocityZ=(player->VelocityZ+((player->Position.Z-z)/elapsed))/2;
+			
+			}
+			
+			prefetching=player->Prefetched.size()!=0;
+			
+			return retr;
+		
+		});
 		
 		//	If the player moved, update
-		//	their position
-		if (t.Item<0>()!=0) {
+		//	their position.  Players which have
+		//	stopped have their prefetches
+		//	cancelled.
+		if ((t.Item<0>()!=0) || prefetching) {
 		
 			Server::Get().Pool().Enqueue([=] () mutable {	update_position(player);	});
 			
@@ -13,6 +13,10 @@ namespace MCPP {
 			column,
 			true
 		);
+		
+		//	Columns which were prefetched and not
+		//	yet sent must not remain loaded either
+		for (auto & pair : Prefetched) if (pair.second) World::Get().EndInterest(pair.first);
 	
 	}
 
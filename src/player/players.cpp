@@ -17,12 +17,18 @@ namespace MCPP {
 	Players::Players () noexcept
 		:	view_distance(10),
 			cache_distance(11),
+			prefetch_distance(3),
+			prefetch_budget(16),
 			spawn_x(0),
 			spawn_y(300),
 			spawn_z(0),
 			spawn_dimension(0),
 			interested_locked(false)
-	{	}
+	{
+	
+		prefetching=0;
+	
+	}
 	
 	
 	const String & Players::Name () const noexcept {
@@ -41,6 +47,8 @@ namespace MCPP {
 	
 	static const String column_concurrency_key("column_concurrency");
 	static const String column_concurrency_log("No user-supplied value for \"{0}\" - {1} concurrent column operations will be allowed");
+	static const String prefetch_distance_key("prefetch_distance");
+	static const String prefetch_budget_key("prefetch_budget");
 	
 	
 	template <typename T, typename Callback>
@@ -126,6 +134,21 @@ namespace MCPP {
 			[] () {	Server::Get().Panic();	}
 		);
 	
+		//	Prefetching
+		prefetch_distance=server.Data().GetSetting(
+			prefetch_distance_key,
+			prefetch_distance
+		);
+		prefetch_budget=server.Data().GetSetting(
+			prefetch_budget_key,
+			prefetch_budget
+		);
+		prefetch_cm.Construct(
+			server.Pool(),
+			1,
+			[] () {	Server::Get().Panic();	}
+		);
+	
 		//	Install event handlers
 		
 		server.OnConnect.Add([this] (SmartPointer<Client> client) {	on_connect(std::move(client));	});
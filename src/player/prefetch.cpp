@@ -0,0 +1,203 @@
+#include <player/player.hpp>
+#include <server.hpp>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+
+
+namespace MCPP {
+
+
+	//	Players moving slower than this (in
+	//	blocks per second) are kept up with
+	//	by ordinary column loading
+	static const Double min_speed=6;
+	//	How far ahead (in seconds) a player's
+	//	position is predicted
+	static const Double lookahead=2;
+	
+	
+	static Word distance (ColumnID a, ColumnID b) noexcept {
+	
+		Word x=static_cast<Word>(std::abs(static_cast<Int64>(a.X)-static_cast<Int64>(b.X)));
+		Word z=static_cast<Word>(std::abs(static_cast<Int64>(a.Z)-static_cast<Int64>(b.Z)));
+		
+		return (x>z) ? x : z;
+	
+	}
+	
+	
+	void Players::prefetch (Player & player, ColumnID curr, Vector<ColumnID> & begin, Vector<ColumnID> & end) {
+	
+		std::unordered_set<ColumnID> wanted;
+		
+		Double speed=std::sqrt(
+			(player.VelocityX*player.VelocityX)+
+			(player.VelocityZ*player.VelocityZ)
+		);
+		
+		if ((prefetch_distance!=0) && (speed>=min_speed)) {
+		
+			//	Predict where the player will be, but
+			//	never further ahead than columns are
+			//	prefetched
+			Double ahead=speed*lookahead;
+			Double max=static_cast<Double>(prefetch_distance*16);
+			if (ahead>max) ahead=max;
+			ahead/=speed;
+			
+			auto predicted=ColumnID::GetContaining(
+				player.Position.X+(player.VelocityX*ahead),
+				player.Position.Z+(player.VelocityZ*ahead),
+				player.Dimension
+			);
+			
+			//	The columns the player would be able
+			//	to see from there, which they cannot
+			//	see yet
+			for (
+				Int32 x=predicted.X-view_distance;
+				x<predicted.X+static_cast<Int32>(view_distance)+1;
+				++x
+			) for (
+				Int32 z=predicted.Z-view_distance;
+				z<predicted.Z+static_cast<Int32>(view_distance)+1;
+				++z
+			) {
+			
+				ColumnID id{
+					x,
+					z,
+					player.Dimension
+				};
+				
+				if (
+					(distance(id,curr)>view_distance) &&
+					(player.Columns.count(id)==0)
+				) wanted.insert(id);
+			
+			}
+		
+		}
+		
+		//	Cancel prefetches which are no longer
+		//	ahead of the player
+		for (auto iter=player.Prefetched.begin();iter!=player.Prefetched.end();) {
+		
+			if (wanted.count(iter->first)==0) {
+			
+				//	Prefetches which have not finished
+				//	end their own interest
+				if (iter->second) end.Add(iter->first);
+				
+				iter=player.Prefetched.erase(iter);
+			
+			} else {
+			
+				wanted.erase(iter->first);
+				
+				++iter;
+			
+			}
+		
+		}
+		
+		//	The columns the player will reach soonest
+		//	are prefetched first
+		for (auto & id : wanted) begin.Add(id);
+		std::sort(
+			begin.begin(),
+			begin.end(),
+			[&] (const ColumnID & a, const ColumnID & b) {	return distance(a,curr)<distance(b,curr);	}
+		);
+		
+		Word i=0;
+		for (;i<begin.Count();++i) {
+		
+			if ((++prefetching)>prefetch_budget) {
+			
+				--prefetching;
+				
+				break;
+			
+			}
+			
+			player.Prefetched.emplace(begin[i],false);
+		
+		}
+		
+		//	Columns for which there was no room are
+		//	tried again the next time the player
+		//	moves
+		while (begin.Count()>i) begin.Delete(begin.Count()-1);
+	
+	}
+	
+	
+	void Players::begin_prefetch (const SmartPointer<Player> & player, const Vector<ColumnID> & ids) {
+	
+		for (auto & id : ids) prefetch_cm->Enqueue([this,player,id] () mutable {
+		
+			//	Prefetches cancelled before they began
+			//	are skipped
+			if (!player->Lock.Execute([&] () {
+			
+				auto iter=player->Prefetched.find(id);
+				
+				return (iter!=player->Prefetched.end()) && !iter->second;
+			
+			})) {
+			
+				--prefetching;
+				
+				return;
+			
+			}
+			
+			try {
+			
+				World::Get().Interested(id,true);
+			
+			} catch (...) {
+			
+				--prefetching;
+				
+				player->Lock.Execute([&] () {
+				
+					auto iter=player->Prefetched.find(id);
+					if ((iter!=player->Prefetched.end()) && !iter->second) player->Prefetched.erase(iter);
+				
+				});
+				
+				Server::Get().Panic(
+					std::current_exception()
+				);
+				
+				return;
+			
+			}
+			
+			--prefetching;
+			
+			//	If the prefetch was cancelled while
+			//	it was in progress, or the column was
+			//	prefetched again and that prefetch
+			//	finished first, this interest is not
+			//	needed
+			if (!player->Lock.Execute([&] () {
+			
+				auto iter=player->Prefetched.find(id);
+				if ((iter==player->Prefetched.end()) || iter->second) return false;
+				
+				iter->second=true;
+				
+				return true;
+			
+			})) World::Get().EndInterest(id);
+		
+		});
+	
+	}
+
+
+}
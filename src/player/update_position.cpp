@@ -16,6 +16,11 @@ namespace MCPP {
 		//	Create a list of columns which
 		//	must be removed from the player
 		Vector<ColumnID> remove;
+		//	Create lists of columns which must
+		//	begin being prefetched, and of columns
+		//	which are no longer being prefetched
+		Vector<ColumnID> prefetch_begin;
+		Vector<ColumnID> prefetch_end;
 	
 		player->Lock.Execute([&] () {
 		
@@ -75,9 +80,13 @@ namespace MCPP {
 				}
 			
 			}
+			
+			prefetch(*player,curr,prefetch_begin,prefetch_end);
 		
 		});
 		
+		for (auto & id : prefetch_end) World::Get().EndInterest(id);
+		
 		//	Perform adds and removes
 		
 		for (auto & id : remove) World::Get().Remove(
@@ -137,6 +146,8 @@ namespace MCPP {
 			throw;
 		
 		}
+		
+		begin_prefetch(player,prefetch_begin);
 	
 	}
 
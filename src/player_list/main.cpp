@@ -103,7 +103,7 @@ class PlayerList : public Module {
 				
 				//	Send a full update to this connecting
 				//	client
-				for (auto & packet : get_packets()) client->Send(packet);
+				for (auto & packet : get_packets()) client->Post(packet);
 				
 				//	Insert an entry specifying that disconnect
 				//	processing has not occurred
@@ -115,7 +115,7 @@ class PlayerList : public Module {
 				//	Send packet to all connected clients
 				//	who are in the correct state
 				auto packet=get_packet(client,true);
-				for (auto & c : Server::Get().Clients) if (c->GetState()==ProtocolState::Play) c->Send(packet);
+				for (auto & c : Server::Get().Clients) if (c->GetState()==ProtocolState::Play) c->Post(packet);
 			
 			});
 		
@@ -156,7 +156,7 @@ class PlayerList : public Module {
 				for (auto & c : Server::Get().Clients) if (
 					(c!=client) &&
 					(c->GetState()==ProtocolState::Play)
-				) c->Send(packet);
+				) c->Post(packet);
 			
 			});
 		
@@ -175,7 +175,7 @@ class PlayerList : public Module {
 				//	Play state and send them these packets
 				for (auto & c : server.Clients)
 				if (c->GetState()==ProtocolState::Play)
-				for (auto & packet : packets) c->Send(packet);
+				for (auto & packet : packets) c->Post(packet);
 			
 			});
 			
@@ -193,9 +193,9 @@ namespace MCPP {
 	}
 	
 	
-	Nullable<Promise<bool>> PluginMessages::Send (PluginMessage message) {
+	Nullable<SendHandle> PluginMessages::Send (PluginMessage message) {
 	
-		Nullable<Promise<bool>> retr;
+		Nullable<SendHandle> retr;
 		
 		if (message.Endpoint.IsNull()) return retr;
 		
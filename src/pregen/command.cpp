@@ -0,0 +1,170 @@
+#include <chat/chat.hpp>
+#include <command/command.hpp>
+#include <permissions/permissions.hpp>
+#include <pregen/pregen.hpp>
+#include <mod.hpp>
+#include <server.hpp>
+#include <utility>
+
+
+using namespace MCPP;
+
+
+static const Word priority=1;
+static const String name("Pre-Generation Command");
+static const String identifier("pregen");
+static const String stop("stop");
+//	The largest radius which may be
+//	pre-generated, which is well past
+//	the edge of the Minecraft world
+static const Word max_radius=1875000;
+
+
+class PregenCommand : public Module, public Command {
+
+
+	private:
+	
+	
+		static CommandResult start (const CommandEvent & event) {
+		
+			CommandResult retr;
+			
+			SByte dimension;
+			Word radius;
+			if (!(
+				event.Arguments[0].ToInteger(&dimension) &&
+				event.Arguments[1].ToInteger(&radius) &&
+				(radius<=max_radius)
+			)) {
+			
+				retr.Status=CommandStatus::SyntaxError;
+				
+				return retr;
+			
+			}
+			
+			Pregenerator::Get().Start(dimension,radius);
+			
+			retr.Message	<<	ChatStyle::BrightGreen
+							<<	ChatStyle::Bold
+							<<	"Pre-generation started";
+			retr.Status=CommandStatus::Success;
+			
+			return retr;
+		
+		}
+		
+		
+		static CommandResult cancel (const CommandEvent & event) {
+		
+			CommandResult retr;
+			
+			if (event.Arguments[0]!=stop) {
+			
+				retr.Status=CommandStatus::SyntaxError;
+				
+				return retr;
+			
+			}
+			
+			if (Pregenerator::Get().Stop()) retr.Message	<<	ChatStyle::Red
+															<<	ChatStyle::Bold
+															<<	"Pre-generation stopped";
+			else retr.Message	<<	ChatStyle::Red
+								<<	ChatStyle::Bold
+								<<	"Pre-generation is not running";
+			retr.Status=CommandStatus::Success;
+			
+			return retr;
+		
+		}
+	
+	
+	public:
+	
+	
+		virtual Word Priority () const noexcept override {
+		
+			return priority;
+		
+		}
+		
+		
+		virtual const String & Name () const noexcept override {
+		
+			return name;
+		
+		}
+		
+		
+		virtual void Install () override {
+		
+			Commands::Get().Add(
+				identifier,
+				this
+			);
+		
+		}
+		
+		
+		virtual void Summary (const String &, ChatMessage & message) override {
+		
+			message << "Pre-generates a region of the world.";
+		
+		}
+		
+		
+		virtual void Help (const String &, ChatMessage & message) override {
+		
+			message	<<	"Syntax: "
+					<<	ChatStyle::Bold
+					<<	"/"
+					<<	identifier
+					<<	" <dimension> <radius>|stop"
+					<<	ChatFormat::Pop
+					<<	Newline
+					<<	"If executed with a dimension and a radius, generates and populates every column within that many columns of the origin of that dimension, "
+						"replacing any region already being pre-generated.  "
+						"Pre-generation pauses while ticks take too long, and resumes after a restart.  "
+						"If executed with the \"stop\" argument, stops pre-generating.";
+		
+		}
+		
+		
+		virtual bool Check (const CommandEvent & event) override {
+		
+			if (event.Issuer.IsNull()) return true;
+			
+			return Permissions::Get().GetUser(event.Issuer).Check(identifier);
+		
+		}
+		
+		
+		virtual CommandResult Execute (CommandEvent event) override {
+		
+			CommandResult retr;
+			
+			switch (event.Arguments.Count()) {
+			
+				case 1:
+					retr=cancel(event);
+					break;
+				case 2:
+					retr=start(event);
+					break;
+				default:
+					retr.Status=CommandStatus::SyntaxError;
+					break;
+			
+			}
+			
+			return retr;
+		
+		}
+
+
+};
+
+
+INSTALL_MODULE(PregenCommand)
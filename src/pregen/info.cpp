@@ -0,0 +1,129 @@
+#include <info/info.hpp>
+#include <pregen/pregen.hpp>
+#include <mod.hpp>
+
+
+using namespace MCPP;
+
+
+static const String name("Pre-Generator Information");
+static const Word priority=1;
+static const String identifier("pregen");
+static const String help("Displays information about world pre-generation.");
+static const String pregen_banner("PRE-GENERATION:");
+static const String running("Running: ");
+static const String paused("Paused: ");
+static const String true_string("Yes");
+static const String false_string("No");
+static const String region("Region: Dimension {0}, Radius {1}");
+static const String progress("Progress: {0} of {1} columns");
+static const String generated("Generated: {0}");
+static const String elapsed("Elapsed: {0}ns");
+static const String rate("Rate: {0} columns/s");
+static const String pauses("Pauses: {0}");
+
+
+static Double columns_per_second (Word count, UInt64 ns) noexcept {
+
+	return (ns==0) ? 0 : ((static_cast<Double>(count)*1000000000)/static_cast<Double>(ns));
+
+}
+
+
+class PregenInfoProvider : public Module, public InformationProvider {
+
+
+	public:
+	
+	
+		virtual const String & Name () const noexcept override {
+		
+			return name;
+		
+		}
+		
+		
+		virtual Word Priority () const noexcept override {
+		
+			return priority;
+		
+		}
+		
+		
+		virtual void Install () override {
+		
+			Information::Get().Add(this);
+		
+		}
+		
+		
+		virtual const String & Identifier () const noexcept override {
+		
+			return identifier;
+		
+		}
+		
+		
+		virtual const String & Help () const noexcept override {
+		
+			return help;
+		
+		}
+		
+		
+		virtual void Execute (ChatMessage & message) const override {
+		
+			auto info=Pregenerator::Get().GetInfo();
+			
+			message	<<	ChatStyle::Bold
+					<<	pregen_banner
+					<<	ChatFormat::Pop
+					<<	Newline
+					<<	running
+					<<	(info.Running ? true_string : false_string)
+					<<	Newline
+					<<	paused
+					<<	(info.Paused ? true_string : false_string)
+					<<	Newline
+					<<	String::Format(
+							region,
+							info.Dimension,
+							info.Radius
+						)
+					<<	Newline
+					<<	String::Format(
+							progress,
+							info.Completed,
+							info.Total
+						)
+					<<	Newline
+					<<	String::Format(
+							generated,
+							info.Generated
+						)
+					<<	Newline
+					<<	String::Format(
+							elapsed,
+							info.Elapsed
+						)
+					<<	Newline
+					<<	String::Format(
+							rate,
+							columns_per_second(
+								info.Generated,
+								info.Elapsed
+							)
+						)
+					<<	Newline
+					<<	String::Format(
+							pauses,
+							info.Pauses
+						);
+		
+		}
+
+
+};
+
+
+INSTALL_MODULE(PregenInfoProvider)
@@ -0,0 +1,463 @@
+#include <pregen/pregen.hpp>
+#include <time/time.hpp>
+#include <serializer.hpp>
+#include <server.hpp>
+#include <singleton.hpp>
+#include <exception>
+#include <utility>
+
+
+using namespace MCPP;
+
+
+namespace MCPP {
+
+
+	static const Word priority=1;
+	static const String name("World Pre-Generator");
+	static const String debug_key("pregen");
+	static const String save_key("pregen");
+	static const String batch_size_key("pregen_batch_size");
+	static const Word default_batch_size=64;
+	static const String parse_error("Error parsing pre-generation progress: \"{0}\" at byte {1}");
+	static const String resume("Resuming pre-generation of dimension {0} with radius {1} at column {2} of {3}");
+	static const String batch_saved("Pre-generated {0} of {1} columns, saved {2}");
+	static const String complete("Finished pre-generating dimension {0} with radius {1}");
+	
+	
+	static Word get_total (Word radius) noexcept {
+	
+		Word width=(radius*2)+1;
+		
+		return width*width;
+	
+	}
+	
+	
+	ColumnID Pregenerator::get_column (Word i, SByte dimension) noexcept {
+	
+		if (i==0) return ColumnID{0,0,dimension};
+		
+		//	Find the ring of the spiral the column
+		//	is in, ring k is the square of side
+		//	2k+1 less the square of side 2k-1
+		Int32 k=1;
+		while (get_total(Word(k))<=i) ++k;
+		
+		Word offset=i-get_total(Word(k-1));
+		Int32 side=Int32(offset/Word(k*2));
+		Int32 pos=Int32(offset%Word(k*2));
+		
+		switch (side) {
+		
+			case 0:return ColumnID{k,pos-k+1,dimension};
+			case 1:return ColumnID{k-1-pos,k,dimension};
+			case 2:return ColumnID{-k,k-1-pos,dimension};
+			default:return ColumnID{pos-k+1,-k,dimension};
+		
+		}
+	
+	}
+	
+	
+	void Pregenerator::save_progress () {
+	
+		ByteBuffer buffer;
+		
+		lock.Execute([&] () {
+		
+			buffer.ToBytes(running);
+			buffer.ToBytes(dimension);
+			buffer.ToBytes(radius);
+			//	Columns which have not been saved
+			//	will be revisited when resuming
+			buffer.ToBytes(next-batch.Count());
+		
+		});
+		
+		buffer.Save(save_key);
+	
+	}
+	
+	
+	void Pregenerator::save_batch (Vector<ColumnID> ids) {
+	
+		auto & world=World::Get();
+		
+		try {
+		
+			world.Save(ids);
+		
+		} catch (...) {
+		
+			for (auto & id : ids) world.EndInterest(id);
+			
+			throw;
+		
+		}
+		
+		//	Once saved the columns may be unloaded
+		for (auto & id : ids) world.EndInterest(id);
+	
+	}
+	
+	
+	void Pregenerator::schedule (Word run, Word delay) {
+	
+		auto & pool=Server::Get().Pool();
+		auto callback=[this,run] () mutable {
+		
+			Server::Get().PanicOnThrow([&] () mutable {	step(run);	});
+		
+		};
+		
+		if (delay==0) pool.Enqueue(std::move(callback));
+		else pool.Enqueue(delay,std::move(callback));
+	
+	}
+	
+	
+	void Pregenerator::step (Word run) {
+	
+		auto & server=Server::Get();
+		auto & world=World::Get();
+		
+		//	Yield to the game whenever ticks are
+		//	taking too long, and check again after
+		//	the next tick
+		auto time=Time::Get().GetInfo();
+		bool lagging=time.Last>time.Threshold;
+		
+		Nullable<ColumnID> id;
+		if (!lock.Execute([&] () mutable {
+		
+			if (!running || (run!=this->run)) return false;
+			
+			if (lagging) {
+			
+				if (!paused) ++pauses;
+				paused=true;
+				
+				return true;
+			
+			}
+			
+			paused=false;
+			
+			id.Construct(get_column(next++,dimension));
+			
+			return true;
+		
+		})) return;
+		
+		if (id.IsNull()) {
+		
+			schedule(run,time.Length);
+			
+			return;
+		
+		}
+		
+		Timer timer(Timer::CreateAndStart());
+		
+		//	Generates and populates the column, interest
+		//	is held until the column has been saved
+		world.Interested(*id,true);
+		
+		elapsed+=timer.ElapsedNanoseconds();
+		++generated;
+		
+		Vector<ColumnID> ids;
+		Word completed;
+		Word total;
+		bool done;
+		bool stale=false;
+		lock.Execute([&] () mutable {
+		
+			if (run!=this->run) {
+			
+				stale=true;
+				
+				return;
+			
+			}
+			
+			batch.Add(*id);
+			
+			completed=next;
+			total=get_total(radius);
+			done=next==total;
+			
+			if (done || (batch.Count()>=batch_size)) ids=std::move(batch);
+			
+			if (done) running=false;
+		
+		});
+		
+		//	Pre-generation was stopped or restarted
+		//	while this column was being generated
+		if (stale) {
+		
+			world.EndInterest(*id);
+			
+			return;
+		
+		}
+		
+		if (ids.Count()!=0) {
+		
+			Word saved=ids.Count();
+			
+			save_batch(std::move(ids));
+			
+			save_progress();
+			
+			if (server.IsVerbose(debug_key)) server.WriteLog(
+				String::Format(
+					batch_saved,
+					completed,
+					total,
+					saved
+				),
+				Service::LogType::Debug
+			);
+		
+		}
+		
+		if (done) {
+		
+			server.WriteLog(
+				String::Format(
+					complete,
+					dimension,
+					radius
+				),
+				Service::LogType::Information
+			);
+			
+			return;
+		
+		}
+		
+		schedule(run,0);
+	
+	}
+	
+	
+	static Singleton<Pregenerator> singleton;
+	
+	
+	Pregenerator & Pregenerator::Get () noexcept {
+	
+		return singleton.Get();
+	
+	}
+	
+	
+	Pregenerator::Pregenerator () noexcept
+		:	batch_size(default_batch_size),
+			running(false),
+			paused(false),
+			dimension(0),
+			radius(0),
+			next(0),
+			run(0)
+	{
+	
+		generated=0;
+		elapsed=0;
+		pauses=0;
+	
+	}
+	
+	
+	Word Pregenerator::Priority () const noexcept {
+	
+		return priority;
+	
+	}
+	
+	
+	const String & Pregenerator::Name () const noexcept {
+	
+		return name;
+	
+	}
+	
+	
+	void Pregenerator::Install () {
+	
+		auto & server=Server::Get();
+		
+		batch_size=server.Data().GetSetting(
+			batch_size_key,
+			default_batch_size
+		);
+		if (batch_size==0) batch_size=1;
+		
+		//	Attempt to load progress from an
+		//	earlier run
+		auto buffer=ByteBuffer::Load(save_key);
+		if (buffer.Count()!=0) {
+		
+			try {
+			
+				running=buffer.FromBytes<bool>();
+				dimension=buffer.FromBytes<SByte>();
+				radius=buffer.FromBytes<Word>();
+				next=buffer.FromBytes<Word>();
+			
+			} catch (const ByteBufferError & e) {
+			
+				running=false;
+				
+				server.WriteLog(
+					String::Format(
+						parse_error,
+						e.what(),
+						e.Where()
+					),
+					Service::LogType::Error
+				);
+			
+			}
+		
+		}
+		
+		//	Work which is in progress when the
+		//	server shuts down is abandoned, the
+		//	saved progress is where it resumes
+		server.OnShutdown.Add([this] () mutable {	lock.Execute([&] () mutable {	++run;	});	});
+		
+		//	The world is not ready until every
+		//	module has been installed
+		server.OnInstall.Add([this] (bool) mutable {
+		
+			Word run;
+			if (!lock.Execute([&] () mutable {
+			
+				if (!running) return false;
+				
+				run=this->run;
+				
+				Server::Get().WriteLog(
+					String::Format(
+						resume,
+						dimension,
+						radius,
+						next,
+						get_total(radius)
+					),
+					Service::LogType::Information
+				);
+				
+				return true;
+			
+			})) return;
+			
+			schedule(run,0);
+		
+		});
+	
+	}
+	
+	
+	void Pregenerator::Start (SByte dimension, Word radius) {
+	
+		Vector<ColumnID> ids;
+		Word run;
+		lock.Execute([&] () mutable {
+		
+			ids=std::move(batch);
+			
+			this->dimension=dimension;
+			this->radius=radius;
+			next=0;
+			running=true;
+			paused=false;
+			run=++this->run;
+		
+		});
+		
+		save_batch(std::move(ids));
+		
+		save_progress();
+		
+		schedule(run,0);
+	
+	}
+	
+	
+	bool Pregenerator::Stop () {
+	
+		Vector<ColumnID> ids;
+		bool retr=lock.Execute([&] () mutable {
+		
+			if (!running) return false;
+			
+			ids=std::move(batch);
+			
+			running=false;
+			paused=false;
+			++run;
+			
+			return true;
+		
+		});
+		
+		if (!retr) return false;
+		
+		save_batch(std::move(ids));
+		
+		save_progress();
+		
+		return true;
+	
+	}
+	
+	
+	PregenInfo Pregenerator::GetInfo () const noexcept {
+	
+		PregenInfo retr;
+		
+		lock.Execute([&] () {
+		
+			retr.Running=running;
+			retr.Paused=paused;
+			retr.Dimension=dimension;
+			retr.Radius=radius;
+			retr.Completed=next-batch.Count();
+			retr.Total=get_total(radius);
+		
+		});
+		
+		retr.Generated=generated;
+		retr.Elapsed=elapsed;
+		retr.Pauses=pauses;
+		
+		return retr;
+	
+	}
+
+
+}
+
+
+extern "C" {
+
+
+	Module * Load () {
+	
+		return &(Pregenerator::Get());
+	
+	}
+	
+	
+	void Unload () {
+	
+		singleton.Destroy();
+	
+	}
+
+
+}
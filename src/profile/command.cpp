@@ -0,0 +1,243 @@
+#include <rleahylib/rleahylib.hpp>
+#include <chat/chat.hpp>
+#include <command/command.hpp>
+#include <mod.hpp>
+#include <profiler.hpp>
+#include <server.hpp>
+#include <exception>
+#include <utility>
+
+
+using namespace MCPP;
+
+
+static const String name("Profile Command");
+static const Word priority=1;
+static const String identifier("profile");
+static const String summary("Captures a trace of what the server is doing.");
+static const String help(
+	"Syntax: /profile <seconds> [file] or /profile on|off\n"
+	"Captures a trace of the handlers the server executes for the given number of seconds and writes it to "
+	"the given file, relative to the server's directory, in the Chrome trace event format.  The trace may be "
+	"viewed with chrome://tracing.  If no file is given the trace is written to \"profile.json\".  "
+	"\"on\" and \"off\" enable and disable the summary of the slowest handlers displayed by /info profile.  "
+	"This command may only be issued from the console."
+);
+static const String on("on");
+static const String off("off");
+static const String default_filename("profile.json");
+static const String summary_setting("profile");
+static const bool summary_default=false;
+static const String capturing("Capturing for {0} seconds to {1}");
+static const String already_capturing("A capture is already in progress");
+static const String summary_enabled("Slowest handler summary enabled");
+static const String summary_disabled("Slowest handler summary disabled");
+static const String capture_complete("Wrote {0} spans to {1} ({2} dropped)");
+static const String capture_failed("Could not write profile to {0}: {1}");
+
+
+class ProfileCommand : public Module, public Command {
+
+
+	private:
+	
+	
+		static void end_capture (const String & filename) {
+		
+			auto & server=Server::Get();
+			
+			try {
+			
+				auto info=Profiler::EndCapture(filename);
+				
+				server.WriteLog(
+					String::Format(
+						capture_complete,
+						info.Spans,
+						filename,
+						info.Dropped
+					),
+					Service::LogType::Information
+				);
+			
+			} catch (const std::exception & e) {
+			
+				server.WriteLog(
+					String::Format(
+						capture_failed,
+						filename,
+						e.what()
+					),
+					Service::LogType::Error
+				);
+			
+			}
+		
+		}
+		
+		
+		static CommandResult capture (Word seconds, String filename) {
+		
+			CommandResult retr;
+			retr.Status=CommandStatus::Success;
+			
+			if (!Profiler::BeginCapture()) {
+			
+				retr.Message	<<	ChatStyle::Red
+								<<	ChatStyle::Bold
+								<<	already_capturing;
+				
+				return retr;
+			
+			}
+			
+			filename=Path::Combine(
+				Path::GetPath(
+					File::GetCurrentExecutableFileName()
+				),
+				filename
+			);
+			
+			retr.Message	<<	ChatStyle::BrightGreen
+							<<	ChatStyle::Bold
+							<<	String::Format(
+									capturing,
+									seconds,
+									filename
+								);
+			
+			try {
+			
+				Server::Get().Pool().Enqueue(
+					seconds*1000,
+					&end_capture,
+					filename
+				);
+			
+			} catch (...) {
+			
+				//	Don't leave the profiler capturing
+				//	forever
+				try {
+				
+					Profiler::EndCapture(filename);
+				
+				} catch (...) {	}
+				
+				throw;
+			
+			}
+			
+			return retr;
+		
+		}
+	
+	
+	public:
+	
+	
+		virtual const String & Name () const noexcept override {
+		
+			return name;
+		
+		}
+		
+		
+		virtual Word Priority () const noexcept override {
+		
+			return priority;
+		
+		}
+		
+		
+		virtual void Install () override {
+		
+			Profiler::Enable(
+				Server::Get().Data().GetSetting(
+					summary_setting,
+					summary_default
+				)
+			);
+			
+			Commands::Get().Add(
+				identifier,
+				this
+			);
+		
+		}
+		
+		
+		virtual void Summary (const String &, ChatMessage & message) override {
+		
+			message << summary;
+		
+		}
+		
+		
+		virtual void Help (const String &, ChatMessage & message) override {
+		
+			message << help;
+		
+		}
+		
+		
+		virtual bool Check (const CommandEvent & event) override {
+		
+			//	Captures write to the server's file
+			//	system
+			return event.Issuer.IsNull();
+		
+		}
+		
+		
+		virtual CommandResult Execute (CommandEvent event) override {
+		
+			CommandResult retr;
+			retr.Status=CommandStatus::SyntaxError;
+			
+			if ((event.Arguments.Count()==0) || (event.Arguments.Count()>2)) return retr;
+			
+			if (event.Arguments.Count()==1) {
+			
+				if (event.Arguments[0]==on) {
+				
+					Profiler::Enable(true);
+					
+					retr.Status=CommandStatus::Success;
+					retr.Message << summary_enabled;
+					
+					return retr;
+				
+				}
+				
+				if (event.Arguments[0]==off) {
+				
+					Profiler::Enable(false);
+					
+					retr.Status=CommandStatus::Success;
+					retr.Message << summary_disabled;
+					
+					return retr;
+				
+				}
+			
+			}
+			
+			Word seconds;
+			if (!(
+				event.Arguments[0].ToInteger(&seconds) &&
+				(seconds!=0)
+			)) return retr;
+			
+			return capture(
+				seconds,
+				(event.Arguments.Count()==2) ? std::move(event.Arguments[1]) : default_filename
+			);
+		
+		}
+
+
+};
+
+
+INSTALL_MODULE(ProfileCommand)
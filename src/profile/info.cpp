@@ -0,0 +1,116 @@
+#include <rleahylib/rleahylib.hpp>
+#include <chat/chat.hpp>
+#include <info/info.hpp>
+#include <mod.hpp>
+#include <profiler.hpp>
+
+
+using namespace MCPP;
+
+
+static const String name("Profiler Information");
+static const Word priority=1;
+static const String identifier("profile");
+static const String help("Displays the handlers which have taken the longest to execute recently.");
+static const Word count=10;
+static const String profile_banner("SLOWEST HANDLERS:");
+static const String disabled("The summary is disabled, enable it with /profile on");
+static const String no_entries("Nothing has been recorded");
+static const String entry_template(": max {0}ns, average {1}ns, {2} calls");
+static const String owner_template(" ({0})");
+
+
+class ProfileInfo : public Module, public InformationProvider {
+
+
+	public:
+	
+	
+		virtual Word Priority () const noexcept override {
+		
+			return priority;
+		
+		}
+		
+		
+		virtual const String & Name () const noexcept override {
+		
+			return name;
+		
+		}
+		
+		
+		virtual void Install () override {
+		
+			Information::Get().Add(this);
+		
+		}
+		
+		
+		virtual const String & Identifier () const noexcept override {
+		
+			return identifier;
+		
+		}
+		
+		
+		virtual const String & Help () const noexcept override {
+		
+			return help;
+		
+		}
+		
+		
+		virtual void Execute (ChatMessage & message) const override {
+		
+			message	<<	ChatStyle::Bold
+					<<	profile_banner
+					<<	ChatFormat::Pop;
+			
+			if (!Profiler::IsEnabled()) {
+			
+				message << Newline << disabled;
+				
+				return;
+			
+			}
+			
+			auto entries=Profiler::GetSlowest(count);
+			
+			if (entries.Count()==0) {
+			
+				message << Newline << no_entries;
+				
+				return;
+			
+			}
+			
+			for (auto & entry : entries) {
+			
+				message	<<	Newline
+						<<	ChatStyle::Bold
+						<<	entry.Name;
+				
+				if (entry.Owner.Size()!=0) message << String::Format(
+					owner_template,
+					entry.Owner
+				);
+				
+				message	<<	ChatFormat::Pop
+						<<	String::Format(
+								entry_template,
+								entry.Max,
+								//	Guard against divide by zero
+								(entry.Count==0) ? 0 : (entry.Total/entry.Count),
+								entry.Count
+							);
+			
+			}
+		
+		}
+
+
+};
+
+
+INSTALL_MODULE(ProfileInfo)
@@ -0,0 +1,542 @@
+#include <profiler.hpp>
+#include <json.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+
+namespace MCPP {
+
+
+	//	The largest number of spans each thread
+	//	will buffer during a capture
+	static const Word max_spans=1<<18;
+	//	The length of each window of the rolling
+	//	summary, in nanoseconds
+	static const UInt64 window=10000000000ULL;
+	//	The names of the built in labels, in order
+	static const String builtin_names []={
+		"Unknown",
+		"Thread Pool Task",
+		"Event Subscriber",
+		"Tick",
+		"Tick Callback"
+	};
+	static const char * could_not_open="Could not open trace file";
+	static const char * could_not_write="Could not write trace file";
+	
+	
+	std::atomic<bool> Profiler::active(false);
+	std::atomic<bool> Profiler::enabled(false);
+	std::atomic<bool> Profiler::capturing(false);
+	const Word Profiler::None;
+	const Word Profiler::Task;
+	const Word Profiler::Subscriber;
+	const Word Profiler::Tick;
+	const Word Profiler::TickCallback;
+	
+	
+	class ProfileStats {
+	
+	
+		public:
+		
+		
+			UInt64 Count;
+			UInt64 Total;
+			UInt64 Max;
+			
+			
+			ProfileStats () noexcept : Count(0), Total(0), Max(0) {	}
+			
+			
+			void Add (UInt64 elapsed) noexcept {
+			
+				++Count;
+				Total+=elapsed;
+				if (elapsed>Max) Max=elapsed;
+			
+			}
+			
+			
+			void Add (const ProfileStats & other) noexcept {
+			
+				Count+=other.Count;
+				Total+=other.Total;
+				if (other.Max>Max) Max=other.Max;
+			
+			}
+	
+	
+	};
+	
+	
+	class ProfileSpan {
+	
+	
+		public:
+		
+		
+			Word Label;
+			Word Owner;
+			UInt64 Begin;
+			UInt64 End;
+	
+	
+	};
+	
+	
+	typedef std::unordered_map<UInt64,ProfileStats> ProfileSummary;
+	
+	
+	//	Each thread records into its own buffer,
+	//	the lock is only contended when a capture
+	//	ends or the summary is read
+	class ProfileBuffer {
+	
+	
+		public:
+		
+		
+			Mutex Lock;
+			Word Thread;
+			bool Abandoned;
+			Vector<ProfileSpan> Spans;
+			UInt64 Dropped;
+			//	The window which Current summarizes,
+			//	Previous summarizes the window before
+			//	that
+			UInt64 Generation;
+			ProfileSummary Current;
+			ProfileSummary Previous;
+			
+			
+			ProfileBuffer (Word thread) noexcept : Thread(thread), Abandoned(false), Dropped(0), Generation(0) {	}
+	
+	
+	};
+	
+	
+	class ProfilerState {
+	
+	
+		public:
+		
+		
+			Mutex Lock;
+			std::unordered_map<String,Word> Labels;
+			Vector<String> Names;
+			Vector<std::shared_ptr<ProfileBuffer>> Buffers;
+			Word NextThread;
+			Timer Clock;
+			
+			
+			ProfilerState () : NextThread(1), Clock(Timer::CreateAndStart()) {
+			
+				for (auto & name : builtin_names) {
+				
+					Labels.emplace(name,Names.Count());
+					Names.Add(name);
+				
+				}
+			
+			}
+	
+	
+	};
+	
+	
+	static ProfilerState & get_state () {
+	
+		static ProfilerState state;
+		
+		return state;
+	
+	}
+	
+	
+	//	Marks the thread's buffer abandoned when
+	//	the thread exits so that it may be discarded
+	//	once nothing in it is needed
+	class LocalBuffer {
+	
+	
+		public:
+		
+		
+			std::shared_ptr<ProfileBuffer> Buffer;
+			
+			
+			~LocalBuffer () noexcept {
+			
+				if (Buffer) Buffer->Lock.Execute([&] () mutable {	Buffer->Abandoned=true;	});
+			
+			}
+	
+	
+	};
+	
+	
+	static thread_local LocalBuffer local;
+	static thread_local Word owner=Profiler::None;
+	
+	
+	static ProfileBuffer & get_buffer () {
+	
+		if (local.Buffer) return *local.Buffer;
+		
+		auto & state=get_state();
+		
+		state.Lock.Execute([&] () mutable {
+		
+			auto buffer=std::make_shared<ProfileBuffer>(state.NextThread++);
+			state.Buffers.Add(buffer);
+			
+			local.Buffer=std::move(buffer);
+		
+		});
+		
+		return *local.Buffer;
+	
+	}
+	
+	
+	static UInt64 get_key (Word label, Word owner) noexcept {
+	
+		return (static_cast<UInt64>(label)<<32)|static_cast<UInt64>(owner);
+	
+	}
+	
+	
+	void Profiler::update () noexcept {
+	
+		active=enabled || capturing;
+	
+	}
+	
+	
+	Word Profiler::GetLabel (const String & name) {
+	
+		auto & state=get_state();
+		
+		return state.Lock.Execute([&] () mutable {
+		
+			auto iter=state.Labels.find(name);
+			if (iter!=state.Labels.end()) return iter->second;
+			
+			Word retr=state.Names.Count();
+			state.Names.Add(name);
+			state.Labels.emplace(name,retr);
+			
+			return retr;
+		
+		});
+	
+	}
+	
+	
+	String Profiler::GetName (Word label) {
+	
+		auto & state=get_state();
+		
+		return state.Lock.Execute([&] () {
+		
+			return (label<state.Names.Count()) ? state.Names[label] : state.Names[None];
+		
+		});
+	
+	}
+	
+	
+	Word Profiler::GetOwner () noexcept {
+	
+		return owner;
+	
+	}
+	
+	
+	Word Profiler::SetOwner (Word owner) noexcept {
+	
+		auto retr=MCPP::owner;
+		MCPP::owner=owner;
+		
+		return retr;
+	
+	}
+	
+	
+	UInt64 Profiler::Now () noexcept {
+	
+		return get_state().Clock.ElapsedNanoseconds();
+	
+	}
+	
+	
+	void Profiler::Record (Word label, Word owner, UInt64 begin, UInt64 end) noexcept {
+	
+		try {
+		
+			auto & buffer=get_buffer();
+			
+			buffer.Lock.Execute([&] () mutable {
+			
+				if (capturing) {
+				
+					if (buffer.Spans.Count()==max_spans) ++buffer.Dropped;
+					else buffer.Spans.Add(ProfileSpan{label,owner,begin,end});
+				
+				}
+				
+				if (enabled) {
+				
+					//	Rotate windows if this span ended
+					//	in a new one
+					UInt64 generation=end/window;
+					if (generation!=buffer.Generation) {
+					
+						if (generation==(buffer.Generation+1)) buffer.Previous=std::move(buffer.Current);
+						else buffer.Previous.clear();
+						buffer.Current.clear();
+						buffer.Generation=generation;
+					
+					}
+					
+					buffer.Current[get_key(label,owner)].Add(end-begin);
+				
+				}
+			
+			});
+		
+		//	Profiling must never interfere with
+		//	what's being profiled
+		} catch (...) {	}
+	
+	}
+	
+	
+	void Profiler::Enable (bool enable) noexcept {
+	
+		enabled=enable;
+		
+		update();
+	
+	}
+	
+	
+	bool Profiler::IsEnabled () noexcept {
+	
+		return enabled;
+	
+	}
+	
+	
+	//	Retrieves all buffers, discarding those
+	//	whose threads have exited and which hold
+	//	nothing which is still needed
+	static Vector<std::shared_ptr<ProfileBuffer>> get_buffers (UInt64 generation) {
+	
+		auto & state=get_state();
+		
+		return state.Lock.Execute([&] () mutable {
+		
+			for (Word i=0;i<state.Buffers.Count();) {
+			
+				auto & buffer=*state.Buffers[i];
+				
+				bool discard=buffer.Lock.Execute([&] () {
+				
+					return	buffer.Abandoned &&
+							(buffer.Spans.Count()==0) &&
+							((buffer.Generation+1)<generation);
+				
+				});
+				
+				if (discard) state.Buffers.Delete(i);
+				else ++i;
+			
+			}
+			
+			return state.Buffers;
+		
+		});
+	
+	}
+	
+	
+	Vector<ProfileEntry> Profiler::GetSlowest (Word count) {
+	
+		UInt64 generation=Now()/window;
+		
+		//	Combine the summaries of each thread
+		ProfileSummary summary;
+		for (auto & buffer : get_buffers(generation)) buffer->Lock.Execute([&] () {
+		
+			//	Only the current window and the one
+			//	before it are reported
+			if (buffer->Generation==generation) {
+			
+				for (auto & pair : buffer->Current) summary[pair.first].Add(pair.second);
+				for (auto & pair : buffer->Previous) summary[pair.first].Add(pair.second);
+			
+			} else if ((buffer->Generation+1)==generation) {
+			
+				for (auto & pair : buffer->Current) summary[pair.first].Add(pair.second);
+			
+			}
+		
+		});
+		
+		Vector<Tuple<UInt64,ProfileStats>> sorted(summary.size());
+		for (auto & pair : summary) sorted.EmplaceBack(pair.first,pair.second);
+		
+		std::sort(
+			sorted.begin(),
+			sorted.end(),
+			[] (const Tuple<UInt64,ProfileStats> & a, const Tuple<UInt64,ProfileStats> & b) {
+			
+				return a.Item<1>().Max>b.Item<1>().Max;
+			
+			}
+		);
+		
+		Vector<ProfileEntry> retr;
+		for (Word i=0;(i<count) && (i<sorted.Count());++i) {
+		
+			auto key=sorted[i].Item<0>();
+			auto & stats=sorted[i].Item<1>();
+			Word owner=static_cast<Word>(key&0xFFFFFFFFULL);
+			
+			retr.Add(
+				ProfileEntry{
+					GetName(static_cast<Word>(key>>32)),
+					(owner==None) ? String() : GetName(owner),
+					stats.Count,
+					stats.Total,
+					stats.Max
+				}
+			);
+		
+		}
+		
+		return retr;
+	
+	}
+	
+	
+	bool Profiler::BeginCapture () {
+	
+		auto & state=get_state();
+		
+		return state.Lock.Execute([&] () mutable {
+		
+			if (capturing) return false;
+			
+			//	Discard anything left over from a
+			//	previous capture
+			for (auto & buffer : state.Buffers) buffer->Lock.Execute([&] () mutable {
+			
+				buffer->Spans.Clear();
+				buffer->Dropped=0;
+			
+			});
+			
+			capturing=true;
+			update();
+			
+			return true;
+		
+		});
+	
+	}
+	
+	
+	//	Writes a number of nanoseconds as a number
+	//	of microseconds, which is the unit of the
+	//	trace event format
+	static void write_microseconds (std::ostream & stream, UInt64 ns) {
+	
+		stream << (ns/1000) << '.' << std::setw(3) << std::setfill('0') << (ns%1000);
+	
+	}
+	
+	
+	ProfileCaptureInfo Profiler::EndCapture (const String & filename) {
+	
+		auto & state=get_state();
+		
+		state.Lock.Execute([&] () mutable {
+		
+			capturing=false;
+			update();
+		
+		});
+		
+		//	Take the spans out of each thread's
+		//	buffer
+		ProfileCaptureInfo retr{0,0};
+		Vector<Tuple<Word,Vector<ProfileSpan>>> spans;
+		for (auto & buffer : get_buffers(Now()/window)) buffer->Lock.Execute([&] () mutable {
+		
+			retr.Spans+=buffer->Spans.Count();
+			retr.Dropped+=buffer->Dropped;
+			
+			spans.EmplaceBack(buffer->Thread,std::move(buffer->Spans));
+			buffer->Spans=Vector<ProfileSpan>();
+			buffer->Dropped=0;
+		
+		});
+		
+		//	Escape each name once rather than once
+		//	per span
+		Vector<std::string> names;
+		for (auto & name : state.Lock.Execute([&] () {	return state.Names;	})) {
+		
+			auto encoded=UTF8().Encode(JSON::Serialize(name));
+			
+			names.Add(
+				std::string(
+					reinterpret_cast<const char *>(encoded.begin()),
+					reinterpret_cast<const char *>(encoded.end())
+				)
+			);
+		
+		}
+		
+		auto c_filename=filename.ToCString();
+		std::ofstream stream(
+			static_cast<char *>(c_filename),
+			std::ios::out|std::ios::trunc|std::ios::binary
+		);
+		if (!stream) throw std::runtime_error(could_not_open);
+		
+		stream << "{\"traceEvents\":[";
+		
+		bool first=true;
+		for (auto & t : spans) for (auto & span : t.Item<1>()) {
+		
+			if (first) first=false;
+			else stream << ',';
+			
+			stream << "\n{\"name\":" << names[span.Label] << ",\"cat\":" << names[span.Owner] << ",\"ph\":\"X\",\"ts\":";
+			write_microseconds(stream,span.Begin);
+			stream << ",\"dur\":";
+			write_microseconds(stream,span.End-span.Begin);
+			stream << ",\"pid\":1,\"tid\":" << t.Item<0>() << '}';
+		
+		}
+		
+		stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+		
+		stream.close();
+		if (!stream) throw std::runtime_error(could_not_write);
+		
+		return retr;
+	
+	}
+
+
+}
@@ -3,6 +3,7 @@
 #include <singleton.hpp>
 #include <cstdlib>
 #include <exception>
+#include <memory>
 
 
 #define stringify_impl(x) #x
@@ -21,9 +22,10 @@ namespace MCPP {
 	static const String couldnt_parse_bind="Startup: Could not parse bind \"{0}\"";
 	static const String connected="{0}:{1} connected, there {3} now {2} client{4} connected";
 	static const String disconnected="{0}:{1} disconnected, there {3} now {2} client{4} connected";
-	static const String disconnected_with_reason="{{0}}:{{1}} disconnected (with reason: \"{0}\"), there {{3}} now {{2}} client{{4}} connected";
+	static const String disconnected_with_reason="{0}:{1} disconnected (with reason: \"{5}\"), there {3} now {2} client{4} connected";
 	static const String error_processing_recv="Error processing received data";
 	static const String buffer_too_long="Buffer too long";
+	static const String accept_limited="{0} is connecting too quickly, refusing its connections for {1}ms";
 	
 	
 	//	Constants
@@ -34,9 +36,23 @@ namespace MCPP {
 	static const String main_thread_desc="Listening Thread";
 	static const Word default_max_bytes=0;	//	Unlimited
 	static const String max_bytes_setting="max_bytes";
+	static const Word default_batch_bytes=0;	//	Disabled
+	static const String batch_bytes_setting="batch_bytes";
 	static const Word default_max_players=0;
 	static const String max_players_setting="max_players";
 	static const String name_template="{0} {1}";
+	static const Word default_log_capacity=4096;
+	static const String log_capacity_setting="log_buffer_size";
+	static const Word default_accept_window=10000;
+	static const String accept_window_setting="accept_window";
+	static const Word default_accept_host_limit=0;	//	Unlimited
+	static const String accept_host_limit_setting="accept_host_limit";
+	static const Word default_accept_range_limit=0;	//	Unlimited
+	static const String accept_range_limit_setting="accept_range_limit";
+	static const Word default_accept_escalate=4;
+	static const String accept_escalate_setting="accept_escalate";
+	static const Word default_accept_escalate_time=300000;
+	static const String accept_escalate_time_setting="accept_escalate_time";
 	
 	
 	const String Server::BuildDate(
@@ -67,18 +83,27 @@ namespace MCPP {
 		data(nullptr),
 		interpreter(nullptr),
 		provider(nullptr),
-		is_shutting_down(false)
+		is_shutting_down(false),
+		logger(
+			[this] (const String & message, Service::LogType type) {	write_log(message,type);	},
+			default_log_capacity
+		)
 	{
 	
 		debug=false;
 		log_all_packets=false;
 		verbose_all=false;
+		async_log=false;
 		
 		OnReceive=[=] (ReceiveEvent event) {
 		
 			try {
 			
-				auto client=Clients[*event.Conn];
+				//	The client is attached to its
+				//	connection, which spares searching
+				//	the client list on every receive
+				auto data=std::static_pointer_cast<SmartPointer<Client>>(event.Conn->GetData());
+				auto client=data ? *data : Clients[*event.Conn];
 				
 				//	Loop while a packet can be
 				//	parsed
@@ -140,6 +165,7 @@ namespace MCPP {
 	
 		Router.Clear();
 		OnAccept.Clear();
+		OnAcceptLimit.Clear();
 		OnConnect.Clear();
 		OnDisconnect.Clear();
 		OnLog.Clear();
@@ -249,6 +275,24 @@ namespace MCPP {
 	
 	void Server::WriteLog (const String & message, Service::LogType type) noexcept {
 	
+		//	Critical messages are written at once,
+		//	they typically precede the process
+		//	terminating
+		if (async_log && (type!=Service::LogType::Critical)) {
+		
+			logger.Enqueue(message,type);
+			
+			return;
+		
+		}
+		
+		write_log(message,type);
+	
+	}
+	
+	
+	void Server::write_log (const String & message, Service::LogType type) noexcept {
+	
 		//	Don't throw errors, eat them
 		try {
 		
@@ -266,6 +310,20 @@ namespace MCPP {
 	}
 	
 	
+	void Server::FlushLog () noexcept {
+	
+		logger.Flush();
+	
+	}
+	
+	
+	LogQueueInfo Server::GetLogInfo () const noexcept {
+	
+		return logger.GetInfo();
+	
+	}
+	
+	
 	void Server::WriteChatLog (const String & from, const Vector<String> & to, const String & message, const Nullable<String> & notes) noexcept {
 	
 		//	Don't throw errors, eat them
@@ -322,6 +380,12 @@ namespace MCPP {
 					
 				} catch (...) {
 				
+					//	Everything logged thus far must
+					//	be written before the data provider
+					//	and event handlers go away
+					async_log=false;
+					logger.Flush();
+				
 					if (data!=nullptr) {
 					
 						delete data;
@@ -333,6 +397,7 @@ namespace MCPP {
 					provider=nullptr;
 					
 					connections.Destroy();
+					limiter.Destroy();
 					pool.Destroy();
 					
 					cleanup_events();
@@ -409,12 +474,22 @@ namespace MCPP {
 		//	Disconnect all connected clients
 		//	and stop the flow of new connections
 		connections.Destroy();
+		limiter.Destroy();
 		
 		//	Now we wait on all pending
 		//	tasks and then kill the
 		//	thread pool
 		pool.Destroy();
 		
+		//	Write out everything which has been
+		//	logged, from here on messages are
+		//	written synchronously, since the
+		//	handlers and data provider they're
+		//	written through are about to be
+		//	destroyed
+		async_log=false;
+		logger.Flush();
+		
 		//	Clear all events et cetera
 		//	that might have module resources
 		//	loaded into them
@@ -660,6 +735,15 @@ namespace MCPP {
 	}
 
 		
+	AcceptLimiter & Server::Limiter () {
+	
+		if (limiter.IsNull()) throw std::out_of_range(NullPointerError);
+		
+		return *limiter;
+	
+	}
+	
+	
 	String Server::GetMessageOfTheDay () {
 
 		if (data==nullptr) return String();
@@ -725,7 +809,11 @@ namespace MCPP {
 			try {
 			
 				//	Create client object
-				auto client=SmartPointer<Client>::Make(std::move(event.Conn));
+				auto client=SmartPointer<Client>::Make(event.Conn);
+				
+				//	Attach the client to its connection
+				//	so receives can find it directly
+				event.Conn->SetData(std::make_shared<SmartPointer<Client>>(client));
 				
 				//	Add to list of connected clients
 				Clients.Add(client);
@@ -745,16 +833,14 @@ namespace MCPP {
 			
 				//	Log
 				auto clients=Clients.Count();
-				WriteLog(
-					String::Format(
-						connected,
-						ip,
-						port,
-						clients,
-						(clients==1) ? "is" : "are",
-						(clients==1) ? "" : "s"
-					),
-					Service::LogType::Information
+				Log(
+					Service::LogType::Information,
+					connected,
+					ip,
+					port,
+					clients,
+					(clients==1) ? "is" : "are",
+					(clients==1) ? "" : "s"
 				);
 			
 			} catch (...) {	}
@@ -764,8 +850,12 @@ namespace MCPP {
 		
 			try {
 			
-				//	Look up the client
-				auto client=Clients[*event.Conn];
+				//	Detach the client from the
+				//	connection, the client refers
+				//	to the connection, and would
+				//	otherwise keep it alive forever
+				auto data=std::static_pointer_cast<SmartPointer<Client>>(event.Conn->TakeData());
+				auto client=data ? std::move(*data) : Clients[*event.Conn];
 				
 				//	Remove the client from the
 				//	list
@@ -784,39 +874,22 @@ namespace MCPP {
 			
 			try {
 				
-				//	Log
-				String disconnect_template;
-				
-				//	If there's no reason, choose
-				//	the template with no reason
-				if (
+				//	Log, choosing the template with no
+				//	reason if there's no reason
+				bool reason=!(
 					event.Reason.IsNull() ||
 					(event.Reason->Size()==0)
-				) {
-				
-					disconnect_template=disconnected;
-				
-				} else {
-				
-					//	Fill the reason into the template
-					disconnect_template=String::Format(
-						disconnected_with_reason,
-						*event.Reason
-					);
-				
-				}
-				
+				);
 				auto clients=Clients.Count();
-				WriteLog(
-					String::Format(
-						disconnect_template,
-						event.Conn->IP(),
-						event.Conn->Port(),
-						clients,
-						(clients==1) ? "is" : "are",
-						(clients==1) ? "" : "s"
-					),
-					Service::LogType::Information
+				Log(
+					Service::LogType::Information,
+					reason ? disconnected_with_reason : disconnected,
+					event.Conn->IP(),
+					event.Conn->Port(),
+					clients,
+					(clients==1) ? "is" : "are",
+					(clients==1) ? "" : "s",
+					reason ? *event.Reason : String()
 				);
 				
 			} catch (...) {	}
@@ -825,6 +898,24 @@ namespace MCPP {
 		ep.Receive=[this] (ReceiveEvent event) mutable {	OnReceive(std::move(event));	};
 		ep.Accept=[this] (AcceptEvent event) mutable {
 		
+			//	Hosts which are connecting too quickly
+			//	are refused before anything else is
+			//	done on their behalf
+			auto limit=limiter->Check(event.RemoteIP);
+			if (!limit.Escalate.IsNull()) {
+			
+				Log(
+					Service::LogType::Warning,
+					accept_limited,
+					*limit.Escalate,
+					limit.Milliseconds
+				);
+				
+				OnAcceptLimit(*limit.Escalate,limit.Milliseconds);
+			
+			}
+			if (!limit.Allow) return false;
+			
 			return OnAccept(
 				event.RemoteIP,
 				event.RemotePort,
@@ -974,9 +1065,22 @@ namespace MCPP {
 		//	Maximum number of bytes to buffer
 		MaximumBytes=data->GetSetting(max_bytes_setting,default_max_bytes);
 		
+		//	Number of bytes to hold for each
+		//	client before sending them
+		BatchBytes=data->GetSetting(batch_bytes_setting,default_batch_bytes);
+		
 		//	Maximum number of players
 		MaximumPlayers=data->GetSetting(max_players_setting,default_max_players);
 
+		//	Rate at which hosts may connect
+		limiter.Construct(
+			data->GetSetting(accept_window_setting,default_accept_window),
+			data->GetSetting(accept_host_limit_setting,default_accept_host_limit),
+			data->GetSetting(accept_range_limit_setting,default_accept_range_limit),
+			data->GetSetting(accept_escalate_setting,default_accept_escalate),
+			data->GetSetting(accept_escalate_time_setting,default_accept_escalate_time)
+		);
+		
 		//	Initialize a thread pool
 		
 		//	Attempt to grab number of threads
@@ -1008,6 +1112,17 @@ namespace MCPP {
 		
 		//	Bind
 		get_binds();
+		
+		//	Hand logging off to the logging
+		//	thread now that event handlers are
+		//	in place
+		logger.SetCapacity(
+			data->GetSetting(
+				log_capacity_setting,
+				default_log_capacity
+			)
+		);
+		async_log=true;
 	
 	}
 	
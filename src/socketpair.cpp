@@ -394,6 +394,13 @@ namespace MCPP {
 		FD_CLR(pair[slave],&set);
 	
 	}
+	
+	
+	ControlSocket::Type ControlSocket::Get () const noexcept {
+	
+		return pair[slave];
+	
+	}
 
 
 }
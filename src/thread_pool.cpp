@@ -1,4 +1,5 @@
 #include <thread_pool.hpp>
+#include <profiler.hpp>
 #include <cstdlib>
 
 
@@ -24,6 +25,9 @@ namespace MCPP {
 	}
 
 
+	ThreadPool::Task::Task () noexcept : Owner(Profiler::GetOwner()) {	}
+	
+	
 	ThreadPool::Task::~Task () noexcept {	}
 	
 	
@@ -190,7 +194,13 @@ namespace MCPP {
 			//	Execute the task
 			Timer timer=Timer::CreateAndStart();
 			++running;
-			if (!(*ptr)()) ++self.Failed;
+			{
+			
+				ProfileScope scope(Profiler::Task,ptr->Owner);
+				
+				if (!(*ptr)()) ++self.Failed;
+			
+			}
 			--running;
 			self.Running+=timer.ElapsedNanoseconds();
 			++self.TaskCount;
@@ -1,6 +1,7 @@
 #include <save/save.hpp>
 #include <time/time.hpp>
 #include <mod.hpp>
+#include <profiler.hpp>
 #include <serializer.hpp>
 #include <server.hpp>
 #include <singleton.hpp>
@@ -13,19 +14,41 @@ using namespace MCPP;
 namespace MCPP {
 
 
-	Time::Callback::Callback (std::function<void (MultiScopeGuard)> callback, bool wait) noexcept : callback(std::move(callback)), wait(wait) {	}
+	Time::Callback::Callback (std::function<void (MultiScopeGuard)> callback, bool wait) noexcept
+		:	callback(std::move(callback)),
+			wait(wait),
+			owner(Profiler::GetOwner())
+	{	}
+	
+	
+	void Time::Callback::invoke (const std::function<void (MultiScopeGuard)> & callback, Word owner, MultiScopeGuard sg) {
+	
+		ProfileScope scope(Profiler::TickCallback,owner);
+		
+		callback(std::move(sg));
+	
+	}
 	
 	
 	void Time::Callback::operator () (const MultiScopeGuard & sg) const {
 	
 		auto & pool=Server::Get().Pool();
 		
+		//	The task is attributed to the module
+		//	which enqueued the callback, not to
+		//	the tick
+		ProfileOwner guard(owner);
+		
 		if (wait) pool.Enqueue(
+			&Callback::invoke,
 			callback,
+			owner,
 			sg
 		);
 		else pool.Enqueue(
+			&Callback::invoke,
 			callback,
+			owner,
 			MultiScopeGuard()
 		);
 	
@@ -77,11 +100,14 @@ namespace MCPP {
 	void Time::tick () {
 	
 		Server::Get().PanicOnThrow([&] () mutable {
+		
+			ProfileScope scope(Profiler::Tick,owner);
 	
 			//	End the previous tick
 			auto elapsed=timer.ElapsedMilliseconds();
 			++ticks;
 			tick_time+=elapsed;
+			last=elapsed;
 			//	Start timing the next tick
 			timer=Timer::CreateAndStart();
 			
@@ -105,9 +131,20 @@ namespace MCPP {
 					auto elapsed=timer.ElapsedMilliseconds();
 					executing+=elapsed;
 					
-					auto & pool=Server::Get().Pool();
+					auto & server=Server::Get();
+					
+					//	Send everything that was held
+					//	during this tick
+					if (server.BatchBytes!=0) for (auto & client : server.Clients) client->Flush();
+					
+					auto & pool=server.Pool();
 					auto lambda=[this] () mutable {	tick();	};
 					
+					//	Whichever task finishes last schedules
+					//	the next tick, don't attribute the tick
+					//	to it
+					ProfileOwner guard(owner);
+					
 					//	If this tick has already taken too long,
 					//	execute the next tick at once
 					if (elapsed>=tick_length) pool.Enqueue(std::move(lambda));
@@ -267,11 +304,12 @@ namespace MCPP {
 	}
 
 
-	Time::Time () noexcept : age(0), time(0) {
+	Time::Time () noexcept : owner(Profiler::None), age(0), time(0) {
 	
 		ticks=0;
 		tick_time=0;
 		executing=0;
+		last=0;
 	
 	}
 	
@@ -293,6 +331,8 @@ namespace MCPP {
 	void Time::Install () {
 	
 		auto & server=Server::Get();
+		
+		owner=Profiler::GetOwner();
 	
 		//	Load settings from the backing
 		//	store
@@ -414,6 +454,8 @@ namespace MCPP {
 		retr.Total=tick_time;
 		retr.Executing=executing;
 		retr.Length=tick_length;
+		retr.Last=last;
+		retr.Threshold=threshold;
 		
 		return retr;
 	
@@ -1,15 +1,23 @@
 #include <world/world.hpp>
+#include <compression.hpp>
+#include <profiler.hpp>
+#include <server.hpp>
+#include <algorithm>
+#include <cstring>
 
 
 namespace MCPP {
 
 
+	static const String flush_name("Send Columns");
+	
+	
 	void World::Add (SmartPointer<Client> client, ColumnID id, bool async) {
 	
 		auto column=get_column(id);
 		
 		try {
-	
+		
 			//	Wait until column is populated, or
 			//	see if column will eventually enter
 			//	desired state
@@ -19,7 +27,7 @@ namespace MCPP {
 					:	column->WaitUntil(ColumnState::Populated)
 			)) process(*column);
 			
-			clients_lock.Execute([&] () {
+			if (!clients_lock.Execute([&] () {
 			
 				auto iter=clients.find(client);
 				
@@ -42,31 +50,78 @@ namespace MCPP {
 					
 					}
 				
-				} else if (iter->second.count(id)!=0) {
+				} else if (!iter->second.insert(id).second) {
 				
 					//	Client already has column, abort
-					return;
+					return false;
 				
-				} else {
+				}
 				
-					iter->second.insert(id);
+				return true;
+			
+			})) {
+			
+				column->EndInterest();
 				
-				}
+				return;
+			
+			}
+			
+			//	The column is sent along with the other
+			//	columns which become ready around the
+			//	same time, the pending send holds its
+			//	own interest in the column
+			column->Interested();
+			
+			//	So long as columns are still being made
+			//	ready for the client, those which are
+			//	ready wait a little for them
+			try {
+			
+				bulk_lock.Execute([&] () mutable {	++bulk_pending[client].Outstanding;	});
+			
+			} catch (...) {
+			
+				column->EndInterest();
 				
-				try {
+				throw;
+			
+			}
+			
+			bool processing;
+			try {
+			
+				processing=column->InvokeWhen(
+					ColumnState::Populated,
+					[this,client,column] () mutable {	enqueue_bulk(std::move(client),column);	}
+				);
+			
+			} catch (...) {
+			
+				column->EndInterest();
 				
-					column->AddPlayer(client);
+				bulk_lock.Execute([&] () mutable {
 				
-				} catch (...) {
+					auto iter=bulk_pending.find(client);
+					
+					if (iter!=bulk_pending.end()) --iter->second.Outstanding;
 				
-					clients.find(client)->second.erase(id);
+				});
+				
+				clients_lock.Execute([&] () {
+				
+					auto iter=clients.find(client);
 					
-					throw;
+					if (iter!=clients.end()) iter->second.erase(id);
 				
-				}
+				});
+				
+				throw;
 			
-			});
+			}
 			
+			if (!processing) process(*column);
+		
 		} catch (...) {
 		
 			column->EndInterest();
@@ -80,6 +135,357 @@ namespace MCPP {
 	}
 	
 	
+	World::BulkPending::BulkPending () noexcept : Bytes(0), Outstanding(0) {	}
+	
+	
+	void World::enqueue_bulk (SmartPointer<Client> client, ColumnContainer * column) {
+	
+		bool immediate=false;
+		bool delayed=false;
+		try {
+		
+			column->Acquire();
+			Word size=column->RawSize();
+			column->Release();
+			
+			bulk_lock.Execute([&] () mutable {
+			
+				auto & pending=bulk_pending[std::move(client)];
+				if (pending.Outstanding!=0) --pending.Outstanding;
+				pending.Columns.Add(column);
+				pending.Bytes+=size;
+				
+				//	Waiting only helps if more columns
+				//	are coming and there's room for them
+				if ((pending.Outstanding==0) || (pending.Bytes>=bulk_max)) {
+				
+					if (bulk_immediate) return;
+					
+					immediate=bulk_immediate=true;
+				
+				} else {
+				
+					if (bulk_scheduled) return;
+					
+					delayed=bulk_scheduled=true;
+				
+				}
+			
+			});
+		
+		} catch (...) {
+		
+			column->EndInterest();
+			
+			throw;
+		
+		}
+		
+		try {
+		
+			auto & pool=Server::Get().Pool();
+			if (immediate) pool.Enqueue([this] () mutable {	flush_bulk(false);	});
+			else if (delayed) pool.Enqueue(
+				bulk_delay,
+				[this] () mutable {	flush_bulk(true);	}
+			);
+		
+		} catch (...) {
+		
+			bulk_lock.Execute([&] () mutable {
+			
+				if (immediate) bulk_immediate=false;
+				if (delayed) bulk_scheduled=false;
+			
+			});
+			
+			throw;
+		
+		}
+	
+	}
+	
+	
+	void World::flush_bulk (bool all) {
+	
+		static const Word flush_label=Profiler::GetLabel(flush_name);
+		ProfileScope scope(flush_label,Profiler::GetOwner());
+		
+		std::unordered_map<SmartPointer<Client>,Vector<ColumnContainer *>> pending;
+		bulk_lock.Execute([&] () mutable {
+		
+			if (all) bulk_scheduled=false;
+			else bulk_immediate=false;
+			
+			for (auto iter=bulk_pending.begin();iter!=bulk_pending.end();) {
+			
+				auto & p=iter->second;
+				
+				if (
+					(p.Columns.Count()!=0) &&
+					(all || (p.Outstanding==0) || (p.Bytes>=bulk_max))
+				) {
+				
+					pending.emplace(iter->first,std::move(p.Columns));
+					p.Columns=Vector<ColumnContainer *>();
+					p.Bytes=0;
+				
+				}
+				
+				if ((p.Columns.Count()==0) && (p.Outstanding==0)) iter=bulk_pending.erase(iter);
+				else ++iter;
+			
+			}
+		
+		});
+		
+		//	The columns in the batch presently being
+		//	built, they have been attached to the
+		//	client, which will receive nothing more
+		//	about them until they're sent
+		Vector<ColumnContainer *> batch;
+		Vector<Byte> raw;
+		Vector<ColumnMetadata> metadata;
+		
+		auto iter=pending.begin();
+		Word i=0;
+		try {
+		
+			for (;iter!=pending.end();++iter) {
+			
+				auto & client=iter->first;
+				auto & columns=iter->second;
+				
+				//	Sends the first columns in the batch,
+				//	which occupy the first bytes of the
+				//	buffer, and then whatever was held
+				//	back from the client in the meantime
+				//
+				//	No column is locked while data is
+				//	compressed and sent
+				auto send=[&] (Word count, Word bytes) {
+				
+					if (count==0) return;
+					
+					if (count==1) {
+					
+						//	A lone column is sent the same way
+						//	it would have been sent without
+						//	batching
+						ColumnContainer::PacketType packet;
+						packet.X=metadata[0].X;
+						packet.Z=metadata[0].Z;
+						packet.Continuous=true;
+						packet.Primary=metadata[0].Primary;
+						packet.Add=metadata[0].Add;
+						packet.Data=Deflate(raw.begin(),raw.begin()+bytes,false,Deflater::FastestLevel);
+						
+						client->Post(packet);
+					
+					} else {
+					
+						Packets::Play::Clientbound::MapChunkBulk packet;
+						packet.Bulk.Skylight=HasSkylight(batch[0]->ID().Dimension);
+						packet.Bulk.Data=Deflate(raw.begin(),raw.begin()+bytes,false,Deflater::FastestLevel);
+						packet.Bulk.Columns=Vector<ColumnMetadata>(count);
+						for (Word n=0;n<count;++n) packet.Bulk.Columns.Add(metadata[n]);
+						
+						client->Post(packet);
+					
+					}
+					
+					for (;count>0;--count) {
+					
+						auto column=batch[0];
+						batch.Delete(0);
+						metadata.Delete(0);
+						
+						try {
+						
+							column->Sent(client);
+						
+						} catch (...) {
+						
+							column->EndInterest();
+							
+							throw;
+						
+						}
+						
+						column->EndInterest();
+					
+					}
+					
+					std::memmove(raw.begin(),raw.begin()+bytes,raw.Count()-bytes);
+					raw.SetCount(raw.Count()-bytes);
+				
+				};
+				
+				//	Columns are sent in ID order, which
+				//	also brings duplicates together
+				std::sort(
+					columns.begin(),
+					columns.end(),
+					[] (const ColumnContainer * a, const ColumnContainer * b) {	return a->ID()<b->ID();	}
+				);
+				
+				for (i=0;i<columns.Count();++i) {
+				
+					auto column=columns[i];
+					auto id=column->ID();
+					
+					//	A client which was removed from and
+					//	then added to a column may have queued
+					//	it twice
+					if ((i!=0) && (columns[i-1]==column)) {
+					
+						column->EndInterest();
+						
+						continue;
+					
+					}
+					
+					//	Each batch is within one dimension
+					if ((batch.Count()!=0) && (batch[0]->ID().Dimension!=id.Dimension)) {
+					
+						try {
+						
+							send(batch.Count(),raw.Count());
+						
+						} catch (...) {
+						
+							column->EndInterest();
+							
+							throw;
+						
+						}
+					
+					}
+					
+					//	The column is only locked while it's
+					//	copied into the buffer and attached
+					Word before=raw.Count();
+					bool attach;
+					column->Acquire();
+					try {
+					
+						//	The client may have been removed
+						//	from this column while it waited
+						attach=clients_lock.Execute([&] () {
+						
+							auto found=clients.find(client);
+							
+							return (found!=clients.end()) && (found->second.count(id)!=0);
+						
+						});
+						
+						if (attach) {
+						
+							auto size=column->RawSize();
+							while ((raw.Capacity()-raw.Count())<size) raw.SetCapacity();
+							
+							ColumnMetadata m;
+							m.X=id.X;
+							m.Z=id.Z;
+							raw.SetCount(
+								before+column->ToRaw(
+									raw.end(),
+									m.Primary,
+									m.Add
+								)
+							);
+							metadata.Add(m);
+							
+							try {
+							
+								batch.Add(column);
+								
+								attach=column->Attach(client);
+							
+							} catch (...) {
+							
+								metadata.Delete(metadata.Count()-1);
+								
+								throw;
+							
+							}
+							
+							if (!attach) {
+							
+								batch.Delete(batch.Count()-1);
+								metadata.Delete(metadata.Count()-1);
+								raw.SetCount(before);
+							
+							}
+						
+						}
+					
+					} catch (...) {
+					
+						column->Release();
+						
+						if (batch.Count()!=metadata.Count()) batch.Delete(batch.Count()-1);
+						raw.SetCount(before);
+						column->EndInterest();
+						
+						throw;
+					
+					}
+					column->Release();
+					
+					if (!attach) {
+					
+						column->EndInterest();
+						
+						continue;
+					
+					}
+					
+					//	If this column took the batch over
+					//	the limit, the columns before it are
+					//	sent without it
+					if ((batch.Count()>1) && (raw.Count()>bulk_max)) send(batch.Count()-1,before);
+				
+				}
+				
+				send(batch.Count(),raw.Count());
+			
+			}
+		
+		} catch (...) {
+		
+			//	Columns already attached are sent
+			//	nothing, but what was held back
+			//	from the client is released
+			for (auto column : batch) {
+			
+				try {
+				
+					column->Sent(iter->first);
+				
+				} catch (...) {	}
+				
+				column->EndInterest();
+			
+			}
+			
+			//	Columns which were never reached must
+			//	still have their interest ended
+			if (iter!=pending.end()) {
+			
+				for (++i;i<iter->second.Count();++i) iter->second[i]->EndInterest();
+				
+				for (++iter;iter!=pending.end();++iter) for (auto column : iter->second) column->EndInterest();
+			
+			}
+			
+			throw;
+		
+		}
+	
+	}
+	
+	
 	void World::Remove (SmartPointer<Client> client, ColumnID id, bool force) {
 	
 		if (clients_lock.Execute([&] () {
@@ -110,7 +516,7 @@ namespace MCPP {
 			}
 			
 			column->EndInterest();
-			
+		
 		}
 	
 	}
@@ -127,9 +533,9 @@ namespace MCPP {
 			if (iter!=clients.end()) {
 			
 				set=std::move(iter->second);
-			
-				clients.erase(iter);
 				
+				clients.erase(iter);
+			
 			}
 		
 		});
@@ -139,12 +545,12 @@ namespace MCPP {
 			auto column=get_column(id);
 			
 			try {
-		
+			
 				column->RemovePlayer(
 					client,
 					force
 				);
-				
+			
 			} catch (...) {
 			
 				column->EndInterest();
@@ -154,7 +560,7 @@ namespace MCPP {
 			}
 			
 			column->EndInterest();
-			
+		
 		}
 	
 	}
@@ -0,0 +1,158 @@
+#include <world/world.hpp>
+#include <compression.hpp>
+#include <cstring>
+
+
+namespace MCPP {
+
+
+	void World::cache (ColumnContainer & column) {
+	
+		auto id=column.ID();
+		
+		//	Changes to a column which has not been
+		//	saved must not be lost, a column which
+		//	is dirty is loaded from the backing store
+		//	next time, and any copy cached from an
+		//	earlier unload is stale
+		if (column.Dirty() || (cache_max==0)) {
+		
+			cache_lock.Execute([&] () mutable {
+			
+				auto iter=cache.find(id);
+				if (iter==cache.end()) return;
+				
+				cache_size-=iter->second.Item<0>().Count();
+				cache_order.erase(iter->second.Item<1>());
+				cache.erase(iter);
+			
+			});
+			
+			return;
+		
+		}
+		
+		auto compressed=Deflate(
+			reinterpret_cast<const Byte *>(column.Get()),
+			reinterpret_cast<const Byte *>(column.Get())+ColumnContainer::Size,
+			false,
+			Deflater::FastestLevel
+		);
+		
+		//	Columns which do not fit in the budget
+		//	are never cached
+		if (compressed.Count()>cache_max) return;
+		
+		cache_lock.Execute([&] () mutable {
+		
+			auto iter=cache.find(id);
+			if (iter==cache.end()) {
+			
+				cache_order.push_front(id);
+				
+				try {
+				
+					iter=cache.emplace(
+						id,
+						Tuple<Vector<Byte>,std::list<ColumnID>::iterator>(
+							std::move(compressed),
+							cache_order.begin()
+						)
+					).first;
+				
+				} catch (...) {
+				
+					cache_order.pop_front();
+					
+					throw;
+				
+				}
+			
+			} else {
+			
+				cache_size-=iter->second.Item<0>().Count();
+				iter->second.Item<0>()=std::move(compressed);
+				
+				//	Most recently used columns are
+				//	at the front
+				cache_order.splice(
+					cache_order.begin(),
+					cache_order,
+					iter->second.Item<1>()
+				);
+			
+			}
+			
+			cache_size+=iter->second.Item<0>().Count();
+			
+			//	Evict the least recently used columns
+			//	until the cache is within budget
+			while (cache_size>cache_max) {
+			
+				auto evict=cache.find(cache_order.back());
+				
+				cache_size-=evict->second.Item<0>().Count();
+				cache.erase(evict);
+				cache_order.pop_back();
+				
+				++cache_evictions;
+			
+			}
+		
+		});
+	
+	}
+	
+	
+	bool World::uncache (ColumnContainer & column) {
+	
+		Vector<Byte> compressed;
+		if (!cache_lock.Execute([&] () mutable {
+		
+			auto iter=cache.find(column.ID());
+			if (iter==cache.end()) return false;
+			
+			//	Once loaded the column may change, so
+			//	the cached copy is discarded
+			compressed=std::move(iter->second.Item<0>());
+			cache_size-=compressed.Count();
+			cache_order.erase(iter->second.Item<1>());
+			cache.erase(iter);
+			
+			return true;
+		
+		})) {
+		
+			++cache_misses;
+			
+			return false;
+		
+		}
+		
+		//	Inflated into this thread's scratch
+		//	slot so that the column is untouched
+		//	if the cached copy is not whole
+		auto scratch=ColumnAllocator::Get().Scratch();
+		if (Inflate(
+			compressed.begin(),
+			compressed.end(),
+			scratch,
+			ColumnContainer::Size
+		)!=ColumnContainer::Size) {
+		
+			++cache_misses;
+			
+			return false;
+		
+		}
+		
+		std::memcpy(column.Get(),scratch,ColumnContainer::Size);
+		
+		++cache_hits;
+		
+		return true;
+	
+	}
+
+
+}
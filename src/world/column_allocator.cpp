@@ -0,0 +1,323 @@
+#include <world/world.hpp>
+#include <new>
+
+
+#ifdef ENVIRONMENT_WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+namespace MCPP {
+
+
+	//	Slots are aligned to cache lines so
+	//	that adjacent columns do not share
+	//	them
+	static const Word slot_alignment=64;
+	//	The size of a huge page on platforms
+	//	where it cannot be queried
+	static const Word default_huge_page_size=2*1024*1024;
+	
+	
+	const Word ColumnAllocator::SlotSize=((sizeof(ColumnContainer)+slot_alignment-1)/slot_alignment)*slot_alignment;
+	const Word ColumnAllocator::SlabSlots=8;
+	
+	
+	static Word round_up (Word num, Word multiple) noexcept {
+	
+		return ((num+multiple-1)/multiple)*multiple;
+	
+	}
+	
+	
+	static Word page_size () noexcept {
+	
+		#ifdef ENVIRONMENT_WINDOWS
+		
+		SYSTEM_INFO sysinfo;
+		GetSystemInfo(&sysinfo);
+		return sysinfo.dwPageSize;
+		
+		#else
+		
+		return sysconf(_SC_PAGESIZE);
+		
+		#endif
+	
+	}
+	
+	
+	static Word huge_page_size () noexcept {
+	
+		#ifdef ENVIRONMENT_WINDOWS
+		
+		Word retr=GetLargePageMinimum();
+		return (retr==0) ? default_huge_page_size : retr;
+		
+		#else
+		
+		return default_huge_page_size;
+		
+		#endif
+	
+	}
+	
+	
+	//	Obtains memory from the operating system,
+	//	returns a null pointer on failure
+	static void * map (Word size, bool huge) noexcept {
+	
+		#ifdef ENVIRONMENT_WINDOWS
+		
+		auto retr=VirtualAlloc(
+			nullptr,
+			size,
+			MEM_RESERVE|MEM_COMMIT|(huge ? MEM_LARGE_PAGES : 0),
+			PAGE_READWRITE
+		);
+		
+		return retr;
+		
+		#else
+		
+		int flags=MAP_PRIVATE|MAP_ANONYMOUS;
+		#ifdef MAP_HUGETLB
+		if (huge) flags|=MAP_HUGETLB;
+		#else
+		if (huge) return nullptr;
+		#endif
+		
+		auto retr=mmap(
+			nullptr,
+			size,
+			PROT_READ|PROT_WRITE,
+			flags,
+			-1,
+			0
+		);
+		
+		return (retr==MAP_FAILED) ? nullptr : retr;
+		
+		#endif
+	
+	}
+	
+	
+	ColumnAllocator & ColumnAllocator::Get () {
+	
+		static ColumnAllocator * allocator=new ColumnAllocator();
+		
+		return *allocator;
+	
+	}
+	
+	
+	ColumnAllocator::ColumnAllocator () noexcept
+		:	huge(HugePages::None),
+			free(nullptr),
+			free_count(0),
+			in_use(0),
+			slabs(0),
+			bytes(0)
+	{	}
+	
+	
+	void ColumnAllocator::grow () {
+	
+		Word size=SlotSize*SlabSlots;
+		void * ptr=nullptr;
+		
+		if (huge==HugePages::Explicit) {
+		
+			Word huge_size=round_up(size,huge_page_size());
+			ptr=map(huge_size,true);
+			if (ptr!=nullptr) size=huge_size;
+		
+		}
+		
+		if (ptr==nullptr) {
+		
+			size=round_up(size,page_size());
+			ptr=map(size,false);
+			if (ptr==nullptr) throw std::bad_alloc();
+			
+			#if !defined(ENVIRONMENT_WINDOWS) && defined(MADV_HUGEPAGE)
+			if (huge!=HugePages::None) madvise(ptr,size,MADV_HUGEPAGE);
+			#endif
+		
+		}
+		
+		++slabs;
+		bytes+=size;
+		
+		//	Rounding up to whole pages leaves room
+		//	at the end of the slab, which is filled
+		//	with as many more slots as fit, rather
+		//	than being wasted (eight slots round up
+		//	to three huge pages, which hold eleven)
+		Word count=size/SlotSize;
+		
+		//	Thread every slot in the slab onto
+		//	the free list
+		auto base=reinterpret_cast<Byte *>(ptr);
+		for (Word i=count;(i--)>0;) {
+		
+			auto slot=reinterpret_cast<FreeSlot *>(base+(i*SlotSize));
+			slot->Next=free;
+			free=slot;
+		
+		}
+		
+		free_count+=count;
+	
+	}
+	
+	
+	void * ColumnAllocator::take () {
+	
+		if (free==nullptr) grow();
+		
+		auto retr=free;
+		free=free->Next;
+		--free_count;
+		
+		return static_cast<void *>(retr);
+	
+	}
+	
+	
+	void ColumnAllocator::give (void * ptr) noexcept {
+	
+		auto slot=reinterpret_cast<FreeSlot *>(ptr);
+		slot->Next=free;
+		free=slot;
+		++free_count;
+	
+	}
+	
+	
+	class ColumnAllocator::ScratchSlot {
+	
+	
+		public:
+		
+		
+			void * Ptr;
+			
+			
+			ScratchSlot () noexcept : Ptr(nullptr) {	}
+			
+			
+			~ScratchSlot () noexcept {
+			
+				if (Ptr==nullptr) return;
+				
+				auto & allocator=ColumnAllocator::Get();
+				allocator.lock.Execute([&] () mutable {	allocator.give(Ptr);	});
+			
+			}
+	
+	
+	};
+	
+	
+	void ColumnAllocator::Configure (HugePages huge, Word count) {
+	
+		lock.Execute([&] () mutable {
+		
+			this->huge=huge;
+			
+			while (free_count<count) grow();
+		
+		});
+	
+	}
+	
+	
+	void * ColumnAllocator::Allocate () {
+	
+		return lock.Execute([&] () mutable {
+		
+			auto retr=take();
+			++in_use;
+			
+			return retr;
+		
+		});
+	
+	}
+	
+	
+	void ColumnAllocator::Free (void * ptr) noexcept {
+	
+		if (ptr==nullptr) return;
+		
+		lock.Execute([&] () mutable {
+		
+			give(ptr);
+			--in_use;
+		
+		});
+	
+	}
+	
+	
+	void * ColumnAllocator::Scratch () {
+	
+		//	Slots are only taken from the free
+		//	list the first time a thread asks
+		static thread_local ScratchSlot slot;
+		
+		if (slot.Ptr==nullptr) slot.Ptr=lock.Execute([&] () mutable {	return take();	});
+		
+		return slot.Ptr;
+	
+	}
+	
+	
+	Word ColumnAllocator::InUse () const noexcept {
+	
+		return lock.Execute([&] () {	return in_use;	});
+	
+	}
+	
+	
+	Word ColumnAllocator::Available () const noexcept {
+	
+		return lock.Execute([&] () {	return free_count;	});
+	
+	}
+	
+	
+	Word ColumnAllocator::Slabs () const noexcept {
+	
+		return lock.Execute([&] () {	return slabs;	});
+	
+	}
+	
+	
+	Word ColumnAllocator::Bytes () const noexcept {
+	
+		return lock.Execute([&] () {	return bytes;	});
+	
+	}
+	
+	
+	void * ColumnContainer::operator new (std::size_t) {
+	
+		return ColumnAllocator::Get().Allocate();
+	
+	}
+	
+	
+	void ColumnContainer::operator delete (void * ptr) noexcept {
+	
+		ColumnAllocator::Get().Free(ptr);
+	
+	}
+
+
+}
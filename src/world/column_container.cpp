@@ -1,14 +1,20 @@
 #include <world/world.hpp>
 #include <cstring>
 #include <limits>
+#include <stdexcept>
 
 
 namespace MCPP {
 
 
 	constexpr Word ColumnContainer::Size;
+	constexpr Word ColumnContainer::LegacySize;
+	constexpr Word ColumnContainer::MaxRawSize;
 
 
+	static const char * owned_by_thread="Column is owned by another handle on this thread";
+	
+	
 	ColumnID ColumnContainer::ID () const noexcept {
 	
 		return id;
@@ -16,10 +22,11 @@ namespace MCPP {
 	}
 
 
-	ColumnContainer::ColumnContainer (ColumnID id) noexcept : Populated(false), id(id), target(ColumnState::Loading), sent(false), dirty(false) {
+	ColumnContainer::ColumnContainer (ColumnID id) noexcept : Populated(false), id(id), target(ColumnState::Loading), sent(false), dirty(false), waiting(0), lighting(false) {
 	
 		curr=static_cast<Word>(ColumnState::Loading);
 		interest=0;
+		lit=false;
 	
 	}
 
@@ -320,6 +327,20 @@ namespace MCPP {
 	}
 	
 	
+	bool ColumnContainer::Lit () const noexcept {
+	
+		return lit;
+	
+	}
+	
+	
+	void ColumnContainer::SetLit () noexcept {
+	
+		lit=true;
+	
+	}
+	
+	
 	void ColumnContainer::Send () {
 	
 		lock.Acquire();
@@ -343,7 +364,7 @@ namespace MCPP {
 			//	Get a packet
 			auto packet=ToChunkData();
 			
-			for (auto & c : clients) const_cast<SmartPointer<Client> &>(c)->Send(packet);
+			for (auto & c : clients) const_cast<SmartPointer<Client> &>(c)->Post(packet);
 		
 		} catch (...) {
 		
@@ -366,12 +387,28 @@ namespace MCPP {
 			//	abort
 			if (!clients.insert(client).second) return;
 			
+			//	If the column is still to be sent to
+			//	the client from when it was last added,
+			//	it's sent as it is at that point instead
+			auto iter=unsent.find(client);
+			if (iter!=unsent.end()) {
+			
+				auto & u=iter->second;
+				u.Changes.Clear();
+				u.Removed=false;
+				u.Unload=false;
+				u.Resend=true;
+				
+				return;
+			
+			}
+			
 			//	Send if necessary
 			if (sent) {
 			
 				try {
 				
-					client->Send(ToChunkData());
+					client->Post(ToChunkData());
 				
 				} catch (...) {
 				
@@ -402,11 +439,24 @@ namespace MCPP {
 			//		to clients.
 			//	C.	This isn't a forceful
 			//		removal.
-			if (
-				(clients.erase(client)!=0) &&
-				!force &&
-				sent
-			) client->Send(GetUnload());
+			if (clients.erase(client)==0) return;
+			
+			//	If the column is yet to be sent to the
+			//	client the unload must follow it
+			auto iter=unsent.find(client);
+			if (iter!=unsent.end()) {
+			
+				auto & u=iter->second;
+				u.Changes.Clear();
+				u.Removed=true;
+				u.Unload=!force && sent;
+				u.Resend=false;
+				
+				return;
+			
+			}
+			
+			if (!force && sent) client->Post(GetUnload());
 		
 		});
 	
@@ -448,6 +498,22 @@ namespace MCPP {
 	}
 	
 	
+	static bool is_extended (UInt16 type) noexcept {
+	
+		return type>std::numeric_limits<Byte>::max();
+	
+	}
+	
+	
+	Byte ColumnContainer::get_height (Word shaft, Byte y) const noexcept {
+	
+		for (;y!=0;--y) if (Blocks[shaft+(static_cast<Word>(y)*16*16)].GetType()!=0) break;
+		
+		return y;
+	
+	}
+	
+	
 	static Byte get_add (const Block & b) noexcept {
 	
 		auto type=b.GetType();
@@ -457,53 +523,20 @@ namespace MCPP {
 	}
 
 
-	ColumnContainer::PacketType ColumnContainer::ToChunkData () const {
+	Word ColumnContainer::ToRaw (Byte * column, UInt16 & primary, UInt16 & extended) const noexcept {
 		
-		//	This gives all chunks from
-		//	bottom-to-top which are not
-		//	all air
+		//	Determine from the maintained
+		//	counts
+		//
+		//	A.	Which chunks we need to send,
+		//		i.e. are not all air.
+		//	B.	Which of A need the add array.
 		bool chunks [16];
-		std::memset(chunks,0,sizeof(chunks));
-		//	This gives all chunks from
-		//	bottom-to-top which require the
-		//	"add" array
 		bool add [16];
-		std::memset(add,0,sizeof(add));
+		for (Word i=0;i<16;++i) {
 		
-		//	Scan all blocks to determine
-		//
-		//	A.	Which chunks we need to send.
-		//	B.	Which of A need the add array.
-		Word chunk=0;
-		Word next_chunk=16*16*16;
-		for (Word i=0;i<(16*16*16*16);++i) {
-		
-			//	Maintain record of which
-			//	chunk we're in
-			if (i==next_chunk) {
-			
-				next_chunk+=16*16*16;
-				++chunk;
-			
-			}
-			
-			//	Type of this block
-			auto type=Blocks[i].GetType();
-			
-			//	Are we sending this chunk?
-			if (type!=0) {
-			
-				//	YES
-				
-				chunks[chunk]=true;
-				
-				//	Is the block type too large
-				//	for one byte?  I.e. do we have
-				//	to send the add array for this
-				//	chunk?
-				if (type>std::numeric_limits<Byte>::max()) add[chunk]=true;
-			
-			}
+			chunks[i]=Occupancy[i]!=0;
+			add[i]=Extended[i]!=0;
 		
 		}
 		
@@ -544,17 +577,12 @@ namespace MCPP {
 		
 		}
 		
-		//	Create a buffer on the stack big
-		//	enough to hold the largest possible
-		//	packet in Mojang format
-		Byte column [(16*16*16*16*3)+(16*16)];
-		
 		//	Loop and convert
 		Word offset=0;
 		Word nibble_offset=spacing;
 		spacing/=2;
-		chunk=0;
-		next_chunk=16*16*16;
+		Word chunk=0;
+		Word next_chunk=16*16*16;
 		bool even=true;
 		for (Word i=0;i<(16*16*16*16);++i) {
 		
@@ -624,16 +652,51 @@ namespace MCPP {
 			sizeof(Biomes)
 		);
 		
+		primary=primary_mask;
+		extended=add_mask;
+		
+		return add_offset+sizeof(Biomes);
+	
+	}
+	
+	
+	Word ColumnContainer::RawSize () const noexcept {
+	
+		bool skylight=HasSkylight(id.Dimension);
+		
+		Word retr=sizeof(Biomes);
+		for (Word i=0;i<16;++i) if (Occupancy[i]!=0) {
+		
+			//	Block types, metadata, and light
+			retr+=(16*16*16)*2;
+			if (skylight) retr+=(16*16*16)/2;
+			if (Extended[i]!=0) retr+=(16*16*16)/2;
+		
+		}
+		
+		return retr;
+	
+	}
+	
+	
+	ColumnContainer::PacketType ColumnContainer::ToChunkData () const {
+	
+		//	Create a buffer on the stack big
+		//	enough to hold the largest possible
+		//	packet in Mojang format
+		Byte column [MaxRawSize];
+		
 		//	Prepare a packet
 		PacketType retr;
 		retr.X=id.X;
 		retr.Z=id.Z;
 		retr.Continuous=true;
-		retr.Primary=primary_mask;
-		retr.Add=add_mask;
+		auto size=ToRaw(column,retr.Primary,retr.Add);
 		retr.Data=Deflate(
 			column,
-			column+add_offset+sizeof(Biomes)
+			column+size,
+			false,
+			Deflater::FastestLevel
 		);
 		
 		return retr;
@@ -641,7 +704,142 @@ namespace MCPP {
 	}
 	
 	
-	void ColumnContainer::SetBlock (BlockID id, Block block) {
+	ColumnContainer::Unsent::Unsent () noexcept : Removed(false), Unload(false), Resend(false) {	}
+	
+	
+	bool ColumnContainer::Attach (SmartPointer<Client> client) {
+	
+		if (!clients.insert(client).second) return false;
+		
+		try {
+		
+			unsent.emplace(client,Unsent());
+		
+		} catch (...) {
+		
+			clients.erase(client);
+			
+			throw;
+		
+		}
+		
+		return true;
+	
+	}
+	
+	
+	void ColumnContainer::Resend () {
+	
+		Byte column [MaxRawSize];
+		PacketType packet;
+		packet.X=id.X;
+		packet.Z=id.Z;
+		packet.Continuous=true;
+		Word size=0;
+		
+		//	Serialize while locked, but compress
+		//	without the lock, holding back changes
+		//	made meanwhile as for a bulk send
+		Vector<SmartPointer<Client>> targets;
+		lock.Execute([&] () mutable {
+		
+			if (!sent) return;
+			
+			for (auto & client : clients) {
+			
+				//	Clients the column is still on its
+				//	way to are sent it again once it
+				//	arrives
+				auto iter=unsent.find(client);
+				if (iter!=unsent.end()) {
+				
+					iter->second.Changes.Clear();
+					iter->second.Resend=true;
+					
+					continue;
+				
+				}
+				
+				targets.Add(client);
+			
+			}
+			
+			if (targets.Count()==0) return;
+			
+			try {
+			
+				for (auto & client : targets) unsent.emplace(client,Unsent());
+			
+			} catch (...) {
+			
+				for (auto & client : targets) unsent.erase(client);
+				
+				throw;
+			
+			}
+			
+			size=ToRaw(column,packet.Primary,packet.Add);
+		
+		});
+		
+		Word i=0;
+		try {
+		
+			if (targets.Count()!=0) packet.Data=Deflate(
+				column,
+				column+size,
+				false,
+				Deflater::FastestLevel
+			);
+			
+			for (;i<targets.Count();++i) {
+			
+				targets[i]->Post(packet);
+				
+				Sent(targets[i]);
+			
+			}
+		
+		} catch (...) {
+		
+			//	Don't hold back changes
+			//	forever
+			for (;i<targets.Count();++i) Sent(targets[i]);
+			
+			throw;
+		
+		}
+	
+	}
+	
+	
+	void ColumnContainer::Sent (SmartPointer<Client> client) {
+	
+		lock.Execute([&] () mutable {
+		
+			auto iter=unsent.find(client);
+			if (iter==unsent.end()) return;
+			
+			auto u=std::move(iter->second);
+			unsent.erase(iter);
+			
+			if (u.Resend) client->Post(ToChunkData());
+			else if (u.Removed) {
+			
+				if (u.Unload) client->Post(GetUnload());
+			
+			} else {
+			
+				for (auto & packet : u.Changes) client->Post(packet);
+			
+			}
+		
+		});
+	
+	}
+	
+	
+	void ColumnContainer::SetBlock (BlockID id, Block block, bool owned) {
 	
 		//	Get offset within this column
 		auto offset=id.GetOffset();
@@ -654,23 +852,139 @@ namespace MCPP {
 		packet.Type=block.GetType();
 		packet.Metadata=block.GetMetadata();
 		
-		lock.Execute([&] () {
+		auto thread=Thread::ID();
+		
+		lock.Execute([&] () mutable {
 		
+			//	Unless the caller owns the column, wait
+			//	for whichever transaction owns it to
+			//	finish with it.  Writes made from the
+			//	owning thread -- from within events
+			//	fired by the transaction's writes --
+			//	proceed, waiting for ourselves would
+			//	never end
+			if (!owned) while (!(owner.IsNull() || (*owner==thread))) {
+			
+				++waiting;
+				wait.Sleep(lock);
+				--waiting;
+			
+			}
+		
+			auto & old=Blocks[offset];
+			
+			//	Light is maintained by the world,
+			//	the replaced block's light remains
+			//	until it's relit
+			block.SetLight(old.GetLight()).SetSkylight(old.GetSkylight());
+			
+			//	Maintain counts and heights
+			auto section=offset/(16*16*16);
+			auto shaft=offset%(16*16);
+			auto from=old.GetType();
+			auto to=block.GetType();
+			if ((from==0)!=(to==0)) {
+			
+				if (to==0) --Occupancy[section];
+				else ++Occupancy[section];
+			
+			}
+			if (is_extended(from)!=is_extended(to)) {
+			
+				if (is_extended(to)) ++Extended[section];
+				else --Extended[section];
+			
+			}
+			
 			//	Assign block
-			Blocks[offset]=block;
+			old=block;
+			
+			if ((to!=0) && (id.Y>Heightmap[shaft])) Heightmap[shaft]=id.Y;
+			else if ((to==0) && (id.Y==Heightmap[shaft])) Heightmap[shaft]=get_height(shaft,id.Y);
 			
 			//	Now dirty
 			dirty=true;
 			
 			//	If we've sent this column to players,
-			//	send a packet
-			if (sent) for (auto & client : clients) const_cast<SmartPointer<Client> &>(client)->Send(packet);
+			//	send a packet, unless the column is
+			//	still on its way to them
+			if (sent) for (auto & client : clients) {
+			
+				if (unsent.size()!=0) {
+				
+					auto iter=unsent.find(client);
+					if (iter!=unsent.end()) {
+					
+						iter->second.Changes.Add(packet);
+						
+						continue;
+					
+					}
+				
+				}
+				
+				const_cast<SmartPointer<Client> &>(client)->Post(packet);
+			
+			}
 		
 		});
 	
 	}
 	
 	
+	Byte ColumnContainer::GetHeight (Int32 x, Int32 z) const noexcept {
+	
+		//	Use a block ID to find the offset of
+		//	the bottom of the shaft
+		auto shaft=BlockID{x,0,z,id.Dimension}.GetOffset();
+		
+		return lock.Execute([&] () {	return Heightmap[shaft];	});
+	
+	}
+	
+	
+	void ColumnContainer::Recalculate () noexcept {
+	
+		std::memset(Occupancy,0,sizeof(Occupancy));
+		std::memset(Extended,0,sizeof(Extended));
+		std::memset(Heightmap,0,sizeof(Heightmap));
+		
+		for (Word i=0;i<(16*16*16*16);++i) {
+		
+			auto type=Blocks[i].GetType();
+			if (type==0) continue;
+			
+			++Occupancy[i/(16*16*16)];
+			if (is_extended(type)) ++Extended[i/(16*16*16)];
+			
+			//	Blocks are scanned from bottom
+			//	to top, so the last non-air block
+			//	in each shaft is the highest
+			Heightmap[i%(16*16)]=static_cast<Byte>(i/(16*16));
+		
+		}
+	
+	}
+	
+	
+	void ColumnContainer::LoadLegacy (const void * ptr) noexcept {
+	
+		auto data=reinterpret_cast<const Byte *>(ptr);
+		
+		//	Legacy columns may be loaded in place,
+		//	blocks and biomes are where they were
+		//	then, and the rest is recalculated
+		std::memmove(Blocks,data,sizeof(Blocks));
+		data+=sizeof(Blocks);
+		std::memmove(Biomes,data,sizeof(Biomes));
+		data+=sizeof(Biomes);
+		std::memcpy(&Populated,data,sizeof(Populated));
+		
+		Recalculate();
+	
+	}
+	
+	
 	Block ColumnContainer::GetBlock (BlockID id) const noexcept {
 	
 		//	Get offset within this column
@@ -682,6 +996,110 @@ namespace MCPP {
 	}
 	
 	
+	bool ColumnContainer::AcquireWrite (bool block) {
+	
+		auto thread=Thread::ID();
+	
+		lock.Acquire();
+		
+		//	Wait for the current owner (if
+		//	any) to relinquish the column,
+		//	if we're permitted to
+		while (!owner.IsNull()) {
+		
+			//	Another handle on this thread owns
+			//	the column, it cannot relinquish it
+			//	while we wait
+			if (*owner==thread) {
+			
+				lock.Release();
+				
+				throw std::logic_error(owned_by_thread);
+			
+			}
+		
+			if (!block) {
+			
+				lock.Release();
+				
+				return false;
+			
+			}
+			
+			++waiting;
+			wait.Sleep(lock);
+			--waiting;
+		
+		}
+		
+		owner.Construct(thread);
+		
+		lock.Release();
+		
+		return true;
+	
+	}
+	
+	
+	void ColumnContainer::ReleaseWrite () noexcept {
+	
+		lock.Acquire();
+		
+		owner.Destroy();
+		
+		//	Threads waiting on state changes
+		//	share the condition variable, so
+		//	only wake it if someone is waiting
+		//	for ownership
+		if (waiting!=0) wait.WakeAll();
+		
+		lock.Release();
+	
+	}
+	
+	
+	bool ColumnContainer::AcquireLight (bool block) noexcept {
+	
+		lock.Acquire();
+		
+		while (lighting) {
+		
+			if (!block) {
+			
+				lock.Release();
+				
+				return false;
+			
+			}
+		
+			++waiting;
+			wait.Sleep(lock);
+			--waiting;
+		
+		}
+		
+		lighting=true;
+		
+		lock.Release();
+		
+		return true;
+	
+	}
+	
+	
+	void ColumnContainer::ReleaseLight () noexcept {
+	
+		lock.Acquire();
+		
+		lighting=false;
+		
+		if (waiting!=0) wait.WakeAll();
+		
+		lock.Release();
+	
+	}
+	
+	
 	void ColumnContainer::Acquire () const noexcept {
 	
 		lock.Acquire();
@@ -53,6 +53,17 @@ namespace MCPP {
 	}
 	
 	
+	bool ColumnID::operator < (const ColumnID & other) const noexcept {
+	
+		if (Dimension!=other.Dimension) return Dimension<other.Dimension;
+		
+		if (X!=other.X) return X<other.X;
+		
+		return Z<other.Z;
+	
+	}
+	
+	
 	bool ColumnID::DoesContain (const BlockID & block) const noexcept {
 	
 		return block.IsContainedBy(*this);
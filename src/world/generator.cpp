@@ -7,6 +7,12 @@ namespace MCPP {
 	void World::generate (ColumnContainer & column) {
 	
 		get_generator(column.ID().Dimension)(column);
+		
+		//	Generators write blocks directly, a
+		//	single pass afterwards is cheaper than
+		//	maintaining counts and heights as each
+		//	block is written
+		column.Recalculate();
 	
 	}
 
@@ -7,6 +7,16 @@ namespace MCPP {
 	WorldInfo World::GetInfo () const noexcept {
 	
 		Word num=lock.Execute([&] () {	return world.size();	});
+		auto & allocator=ColumnAllocator::Get();
+		Word queued=light_lock.Execute([&] () {	return light_count;	});
+		Word cached;
+		Word cached_size=cache_lock.Execute([&] () {
+		
+			cached=cache.size();
+			
+			return cache_size;
+		
+		});
 		
 		return WorldInfo{
 			Word(maintenances),
@@ -20,12 +30,21 @@ namespace MCPP {
 			UInt64(generate_time),
 			Word(populated),
 			UInt64(populate_time),
+			Word(lit),
+			Word(relit),
+			UInt64(light_time),
+			queued,
+			Word(cache_hits),
+			Word(cache_misses),
+			Word(cache_evictions),
+			cached,
+			cached_size,
+			cache_max,
 			num,
-			num*(
-				sizeof(ColumnContainer::Blocks)+
-				sizeof(ColumnContainer::Biomes)+
-				sizeof(ColumnContainer::Populated)
-			)
+			num*ColumnContainer::Size,
+			allocator.Available(),
+			allocator.Slabs(),
+			allocator.Bytes()
 		};
 	
 	}
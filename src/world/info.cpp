@@ -29,6 +29,22 @@ static const String populate_time_label("Populating Time: ");
 static const String populate_time_avg_label("Populating Time (Average): ");
 
 
+static const String light_label("Lights: ");
+static const String relight_label("Section Relights: ");
+static const String light_time_label("Lighting Time: ");
+static const String light_queue_label("Relight Queue: ");
+
+
+static const String cache_hit_label("Cache Hits: ");
+static const String cache_miss_label("Cache Misses: ");
+static const String cache_hit_rate_label("Cache Hit Rate: ");
+static const String cache_eviction_label("Cache Evictions: ");
+static const String cache_count_label("Cached Columns: ");
+static const String cache_memory_label("Cache Memory Use: ");
+static const String cache_memory_template("{0} of {1}");
+static const String percent_template("{0}%");
+
+
 static const String save_label("Saves: ");
 static const String save_time_label("Saving Time: ");
 static const String save_time_avg_label("Saving Time (Average): ");
@@ -44,6 +60,9 @@ static const String maintenance_time_avg_label("Maintenance Cycle Time (Average)
 
 static const String count_label("Loaded Columns: ");
 static const String memory_label("Memory Use: ");
+static const String free_label("Free Column Slots: ");
+static const String slabs_label("Column Slabs: ");
+static const String storage_label("Column Storage: ");
 
 
 static inline UInt64 avg (UInt64 t, Word n) noexcept {
@@ -221,6 +240,70 @@ class WorldInfoProvider : public Module, public InformationProvider {
 						))
 					<<	Newline
 					
+					//	Lit/Relit/Lighting
+					<<	ChatStyle::Bold
+					<<	light_label
+					<<	ChatFormat::Pop
+					<<	info.Lit
+					<<	Newline
+					<<	ChatStyle::Bold
+					<<	relight_label
+					<<	ChatFormat::Pop
+					<<	info.Relit
+					<<	Newline
+					<<	ChatStyle::Bold
+					<<	light_time_label
+					<<	ChatFormat::Pop
+					<<	ns(info.Lighting)
+					<<	Newline
+					<<	ChatStyle::Bold
+					<<	light_queue_label
+					<<	ChatFormat::Pop
+					<<	info.LightQueue
+					<<	Newline
+					
+					//	Cache
+					<<	ChatStyle::Bold
+					<<	cache_hit_label
+					<<	ChatFormat::Pop
+					<<	info.CacheHits
+					<<	Newline
+					<<	ChatStyle::Bold
+					<<	cache_miss_label
+					<<	ChatFormat::Pop
+					<<	info.CacheMisses
+					<<	Newline
+					<<	ChatStyle::Bold
+					<<	cache_hit_rate_label
+					<<	ChatFormat::Pop
+					<<	String::Format(
+							percent_template,
+							avg(
+								UInt64(info.CacheHits)*100,
+								info.CacheHits+info.CacheMisses
+							)
+						)
+					<<	Newline
+					<<	ChatStyle::Bold
+					<<	cache_eviction_label
+					<<	ChatFormat::Pop
+					<<	info.CacheEvictions
+					<<	Newline
+					<<	ChatStyle::Bold
+					<<	cache_count_label
+					<<	ChatFormat::Pop
+					<<	info.CacheCount
+					<<	Newline
+					<<	ChatStyle::Bold
+					<<	cache_memory_label
+					<<	ChatFormat::Pop
+					<<	String::Format(
+							cache_memory_template,
+							memory_format(info.CacheSize),
+							memory_format(info.CacheMax)
+						)
+					<<	Newline
+					
 					//	Saved/Saving
 					<<	ChatStyle::Bold
 					<<	save_label
@@ -279,7 +362,24 @@ class WorldInfoProvider : public Module, public InformationProvider {
 					<<	ChatStyle::Bold
 					<<	memory_label
 					<<	ChatFormat::Pop
-					<<	memory_format(info.Size);
+					<<	memory_format(info.Size)
+					<<	Newline
+					
+					//	Column storage
+					<<	ChatStyle::Bold
+					<<	free_label
+					<<	ChatFormat::Pop
+					<<	info.Free
+					<<	Newline
+					<<	ChatStyle::Bold
+					<<	slabs_label
+					<<	ChatFormat::Pop
+					<<	info.Slabs
+					<<	Newline
+					<<	ChatStyle::Bold
+					<<	storage_label
+					<<	ChatFormat::Pop
+					<<	memory_format(info.Storage);
 					
 		}
 
@@ -47,6 +47,26 @@ namespace MCPP {
 		});
 	
 	}
+	
+	
+	Nullable<Byte> World::GetHeight (Int32 x, Int32 z, SByte dimension) {
+	
+		Nullable<Byte> retr;
+		
+		BlockID id{x,0,z,dimension};
+		
+		auto column=get_column(id.GetContaining(),false);
+		if (column==nullptr) return retr;
+		
+		//	Heights aren't final until the column
+		//	has been populated
+		if (column->GetState()==ColumnState::Populated) retr.Construct(column->GetHeight(x,z));
+		
+		column->EndInterest();
+		
+		return retr;
+	
+	}
 
 
 }
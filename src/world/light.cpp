@@ -0,0 +1,1099 @@
+#include <world/world.hpp>
+#include <profiler.hpp>
+#include <server.hpp>
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+
+
+namespace MCPP {
+
+
+	static const String relight_name("Relight Sections");
+	//	Light may travel at most this many
+	//	blocks, so propagating light from a
+	//	column never needs to look further
+	//	than the columns surrounding it
+	static const Byte max_light=15;
+	//	Each offset is a direction a block's
+	//	light may spread, down is first
+	static const Int32 directions [][3]={
+		{0,-1,0},
+		{0,1,0},
+		{-1,0,0},
+		{1,0,0},
+		{0,0,-1},
+		{0,0,1}
+	};
+	//	The width (and depth) of the region
+	//	of blocks light is propagated within
+	static const Int32 region_width=16*3;
+	static const Int32 region_height=16*16;
+	
+	
+	//	How much each block type attenuates
+	//	light passing through it, and how
+	//	much light it emits
+	//
+	//	Block types which are not listed,
+	//	including those this server does not
+	//	know, are transparent and emit no
+	//	light
+	class LightTables {
+	
+	
+		public:
+		
+		
+			Byte Opacity [256];
+			Byte Emission [256];
+			
+			
+			LightTables () noexcept {
+			
+				memset(Opacity,0,sizeof(Opacity));
+				memset(Emission,0,sizeof(Emission));
+				
+				//	Opaque
+				for (Byte type : {
+					1,		//	Stone
+					2,		//	Grass
+					3,		//	Dirt
+					4,		//	Cobblestone
+					5,		//	Planks
+					7,		//	Bedrock
+					12,		//	Sand
+					13,		//	Gravel
+					14,		//	Gold ore
+					15,		//	Iron ore
+					16,		//	Coal ore
+					17,		//	Log
+					19,		//	Sponge
+					21,		//	Lapis lazuli ore
+					22,		//	Lapis lazuli block
+					23,		//	Dispenser
+					24,		//	Sandstone
+					25,		//	Note block
+					35,		//	Wool
+					41,		//	Gold block
+					42,		//	Iron block
+					43,		//	Double slab
+					44,		//	Slab
+					45,		//	Bricks
+					46,		//	TNT
+					47,		//	Bookshelf
+					48,		//	Moss stone
+					49,		//	Obsidian
+					53,		//	Oak stairs
+					56,		//	Diamond ore
+					57,		//	Diamond block
+					58,		//	Crafting table
+					60,		//	Farmland
+					61,		//	Furnace
+					62,		//	Lit furnace
+					67,		//	Cobblestone stairs
+					73,		//	Redstone ore
+					74,		//	Lit redstone ore
+					80,		//	Snow block
+					82,		//	Clay
+					84,		//	Jukebox
+					86,		//	Pumpkin
+					87,		//	Netherrack
+					88,		//	Soul sand
+					89,		//	Glowstone
+					91,		//	Jack o'lantern
+					97,		//	Monster egg
+					98,		//	Stone bricks
+					99,		//	Brown mushroom block
+					100,	//	Red mushroom block
+					103,	//	Melon
+					108,	//	Brick stairs
+					109,	//	Stone brick stairs
+					110,	//	Mycelium
+					112,	//	Nether brick
+					114,	//	Nether brick stairs
+					121,	//	End stone
+					123,	//	Redstone lamp (off)
+					124,	//	Redstone lamp (on)
+					125,	//	Double wooden slab
+					126,	//	Wooden slab
+					128,	//	Sandstone stairs
+					129,	//	Emerald ore
+					133,	//	Emerald block
+					134,	//	Spruce stairs
+					135,	//	Birch stairs
+					136,	//	Jungle stairs
+					137,	//	Command block
+					152,	//	Redstone block
+					153,	//	Quartz ore
+					155,	//	Quartz block
+					156,	//	Quartz stairs
+					158,	//	Dropper
+					159,	//	Stained clay
+					162,	//	Log
+					163,	//	Acacia stairs
+					164,	//	Dark oak stairs
+					170,	//	Hay bale
+					172,	//	Hardened clay
+					173,	//	Coal block
+					174		//	Packed ice
+				}) Opacity[type]=max_light;
+				
+				//	Translucent
+				Opacity[18]=1;	//	Leaves
+				Opacity[30]=1;	//	Cobweb
+				Opacity[161]=1;	//	Leaves
+				Opacity[8]=3;	//	Flowing water
+				Opacity[9]=3;	//	Water
+				Opacity[79]=3;	//	Ice
+				
+				//	Light sources
+				Emission[10]=15;	//	Flowing lava
+				Emission[11]=15;	//	Lava
+				Emission[39]=1;		//	Brown mushroom
+				Emission[50]=14;	//	Torch
+				Emission[51]=15;	//	Fire
+				Emission[62]=13;	//	Lit furnace
+				Emission[74]=9;		//	Lit redstone ore
+				Emission[76]=7;		//	Redstone torch (on)
+				Emission[89]=15;	//	Glowstone
+				Emission[90]=11;	//	Portal
+				Emission[91]=15;	//	Jack o'lantern
+				Emission[94]=9;		//	Repeater (on)
+				Emission[117]=1;	//	Brewing stand
+				Emission[119]=15;	//	End portal
+				Emission[120]=1;	//	End portal frame
+				Emission[122]=1;	//	Dragon egg
+				Emission[124]=15;	//	Redstone lamp (on)
+				Emission[130]=7;	//	Ender chest
+				Emission[138]=15;	//	Beacon
+				Emission[150]=9;	//	Comparator (on)
+			
+			}
+	
+	
+	};
+	
+	
+	static const LightTables tables;
+	
+	
+	static inline Byte get_opacity (Block block) noexcept {
+	
+		auto type=block.GetType();
+		
+		return (type<256) ? tables.Opacity[type] : 0;
+	
+	}
+	
+	
+	static inline Byte get_emission (Block block) noexcept {
+	
+		auto type=block.GetType();
+		
+		return (type<256) ? tables.Emission[type] : 0;
+	
+	}
+	
+	
+	//	Determines how much light passes from
+	//	one block into a neighbouring block with
+	//	a given opacity
+	//
+	//	Full skylight passes straight down through
+	//	transparent blocks without diminishing
+	static inline Byte attenuate (Byte level, Byte opacity, bool sky, bool down) noexcept {
+	
+		if (sky && down && (level==max_light) && (opacity==0)) return max_light;
+		
+		Byte loss=(opacity==0) ? 1 : opacity;
+		
+		return (loss>=level) ? 0 : (level-loss);
+	
+	}
+	
+	
+	//	Positions within a region are packed
+	//	into the low 20 bits of a 32-bit integer,
+	//	leaving the high bits free to carry a
+	//	light level
+	static const Word region_size=1<<20;
+	//	Regions are copied in and out in cells
+	//	of a section of one column each
+	static const Word cell_size=16*16*16;
+	static const Word region_cells=9*16;
+	
+	
+	static inline UInt32 pack (Int32 x, Int32 y, Int32 z) noexcept {
+	
+		return static_cast<UInt32>(x)|(static_cast<UInt32>(z)<<6)|(static_cast<UInt32>(y)<<12);
+	
+	}
+	
+	
+	//	Converts an offset within a column to
+	//	a position within the region, given the
+	//	index of the column within the region
+	static inline UInt32 to_region (Word offset, Word column=4) noexcept {
+	
+		return pack(
+			static_cast<Int32>(offset%16)+static_cast<Int32>((column%3)*16),
+			static_cast<Int32>(offset/(16*16)),
+			static_cast<Int32>((offset/16)%16)+static_cast<Int32>((column/3)*16)
+		);
+	
+	}
+	
+	
+	static inline Int32 get_x (UInt32 pos) noexcept {
+	
+		return static_cast<Int32>(pos&63);
+	
+	}
+	
+	
+	static inline Int32 get_z (UInt32 pos) noexcept {
+	
+		return static_cast<Int32>((pos>>6)&63);
+	
+	}
+	
+	
+	static inline Int32 get_y (UInt32 pos) noexcept {
+	
+		return static_cast<Int32>((pos>>12)&255);
+	
+	}
+	
+	
+	static inline Byte get_level (UInt32 entry) noexcept {
+	
+		return static_cast<Byte>(entry>>20);
+	
+	}
+	
+	
+	//	Determines which cell of a region a
+	//	position is within.  The cell's column
+	//	is the quotient of dividing by 16, its
+	//	section the remainder
+	static inline Word get_cell (UInt32 pos) noexcept {
+	
+		return (static_cast<Word>(((get_z(pos)/16)*3)+(get_x(pos)/16))*16)+static_cast<Word>(get_y(pos)/16);
+	
+	}
+	
+	
+	//	What light is propagated from, and into,
+	//	for each position in a region.  Each thread
+	//	allocates this once, it's too large for
+	//	the stack
+	class LightSnapshot {
+	
+	
+		public:
+		
+		
+			//	Opacity in the low four bits, emission
+			//	in the high four bits
+			std::unique_ptr<Byte []> Properties;
+			//	Block light in the low four bits,
+			//	skylight in the high four bits
+			std::unique_ptr<Byte []> Light;
+			
+			
+			LightSnapshot () : Properties(new Byte [region_size]), Light(new Byte [region_size]) {	}
+	
+	
+	};
+	
+	
+	//	A column and the columns surrounding
+	//	it, within which light is propagated
+	//	by breadth first flood fill
+	//
+	//	Light is propagated within a snapshot of
+	//	the columns, into which each section of
+	//	each column is copied the first time the
+	//	fill reaches it, and out of which only
+	//	sections whose light was written are
+	//	copied back.  Columns are locked one at a
+	//	time while they're copied.
+	//
+	//	Regions which overlap exclude each other
+	//	from the columns they share for the region's
+	//	lifetime, but a column is only claimed once
+	//	the fill reaches it
+	class LightRegion {
+	
+	
+		private:
+		
+		
+			//	Thrown when a column the fill reaches
+			//	cannot be claimed without risking
+			//	deadlock
+			class Contended {
+			
+			
+				public:
+				
+				
+					Word Column;
+			
+			
+			};
+			
+			
+			ColumnContainer ** columns;
+			//	Columns claimed, in the order in which
+			//	they were claimed
+			Vector<ColumnContainer *> owned;
+			bool sky;
+			Vector<UInt32> increase;
+			Vector<UInt32> decrease;
+			Byte * properties;
+			Byte * light;
+			bool claimed [9];
+			bool loaded [region_cells];
+			bool written [region_cells];
+			
+			
+			bool contains (Int32 x, Int32 z) const noexcept {
+			
+				return columns[((z/16)*3)+(x/16)]!=nullptr;
+			
+			}
+			
+			
+			//	Claims the right to propagate light into
+			//	and out of a column.  Claims are only
+			//	waited for in order of column ID, so that
+			//	regions which overlap may not deadlock
+			void claim (Word i) {
+			
+				auto column=columns[i];
+				
+				bool block=true;
+				for (auto curr : owned) if (!(curr->ID()<column->ID())) block=false;
+				
+				if (!column->AcquireLight(block)) throw Contended{i};
+				
+				owned.Add(column);
+				claimed[i]=true;
+			
+			}
+			
+			
+			void relinquish () noexcept {
+			
+				for (Word i=owned.Count();(i--)>0;) owned[i]->ReleaseLight();
+				
+				owned.Clear();
+				for (auto & c : claimed) c=false;
+			
+			}
+			
+			
+			//	Copies a cell into the snapshot
+			void load (Word cell) {
+			
+				Word i=cell/16;
+				if (!claimed[i]) claim(i);
+				
+				auto column=columns[i];
+				Word begin=(cell%16)*cell_size;
+				
+				column->Acquire();
+				
+				for (Word offset=begin;offset<(begin+cell_size);++offset) {
+				
+					auto block=column->Blocks[offset];
+					auto pos=to_region(offset,i);
+					
+					properties[pos]=get_opacity(block)|(get_emission(block)<<4);
+					light[pos]=block.GetLight()|(block.GetSkylight()<<4);
+				
+				}
+				
+				column->Release();
+				
+				loaded[cell]=true;
+			
+			}
+			
+			
+			UInt32 fetch (UInt32 pos) {
+			
+				auto cell=get_cell(pos);
+				if (!loaded[cell]) load(cell);
+				
+				return pos;
+			
+			}
+			
+			
+			//	Discards the snapshot
+			void reset () noexcept {
+			
+				for (auto & l : loaded) l=false;
+				for (auto & w : written) w=false;
+				increase.Clear();
+				decrease.Clear();
+			
+			}
+			
+			
+			Byte opacity_at (UInt32 pos) {
+			
+				return properties[fetch(pos)]&15;
+			
+			}
+			
+			
+			Byte emission_at (UInt32 pos) {
+			
+				return properties[fetch(pos)]>>4;
+			
+			}
+			
+			
+			//	Invokes a callback for each neighbour of
+			//	a position which is within the region,
+			//	passing its packed position, and whether
+			//	it's below the position
+			template <typename T>
+			void neighbours (UInt32 pos, T callback) {
+			
+				Int32 x=get_x(pos);
+				Int32 y=get_y(pos);
+				Int32 z=get_z(pos);
+				
+				bool down=true;
+				for (auto & d : directions) {
+				
+					Int32 nx=x+d[0];
+					Int32 ny=y+d[1];
+					Int32 nz=z+d[2];
+					
+					if (!(
+						(nx<0) || (nx>=region_width) ||
+						(ny<0) || (ny>=region_height) ||
+						(nz<0) || (nz>=region_width)
+					) && contains(nx,nz)) callback(pack(nx,ny,nz),down);
+					
+					down=false;
+				
+				}
+			
+			}
+			
+			
+			template <bool is_sky>
+			Byte get_light (UInt32 pos) {
+			
+				fetch(pos);
+			
+				return is_sky ? (light[pos]>>4) : (light[pos]&15);
+			
+			}
+			
+			
+			template <bool is_sky>
+			void set_light (UInt32 pos, Byte level) {
+			
+				auto cell=get_cell(pos);
+				if (!loaded[cell]) load(cell);
+				written[cell]=true;
+			
+				if (is_sky) light[pos]=(light[pos]&15)|(level<<4);
+				else light[pos]=(light[pos]&240)|level;
+			
+			}
+			
+			
+			//	The light a block has regardless of its
+			//	surroundings: blocks emit light, and the
+			//	topmost blocks receive it from the sky
+			template <bool is_sky>
+			Byte get_source (UInt32 pos) {
+			
+				if (!is_sky) return emission_at(pos);
+				
+				return (get_y(pos)==(region_height-1)) ? attenuate(max_light,opacity_at(pos),true,true) : 0;
+			
+			}
+			
+			
+			//	Spreads light outward from every queued
+			//	position
+			template <bool is_sky>
+			void spread () {
+			
+				for (Word i=0;i<increase.Count();++i) {
+				
+					auto pos=increase[i];
+					auto level=get_light<is_sky>(pos);
+					if (level<=1) continue;
+					
+					neighbours(pos,[&] (UInt32 n, bool down) mutable {
+					
+						auto candidate=attenuate(level,opacity_at(n),is_sky,down);
+						if (candidate<=get_light<is_sky>(n)) return;
+						
+						set_light<is_sky>(n,candidate);
+						increase.Add(n);
+					
+					});
+				
+				}
+				
+				increase.Clear();
+			
+			}
+			
+			
+			//	Removes light which came from the queued
+			//	positions, queueing the edges of the darkened
+			//	area to be spread back in
+			template <bool is_sky>
+			void darken () {
+			
+				for (Word i=0;i<decrease.Count();++i) {
+				
+					auto entry=decrease[i];
+					auto level=get_level(entry);
+					
+					neighbours(entry&0xFFFFF,[&] (UInt32 n, bool down) mutable {
+					
+						auto curr=get_light<is_sky>(n);
+						if (curr==0) return;
+						
+						//	Light at or above the removed level
+						//	came from elsewhere, and must spread
+						//	back into the darkened area
+						if (!(
+							(curr<level) ||
+							(is_sky && down && (level==max_light) && (curr==max_light))
+						)) {
+						
+							increase.Add(n);
+							
+							return;
+						
+						}
+						
+						set_light<is_sky>(n,0);
+						decrease.Add(n|(static_cast<UInt32>(curr)<<20));
+						
+						auto source=get_source<is_sky>(n);
+						if (source!=0) {
+						
+							set_light<is_sky>(n,source);
+							increase.Add(n);
+						
+						}
+					
+					});
+				
+				}
+				
+				decrease.Clear();
+			
+			}
+			
+			
+			//	Queues a block in the center column
+			//	which has changed
+			template <bool is_sky>
+			void change (UInt32 pos) {
+			
+				auto level=get_light<is_sky>(pos);
+				set_light<is_sky>(pos,0);
+				if (level!=0) decrease.Add(pos|(static_cast<UInt32>(level)<<20));
+				
+				auto source=get_source<is_sky>(pos);
+				if (source!=0) {
+				
+					set_light<is_sky>(pos,source);
+					increase.Add(pos);
+				
+				}
+				
+				//	Light may now pass into this block
+				//	from any direction
+				neighbours(pos,[&] (UInt32 n, bool) mutable {	increase.Add(n);	});
+			
+			}
+			
+			
+			//	Queues the blocks on either side of each
+			//	face of the center column which borders
+			//	a lit column
+			void border () {
+			
+				static const Int32 faces [][4]={
+					//	Column index, x, z, whether the face
+					//	runs along the x axis
+					{1,16,15,1},
+					{7,16,32,1},
+					{3,15,16,0},
+					{5,32,16,0}
+				};
+				
+				for (auto & face : faces) {
+				
+					if (columns[face[0]]==nullptr) continue;
+					
+					for (Int32 y=0;y<region_height;++y) for (Int32 i=0;i<16;++i) {
+					
+						Int32 x=face[1];
+						Int32 z=face[2];
+						if (face[3]==0) z+=i;
+						else x+=i;
+						
+						increase.Add(pack(x,y,z));
+						
+						//	The adjacent block within the
+						//	center column
+						if (face[3]==0) x=(x==15) ? 16 : 31;
+						else z=(z==15) ? 16 : 31;
+						
+						increase.Add(pack(x,y,z));
+					
+					}
+				
+				}
+			
+			}
+		
+		
+		public:
+		
+		
+			LightRegion (ColumnContainer ** columns, bool sky) noexcept : columns(columns), sky(sky) {
+			
+				static thread_local LightSnapshot snapshot;
+				properties=snapshot.Properties.get();
+				light=snapshot.Light.get();
+				
+				for (auto & c : claimed) c=false;
+				reset();
+			
+			}
+			
+			
+			~LightRegion () noexcept {
+			
+				relinquish();
+			
+			}
+			
+			
+			LightRegion (const LightRegion &) = delete;
+			LightRegion (LightRegion &&) = delete;
+			LightRegion & operator = (const LightRegion &) = delete;
+			LightRegion & operator = (LightRegion &&) = delete;
+			
+			
+			//	Invokes a callback which propagates light
+			//	within the region.  If the callback reaches
+			//	a column which cannot be claimed in order,
+			//	every claim is relinquished, the columns
+			//	claimed and the contended column are waited
+			//	for in order, and the callback is invoked
+			//	again from scratch.  The set of columns
+			//	only grows, so this ends.
+			template <typename T>
+			void Run (T && callback) {
+			
+				for (;;) {
+				
+					try {
+					
+						callback();
+						
+						return;
+					
+					} catch (const Contended & e) {
+					
+						Vector<ColumnContainer *> wanted;
+						for (auto column : owned) wanted.Add(column);
+						wanted.Add(columns[e.Column]);
+						std::sort(
+							wanted.begin(),
+							wanted.end(),
+							[] (const ColumnContainer * a, const ColumnContainer * b) {	return a->ID()<b->ID();	}
+						);
+						
+						relinquish();
+						reset();
+						
+						for (auto column : wanted) for (Word i=0;i<9;++i) if (columns[i]==column) claim(i);
+					
+					}
+				
+				}
+			
+			}
+			
+			
+			//	Calculates the light of the center column
+			//	from scratch, and exchanges light with
+			//	the surrounding columns
+			void Light () {
+			
+				//	Skylight falls straight down each
+				//	vertical shaft of blocks, the highest
+				//	block any shaft darkens is the highest
+				//	block from which skylight may spread
+				//	sideways within the column
+				Int32 top=-1;
+				for (Int32 x=16;x<32;++x) for (Int32 z=16;z<32;++z) {
+				
+					Byte level=sky ? max_light : 0;
+					for (Int32 y=region_height;(y--)>0;) {
+					
+						auto pos=pack(x,y,z);
+						
+						if (level!=0) level=attenuate(level,opacity_at(pos),true,true);
+						if ((level!=max_light) && (y>top)) top=y;
+						
+						auto emission=emission_at(pos);
+						set_light<false>(pos,emission);
+						set_light<true>(pos,level);
+						if (emission!=0) increase.Add(pos);
+					
+					}
+				
+				}
+				
+				border();
+				spread<false>();
+				
+				if (!sky) return;
+				
+				if (top!=(region_height-1)) ++top;
+				for (Int32 y=0;y<=top;++y) for (Int32 x=16;x<32;++x) for (Int32 z=16;z<32;++z) {
+				
+					auto pos=pack(x,y,z);
+					if (get_light<true>(pos)>1) increase.Add(pos);
+				
+				}
+				
+				border();
+				spread<true>();
+			
+			}
+			
+			
+			//	Relights the center column after blocks
+			//	at the given offsets within it changed
+			void Relight (const Vector<Word> & offsets, Word begin, Word end) {
+			
+				for (Word i=begin;i<end;++i) change<false>(to_region(offsets[i]));
+				darken<false>();
+				spread<false>();
+				
+				if (!sky) return;
+				
+				for (Word i=begin;i<end;++i) change<true>(to_region(offsets[i]));
+				darken<true>();
+				spread<true>();
+			
+			}
+	
+	
+			//	Copies light back out of the snapshot
+			//	for each section it was written in, and
+			//	sets each flag to whether the light of the
+			//	corresponding column changed
+			void Commit (bool * changed) noexcept {
+			
+				for (Word i=0;i<9;++i) {
+				
+					changed[i]=false;
+					
+					auto column=columns[i];
+					bool locked=false;
+					for (Word section=0;section<16;++section) {
+					
+						if (!written[(i*16)+section]) continue;
+						
+						if (!locked) {
+					
+							column->Acquire();
+							locked=true;
+					
+						}
+						
+						Word begin=section*cell_size;
+						for (Word offset=begin;offset<(begin+cell_size);++offset) {
+					
+							auto & block=column->Blocks[offset];
+							auto pos=to_region(offset,i);
+						
+							Byte level=light[pos]&15;
+							Byte sky_level=light[pos]>>4;
+							if ((block.GetLight()==level) && (block.GetSkylight()==sky_level)) continue;
+						
+							block.SetLight(level).SetSkylight(sky_level);
+							changed[i]=true;
+					
+						}
+					
+					}
+					
+					if (locked) column->Release();
+				
+				}
+			
+			}
+	
+	
+	};
+	
+	
+	
+	void World::get_neighbours (ColumnContainer & column, ColumnContainer ** columns) {
+	
+		auto id=column.ID();
+		
+		for (Word i=0;i<9;++i) columns[i]=nullptr;
+		columns[4]=&column;
+		
+		try {
+		
+			for (Int32 z=-1;z<=1;++z) for (Int32 x=-1;x<=1;++x) {
+			
+				if ((x==0) && (z==0)) continue;
+				
+				auto & neighbour=columns[((z+1)*3)+(x+1)];
+				neighbour=get_column(
+					ColumnID{
+						id.X+x,
+						id.Z+z,
+						id.Dimension
+					},
+					false
+				);
+				
+				//	Light may only be exchanged with
+				//	columns whose own light has been
+				//	calculated
+				if ((neighbour!=nullptr) && !neighbour->Lit()) {
+				
+					neighbour->EndInterest();
+					neighbour=nullptr;
+				
+				}
+			
+			}
+		
+		} catch (...) {
+		
+			for (Word i=0;i<9;++i) if ((i!=4) && (columns[i]!=nullptr)) columns[i]->EndInterest();
+			
+			throw;
+		
+		}
+	
+	}
+	
+	
+	static void end_interest (ColumnContainer ** columns) noexcept {
+	
+		for (Word i=0;i<9;++i) if ((i!=4) && (columns[i]!=nullptr)) columns[i]->EndInterest();
+	
+	}
+	
+	
+	void World::light (ColumnContainer & column) {
+	
+		Timer timer(Timer::CreateAndStart());
+		
+		//	The column is marked lit before its
+		//	neighbours are examined so that of two
+		//	adjacent columns being lit at once, at
+		//	least one sees the other and light is
+		//	exchanged between them
+		column.SetLit();
+		
+		ColumnContainer * columns [9];
+		get_neighbours(column,columns);
+		
+		try {
+		
+			bool changed [9];
+			{
+			
+				LightRegion region(columns,HasSkylight(column.ID().Dimension));
+			
+				region.Run([&] () mutable {	region.Light();	});
+				region.Commit(changed);
+			
+			}
+			
+			//	The center column is sent once it's
+			//	lit, but its neighbours may have been
+			//	sent already, and their light has
+			//	changed
+			for (Word i=0;i<9;++i) if ((i!=4) && changed[i]) columns[i]->Resend();
+		
+		} catch (...) {
+		
+			end_interest(columns);
+			
+			throw;
+		
+		}
+		
+		end_interest(columns);
+		
+		light_time+=timer.ElapsedNanoseconds();
+		++lit;
+	
+	}
+	
+	
+	void World::enqueue_light (ColumnContainer & column, BlockID id, Block from, Block to) {
+	
+		//	Columns which have not been lit will
+		//	have their light calculated from scratch
+		if (!column.Lit()) return;
+		
+		if (
+			(get_opacity(from)==get_opacity(to)) &&
+			(get_emission(from)==get_emission(to))
+		) return;
+		
+		bool schedule=light_lock.Execute([&] () mutable {
+		
+			light_pending[column.ID()].Add(id.GetOffset());
+			++light_count;
+			
+			if (light_scheduled) return false;
+			
+			light_scheduled=true;
+			
+			return true;
+		
+		});
+		
+		if (!schedule) return;
+		
+		//	Changes are batched for a short time so
+		//	that a bulk edit relights each affected
+		//	section once, rather than once per block
+		try {
+		
+			Server::Get().Pool().Enqueue(
+				light_delay,
+				[this] () mutable {	relight();	}
+			);
+		
+		} catch (...) {
+		
+			light_lock.Execute([&] () mutable {	light_scheduled=false;	});
+			
+			throw;
+		
+		}
+	
+	}
+	
+	
+	void World::relight () {
+	
+		static const Word relight_label=Profiler::GetLabel(relight_name);
+		ProfileScope scope(relight_label,Profiler::GetOwner());
+		
+		std::unordered_map<ColumnID,Vector<Word>> pending;
+		light_lock.Execute([&] () mutable {
+		
+			pending=std::move(light_pending);
+			light_pending.clear();
+			light_count=0;
+			light_scheduled=false;
+		
+		});
+		
+		for (auto & pair : pending) {
+		
+			//	Columns which have been unloaded
+			//	since they were changed cannot be
+			//	relit
+			auto column=get_column(pair.first,false);
+			if (column==nullptr) continue;
+			
+			ColumnContainer * columns [9];
+			try {
+			
+				get_neighbours(*column,columns);
+			
+			} catch (...) {
+			
+				column->EndInterest();
+				
+				throw;
+			
+			}
+			
+			try {
+			
+				Timer timer(Timer::CreateAndStart());
+				
+				LightRegion region(columns,HasSkylight(pair.first.Dimension));
+				
+				//	Group changes by section, and relight
+				//	each section in a single pass
+				auto & offsets=pair.second;
+				std::sort(offsets.begin(),offsets.end());
+				
+				Word sections=0;
+				region.Run([&] () mutable {
+				
+					sections=0;
+					for (Word begin=0;begin<offsets.Count();) {
+				
+						Word section=offsets[begin]/(16*16*16);
+						Word end=begin+1;
+						while ((end<offsets.Count()) && ((offsets[end]/(16*16*16))==section)) ++end;
+					
+						region.Relight(offsets,begin,end);
+						++sections;
+					
+						begin=end;
+				
+					}
+				
+				});
+				relit+=sections;
+				
+				//	Clients relight the blocks they're
+				//	sent changes to, and the blocks around
+				//	them, themselves, so nothing is resent
+				bool changed [9];
+				region.Commit(changed);
+				
+				light_time+=timer.ElapsedNanoseconds();
+			
+			} catch (...) {
+			
+				end_interest(columns);
+				column->EndInterest();
+				
+				throw;
+			
+			}
+			
+			end_interest(columns);
+			column->EndInterest();
+		
+		}
+	
+	}
+
+
+}
@@ -1,13 +1,46 @@
 #include <world/world.hpp>
 #include <server.hpp>
 #include <cstring>
+#include <stdexcept>
 
 
 namespace MCPP {
 
 
+	static const char * unknown_codec="Column saved with unknown codec";
+	static const String dictionary_error("Column X={0}, Z={1}, Dimension={2} was saved with Zstandard dictionary {3}, but the dictionary in \"column_dictionary\" is {4} - restore the dictionary the world was saved with to load it");
+
+
+	const Codec & World::get_codec (Byte id) const {
+	
+		switch (id) {
+		
+			case Codec::Zlib:
+				return *zlib_codec;
+			case Codec::Zstd:
+				return *zstd_codec;
+			default:
+				throw std::runtime_error(unknown_codec);
+		
+		}
+	
+	}
+
+
 	ColumnState World::load (ColumnContainer & column) {
 	
+		//	Recently unloaded columns may not
+		//	have to go to the backing store
+		if (uncache(column)) {
+		
+			//	Populated columns were lit before
+			//	they were cached
+			if (column.Populated) column.SetLit();
+			
+			return column.Populated ? ColumnState::Populated : ColumnState::Generated;
+		
+		}
+	
 		//	Attemt to retrieve data
 		auto buffer=Server::Get().Data().GetBinary(key(column));
 		//	If no data was retrieved from
@@ -15,22 +48,61 @@ namespace MCPP {
 		//	will have to be generated
 		if (buffer.IsNull()) return ColumnState::Generating;
 		
-		//	Decompress
-		auto decompressed=Inflate(
-			buffer->begin(),
-			buffer->end()
-		);
+		//	Decompress into this thread's scratch
+		//	slot with whichever codec it was saved
+		//	with, so that the column is untouched
+		//	unless what was saved turns out to be
+		//	valid
+		const Byte * begin=buffer->begin();
+		auto & codec=get_codec(Codec::Identify(begin,buffer->end()));
+		auto scratch=ColumnAllocator::Get().Scratch();
+		Word size;
+		try {
+		
+			size=codec.Decompress(
+				begin,
+				buffer->end(),
+				scratch,
+				ColumnContainer::Size
+			);
 		
+		//	Generating the column would overwrite
+		//	what was saved, so the load fails, but
+		//	says why
+		} catch (const CodecError & e) {
+		
+			auto id=column.ID();
+			Server::Get().WriteLog(
+				String::Format(
+					dictionary_error,
+					id.X,
+					id.Z,
+					id.Dimension,
+					e.Saved(),
+					e.Current()
+				),
+				Service::LogType::Error
+			);
+			
+			throw;
+		
+		}
+		
+		//	Columns saved before occupancy and
+		//	heights were saved alongside blocks
+		//	have them recalculated
+		bool legacy=size==ColumnContainer::LegacySize;
+		if (legacy) column.LoadLegacy(scratch);
+		else if (size==ColumnContainer::Size) std::memcpy(column.Get(),scratch,size);
 		//	If the data is an invalid length,
 		//	generate the column
-		if (decompressed.Count()!=ColumnContainer::Size) return ColumnState::Generating;
-		
-		//	Copy the decompressed data
-		std::memcpy(
-			column.Get(),
-			decompressed.begin(),
-			ColumnContainer::Size
-		);
+		else return ColumnState::Generating;
+		
+		//	Columns in the legacy format may have
+		//	been saved before light was calculated,
+		//	when every block was fully lit, so they
+		//	are relit rather than trusted
+		if (column.Populated && !legacy) column.SetLit();
 		
 		//	The column was loaded, but what
 		//	stat was it in?
@@ -7,7 +7,7 @@ namespace MCPP {
 
 	static const String maintenance_error("Error during world maintenance");
 	static const String end_maintenance("Finished world maintenance, took {0}ns, saved {1}, unloaded {2}");
-	static const String unload("Unloaded column {0}");
+	static const String unload("Unloaded column X={0}, Z={1}, Dimension={2}");
 
 
 	void World::maintenance () {
@@ -90,14 +90,28 @@ namespace MCPP {
 					++unloaded;
 					++this_unloaded;
 					
+					//	Nothing else may reach the column
+					//	now that it is out of the world,
+					//	so it can be compressed without
+					//	holding its lock
+					//
+					//	Failing to cache a column only
+					//	means it will be loaded from the
+					//	backing store
+					try {
+					
+						cache(*column);
+					
+					} catch (...) {	}
+					
 					//	TODO: Fire event
 					
-					if (is_verbose) server.WriteLog(
-						String::Format(
-							unload,
-							column->ToString()
-						),
-						Service::LogType::Debug
+					if (is_verbose) server.Log(
+						Service::LogType::Debug,
+						unload,
+						column->ID().X,
+						column->ID().Z,
+						column->ID().Dimension
 					);
 					
 				}
@@ -111,14 +125,12 @@ namespace MCPP {
 		++maintenances;
 		
 		//	Log if applicable
-		if (is_verbose) server.WriteLog(
-			String::Format(
-				end_maintenance,
-				elapsed,
-				this_saved,
-				this_unloaded
-			),
-			Service::LogType::Debug
+		if (is_verbose) server.Log(
+			Service::LogType::Debug,
+			end_maintenance,
+			elapsed,
+			this_saved,
+			this_unloaded
 		);
 	
 	}
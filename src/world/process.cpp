@@ -1,4 +1,5 @@
 #include <world/world.hpp>
+#include <profiler.hpp>
 #include <server.hpp>
 #include <exception>
 
@@ -6,13 +7,18 @@
 namespace MCPP {
 
 
-	static const String end_load("Loaded {0} {1} - {2} bytes in {3}ns");
+	static const String end_load("Loaded X={0}, Z={1}, Dimension={2} {3} - {4} bytes in {5}ns");
 	static const String populated_str("populated");
 	static const String generated_str("generated");
-	static const String end_load_miss("Attempted to load {0} but it was not present - took {1}ns");
-	static const String end_generate("Generated {0} - took {1}ns");
-	static const String end_populate("Populated {0} - took {1}ns");
+	static const String end_load_miss("Attempted to load X={0}, Z={1}, Dimension={2} but it was not present - took {3}ns");
+	static const String end_generate("Generated X={0}, Z={1}, Dimension={2} - took {3}ns");
+	static const String end_populate("Populated X={0}, Z={1}, Dimension={2} - took {3}ns");
 	static const String processing_error("Error while processing {0}");
+	static const String load_stage("Load Column");
+	static const String generate_stage("Generate Column");
+	static const String populate_stage("Populate Column");
+	static const String light_stage("Light Column");
+	static const String send_stage("Send Column");
 
 
 	void World::process (ColumnContainer & column, const WorldHandle * handle) {
@@ -20,6 +26,15 @@ namespace MCPP {
 		try {
 		
 			auto & server=Server::Get();
+			
+			//	Stages are attributed to the module on
+			//	whose behalf the column is being processed
+			static const Word load_label=Profiler::GetLabel(load_stage);
+			static const Word generate_label=Profiler::GetLabel(generate_stage);
+			static const Word populate_label=Profiler::GetLabel(populate_stage);
+			static const Word light_label=Profiler::GetLabel(light_stage);
+			static const Word send_label=Profiler::GetLabel(send_stage);
+			auto owner=Profiler::GetOwner();
 	
 			//	The state the column is currently in
 			ColumnState curr=column.GetState();
@@ -50,7 +65,13 @@ namespace MCPP {
 						dirty=false;
 						
 						//	Load from backing store
-						curr=load(column);
+						{
+						
+							ProfileScope scope(load_label,owner);
+							
+							curr=load(column);
+						
+						}
 						
 						//	Stats
 						auto elapsed=timer.ElapsedNanoseconds();
@@ -58,33 +79,58 @@ namespace MCPP {
 						++loaded;
 						
 						//	Log if necessary
-						if (is_verbose) server.WriteLog(
-							(
-								(curr==ColumnState::Generating)
-									//	We missed on the load --
-									//	nothing was loaded
-									?	String::Format(
-											end_load_miss,
-											column.ToString(),
-											elapsed
-										)
-									//	Load hit something -- we either
-									//	loaded a populated or generated
-									//	column
-									:	String::Format(
-											end_load,
-											column.ToString(),
-											(curr==ColumnState::Populated) ? populated_str : generated_str,
-											ColumnContainer::Size,
-											elapsed
-										)
-							),
-							Service::LogType::Debug
-						);
+						//
+						//	Formatting is deferred to the logging
+						//	thread, so pass the coordinates rather
+						//	than formatting the column here
+						if (is_verbose) {
+						
+							auto id=column.ID();
+							
+							//	We missed on the load --
+							//	nothing was loaded
+							if (curr==ColumnState::Generating) server.Log(
+								Service::LogType::Debug,
+								end_load_miss,
+								id.X,
+								id.Z,
+								id.Dimension,
+								elapsed
+							);
+							//	Load hit something -- we either
+							//	loaded a populated or generated
+							//	column
+							else server.Log(
+								Service::LogType::Debug,
+								end_load,
+								id.X,
+								id.Z,
+								id.Dimension,
+								(curr==ColumnState::Populated) ? populated_str : generated_str,
+								ColumnContainer::Size,
+								elapsed
+							);
+						
+						}
 						
 						//	We need to send the column to clients
-						//	if it has become populated
-						if (curr==ColumnState::Populated) goto populated;
+						//	if it has become populated, its light
+						//	was saved along with it, unless it was
+						//	saved in the legacy format, in which
+						//	case it's lit now
+						if (curr==ColumnState::Populated) {
+						
+							if (!column.Lit()) {
+							
+								ProfileScope scope(light_label,owner);
+								
+								light(column);
+							
+							}
+							
+							goto populated;
+						
+						}
 						
 					}break;
 					
@@ -96,7 +142,13 @@ namespace MCPP {
 						
 						//	Generate column by invoking
 						//	world generator
-						generate(column);
+						{
+						
+							ProfileScope scope(generate_label,owner);
+							
+							generate(column);
+						
+						}
 						curr=ColumnState::Generated;
 						
 						//	Stats
@@ -105,13 +157,13 @@ namespace MCPP {
 						++generated;
 						
 						//	Log if necessary
-						if (is_verbose) server.WriteLog(
-							String::Format(
-								end_generate,
-								column.ToString(),
-								elapsed
-							),
-							Service::LogType::Debug
+						if (is_verbose) server.Log(
+							Service::LogType::Debug,
+							end_generate,
+							column.ID().X,
+							column.ID().Z,
+							column.ID().Dimension,
+							elapsed
 						);
 						
 					}break;
@@ -135,7 +187,13 @@ namespace MCPP {
 						
 						//	Populate column by invoking
 						//	populators
-						populate(column,handle);
+						{
+						
+							ProfileScope scope(populate_label,owner);
+							
+							populate(column,handle);
+						
+						}
 						curr=ColumnState::Populated;
 						
 						//	Stats
@@ -144,14 +202,24 @@ namespace MCPP {
 						++populated;
 						
 						//	Log if necessary
-						if (is_verbose) server.WriteLog(
-							String::Format(
-								end_populate,
-								column.ToString(),
-								elapsed
-							),
-							Service::LogType::Debug
+						if (is_verbose) server.Log(
+							Service::LogType::Debug,
+							end_populate,
+							column.ID().X,
+							column.ID().Z,
+							column.ID().Dimension,
+							elapsed
 						);
+						
+						//	Light the column before it's
+						//	sent to clients
+						{
+						
+							ProfileScope scope(light_label,owner);
+							
+							light(column);
+						
+						}
 					
 					//	This scope is a neat
 					//	trick to avoid goto jumping
@@ -164,6 +232,8 @@ namespace MCPP {
 						//	sent to attached users
 						populated:
 						
+						ProfileScope scope(send_label,owner);
+						
 						column.Send();
 						
 						//	TODO: Fire event
@@ -2,14 +2,13 @@
 #include <compression.hpp>
 #include <server.hpp>
 #include <cstring>
-#include <iterator>
 
 
 namespace MCPP {
 
 
 	static const String save_failed("Failed saving {0} after {1}ns");
-	static const String end_save("Saved column {0} - {1} bytes in {2}ns");
+	static const String end_save("Saved column X={0}, Z={1}, Dimension={2} - {3} bytes in {4}ns");
 
 
 	bool World::save (ColumnContainer & column) {
@@ -17,6 +16,17 @@ namespace MCPP {
 		//	Start timer
 		Timer timer(Timer::CreateAndStart());
 	
+		//	We copy the column so that
+		//	other threads do not have
+		//	to wait for the backing
+		//	store save operation
+		//
+		//	The copy is made into this thread's
+		//	scratch slot so that it need not be
+		//	allocated, and is not counted as a
+		//	column in use
+		auto copy=ColumnAllocator::Get().Scratch();
+		
 		column.Acquire();
 		
 		//	Only save if necessary
@@ -28,13 +38,8 @@ namespace MCPP {
 		
 		}
 		
-		//	We copy the column so that
-		//	other threads do not have
-		//	to wait for the backing
-		//	store save operation
-		Byte buffer [ColumnContainer::Size];
 		memcpy(
-			buffer,
+			copy,
 			column.Get(),
 			ColumnContainer::Size
 		);
@@ -49,10 +54,12 @@ namespace MCPP {
 		//	Perform save
 		try {
 		
-			auto compressed=Deflate(
-				std::begin(buffer),
-				std::end(buffer)
+			auto buffer=reinterpret_cast<const Byte *>(copy);
+			auto compressed=codec->Encode(
+				buffer,
+				buffer+ColumnContainer::Size
 			);
+			
 			server.Data().SaveBinary(
 				key(column),
 				compressed.begin(),
@@ -88,19 +95,53 @@ namespace MCPP {
 		++saved;
 		
 		//	Log if applicable
-		if (server.IsVerbose(verbose)) server.WriteLog(
-			String::Format(
-				end_save,
-				column.ToString(),
-				ColumnContainer::Size,
-				elapsed
-			),
-			Service::LogType::Debug
+		if (server.IsVerbose(verbose)) server.Log(
+			Service::LogType::Debug,
+			end_save,
+			column.ID().X,
+			column.ID().Z,
+			column.ID().Dimension,
+			ColumnContainer::Size,
+			elapsed
 		);
 		
 		return true;
 	
 	}
+	
+	
+	Word World::Save (const Vector<ColumnID> & ids) {
+	
+		Word retr=0;
+		
+		maintenance_lock.Execute([&] () {
+		
+			for (auto & id : ids) {
+			
+				auto column=get_column(id,false);
+				if (column==nullptr) continue;
+				
+				try {
+				
+					if (save(*column)) ++retr;
+				
+				} catch (...) {
+				
+					column->EndInterest();
+					
+					throw;
+				
+				}
+				
+				column->EndInterest();
+			
+			}
+		
+		});
+		
+		return retr;
+	
+	}
 
 
 }
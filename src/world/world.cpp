@@ -18,6 +18,23 @@ namespace MCPP {
 	static const String seed_key("seed");
 	static const String maintenance_interval_key("maintenance_interval");
 	static const String type_key("world_type");
+	static const String light_delay_key("light_delay");
+	static const Word default_light_delay=50;
+	static const String bulk_max_key("bulk_max_bytes");
+	static const Word default_bulk_max=1024*1024;
+	static const Word default_bulk_delay=50;	//	1 tick
+	static const String cache_max_key("column_cache_bytes");
+	static const Word default_cache_max=64*1024*1024;
+	static const String huge_pages_key("column_huge_pages");
+	static const String huge_pages_transparent("transparent");
+	static const String huge_pages_explicit("explicit");
+	static const String preallocate_key("column_preallocate");
+	static const Word default_preallocate=0;
+	static const String codec_key("column_codec");
+	static const String codec_zstd("zstd");
+	static const String codec_level_key("column_codec_level");
+	static const String dictionary_key("column_dictionary");
+	static const String log_codec("Saving columns with {0}");
 	static const String log_type("Set world type to \"{0}\"");
 
 
@@ -35,6 +52,24 @@ namespace MCPP {
 		generate_time=0;
 		populated=0;
 		populate_time=0;
+		lit=0;
+		relit=0;
+		light_time=0;
+		cache_hits=0;
+		cache_misses=0;
+		cache_evictions=0;
+		
+		light_count=0;
+		light_scheduled=false;
+		
+		bulk_scheduled=false;
+		bulk_immediate=false;
+		bulk_delay=default_bulk_delay;
+		
+		cache_size=0;
+		cache_max=0;
+		
+		codec=nullptr;
 	
 	}
 	
@@ -82,6 +117,74 @@ namespace MCPP {
 			Service::LogType::Information
 		);
 		
+		//	Light delay
+		light_delay=server.Data().GetSetting(
+			light_delay_key,
+			default_light_delay
+		);
+		
+		//	Largest batch of columns
+		bulk_max=server.Data().GetSetting(
+			bulk_max_key,
+			default_bulk_max
+		);
+		
+		//	Budget for recently unloaded columns
+		cache_max=server.Data().GetSetting(
+			cache_max_key,
+			default_cache_max
+		);
+		
+		//	Column storage
+		auto huge_pages=server.Data().GetSetting(huge_pages_key);
+		ColumnAllocator::Get().Configure(
+			huge_pages.IsNull()
+				?	HugePages::None
+				:	(
+						(*huge_pages==huge_pages_explicit)
+							?	HugePages::Explicit
+							:	(
+									(*huge_pages==huge_pages_transparent)
+										?	HugePages::Transparent
+										:	HugePages::None
+								)
+					),
+			server.Data().GetSetting(
+				preallocate_key,
+				default_preallocate
+			)
+		);
+		
+		//	Column storage codec, ZLib unless
+		//	Zstandard is asked for.  Columns are
+		//	loaded with whichever codec they were
+		//	saved with either way
+		auto codec_name=server.Data().GetSetting(codec_key);
+		bool use_zstd=!codec_name.IsNull() && (*codec_name==codec_zstd);
+		Int32 zlib_level=Deflater::BestLevel;
+		Int32 zstd_level=ZstdCodec::DefaultLevel;
+		auto level=server.Data().GetSetting(codec_level_key);
+		if (!level.IsNull()) level->ToInteger(use_zstd ? &zstd_level : &zlib_level);
+		zlib_codec=std::unique_ptr<ZlibCodec>(new ZlibCodec(zlib_level));
+		//	A dictionary (which may be trained on
+		//	saved columns with "zstd --train") may
+		//	be stored alongside the columns
+		auto dictionary=server.Data().GetBinary(dictionary_key);
+		zstd_codec=std::unique_ptr<ZstdCodec>(
+			dictionary.IsNull()
+				?	new ZstdCodec(zstd_level)
+				:	new ZstdCodec(zstd_level,dictionary->begin(),dictionary->end())
+		);
+		if (use_zstd) codec=zstd_codec.get();
+		else codec=zlib_codec.get();
+		server.WriteLog(
+			String::Format(
+				log_codec,
+				codec->Name()
+			),
+			Service::LogType::Information
+		);
+		
 		//	Install shutdown handler to cleanup
 		//	any module code
 		server.OnShutdown.Add([this] () mutable {	cleanup_events();	});
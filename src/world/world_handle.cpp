@@ -17,9 +17,14 @@ namespace MCPP {
 			//	end interest in it
 			if (cache!=nullptr) cache->EndInterest();
 			
+			//	Relinquish all columns we
+			//	own
+			release();
+			
 			//	If we're holding the lock,
 			//	release it
-			if (locked) world->wlock.Release();
+			if (locked) world->wlock.CompleteWrite();
+			else if (shared) world->wlock.CompleteRead();
 			
 			//	Prevent this from executing
 			//	again
@@ -177,8 +182,18 @@ namespace MCPP {
 		//	here is permitted
 		if (!(force || world->can_set(event))) return false;
 		
-		//	Set block
-		column->SetBlock(id,block);
+		//	Set block, transactions own the
+		//	columns they write to, exclusive
+		//	handles own the whole world, only
+		//	dirty writes must wait for owners
+		column->SetBlock(
+			id,
+			block,
+			locked || (write==BlockWriteStrategy::Transactional)
+		);
+		
+		//	Queue the change to be relit
+		world->enqueue_light(*column,id,event.From,block);
 		
 		//	Fire event to notify listeners
 		//	that block has been set
@@ -188,24 +203,144 @@ namespace MCPP {
 	
 	}
 
+	
+	inline bool WorldHandle::own (ColumnContainer * column, bool block) const {
+		
+		//	Make room for the column before
+		//	acquiring it so that we don't
+		//	leak ownership if this throws
+		auto iter=held.emplace(column->ID(),column).first;
+		
+		//	Columns we own must not be
+		//	unloaded
+		column->Interested();
+		
+		bool acquired;
+		try {
+		
+			acquired=column->AcquireWrite(block);
+		
+		} catch (...) {
+		
+			column->EndInterest();
+			
+			held.erase(iter);
+			
+			throw;
+		
+		}
+		
+		if (!acquired) {
+		
+			column->EndInterest();
+			
+			held.erase(iter);
+		
+		}
+		
+		return acquired;
+	
+	}
+	
+	
+	inline void WorldHandle::acquire (ColumnContainer * column) const {
+	
+		//	If we already own this column,
+		//	there's nothing to do
+		auto id=column->ID();
+		if (held.count(id)!=0) return;
+		
+		//	We may only wait for a column if it
+		//	orders after every column we already
+		//	own.  Since every handle obeys this rule
+		//	no cycle of waiting handles can form,
+		//	and therefore no deadlock is possible.
+		if ((held.size()==0) || (held.rbegin()->first<id)) {
+		
+			own(column,true);
+			
+			return;
+		
+		}
+		
+		if (own(column,false)) return;
+		
+		//	The column is owned by someone else,
+		//	and waiting for it risks deadlock, so
+		//	we give up everything we own, and wait
+		//	for it all, and the column, in order
+		auto wanted=held;
+		wanted.emplace(id,column);
+		
+		//	Columns must not be unloaded while
+		//	we don't own them
+		for (auto & pair : wanted) pair.second->Interested();
+		
+		try {
+		
+			release();
+			
+			for (auto & pair : wanted) own(pair.second,true);
+		
+		} catch (...) {
+		
+			for (auto & pair : wanted) pair.second->EndInterest();
+			
+			throw;
+		
+		}
+		
+		for (auto & pair : wanted) pair.second->EndInterest();
+		
+		++reacquired;
+	
+	}
+	
+	
+	inline void WorldHandle::release () const noexcept {
+	
+		for (auto & pair : held) {
+		
+			pair.second->ReleaseWrite();
+			pair.second->EndInterest();
+		
+		}
+		
+		held.clear();
+	
+	}
+
 
 	WorldHandle::WorldHandle (World * world, BlockWriteStrategy write, BlockAccessStrategy access)
 		:	write(write),
 			access(access),
 			world(world),
 			locked(false),
+			shared(false),
 			cache(nullptr),
-			populate(0)
+			populate(0),
+			reacquired(0)
 	{
 	
-		//	If we're beginning a transaction,
-		//	begin it by acquiring the lock
-		//	at once
-		if (write==BlockWriteStrategy::Transactional) {
+		switch (write) {
 		
-			world->wlock.Acquire();
-			
-			locked=true;
+			//	Exclusive handles lock the entire
+			//	world at once
+			case BlockWriteStrategy::Exclusive:
+				world->wlock.Write();
+				locked=true;
+				break;
+			//	Transactions hold the world lock
+			//	shared for their entire lifetime,
+			//	they take ownership of columns as
+			//	they touch them
+			case BlockWriteStrategy::Transactional:
+				world->wlock.Read();
+				shared=true;
+				break;
+			case BlockWriteStrategy::Dirty:
+			default:
+				break;
 		
 		}
 	
@@ -217,8 +352,11 @@ namespace MCPP {
 		access(other.access),
 		world(other.world),
 		locked(other.locked),
+		shared(other.shared),
+		held(std::move(other.held)),
 		cache(other.cache),
-		populate(other.populate)
+		populate(other.populate),
+		reacquired(other.reacquired)
 	{
 	
 		//	Null out the other object's
@@ -243,8 +381,11 @@ namespace MCPP {
 			access=other.access;
 			world=other.world;
 			locked=other.locked;
+			shared=other.shared;
+			held=std::move(other.held);
 			cache=other.cache;
 			populate=other.populate;
+			reacquired=other.reacquired;
 			
 			//	Invalidate the other
 			//	handle
@@ -277,18 +418,50 @@ namespace MCPP {
 		//	for whatever reason, fail
 		if (column==nullptr) return false;
 		
-		//	Acquire the world lock if
-		//	necessary
-		bool locked=false;
-		if (!this->locked) {
+		//	If we hold the world lock exclusively
+		//	we may write at once
+		if (locked) return set_impl(
+			column,
+			id,
+			block,
+			force
+		);
+		
+		//	Transactions hold the world lock
+		//	shared for their entire lifetime,
+		//	and must own every column they write
+		//	to
+		if (write==BlockWriteStrategy::Transactional) {
 		
-			world->wlock.Acquire();
+			acquire(column);
 			
-			locked=true;
-			this->locked=true;
+			return set_impl(
+				column,
+				id,
+				block,
+				force
+			);
 		
 		}
 		
+		//	Dirty writes hold the world lock shared
+		//	only for the duration of the write --
+		//	unless this write was made from within
+		//	an event fired by another write made
+		//	through this handle -- so that exclusive
+		//	handles may exclude them, and wait for
+		//	any transaction which owns the column
+		//	to finish with it
+		if (shared) return set_impl(
+			column,
+			id,
+			block,
+			force
+		);
+		
+		world->wlock.Read();
+		shared=true;
+			
 		bool retr;
 		try {
 		
@@ -302,25 +475,15 @@ namespace MCPP {
 		} catch (...) {
 		
 			//	Don't leak lock
-			if (locked) {
-			
-				world->wlock.Release();
-				
-				this->locked=false;
-				
-			}
+			world->wlock.CompleteRead();
+			shared=false;
 			
 			throw;
 		
 		}
 		
-		if (locked) {
-		
-			world->wlock.Release();
-			
-			this->locked=false;
-			
-		}
+		world->wlock.CompleteRead();
+		shared=false;
 		
 		return retr;
 	
@@ -342,6 +505,11 @@ namespace MCPP {
 		//	a null column
 		if (column==nullptr) return retr;
 		
+		//	Transactions guarantee that columns
+		//	they read from do not change, so
+		//	they must own them
+		if (write==BlockWriteStrategy::Transactional) acquire(column);
+		
 		retr.Construct(column->GetBlock(id));
 		
 		return retr;
@@ -350,6 +518,7 @@ namespace MCPP {
 	
 	
 	static const char * block_retrieve_error="Block could not be retrieved";
+	static const char * different_dimensions="Corners are not in the same dimension";
 	
 	
 	Block WorldHandle::Get (BlockID id) const {
@@ -368,6 +537,42 @@ namespace MCPP {
 	}
 	
 	
+	bool WorldHandle::Acquire (ColumnID a, ColumnID b) const {
+	
+		if (a.Dimension!=b.Dimension) throw std::invalid_argument(different_dimensions);
+	
+		if (write!=BlockWriteStrategy::Transactional) return true;
+		
+		//	Iterating by dimension, then x, then
+		//	z visits columns in the same order
+		//	in which they are ranked
+		Int32 min_x=(a.X<b.X) ? a.X : b.X;
+		Int32 max_x=(a.X<b.X) ? b.X : a.X;
+		Int32 min_z=(a.Z<b.Z) ? a.Z : b.Z;
+		Int32 max_z=(a.Z<b.Z) ? b.Z : a.Z;
+		
+		for (Int64 x=min_x;x<=max_x;++x) for (Int64 z=min_z;z<=max_z;++z) {
+		
+			auto * column=get_column(
+				ColumnID{
+					static_cast<Int32>(x),
+					static_cast<Int32>(z),
+					a.Dimension
+				},
+				false
+			);
+			
+			if (column==nullptr) return false;
+			
+			acquire(column);
+		
+		}
+		
+		return true;
+	
+	}
+	
+	
 	bool WorldHandle::Exclusive () const noexcept {
 	
 		return locked;
@@ -375,6 +580,20 @@ namespace MCPP {
 	}
 	
 	
+	bool WorldHandle::Locked () const noexcept {
+	
+		return locked || shared || (held.size()!=0);
+	
+	}
+	
+	
+	Word WorldHandle::Reacquired () const noexcept {
+	
+		return reacquired;
+	
+	}
+	
+	
 	void WorldHandle::BeginPopulate () const noexcept {
 	
 		++populate;
@@ -3,6 +3,7 @@
 #include <yggdrasil.hpp>
 #include <limits>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 
@@ -192,9 +193,7 @@ namespace Yggdrasil {
 	static MCPP::HTTPRequest get_request (const JSON::Value & value) {
 	
 		auto retr=get_request();
-		retr.Body=UTF8().Encode(
-			JSON::Serialize(value)
-		);
+		JSON::Serialize(retr.Body,value);
 		retr.Verb=MCPP::HTTPVerb::POST;
 		retr.Headers.Add({
 			content_type_key,
@@ -364,6 +363,36 @@ namespace Yggdrasil {
 	}
 	
 	
+	//	The greatest latency, in milliseconds,
+	//	counted in each bucket of the latency
+	//	histogram
+	static const Word latency_maximums []={
+		50,
+		100,
+		250,
+		500,
+		1000,
+		2500,
+		5000,
+		std::numeric_limits<Word>::max()
+	};
+	
+	
+	Client::Client () : verified_max(0), verified_time(0), clock(Timer::CreateAndStart()) {
+	
+		static_assert(
+			std::extent<decltype(latency)>::value==std::extent<decltype(latency_maximums)>::value,
+			"Latency histogram does not match its buckets"
+		);
+		
+		requests=0;
+		coalesced=0;
+		cached=0;
+		for (auto & count : latency) count=0;
+	
+	}
+	
+	
 	static const String auth_username_key("username");
 	static const String auth_password_key("password");
 	static const String auth_client_token_key("clientToken");
@@ -585,6 +614,94 @@ namespace Yggdrasil {
 	}
 	
 	
+	Nullable<String> Client::recall (const VerifiedKey & key) {
+	
+		return verified_lock.Execute([&] () mutable {
+		
+			Nullable<String> retr;
+			
+			auto iter=verified.find(key);
+			if (iter==verified.end()) return retr;
+			
+			if (clock.ElapsedMilliseconds()>=iter->second.Expires) verified.erase(iter);
+			else retr.Construct(iter->second.UUID);
+			
+			return retr;
+		
+		});
+	
+	}
+	
+	
+	void Client::remember (VerifiedKey key, String uuid) {
+	
+		verified_lock.Execute([&] () mutable {
+		
+			if ((verified_max==0) || (verified_time==0)) return;
+			
+			auto now=clock.ElapsedMilliseconds();
+			
+			//	Make room by forgetting every session
+			//	which has expired, or if none have,
+			//	the session which would expire first
+			if ((verified.size()>=verified_max) && (verified.find(key)==verified.end())) {
+			
+				auto first=verified.end();
+				for (auto iter=verified.begin();iter!=verified.end();) {
+				
+					if (now>=iter->second.Expires) {
+					
+						iter=verified.erase(iter);
+						
+						continue;
+					
+					}
+					
+					if ((first==verified.end()) || (iter->second.Expires<first->second.Expires)) first=iter;
+					
+					++iter;
+				
+				}
+				
+				if (verified.size()>=verified_max) verified.erase(first);
+			
+			}
+			
+			verified[std::move(key)]=VerifiedSession{
+				std::move(uuid),
+				now+verified_time
+			};
+		
+		});
+	
+	}
+	
+	
+	Vector<Promise<String>> Client::take (const SessionKey & key) {
+	
+		return sessions_lock.Execute([&] () mutable {
+		
+			auto iter=sessions.find(key);
+			auto retr=std::move(iter->second);
+			sessions.erase(iter);
+			
+			return retr;
+		
+		});
+	
+	}
+	
+	
+	void Client::record (UInt64 milliseconds) noexcept {
+	
+		Word i=0;
+		while (milliseconds>latency_maximums[i]) ++i;
+		
+		++latency[i];
+	
+	}
+	
+	
 	static const String session_id_key("id");
 	static const String server_endpoint("hasJoined?username={0}&serverId={1}");
 	static const char * session_fail("Session verification failed");
@@ -592,44 +709,176 @@ namespace Yggdrasil {
 		const String & username,
 		const String & server_id,
 		const Vector<Byte> & secret,
-		const Vector<Byte> & public_key
+		const Vector<Byte> & public_key,
+		Nullable<IPAddress> ip
 	) {
 	
-		//	Building a custom GET request
-		auto request=get_request();
-		request.URL=String::Format(
-			session_url,
-			String::Format(
-				server_endpoint,
-				MCPP::URL::Encode(username),
-				MCPP::URL::Encode(
-					get_hash(server_id,secret,public_key)
-				)
-			)
-		);
+		Promise<String> retr;
 		
-		//	Dispatch
-		return http.Execute(
-			std::move(request)
-		).Then([] (Promise<MCPP::HTTPResponse> p) {
+		//	If this username was verified from this
+		//	address recently, there's no need to ask
+		//	again
+		if (!ip.IsNull()) {
 		
-			auto response=p.Get();
-			check(response);
+			auto uuid=recall(VerifiedKey(username,*ip));
+			if (!uuid.IsNull()) {
 			
-			//	If the server returned nothing,
-			//	that's its way of letting us now
-			//	we failed
-			if (response.Body.Count()==0) throw std::runtime_error(session_fail);
+				++cached;
+				
+				retr.Complete(std::move(*uuid));
+				
+				return retr;
 			
-			auto obj=get_json(response);
-			return get_value<String>(
-				obj,
-				session_id_key
+			}
+		
+		}
+		
+		auto hash=get_hash(server_id,secret,public_key);
+		
+		//	If this exact verification is already
+		//	in progress, wait for its result
+		SessionKey key(username,hash);
+		if (!sessions_lock.Execute([&] () mutable {
+		
+			auto iter=sessions.find(key);
+			if (iter!=sessions.end()) {
+			
+				iter->second.Add(retr);
+				
+				return false;
+			
+			}
+			
+			Vector<Promise<String>> waiting;
+			waiting.Add(retr);
+			sessions.emplace(key,std::move(waiting));
+			
+			return true;
+		
+		})) {
+		
+			++coalesced;
+			
+			return retr;
+		
+		}
+		
+		try {
+	
+			//	Building a custom GET request
+			auto request=get_request();
+			request.URL=String::Format(
+				session_url,
+				String::Format(
+					server_endpoint,
+					MCPP::URL::Encode(username),
+					MCPP::URL::Encode(hash)
+				)
 			);
 		
+			++requests;
+			
+			//	Dispatch
+			auto timer=Timer::CreateAndStart();
+			http.Execute(
+				std::move(request)
+			).Then([this,key,ip,timer] (Promise<MCPP::HTTPResponse> p) mutable {
+			
+				record(timer.ElapsedMilliseconds());
+				
+				auto waiting=take(key);
+				
+				String uuid;
+				try {
+		
+					auto response=p.Get();
+					check(response);
+			
+					//	If the server returned nothing,
+					//	that's its way of letting us now
+					//	we failed
+					if (response.Body.Count()==0) throw std::runtime_error(session_fail);
+			
+					auto obj=get_json(response);
+					uuid=get_value<String>(
+						obj,
+						session_id_key
+					);
+		
+				} catch (...) {
+				
+					auto ex=std::current_exception();
+					for (auto & promise : waiting) promise.Fail(ex);
+					
+					return;
+				
+				}
+				
+				if (!ip.IsNull()) remember(
+					VerifiedKey(key.Item<0>(),*ip),
+					uuid
+				);
+				
+				for (auto & promise : waiting) promise.Complete(uuid);
+			
+			});
+		
+		} catch (...) {
+		
+			//	Verifications which joined this one
+			//	would otherwise never complete, the
+			//	first promise is this call's, which
+			//	fails by throwing
+			auto ex=std::current_exception();
+			auto waiting=take(key);
+			for (Word i=1;i<waiting.Count();++i) waiting[i].Fail(ex);
+			
+			throw;
+		
+		}
+		
+		return retr;
+	
+	}
+	
+	
+	void Client::SetMaxConnections (Word max) {
+	
+		http.SetMaxHostConnections(max);
+	
+	}
+
+
+	void Client::SetSessionCache (Word max, Word milliseconds) {
+	
+		verified_lock.Execute([&] () mutable {
+		
+			verified_max=max;
+			verified_time=milliseconds;
+			
+			if ((verified_max==0) || (verified_time==0)) verified.clear();
+		
 		});
 	
 	}
 
+	
+	SessionInfo Client::GetInfo () const {
+	
+		SessionInfo retr;
+		retr.Requests=requests;
+		retr.Coalesced=coalesced;
+		retr.Cached=cached;
+		for (Word i=0;i<std::extent<decltype(latency)>::value;++i) retr.Latency.Add(
+			LatencyBucket{
+				latency_maximums[i],
+				latency[i]
+			}
+		);
+		
+		return retr;
+	
+	}
+
 
 }